@@ -0,0 +1,43 @@
+#!/bin/sh
+#
+# $COPYRIGHT$
+#
+# Additional copyrights may follow
+#
+# $HEADER$
+#
+# Write the list of MCA components installed in a directory into the
+# manifest read by mca_base_component_repository_add(), so that
+# processes do not have to scan (and stat every file of) the
+# directory at startup.
+#
+# Usage: opal_mca_component_manifest.sh <component directory>
+#
+
+dir=$1
+# no mca_ prefix, the directory scan would take it for a component
+manifest=component_manifest.txt
+
+if test -z "$dir" || test ! -d "$dir"; then
+    exit 0
+fi
+
+cd "$dir" || exit 1
+
+tmp=".$manifest.$$"
+{
+    echo "# Open MPI MCA component manifest -- generated at install time."
+    echo "# It is ignored if this directory is modified after it was written."
+    for file in mca_*; do
+        test -f "$file" || continue
+        case "$file" in
+            *.la|*.lo|*.txt) continue ;;
+        esac
+        # strip the extension, the dl framework adds it back
+        echo "${file%.*}"
+    done | sort -u
+} > "$tmp" || { rm -f "$tmp"; exit 1; }
+
+# the rename modifies the directory, touch the manifest afterwards so it
+# is not considered stale
+mv -f "$tmp" "$manifest" && touch "$manifest"
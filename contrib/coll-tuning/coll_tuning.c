@@ -0,0 +1,903 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/*
+ * Measure the collective algorithms of coll/tuned and the collective
+ * components usable by coll/han on the current machine, and write the
+ * winners as dynamic rule files:
+ *
+ *   mpirun -np <N> ./coll_tuning [options]
+ *
+ *   coll_tuned_dynamic_rules_filename = coll_tuned.rules
+ *   (with coll_tuned_use_dynamic_rules = 1)
+ *   coll_han_dynamic_rules_filename = coll_han.rules
+ *   (with coll_han_use_dynamic_file_rules = 1)
+ *
+ * Every algorithm of a collective is forced in turn through its
+ * coll_tuned_<coll>_algorithm control variable (MPI_T), on communicators
+ * of the requested sizes created after the change so that coll/tuned
+ * reads the new value. The segmented collectives (bcast, reduce) are
+ * measured with every segment size of a list, forced the same way
+ * through coll_tuned_<coll>_algorithm_segmentsize, and the segment size
+ * of the winner is written to its rule. The HAN candidates are selected by creating the
+ * communicators with the ompi_comm_coll_preference info key.
+ *
+ * A measurement is repeated until the half width of the 95% confidence
+ * interval of its mean falls under a fraction of the mean (or a maximum
+ * number of samples is reached). Along the message sizes the current
+ * winner is only replaced when another candidate is faster with non
+ * overlapping confidence intervals, which keeps noise from producing a
+ * new rule at every size.
+ *
+ * The message sizes written in the files follow the computation of the
+ * decision functions: total size of the operation for the collectives
+ * coll/tuned keys on it (alltoall, gather, ...), size of a block for
+ * coll/han. Collectives whose coll/tuned decision does not depend on the
+ * message size get a single rule, the candidate with the lowest time
+ * relative to the best one summed over the message sizes.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <math.h>
+
+#include "mpi.h"
+
+#define TUNE_MAX_SIZES  64
+#define TUNE_MAX_COMMS  32
+#define TUNE_MAX_CANDS  64
+#define TUNE_MAX_SEGS   8
+#define TUNE_NAME_LEN   64
+
+/* how the coll/tuned decision computes the message size */
+enum {
+    TUNE_KEY_NONE = 0,  /* does not depend on it */
+    TUNE_KEY_BLOCK,     /* size of one block */
+    TUNE_KEY_TOTAL      /* size of one block times the communicator size */
+};
+
+/* topologic levels of coll/han, see coll_han_dynamic.h */
+enum {
+    TUNE_INTRA_NODE = 0,
+    TUNE_INTER_NODE,
+    TUNE_GLOBAL_COMMUNICATOR,
+    TUNE_NB_TOPO_LVL
+};
+
+typedef struct {
+    const char *name;
+    int id;         /* COLLTYPE of ompi/mca/coll/base/coll_base_functions.h */
+    int reduction;
+    int tuned_key;
+    int han;        /* coll/han has dynamic rules for it */
+    int adapt;      /* coll/adapt implements it */
+    int segmented;  /* coll/tuned has a forced segment size for it */
+} tune_coll_t;
+
+static const tune_coll_t tune_colls[] = {
+    { "allgather",            0, 0, TUNE_KEY_TOTAL, 1, 1, 0 },
+    { "allgatherv",           1, 0, TUNE_KEY_BLOCK, 1, 0, 0 },
+    { "allreduce",            2, 1, TUNE_KEY_BLOCK, 1, 1, 0 },
+    { "alltoall",             3, 0, TUNE_KEY_TOTAL, 0, 0, 0 },
+    { "alltoallv",            4, 0, TUNE_KEY_NONE,  0, 0, 0 },
+    { "barrier",              6, 0, TUNE_KEY_NONE,  1, 0, 0 },
+    { "bcast",                7, 0, TUNE_KEY_BLOCK, 1, 1, 1 },
+    { "exscan",               8, 1, TUNE_KEY_NONE,  0, 0, 0 },
+    { "gather",               9, 0, TUNE_KEY_TOTAL, 1, 0, 0 },
+    { "reduce",              11, 1, TUNE_KEY_BLOCK, 1, 1, 1 },
+    { "reduce_scatter",      12, 1, TUNE_KEY_TOTAL, 0, 0, 0 },
+    { "reduce_scatter_block",13, 1, TUNE_KEY_TOTAL, 0, 0, 0 },
+    { "scan",                14, 1, TUNE_KEY_NONE,  0, 0, 0 },
+    { "scatter",             15, 0, TUNE_KEY_TOTAL, 1, 0, 0 },
+};
+#define TUNE_NCOLLS ((int) (sizeof(tune_colls) / sizeof(tune_colls[0])))
+
+typedef struct {
+    double mean;
+    double half;    /* half width of the 95% confidence interval */
+    int samples;
+    int valid;
+} tune_stat_t;
+
+typedef struct {
+    int config;     /* communicator size */
+    int nrules;
+    size_t key[TUNE_MAX_SIZES];
+    int choice[TUNE_MAX_SIZES];
+    int segsize[TUNE_MAX_SIZES];
+} tune_rules_t;
+
+typedef struct {
+    int value;
+    int segsize;
+    char name[TUNE_NAME_LEN];
+} tune_cand_t;
+
+/* options */
+static size_t min_size = 1, max_size = 1 << 20, buffer_size = 1 << 26;
+static int min_samples = 5, max_samples = 100, max_iters = 1000, warmup = 2;
+static double precision = 0.05, sample_time = 1e-3;
+static int verbose = 0, do_tuned = 1, do_han = 1;
+static const char *tuned_file = "coll_tuned.rules", *han_file = "coll_han.rules";
+static int ncomms = 0, comm_sizes[TUNE_MAX_COMMS];
+static int nsegs = 3, seg_sizes[TUNE_MAX_SEGS] = { 1024, 8192, 65536 };
+static int selected[TUNE_NCOLLS];
+
+static int rank, size;
+static char *sbuf, *rbuf;
+static int *scounts, *sdispls, *rcounts, *rdispls;
+static size_t msg_sizes[TUNE_MAX_SIZES];
+static int nsizes;
+
+/* Student's t quantile at 97.5% for 1 to 30 degrees of freedom */
+static const double t975[] = {
+    12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+    2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+    2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+};
+
+static double tune_t975(int df)
+{
+    return (df <= 30) ? t975[df - 1] : 1.960;
+}
+
+/* bytes needed in each buffer for one block of b bytes */
+static size_t tune_needed(const tune_coll_t *c, size_t b, int n)
+{
+    switch (c->id) {
+    case 0: case 1: case 3: case 4: case 9: case 12: case 13: case 15:
+        return b * (size_t) n;
+    default:
+        return b;
+    }
+}
+
+static size_t tune_tuned_key(const tune_coll_t *c, size_t b, int n)
+{
+    return (TUNE_KEY_TOTAL == c->tuned_key) ? b * (size_t) n : b;
+}
+
+/* barrier has no message, reductions work on floats */
+static int tune_size_usable(const tune_coll_t *c, size_t b, int n)
+{
+    if (6 == c->id) {
+        return 0 == b;
+    }
+    if (0 == b || (c->reduction && b < sizeof(float))) {
+        return 0;
+    }
+    return tune_needed(c, b, n) <= buffer_size;
+}
+
+static int tune_run(const tune_coll_t *c, size_t b, MPI_Comm comm)
+{
+    int count = (int) b, fcount = (int) (b / sizeof(float));
+
+    switch (c->id) {
+    case 0:
+        return MPI_Allgather(sbuf, count, MPI_BYTE, rbuf, count, MPI_BYTE, comm);
+    case 1:
+        return MPI_Allgatherv(sbuf, count, MPI_BYTE, rbuf, rcounts, rdispls, MPI_BYTE, comm);
+    case 2:
+        return MPI_Allreduce(sbuf, rbuf, fcount, MPI_FLOAT, MPI_SUM, comm);
+    case 3:
+        return MPI_Alltoall(sbuf, count, MPI_BYTE, rbuf, count, MPI_BYTE, comm);
+    case 4:
+        return MPI_Alltoallv(sbuf, scounts, sdispls, MPI_BYTE,
+                             rbuf, rcounts, rdispls, MPI_BYTE, comm);
+    case 6:
+        return MPI_Barrier(comm);
+    case 7:
+        return MPI_Bcast(sbuf, count, MPI_BYTE, 0, comm);
+    case 8:
+        return MPI_Exscan(sbuf, rbuf, fcount, MPI_FLOAT, MPI_SUM, comm);
+    case 9:
+        return MPI_Gather(sbuf, count, MPI_BYTE, rbuf, count, MPI_BYTE, 0, comm);
+    case 11:
+        return MPI_Reduce(sbuf, rbuf, fcount, MPI_FLOAT, MPI_SUM, 0, comm);
+    case 12:
+        return MPI_Reduce_scatter(sbuf, rbuf, rcounts, MPI_FLOAT, MPI_SUM, comm);
+    case 13:
+        return MPI_Reduce_scatter_block(sbuf, rbuf, fcount, MPI_FLOAT, MPI_SUM, comm);
+    case 14:
+        return MPI_Scan(sbuf, rbuf, fcount, MPI_FLOAT, MPI_SUM, comm);
+    case 15:
+        return MPI_Scatter(sbuf, count, MPI_BYTE, rbuf, count, MPI_BYTE, 0, comm);
+    }
+    return MPI_ERR_OTHER;
+}
+
+/*
+ * Time collective c with blocks of b bytes on comm. The loop is driven
+ * by the slowest process of ctl, which is comm itself or a communicator
+ * containing several comms measured at the same time.
+ */
+static void tune_measure(const tune_coll_t *c, size_t b, MPI_Comm comm, MPI_Comm ctl,
+                         tune_stat_t *st)
+{
+    double t, t0, mean = 0.0, m2 = 0.0, d, half = 0.0;
+    int n, i, s, iters, err = 0;
+
+    MPI_Comm_size(comm, &n);
+    for (i = 0; i < n; i++) {
+        scounts[i] = rcounts[i] = (int) b;
+        sdispls[i] = rdispls[i] = (int) (b * i);
+        if (12 == c->id) {
+            rcounts[i] = (int) (b / sizeof(float));
+        }
+    }
+
+    /* algorithms restricted to some communicator sizes return an error
+       on every process */
+    for (i = 0; i < warmup; i++) {
+        err |= (MPI_SUCCESS != tune_run(c, b, comm));
+    }
+    MPI_Allreduce(MPI_IN_PLACE, &err, 1, MPI_INT, MPI_MAX, ctl);
+    st->valid = !err;
+    if (err) {
+        return;
+    }
+
+    MPI_Barrier(comm);
+    t = MPI_Wtime();
+    tune_run(c, b, comm);
+    t0 = MPI_Wtime() - t;
+    MPI_Allreduce(MPI_IN_PLACE, &t0, 1, MPI_DOUBLE, MPI_MAX, ctl);
+    iters = (t0 > 0.0) ? (int) (sample_time / t0) : max_iters;
+    iters = (iters < 1) ? 1 : ((iters > max_iters) ? max_iters : iters);
+
+    for (s = 1; s <= max_samples; s++) {
+        MPI_Barrier(comm);
+        t = MPI_Wtime();
+        for (i = 0; i < iters; i++) {
+            tune_run(c, b, comm);
+        }
+        t = (MPI_Wtime() - t) / iters;
+        MPI_Allreduce(MPI_IN_PLACE, &t, 1, MPI_DOUBLE, MPI_MAX, ctl);
+
+        d = t - mean;
+        mean += d / s;
+        m2 += d * (t - mean);
+        if (s >= min_samples) {
+            half = tune_t975(s - 1) * sqrt(m2 / (s - 1) / s);
+            if (half <= precision * mean) {
+                break;
+            }
+        }
+    }
+    st->mean = mean;
+    st->half = half;
+    st->samples = (s > max_samples) ? max_samples : s;
+}
+
+/*
+ * Turn the measurements st[cand * nsizes + size] into rules
+ */
+static void tune_choose(int sizeless, int ncands, const tune_stat_t *st,
+                        const size_t *keys, tune_rules_t *rules)
+{
+    int s, a, best, inc = -1;
+
+    rules->nrules = 0;
+    if (sizeless) {
+        double score[TUNE_MAX_CANDS] = { 0.0 }, bmean;
+
+        for (s = 0; s < nsizes; s++) {
+            for (a = 0, bmean = 0.0; a < ncands; a++) {
+                const tune_stat_t *x = &st[a * nsizes + s];
+                if (x->valid && (0.0 == bmean || x->mean < bmean)) {
+                    bmean = x->mean;
+                }
+            }
+            for (a = 0; a < ncands && bmean > 0.0; a++) {
+                const tune_stat_t *x = &st[a * nsizes + s];
+                score[a] = (x->valid && score[a] >= 0.0) ? score[a] + x->mean / bmean : -1.0;
+            }
+        }
+        for (a = 0, best = -1; a < ncands; a++) {
+            if (score[a] > 0.0 && (best < 0 || score[a] < score[best])) {
+                best = a;
+            }
+        }
+        if (best >= 0) {
+            rules->key[0] = 0;
+            rules->choice[0] = best;
+            rules->nrules = 1;
+        }
+        return;
+    }
+
+    for (s = 0; s < nsizes; s++) {
+        for (a = 0, best = -1; a < ncands; a++) {
+            const tune_stat_t *x = &st[a * nsizes + s];
+            if (x->valid && (best < 0 || x->mean < st[best * nsizes + s].mean)) {
+                best = a;
+            }
+        }
+        if (best < 0 || best == inc) {
+            continue;
+        }
+        if (inc >= 0 && st[inc * nsizes + s].valid) {
+            const tune_stat_t *b = &st[best * nsizes + s], *i = &st[inc * nsizes + s];
+            if (b->mean + b->half >= i->mean - i->half) {
+                /* not significantly faster than the current winner */
+                continue;
+            }
+        }
+        rules->key[rules->nrules] = (0 == rules->nrules) ? 0 : keys[s];
+        rules->choice[rules->nrules] = best;
+        rules->nrules++;
+        inc = best;
+    }
+}
+
+static void tune_report(const tune_coll_t *c, const char *what, int config,
+                        const tune_cand_t *cands, int ncands, const tune_stat_t *st)
+{
+    int s, a;
+
+    if (0 != rank || !verbose) {
+        return;
+    }
+    for (s = 0; s < nsizes; s++) {
+        for (a = 0; a < ncands; a++) {
+            const tune_stat_t *x = &st[a * nsizes + s];
+            if (!x->valid) {
+                continue;
+            }
+            printf("%s %s np %d size %zu %s: %.3f us +- %.3f (%d samples)\n",
+                   what, c->name, config, msg_sizes[s], cands[a].name,
+                   x->mean * 1e6, x->half * 1e6, x->samples);
+        }
+    }
+    fflush(stdout);
+}
+
+static int tune_cvar_index(const char *name)
+{
+    int idx;
+
+    return (MPI_SUCCESS == MPI_T_cvar_get_index(name, &idx)) ? idx : -1;
+}
+
+static int tune_cvar_write(int idx, int value)
+{
+    MPI_T_cvar_handle handle;
+    int count, rc;
+
+    rc = MPI_T_cvar_handle_alloc(idx, NULL, &handle, &count);
+    if (MPI_SUCCESS != rc) {
+        return rc;
+    }
+    rc = MPI_T_cvar_write(handle, &value);
+    MPI_T_cvar_handle_free(&handle);
+    return rc;
+}
+
+/* the algorithms of a coll/tuned collective, from the enumerator of its
+   control variable */
+static int tune_tuned_algorithms(int idx, tune_cand_t *cands)
+{
+    char name[TUNE_NAME_LEN], desc[8];
+    int nlen = TUNE_NAME_LEN, dlen = sizeof(desc), verb, bind, scope, num, i, n = 0;
+    MPI_Datatype dtype;
+    MPI_T_enum enumtype;
+
+    if (MPI_SUCCESS != MPI_T_cvar_get_info(idx, name, &nlen, &verb, &dtype, &enumtype,
+                                           desc, &dlen, &bind, &scope) ||
+        MPI_T_ENUM_NULL == enumtype) {
+        return 0;
+    }
+    nlen = TUNE_NAME_LEN;
+    if (MPI_SUCCESS != MPI_T_enum_get_info(enumtype, &num, name, &nlen)) {
+        return 0;
+    }
+    for (i = 0; i < num && n < TUNE_MAX_CANDS; i++) {
+        nlen = TUNE_NAME_LEN;
+        if (MPI_SUCCESS != MPI_T_enum_get_item(enumtype, i, &cands[n].value,
+                                               cands[n].name, &nlen)) {
+            continue;
+        }
+        if (0 != cands[n].value) {  /* 0 is the default decision */
+            cands[n].segsize = 0;
+            n++;
+        }
+    }
+    return n;
+}
+
+/* every algorithm with every segment size, the algorithms that do not
+   segment ignore it */
+static int tune_tuned_segments(tune_cand_t *cands, int ncands)
+{
+    tune_cand_t algs[TUNE_MAX_CANDS];
+    int a, g, n = 0;
+
+    memcpy(algs, cands, ncands * sizeof(tune_cand_t));
+    for (a = 0; a < ncands; a++) {
+        for (g = 0; g < nsegs && n < TUNE_MAX_CANDS; g++) {
+            cands[n].value = algs[a].value;
+            cands[n].segsize = seg_sizes[g];
+            snprintf(cands[n].name, TUNE_NAME_LEN, "%.40s/%d", algs[a].name, seg_sizes[g]);
+            n++;
+        }
+    }
+    return n;
+}
+
+static MPI_Comm tune_comm_with(MPI_Comm comm, const char *preference)
+{
+    MPI_Comm newcomm;
+    MPI_Info info;
+
+    MPI_Info_create(&info);
+    MPI_Info_set(info, "ompi_comm_coll_preference", preference);
+    MPI_Comm_dup_with_info(comm, info, &newcomm);
+    MPI_Info_free(&info);
+    return newcomm;
+}
+
+static void tune_fill_keys(const tune_coll_t *c, int n, int han, size_t *keys)
+{
+    for (int s = 0; s < nsizes; s++) {
+        keys[s] = han ? msg_sizes[s] : tune_tuned_key(c, msg_sizes[s], n);
+    }
+}
+
+/*
+ * coll/tuned: every algorithm of c on every communicator size
+ */
+static void tune_tuned_coll(const tune_coll_t *c, tune_rules_t *rules, int *nconfigs)
+{
+    tune_cand_t cands[TUNE_MAX_CANDS];
+    tune_stat_t *st;
+    size_t keys[TUNE_MAX_SIZES];
+    char name[TUNE_NAME_LEN];
+    int idx, sidx = -1, ncands, i, a, s;
+
+    *nconfigs = 0;
+    snprintf(name, sizeof(name), "coll_tuned_%s_algorithm", c->name);
+    idx = tune_cvar_index(name);
+    ncands = (idx < 0) ? 0 : tune_tuned_algorithms(idx, cands);
+    if (0 == ncands) {
+        if (0 == rank) {
+            fprintf(stderr, "coll_tuning: cannot force the %s algorithms, skipped\n", c->name);
+        }
+        return;
+    }
+    if (c->segmented) {
+        snprintf(name, sizeof(name), "coll_tuned_%s_algorithm_segmentsize", c->name);
+        sidx = tune_cvar_index(name);
+        if (sidx >= 0) {
+            ncands = tune_tuned_segments(cands, ncands);
+        } else if (0 == rank) {
+            fprintf(stderr, "coll_tuning: cannot force the %s segment size, using the default\n",
+                    c->name);
+        }
+    }
+
+    st = (tune_stat_t *) calloc(ncands * nsizes, sizeof(tune_stat_t));
+    for (i = 0; i < ncomms; i++) {
+        int n = comm_sizes[i];
+        MPI_Comm sub;
+
+        MPI_Comm_split(MPI_COMM_WORLD, (rank < n) ? 0 : MPI_UNDEFINED, rank, &sub);
+        if (MPI_COMM_NULL != sub) {
+            for (a = 0; a < ncands; a++) {
+                MPI_Comm comm;
+
+                if (MPI_SUCCESS != tune_cvar_write(idx, cands[a].value) ||
+                    (sidx >= 0 && MPI_SUCCESS != tune_cvar_write(sidx, cands[a].segsize))) {
+                    /* drop what was measured on the previous size */
+                    for (s = 0; s < nsizes; s++) {
+                        st[a * nsizes + s].valid = 0;
+                    }
+                    continue;
+                }
+                /* coll/tuned reads the forced algorithm when the
+                   communicator is created */
+                comm = tune_comm_with(sub, "tuned");
+                for (s = 0; s < nsizes; s++) {
+                    tune_stat_t *x = &st[a * nsizes + s];
+                    x->valid = 0;
+                    if (tune_size_usable(c, msg_sizes[s], n)) {
+                        tune_measure(c, msg_sizes[s], comm, comm, x);
+                    }
+                }
+                MPI_Comm_free(&comm);
+            }
+            tune_cvar_write(idx, 0);
+            if (sidx >= 0) {
+                tune_cvar_write(sidx, 0);
+            }
+            tune_report(c, "tuned", n, cands, ncands, st);
+
+            tune_fill_keys(c, n, 0, keys);
+            tune_choose(TUNE_KEY_NONE == c->tuned_key, ncands, st, keys, &rules[*nconfigs]);
+            rules[*nconfigs].config = n;
+            for (a = 0; a < rules[*nconfigs].nrules; a++) {
+                rules[*nconfigs].segsize[a] = cands[rules[*nconfigs].choice[a]].segsize;
+                rules[*nconfigs].choice[a] = cands[rules[*nconfigs].choice[a]].value;
+            }
+            MPI_Comm_free(&sub);
+        }
+        if (0 == rank && rules[*nconfigs].nrules > 0) {
+            (*nconfigs)++;
+        }
+        MPI_Barrier(MPI_COMM_WORLD);
+    }
+    free(st);
+}
+
+/* candidates of coll/han for c on a topologic level, in order of
+   preference on ties */
+static const char *han_components[] = { "han", "tuned", "adapt", "basic" };
+#define TUNE_HAN_NCOMPONENTS 4
+
+static int tune_han_candidates(const tune_coll_t *c, int level, int *cands)
+{
+    char name[TUNE_NAME_LEN];
+    int i, n = 0;
+
+    for (i = 0; i < TUNE_HAN_NCOMPONENTS; i++) {
+        if ((0 == i && TUNE_GLOBAL_COMMUNICATOR != level) ||
+            (2 == i && !c->adapt)) {
+            continue;
+        }
+        snprintf(name, sizeof(name), "coll_%s_priority", han_components[i]);
+        if (tune_cvar_index(name) >= 0) {
+            cands[n++] = i;
+        }
+    }
+    return n;
+}
+
+/*
+ * Measure the han candidates on comm (one per process, possibly of
+ * different sizes), all of them at the same time
+ */
+static void tune_han_level(const tune_coll_t *c, int level, MPI_Comm comm, MPI_Comm ctl,
+                           int config, tune_rules_t *rules)
+{
+    tune_cand_t names[TUNE_MAX_CANDS];
+    tune_stat_t *st;
+    size_t keys[TUNE_MAX_SIZES];
+    int cands[TUNE_HAN_NCOMPONENTS], ncands, n, nmax, a, s;
+
+    MPI_Comm_size(comm, &n);
+    MPI_Allreduce(&n, &nmax, 1, MPI_INT, MPI_MAX, ctl);
+    ncands = tune_han_candidates(c, level, cands);
+    st = (tune_stat_t *) calloc(ncands * nsizes, sizeof(tune_stat_t));
+
+    for (a = 0; a < ncands; a++) {
+        char preference[TUNE_NAME_LEN];
+        MPI_Comm ccomm;
+
+        snprintf(names[a].name, TUNE_NAME_LEN, "%s", han_components[cands[a]]);
+        snprintf(preference, sizeof(preference), "%s%s", han_components[cands[a]],
+                 (TUNE_GLOBAL_COMMUNICATOR == level) ? "" : ",^han");
+        ccomm = tune_comm_with(comm, preference);
+        for (s = 0; s < nsizes; s++) {
+            st[a * nsizes + s].valid = 0;
+            if (tune_size_usable(c, msg_sizes[s], nmax)) {
+                tune_measure(c, msg_sizes[s], ccomm, ctl, &st[a * nsizes + s]);
+            }
+        }
+        MPI_Comm_free(&ccomm);
+    }
+    tune_report(c, (TUNE_INTRA_NODE == level) ? "han/intra_node" :
+                (TUNE_INTER_NODE == level) ? "han/inter_node" : "han/global",
+                config, names, ncands, st);
+
+    tune_fill_keys(c, n, 1, keys);
+    tune_choose(0, ncands, st, keys, rules);
+    rules->config = config;
+    for (a = 0; a < rules->nrules; a++) {
+        rules->choice[a] = cands[rules->choice[a]];
+    }
+    free(st);
+}
+
+static void tune_han_coll(const tune_coll_t *c, tune_rules_t rules[TUNE_NB_TOPO_LVL][TUNE_MAX_COMMS],
+                          int nconfigs[TUNE_NB_TOPO_LVL], MPI_Comm node, MPI_Comm leaders)
+{
+    int i, sizes[2];
+
+    nconfigs[TUNE_INTRA_NODE] = nconfigs[TUNE_INTER_NODE] = 0;
+    nconfigs[TUNE_GLOBAL_COMMUNICATOR] = 0;
+
+    /* the sub-communicators of han on this machine */
+    MPI_Comm_size(node, &sizes[0]);
+    MPI_Comm_size(leaders, &sizes[1]);
+    MPI_Bcast(sizes, 2, MPI_INT, 0, MPI_COMM_WORLD);
+    if (sizes[0] > 1) {
+        tune_han_level(c, TUNE_INTRA_NODE, node, MPI_COMM_WORLD, sizes[0],
+                       &rules[TUNE_INTRA_NODE][0]);
+        nconfigs[TUNE_INTRA_NODE] = (rules[TUNE_INTRA_NODE][0].nrules > 0);
+    }
+    if (sizes[1] > 1) {
+        tune_han_level(c, TUNE_INTER_NODE, leaders, MPI_COMM_WORLD, sizes[1],
+                       &rules[TUNE_INTER_NODE][0]);
+        nconfigs[TUNE_INTER_NODE] = (rules[TUNE_INTER_NODE][0].nrules > 0);
+    }
+
+    for (i = 0; i < ncomms; i++) {
+        int n = comm_sizes[i], k = nconfigs[TUNE_GLOBAL_COMMUNICATOR];
+        MPI_Comm sub;
+
+        MPI_Comm_split(MPI_COMM_WORLD, (rank < n) ? 0 : MPI_UNDEFINED, rank, &sub);
+        if (MPI_COMM_NULL != sub) {
+            tune_han_level(c, TUNE_GLOBAL_COMMUNICATOR, sub, sub, n,
+                           &rules[TUNE_GLOBAL_COMMUNICATOR][k]);
+            MPI_Comm_free(&sub);
+            if (0 == rank && rules[TUNE_GLOBAL_COMMUNICATOR][k].nrules > 0) {
+                nconfigs[TUNE_GLOBAL_COMMUNICATOR]++;
+            }
+        }
+        MPI_Barrier(MPI_COMM_WORLD);
+    }
+}
+
+static void tune_write_tuned(tune_rules_t (*rules)[TUNE_MAX_COMMS], const int *nconfigs)
+{
+    FILE *f;
+    int c, i, r, ncolls = 0;
+
+    for (c = 0; c < TUNE_NCOLLS; c++) {
+        ncolls += (nconfigs[c] > 0);
+    }
+    if (NULL == (f = fopen(tuned_file, "w"))) {
+        fprintf(stderr, "coll_tuning: cannot write %s\n", tuned_file);
+        return;
+    }
+    fprintf(f, "# coll/tuned dynamic rules measured by coll_tuning on %d processes\n", size);
+    fprintf(f, "%d # number of collectives\n", ncolls);
+    for (c = 0; c < TUNE_NCOLLS; c++) {
+        if (0 == nconfigs[c]) {
+            continue;
+        }
+        fprintf(f, "%d # collective id (%s)\n", tune_colls[c].id, tune_colls[c].name);
+        fprintf(f, "%d # number of communicator sizes\n", nconfigs[c]);
+        for (i = 0; i < nconfigs[c]; i++) {
+            tune_rules_t *x = &rules[c][i];
+            fprintf(f, "%d # communicator size\n", x->config);
+            fprintf(f, "%d # number of message sizes\n", x->nrules);
+            for (r = 0; r < x->nrules; r++) {
+                fprintf(f, "%zu %d 0 %d # message size, algorithm, topology fanout, segment size\n",
+                        x->key[r], x->choice[r], x->segsize[r]);
+            }
+        }
+    }
+    fclose(f);
+    printf("coll_tuning: coll/tuned rules written to %s\n", tuned_file);
+}
+
+static void tune_write_han(tune_rules_t (*rules)[TUNE_NB_TOPO_LVL][TUNE_MAX_COMMS],
+                           int (*nconfigs)[TUNE_NB_TOPO_LVL])
+{
+    static const char *levels[] = { "intra_node", "inter_node", "global_communicator" };
+    FILE *f;
+    int c, l, i, r, ncolls = 0, nlevels;
+
+    for (c = 0; c < TUNE_NCOLLS; c++) {
+        ncolls += (nconfigs[c][0] + nconfigs[c][1] + nconfigs[c][2] > 0);
+    }
+    if (NULL == (f = fopen(han_file, "w"))) {
+        fprintf(stderr, "coll_tuning: cannot write %s\n", han_file);
+        return;
+    }
+    fprintf(f, "# coll/han dynamic rules measured by coll_tuning on %d processes\n", size);
+    fprintf(f, "%d # number of collectives\n", ncolls);
+    for (c = 0; c < TUNE_NCOLLS; c++) {
+        for (l = 0, nlevels = 0; l < TUNE_NB_TOPO_LVL; l++) {
+            nlevels += (nconfigs[c][l] > 0);
+        }
+        if (0 == nlevels) {
+            continue;
+        }
+        fprintf(f, "%s # collective\n", tune_colls[c].name);
+        fprintf(f, "%d # number of topologic levels\n", nlevels);
+        for (l = 0; l < TUNE_NB_TOPO_LVL; l++) {
+            if (0 == nconfigs[c][l]) {
+                continue;
+            }
+            fprintf(f, "%d # topologic level (%s)\n", l, levels[l]);
+            fprintf(f, "%d # number of configurations\n", nconfigs[c][l]);
+            for (i = 0; i < nconfigs[c][l]; i++) {
+                tune_rules_t *x = &rules[c][l][i];
+                /* the first configuration covers all the smaller ones */
+                fprintf(f, "%d # configuration size (measured on %d)\n",
+                        (0 == i) ? 1 : x->config, x->config);
+                fprintf(f, "%d # number of message sizes\n", x->nrules);
+                for (r = 0; r < x->nrules; r++) {
+                    fprintf(f, "%zu %s\n", x->key[r], han_components[x->choice[r]]);
+                }
+            }
+        }
+    }
+    fclose(f);
+    printf("coll_tuning: coll/han rules written to %s\n", han_file);
+}
+
+static void usage(const char *argv0)
+{
+    printf("Usage: mpirun %s [options]\n"
+           "  -c coll,...  collectives to tune (default: all)\n"
+           "  -n n,...     communicator sizes (default: powers of 2 and the world size)\n"
+           "  -m bytes     smallest block size (default %zu)\n"
+           "  -M bytes     largest block size (default %zu)\n"
+           "  -b bytes     largest buffer per process (default %zu)\n"
+           "  -g bytes,... segment sizes of bcast and reduce (default 1024,8192,65536)\n"
+           "  -s n         minimum number of samples (default %d)\n"
+           "  -S n         maximum number of samples (default %d)\n"
+           "  -e frac      target half width of the confidence interval (default %.2f)\n"
+           "  -T sec       minimum duration of a sample (default %g)\n"
+           "  -o tuned|han component to tune (default: both)\n"
+           "  -t file      coll/tuned rules file (default %s)\n"
+           "  -H file      coll/han rules file (default %s)\n"
+           "  -v           print every measurement\n",
+           argv0, min_size, max_size, buffer_size, min_samples, max_samples,
+           precision, sample_time, tuned_file, han_file);
+}
+
+static int parse_options(int argc, char **argv)
+{
+    char *tok, *save;
+    int opt, c, all = 1;
+
+    while (-1 != (opt = getopt(argc, argv, "c:n:m:M:b:g:s:S:e:T:o:t:H:vh"))) {
+        switch (opt) {
+        case 'c':
+            all = 0;
+            for (tok = strtok_r(optarg, ",", &save); NULL != tok; tok = strtok_r(NULL, ",", &save)) {
+                for (c = 0; c < TUNE_NCOLLS && 0 != strcmp(tok, tune_colls[c].name); c++);
+                if (c == TUNE_NCOLLS) {
+                    if (0 == rank) fprintf(stderr, "coll_tuning: unknown collective %s\n", tok);
+                    return -1;
+                }
+                selected[c] = 1;
+            }
+            break;
+        case 'n':
+            for (tok = strtok_r(optarg, ",", &save); NULL != tok && ncomms < TUNE_MAX_COMMS;
+                 tok = strtok_r(NULL, ",", &save)) {
+                comm_sizes[ncomms] = atoi(tok);
+                if (comm_sizes[ncomms] >= 2 && comm_sizes[ncomms] <= size &&
+                    (0 == ncomms || comm_sizes[ncomms] > comm_sizes[ncomms - 1])) {
+                    ncomms++;
+                }
+            }
+            break;
+        case 'm': min_size = strtoull(optarg, NULL, 0); break;
+        case 'M': max_size = strtoull(optarg, NULL, 0); break;
+        case 'b': buffer_size = strtoull(optarg, NULL, 0); break;
+        case 'g':
+            nsegs = 0;
+            for (tok = strtok_r(optarg, ",", &save); NULL != tok && nsegs < TUNE_MAX_SEGS;
+                 tok = strtok_r(NULL, ",", &save)) {
+                if (atoi(tok) > 0) {
+                    seg_sizes[nsegs++] = atoi(tok);
+                }
+            }
+            if (0 == nsegs) {
+                if (0 == rank) fprintf(stderr, "coll_tuning: no valid segment size\n");
+                return -1;
+            }
+            break;
+        case 's': min_samples = atoi(optarg); break;
+        case 'S': max_samples = atoi(optarg); break;
+        case 'e': precision = atof(optarg); break;
+        case 'T': sample_time = atof(optarg); break;
+        case 'o':
+            do_tuned = (0 == strcmp(optarg, "tuned"));
+            do_han = (0 == strcmp(optarg, "han"));
+            break;
+        case 't': tuned_file = optarg; break;
+        case 'H': han_file = optarg; break;
+        case 'v': verbose = 1; break;
+        default:
+            if (0 == rank) usage(argv[0]);
+            return -1;
+        }
+    }
+    if (min_samples < 2) min_samples = 2;
+    if (max_samples < min_samples) max_samples = min_samples;
+    if (all) {
+        for (c = 0; c < TUNE_NCOLLS; c++) selected[c] = 1;
+    }
+    if (0 == ncomms) {
+        for (int n = 2; n < size && ncomms < TUNE_MAX_COMMS - 1; n *= 2) {
+            comm_sizes[ncomms++] = n;
+        }
+        comm_sizes[ncomms++] = size;
+    }
+    /* barrier is only measured with a size of 0 */
+    msg_sizes[nsizes++] = 0;
+    for (size_t b = (min_size < 1) ? 1 : min_size; b <= max_size && nsizes < TUNE_MAX_SIZES; b *= 2) {
+        msg_sizes[nsizes++] = b;
+    }
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    static tune_rules_t tuned_rules[TUNE_NCOLLS][TUNE_MAX_COMMS];
+    static tune_rules_t han_rules[TUNE_NCOLLS][TUNE_NB_TOPO_LVL][TUNE_MAX_COMMS];
+    int tuned_nconfigs[TUNE_NCOLLS] = { 0 }, han_nconfigs[TUNE_NCOLLS][TUNE_NB_TOPO_LVL];
+    int provided, c, local_rank;
+    MPI_Comm node, leaders;
+
+    /* the forced algorithms are only honored with the dynamic rules */
+    setenv("OMPI_MCA_coll_tuned_use_dynamic_rules", "1", 1);
+
+    MPI_Init(&argc, &argv);
+    MPI_T_init_thread(MPI_THREAD_SINGLE, &provided);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+    MPI_Comm_set_errhandler(MPI_COMM_WORLD, MPI_ERRORS_RETURN);
+
+    if (size < 2 || 0 != parse_options(argc, argv)) {
+        if (size < 2 && 0 == rank) {
+            fprintf(stderr, "coll_tuning: needs at least 2 processes\n");
+        }
+        MPI_T_finalize();
+        MPI_Finalize();
+        return 1;
+    }
+
+    sbuf = (char *) calloc(buffer_size, 1);
+    rbuf = (char *) calloc(buffer_size, 1);
+    scounts = (int *) malloc(4 * size * sizeof(int));
+    if (NULL == sbuf || NULL == rbuf || NULL == scounts) {
+        fprintf(stderr, "coll_tuning: cannot allocate %zu bytes buffers\n", buffer_size);
+        MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+    sdispls = scounts + size;
+    rcounts = scounts + 2 * size;
+    rdispls = scounts + 3 * size;
+
+    if (do_tuned) {
+        for (c = 0; c < TUNE_NCOLLS; c++) {
+            if (selected[c]) {
+                tune_tuned_coll(&tune_colls[c], tuned_rules[c], &tuned_nconfigs[c]);
+            }
+        }
+        if (0 == rank) {
+            tune_write_tuned(tuned_rules, tuned_nconfigs);
+        }
+    }
+
+    if (do_han) {
+        /* the communicators han builds: processes of a node, and
+           processes of the same local rank across the nodes */
+        MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &node);
+        MPI_Comm_rank(node, &local_rank);
+        MPI_Comm_split(MPI_COMM_WORLD, local_rank, rank, &leaders);
+        for (c = 0; c < TUNE_NCOLLS; c++) {
+            han_nconfigs[c][0] = han_nconfigs[c][1] = han_nconfigs[c][2] = 0;
+            if (selected[c] && tune_colls[c].han) {
+                tune_han_coll(&tune_colls[c], han_rules[c], han_nconfigs[c], node, leaders);
+            }
+        }
+        if (0 == rank) {
+            tune_write_han(han_rules, han_nconfigs);
+        }
+        MPI_Comm_free(&leaders);
+        MPI_Comm_free(&node);
+    }
+
+    free(sbuf);
+    free(rbuf);
+    free(scounts);
+    MPI_T_finalize();
+    MPI_Finalize();
+    return 0;
+}
@@ -47,6 +47,7 @@
 #include "ompi/mca/coll/base/base.h"
 #include "ompi/request/request.h"
 #include "ompi/runtime/mpiruntime.h"
+#include "ompi/runtime/params.h"
 
 struct ompi_comm_cid_context_t;
 
@@ -78,6 +79,10 @@ struct ompi_comm_cid_context_t {
     int nextcid_epoch;
 #endif /* OPAL_ENABLE_FT_MPI */
     int start;
+    /** window based allocation: local values followed by the reduced ones */
+    int *window;
+    int window_base;
+    uint32_t window_seq;
     int flag, rflag;
     int local_leader;
     int remote_leader;
@@ -101,6 +106,7 @@ static void mca_comm_cid_context_destruct (ompi_comm_cid_context_t *context)
 {
     free (context->port_string);
     free (context->pmix_tag);
+    free (context->window);
 }
 
 OBJ_CLASS_INSTANCE (ompi_comm_cid_context_t, opal_object_t,
@@ -275,6 +281,10 @@ static ompi_comm_allreduce_context_t *ompi_comm_allreduce_context_alloc (int *in
     return context;
 }
 
+/* reserve a window of cids and agree on the first free one with a single allreduce */
+static int ompi_comm_nextcid_window (ompi_comm_request_t *request);
+/* pick the cid out of the reduced window, fall back to getnextcid if none is free */
+static int ompi_comm_nextcid_window_complete (ompi_comm_request_t *request);
 /* find the next available local cid and start an allreduce */
 static int ompi_comm_allreduce_getnextcid (ompi_comm_request_t *request);
 /* verify that the maximum cid is locally available and start an allreduce */
@@ -311,7 +321,15 @@ int ompi_comm_nextcid_nb (ompi_communicator_t *newcomm, ompi_communicator_t *com
     request->context = &context->super;
     request->super.req_mpi_object.comm = context->comm;
 
-    ompi_comm_request_schedule_append (request, ompi_comm_allreduce_getnextcid, NULL, 0);
+    if (ompi_mpi_comm_cid_window > 0 &&
+        (OMPI_COMM_CID_INTRA == mode || OMPI_COMM_CID_INTER == mode)) {
+        /* all processes start the allocations on a communicator in the same
+         * order, so the sequence number is the same everywhere */
+        context->window_seq = comm->c_id_window_started++;
+        ompi_comm_request_schedule_append (request, ompi_comm_nextcid_window, NULL, 0);
+    } else {
+        ompi_comm_request_schedule_append (request, ompi_comm_allreduce_getnextcid, NULL, 0);
+    }
     ompi_comm_request_start (request);
 
     *req = &request->super;
@@ -339,6 +357,208 @@ int ompi_comm_nextcid (ompi_communicator_t *newcomm, ompi_communicator_t *comm,
     return rc;
 }
 
+/* find the first locally available cid at or above start and reserve it
+ * for comm. returns pml_max_contextid if there is none. must be called
+ * with the cid lock held. */
+static int ompi_comm_reserve_local_cid (int start, ompi_communicator_t *comm)
+{
+    for (unsigned int i = start ; i < mca_pml.pml_max_contextid ; ++i) {
+        if (opal_pointer_array_test_and_set_item (&ompi_mpi_communicators, i, comm)) {
+            return i;
+        }
+    }
+
+    return mca_pml.pml_max_contextid;
+}
+
+/**
+ * Window based cid allocation.
+ *
+ * All processes examine the same window of ompi_mpi_comm_cid_window cids
+ * starting at the c_id_available of the parent communicator. Each process
+ * reserves the cids of the window that are locally free and contributes a
+ * flag per cid (0 if free) together with its lowest free cid. A single
+ * MPI_MAX allreduce then yields the cids that are free everywhere and a
+ * lower bound for the next window. If no cid of the window is free, the
+ * iterative algorithm below is used starting after the window.
+ *
+ * The c_id_available value must be identical on all processes, hence the
+ * allocations on a given parent are completed in the order they were
+ * started.
+ */
+#if OPAL_ENABLE_FT_MPI
+#define OMPI_COMM_CID_WINDOW_HDR 2
+#else
+#define OMPI_COMM_CID_WINDOW_HDR 1
+#endif /* OPAL_ENABLE_FT_MPI */
+
+static void ompi_comm_nextcid_window_release (ompi_comm_cid_context_t *context, int keep)
+{
+    int count = ompi_mpi_comm_cid_window;
+
+    for (int i = 0 ; i < count ; ++i) {
+        /* local flag 0 means the cid was reserved by this operation */
+        if (i != keep && 0 == context->window[OMPI_COMM_CID_WINDOW_HDR + i]) {
+            opal_pointer_array_set_item (&ompi_mpi_communicators, context->window_base + i, NULL);
+        }
+    }
+}
+
+static int ompi_comm_nextcid_window (ompi_comm_request_t *request)
+{
+    ompi_comm_cid_context_t *context = (ompi_comm_cid_context_t *) request->context;
+    ompi_communicator_t *comm = context->comm;
+    int64_t my_id = ((int64_t) ompi_comm_get_cid (comm) << 32 | context->pml_tag);
+    int participate = (context->newcomm->c_local_group->grp_my_rank != MPI_UNDEFINED);
+    int count = ompi_mpi_comm_cid_window + OMPI_COMM_CID_WINDOW_HDR;
+    int *local;
+    ompi_request_t *subreq;
+    int ret;
+
+    if (comm->c_id_window_completed != context->window_seq) {
+        /* an earlier allocation on this communicator is still in progress */
+        return ompi_comm_request_schedule_append (request, ompi_comm_nextcid_window, NULL, 0);
+    }
+
+    if (OPAL_THREAD_TRYLOCK(&ompi_cid_lock)) {
+        return ompi_comm_request_schedule_append (request, ompi_comm_nextcid_window, NULL, 0);
+    }
+
+    if (ompi_comm_cid_lowest_id < my_id) {
+        OPAL_THREAD_UNLOCK(&ompi_cid_lock);
+        return ompi_comm_request_schedule_append (request, ompi_comm_nextcid_window, NULL, 0);
+    }
+
+    ompi_comm_cid_lowest_id = my_id;
+
+    if (NULL == context->window) {
+        context->window = (int *) malloc (2 * count * sizeof (int));
+        if (OPAL_UNLIKELY(NULL == context->window)) {
+            ret = OMPI_ERR_OUT_OF_RESOURCE;
+            goto err_exit;
+        }
+    }
+    local = context->window;
+
+    context->window_base = (MPI_UNDEFINED == comm->c_id_available) ?
+        (int) ompi_comm_get_cid (comm) : comm->c_id_available;
+
+    local[0] = ompi_mpi_communicators.lowest_free;
+#if OPAL_ENABLE_FT_MPI
+    /* MPI_MAX on the negated epochs gives the minimum epoch */
+    local[1] = -(participate ? ompi_comm_cid_epoch - 1 : INT_MAX);
+#endif /* OPAL_ENABLE_FT_MPI */
+
+    for (int i = 0 ; i < ompi_mpi_comm_cid_window ; ++i) {
+        unsigned int cid = context->window_base + i;
+
+        if (cid >= mca_pml.pml_max_contextid) {
+            local[OMPI_COMM_CID_WINDOW_HDR + i] = 1;
+        } else if (participate) {
+            local[OMPI_COMM_CID_WINDOW_HDR + i] =
+                !opal_pointer_array_test_and_set_item (&ompi_mpi_communicators, cid, comm);
+        } else {
+            /* nothing is reserved, the cid this process ends up with is
+             * chosen locally once the operation completes */
+            local[OMPI_COMM_CID_WINDOW_HDR + i] = 1;
+        }
+    }
+
+    ret = context->allreduce_fn (local, local + count, count, MPI_MAX, context, &subreq);
+    if (OMPI_SUCCESS != ret) {
+        ompi_comm_nextcid_window_release (context, -1);
+        goto err_exit;
+    }
+
+    OPAL_THREAD_UNLOCK(&ompi_cid_lock);
+
+    return ompi_comm_request_schedule_append (request, ompi_comm_nextcid_window_complete, &subreq, 1);
+err_exit:
+    ++comm->c_id_window_completed;
+    ompi_comm_cid_lowest_id = INT64_MAX;
+    OPAL_THREAD_UNLOCK(&ompi_cid_lock);
+    return ret;
+}
+
+static int ompi_comm_nextcid_window_complete (ompi_comm_request_t *request)
+{
+    ompi_comm_cid_context_t *context = (ompi_comm_cid_context_t *) request->context;
+    ompi_communicator_t *comm = context->comm;
+    int participate = (context->newcomm->c_local_group->grp_my_rank != MPI_UNDEFINED);
+    int count = ompi_mpi_comm_cid_window + OMPI_COMM_CID_WINDOW_HDR;
+    int *reduced = context->window + count;
+    int found = -1;
+#if OPAL_ENABLE_FT_MPI
+    int min_epoch;
+#endif /* OPAL_ENABLE_FT_MPI */
+
+    if (OPAL_THREAD_TRYLOCK(&ompi_cid_lock)) {
+        return ompi_comm_request_schedule_append (request, ompi_comm_nextcid_window_complete, NULL, 0);
+    }
+
+    ++comm->c_id_window_completed;
+
+    if (OMPI_SUCCESS != request->super.req_status.MPI_ERROR) {
+        ompi_comm_nextcid_window_release (context, -1);
+        ompi_comm_cid_lowest_id = INT64_MAX;
+        OPAL_THREAD_UNLOCK(&ompi_cid_lock);
+        return request->super.req_status.MPI_ERROR;
+    }
+
+    /* every cid below the largest lowest free cid is in use somewhere */
+    comm->c_id_available = reduced[0];
+
+#if OPAL_ENABLE_FT_MPI
+    min_epoch = -reduced[1];
+    if (0 == min_epoch) {
+        /* out of epochs */
+        ompi_comm_nextcid_window_release (context, -1);
+        ompi_comm_cid_lowest_id = INT64_MAX;
+        OPAL_THREAD_UNLOCK(&ompi_cid_lock);
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+#endif /* OPAL_ENABLE_FT_MPI */
+
+    for (int i = 0 ; i < ompi_mpi_comm_cid_window ; ++i) {
+        if (0 == reduced[OMPI_COMM_CID_WINDOW_HDR + i]) {
+            found = i;
+            break;
+        }
+    }
+
+    if (participate) {
+        ompi_comm_nextcid_window_release (context, found);
+    }
+
+    if (found < 0) {
+        /* nothing in the window is free everywhere. the window may have
+         * been above free cids so restart from the agreed lower bound */
+        context->start = reduced[0];
+        OPAL_THREAD_UNLOCK(&ompi_cid_lock);
+
+        return ompi_comm_allreduce_getnextcid (request);
+    }
+
+    if (participate) {
+        context->nextcid = context->window_base + found;
+    } else {
+        /* see ompi_comm_nextcid_check_flag */
+        context->nextcid = ompi_comm_reserve_local_cid (context->start, context->comm);
+    }
+
+    context->newcomm->c_contextid = context->nextcid;
+#if OPAL_ENABLE_FT_MPI
+    context->newcomm->c_epoch = INT_MAX - min_epoch;
+    ompi_comm_cid_epoch -= 1; /* protected by the cid_lock */
+#endif /* OPAL_ENABLE_FT_MPI */
+    opal_pointer_array_set_item (&ompi_mpi_communicators, context->nextcid, context->newcomm);
+
+    ompi_comm_cid_lowest_id = INT64_MAX;
+    OPAL_THREAD_UNLOCK(&ompi_cid_lock);
+
+    return OMPI_SUCCESS;
+}
+
 static int ompi_comm_allreduce_getnextcid (ompi_comm_request_t *request)
 {
     ompi_comm_cid_context_t *context = (ompi_comm_cid_context_t *) request->context;
@@ -363,16 +583,8 @@ static int ompi_comm_allreduce_getnextcid (ompi_comm_request_t *request)
      * This is the real algorithm described in the doc
      */
     if( participate ){
-        flag = false;
-        context->nextlocal_cid = mca_pml.pml_max_contextid;
-        for (unsigned int i = context->start ; i < mca_pml.pml_max_contextid ; ++i) {
-            flag = opal_pointer_array_test_and_set_item (&ompi_mpi_communicators, i,
-                                                         context->comm);
-            if (true == flag) {
-                context->nextlocal_cid = i;
-                break;
-            }
-        }
+        context->nextlocal_cid = ompi_comm_reserve_local_cid (context->start, context->comm);
+        flag = ((unsigned int) context->nextlocal_cid != mca_pml.pml_max_contextid);
 #if OPAL_ENABLE_FT_MPI
         context->nextcid_epoch = ompi_comm_cid_epoch - 1;
         if (0 == context->nextcid_epoch) {
@@ -489,16 +701,7 @@ static int ompi_comm_nextcid_check_flag (ompi_comm_request_t *request)
              * but we cannot use `nextcid` as we may have it
              * in-use, go ahead with next locally-available CID
              */
-            context->nextlocal_cid = mca_pml.pml_max_contextid;
-            for (unsigned int i = context->start ; i < mca_pml.pml_max_contextid ; ++i) {
-                bool flag;
-                flag = opal_pointer_array_test_and_set_item (&ompi_mpi_communicators, i,
-                                                                context->comm);
-                if (true == flag) {
-                    context->nextlocal_cid = i;
-                    break;
-                }
-            }
+            context->nextlocal_cid = ompi_comm_reserve_local_cid (context->start, context->comm);
             context->nextcid = context->nextlocal_cid;
         }
 
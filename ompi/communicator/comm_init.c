@@ -393,6 +393,8 @@ static void ompi_comm_construct(ompi_communicator_t* comm)
     comm->c_topo         = NULL;
     comm->c_coll         = NULL;
     comm->c_nbc_tag      = MCA_COLL_BASE_TAG_NONBLOCKING_BASE;
+    comm->c_id_window_started   = 0;
+    comm->c_id_window_completed = 0;
 
     /* A keyhash will be created if/when an attribute is cached on
        this communicator */
@@ -219,6 +219,12 @@ struct ompi_communicator_t {
      */
     opal_atomic_int32_t c_nbc_tag;
 
+    /* Number of context ID allocations started and completed on this
+     * communicator with the window based algorithm. They are completed in
+     * the order they were started (see comm_cid.c). */
+    uint32_t c_id_window_started;
+    uint32_t c_id_window_completed;
+
 #if OPAL_ENABLE_FT_MPI
     /** MPI_ANY_SOURCE Failed Group Offset - OMPI_Comm_failure_get_acked */
     int                      any_source_offset;
@@ -84,6 +84,18 @@ typedef struct mca_coll_adapt_component_t {
     /* Reduce free list */
     opal_free_list_t *adapt_ireduce_context_free_list;
 
+    /* Allreduce MCA parameter */
+    int adapt_iallreduce_algorithm;
+    size_t adapt_iallreduce_segment_size;
+    int adapt_iallreduce_max_send_requests;
+    int adapt_iallreduce_max_recv_requests;
+    /* Allreduce free list */
+    opal_free_list_t *adapt_iallreduce_context_free_list;
+
+    /* Allgather MCA parameter */
+    int adapt_iallgather_algorithm;
+    size_t adapt_iallgather_segment_size;
+
 } mca_coll_adapt_component_t;
 
 /*
@@ -94,6 +106,8 @@ typedef struct mca_coll_adapt_collective_fallback_s {
     union {
         mca_coll_base_module_reduce_fn_t   reduce;
         mca_coll_base_module_ireduce_fn_t ireduce;
+        mca_coll_base_module_allreduce_fn_t   allreduce;
+        mca_coll_base_module_iallreduce_fn_t iallreduce;
     } previous_routine;
     mca_coll_base_module_t *previous_module;
 } mca_coll_adapt_collective_fallback_t;
@@ -102,6 +116,8 @@ typedef struct mca_coll_adapt_collective_fallback_s {
 typedef enum mca_coll_adapt_colltype {
     ADAPT_REDUCE  = 0,
     ADAPT_IREDUCE = 1,
+    ADAPT_ALLREDUCE = 2,
+    ADAPT_IALLREDUCE = 3,
     ADAPT_COLLCOUNT
 } mca_coll_adapt_colltype_t;
 
@@ -111,9 +127,13 @@ typedef enum mca_coll_adapt_colltype {
  */
 #define previous_reduce     previous_routines[ADAPT_REDUCE].previous_routine.reduce
 #define previous_ireduce    previous_routines[ADAPT_IREDUCE].previous_routine.ireduce
+#define previous_allreduce  previous_routines[ADAPT_ALLREDUCE].previous_routine.allreduce
+#define previous_iallreduce previous_routines[ADAPT_IALLREDUCE].previous_routine.iallreduce
 
 #define previous_reduce_module     previous_routines[ADAPT_REDUCE].previous_module
 #define previous_ireduce_module    previous_routines[ADAPT_IREDUCE].previous_module
+#define previous_allreduce_module  previous_routines[ADAPT_ALLREDUCE].previous_module
+#define previous_iallreduce_module previous_routines[ADAPT_IALLREDUCE].previous_module
 
 
 /* Coll adapt module per communicator*/
@@ -126,6 +146,10 @@ struct mca_coll_adapt_module_t {
 
     /* cached topologies */
     opal_list_t *topo_cache;
+    /* trees rooted at every rank, for the allgather */
+    ompi_coll_tree_t **topo_all_roots;
+    int topo_all_roots_size;
+    ompi_coll_adapt_algorithm_t topo_all_roots_algorithm;
 
     /* Whether this module has been lazily initialized or not yet */
     bool adapt_enabled;
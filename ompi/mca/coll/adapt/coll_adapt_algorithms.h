@@ -26,3 +26,17 @@ int ompi_coll_adapt_ireduce_fini(void);
 int ompi_coll_adapt_reduce(REDUCE_ARGS);
 int ompi_coll_adapt_ireduce(IREDUCE_ARGS);
 
+
+/* Allreduce */
+int ompi_coll_adapt_iallreduce_register(void);
+int ompi_coll_adapt_iallreduce_fini(void);
+int ompi_coll_adapt_allreduce(ALLREDUCE_ARGS);
+int ompi_coll_adapt_iallreduce(IALLREDUCE_ARGS);
+
+/* Allgather */
+int ompi_coll_adapt_iallgather_register(void);
+int ompi_coll_adapt_allgather(ALLGATHER_ARGS);
+int ompi_coll_adapt_iallgather(IALLGATHER_ARGS);
+
+/* Bcast on a given tree, used by the allgather */
+int ompi_coll_adapt_ibcast_generic(IBCAST_ARGS, ompi_coll_tree_t * tree, size_t seg_size);
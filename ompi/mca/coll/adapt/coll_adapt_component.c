@@ -93,6 +93,7 @@ static int adapt_close(void)
 {
     ompi_coll_adapt_ibcast_fini();
     ompi_coll_adapt_ireduce_fini();
+    ompi_coll_adapt_iallreduce_fini();
 
     return OMPI_SUCCESS;
 }
@@ -150,6 +151,8 @@ static int adapt_register(void)
                                            &cs->adapt_context_free_list_inc);
     ompi_coll_adapt_ibcast_register();
     ompi_coll_adapt_ireduce_register();
+    ompi_coll_adapt_iallreduce_register();
+    ompi_coll_adapt_iallgather_register();
 
     return adapt_verify_mca_variables();
 }
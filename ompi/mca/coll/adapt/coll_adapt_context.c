@@ -27,6 +27,22 @@ static void adapt_constant_reduce_context_destruct(ompi_coll_adapt_constant_redu
     OBJ_DESTRUCT(&context->inbuf_list);
 }
 
+static void adapt_constant_allreduce_context_construct(ompi_coll_adapt_constant_allreduce_context_t *context)
+{
+    OBJ_CONSTRUCT(&context->mutex_op, opal_mutex_t);
+    OBJ_CONSTRUCT(&context->inbuf_list, opal_free_list_t);
+    context->next_recv_segs = NULL;
+    context->seg_recv_count = NULL;
+}
+
+static void adapt_constant_allreduce_context_destruct(ompi_coll_adapt_constant_allreduce_context_t *context)
+{
+    free((void *) context->next_recv_segs);
+    free((void *) context->seg_recv_count);
+    OBJ_DESTRUCT(&context->mutex_op);
+    OBJ_DESTRUCT(&context->inbuf_list);
+}
+
 
 OBJ_CLASS_INSTANCE(ompi_coll_adapt_bcast_context_t, opal_free_list_item_t,
                    NULL, NULL);
@@ -40,3 +56,13 @@ OBJ_CLASS_INSTANCE(ompi_coll_adapt_reduce_context_t, opal_free_list_item_t,
 OBJ_CLASS_INSTANCE(ompi_coll_adapt_constant_reduce_context_t, opal_object_t,
                    &adapt_constant_reduce_context_construct,
                    &adapt_constant_reduce_context_destruct);
+
+OBJ_CLASS_INSTANCE(ompi_coll_adapt_allreduce_context_t, opal_free_list_item_t,
+                   NULL, NULL);
+
+OBJ_CLASS_INSTANCE(ompi_coll_adapt_constant_allreduce_context_t, opal_object_t,
+                   &adapt_constant_allreduce_context_construct,
+                   &adapt_constant_allreduce_context_destruct);
+
+OBJ_CLASS_INSTANCE(ompi_coll_adapt_constant_allgather_context_t, opal_object_t,
+                   NULL, NULL);
@@ -126,3 +126,66 @@ struct ompi_coll_adapt_reduce_context_s {
 };
 
 OBJ_CLASS_DECLARATION(ompi_coll_adapt_reduce_context_t);
+
+/* Allreduce constant context in allreduce context */
+struct ompi_coll_adapt_constant_allreduce_context_s {
+    opal_object_t super;
+    size_t count;
+    size_t seg_count;
+    ompi_datatype_t *datatype;
+    ompi_communicator_t *comm;
+    /* Increment of each segment */
+    ptrdiff_t segment_increment;
+    ptrdiff_t lower_bound;
+    int num_segs;
+    int rank;
+    /* Tags of the segments on the way up to the root and back down */
+    int up_tag;
+    int down_tag;
+    /* Next seg need to be received for every children */
+    opal_atomic_int32_t *next_recv_segs;
+    /* Number of children whose contribution to a segment has been reduced */
+    opal_atomic_int32_t *seg_recv_count;
+    /* Next seg a leaf sends to its parent */
+    opal_atomic_int32_t next_send_seg;
+    /* Number of finished operations, the request completes at num_ops */
+    opal_atomic_int32_t num_done;
+    int32_t num_ops;
+    /* Mutex to protect the reduce op into rbuf */
+    opal_mutex_t mutex_op;
+    ompi_op_t *op;
+    ompi_coll_tree_t *tree;
+    char *rbuf;
+    opal_free_list_t inbuf_list;
+    ompi_request_t *request;
+};
+
+typedef struct ompi_coll_adapt_constant_allreduce_context_s ompi_coll_adapt_constant_allreduce_context_t;
+
+OBJ_CLASS_DECLARATION(ompi_coll_adapt_constant_allreduce_context_t);
+
+/* Allreduce context of each segment */
+struct ompi_coll_adapt_allreduce_context_s {
+    opal_free_list_item_t super;
+    int seg_index;
+    int child_id;
+    ompi_coll_adapt_constant_allreduce_context_t *con;
+    /* store the incoming segment */
+    ompi_coll_adapt_inbuf_t *inbuf;
+};
+
+typedef struct ompi_coll_adapt_allreduce_context_s ompi_coll_adapt_allreduce_context_t;
+
+OBJ_CLASS_DECLARATION(ompi_coll_adapt_allreduce_context_t);
+
+/* Allgather constant context, the operation is made of one ibcast per rank */
+struct ompi_coll_adapt_constant_allgather_context_s {
+    opal_object_t super;
+    /* Number of ibcast not yet completed, plus one while they are started */
+    opal_atomic_int32_t num_pending;
+    ompi_request_t *request;
+};
+
+typedef struct ompi_coll_adapt_constant_allgather_context_s ompi_coll_adapt_constant_allgather_context_t;
+
+OBJ_CLASS_DECLARATION(ompi_coll_adapt_constant_allgather_context_t);
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2014-2020 The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+#include "ompi/communicator/communicator.h"
+#include "coll_adapt.h"
+#include "coll_adapt_algorithms.h"
+#include "coll_adapt_context.h"
+#include "coll_adapt_topocache.h"
+#include "ompi/constants.h"
+#include "ompi/mca/coll/base/coll_base_util.h"
+
+/*
+ * MPI_Allgather and MPI_Iallgather are one segmented ibcast per rank, each
+ * on the tree rooted at that rank, all of them in flight at the same time.
+ * The segments of a block are forwarded by the callbacks of the ibcast as
+ * soon as they arrive, so the blocks that come in first, from the fastest
+ * peers, are pushed further first.
+ */
+
+/*
+ * Set up MCA parameters of MPI_Allgather and MPI_Iallgather
+ */
+int ompi_coll_adapt_iallgather_register(void)
+{
+    mca_base_component_t *c = &mca_coll_adapt_component.super.collm_version;
+
+    mca_coll_adapt_component.adapt_iallgather_algorithm = 1;
+    mca_base_component_var_register(c, "allgather_algorithm",
+                                    "Algorithm of the broadcast of each block in allgather, 1: binomial, 2: in_order_binomial, 3: binary, 4: pipeline, 5: chain, 6: linear", MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                    OPAL_INFO_LVL_5, MCA_BASE_VAR_SCOPE_READONLY,
+                                    &mca_coll_adapt_component.adapt_iallgather_algorithm);
+    if( (mca_coll_adapt_component.adapt_iallgather_algorithm <= OMPI_COLL_ADAPT_ALGORITHM_TUNED) ||
+        (mca_coll_adapt_component.adapt_iallgather_algorithm >= OMPI_COLL_ADAPT_ALGORITHM_COUNT) ) {
+        mca_coll_adapt_component.adapt_iallgather_algorithm = 1;
+    }
+
+    mca_coll_adapt_component.adapt_iallgather_segment_size = 163740;
+    mca_base_component_var_register(c, "allgather_segment_size",
+                                    "Segment size in bytes used by default for the broadcast of each block in allgather. 0 bytes means no segmentation.",
+                                    MCA_BASE_VAR_TYPE_SIZE_T, NULL, 0, 0,
+                                    OPAL_INFO_LVL_5,
+                                    MCA_BASE_VAR_SCOPE_READONLY,
+                                    &mca_coll_adapt_component.adapt_iallgather_segment_size);
+
+    return OMPI_SUCCESS;
+}
+
+/*
+ * Account for one finished ibcast, complete the request after the last one
+ */
+static void iallgather_bcast_done(ompi_coll_adapt_constant_allgather_context_t *con)
+{
+    if (0 == opal_atomic_sub_fetch_32(&con->num_pending, 1)) {
+        ompi_request_t *temp_req = con->request;
+        OBJ_RELEASE(con);
+        ompi_request_complete(temp_req, 1);
+    }
+}
+
+/*
+ * Callback function of the ibcast of a block
+ */
+static int bcast_cb(ompi_request_t * req)
+{
+    ompi_coll_adapt_constant_allgather_context_t *con =
+        (ompi_coll_adapt_constant_allgather_context_t *) req->req_complete_cb_data;
+
+    req->req_free(&req);
+    iallgather_bcast_done(con);
+    return 1;
+}
+
+int ompi_coll_adapt_iallgather(const void *sbuf, int scount, struct ompi_datatype_t *sdtype,
+                               void *rbuf, int rcount, struct ompi_datatype_t *rdtype,
+                               struct ompi_communicator_t *comm, ompi_request_t ** request,
+                               mca_coll_base_module_t * module)
+{
+    int size = ompi_comm_size(comm), rank = ompi_comm_rank(comm), err;
+    ompi_coll_base_nbc_request_t *temp_request = NULL;
+    ompi_coll_adapt_constant_allgather_context_t *con;
+    ompi_coll_tree_t **trees;
+    ptrdiff_t extent, lb, block_size;
+
+    OPAL_OUTPUT_VERBOSE((10, mca_coll_adapt_component.adapt_output,
+                         "iallgather algorithm %d, coll_adapt_iallgather_segment_size %zu\n",
+                         mca_coll_adapt_component.adapt_iallgather_algorithm,
+                         mca_coll_adapt_component.adapt_iallgather_segment_size));
+
+    trees = adapt_module_cached_topology_all_roots(module, comm,
+                                                   mca_coll_adapt_component.adapt_iallgather_algorithm);
+    if (NULL == trees) {
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+
+    ompi_datatype_get_extent(rdtype, &lb, &extent);
+    block_size = (ptrdiff_t) rcount * extent;
+
+    /* Put the own block in place, it is the data of the ibcast rooted here */
+    if (MPI_IN_PLACE != sbuf) {
+        err = ompi_datatype_sndrcv((void *) sbuf, scount, sdtype,
+                                   (char *) rbuf + (ptrdiff_t) rank * block_size, rcount, rdtype);
+        if (MPI_SUCCESS != err) {
+            return err;
+        }
+    }
+
+    /* Set up request */
+    temp_request = OBJ_NEW(ompi_coll_base_nbc_request_t);
+    OMPI_REQUEST_INIT(&temp_request->super, false);
+    temp_request->super.req_state = OMPI_REQUEST_ACTIVE;
+    temp_request->super.req_type = OMPI_REQUEST_COLL;
+    temp_request->super.req_free = ompi_coll_adapt_request_free;
+    temp_request->super.req_status.MPI_SOURCE = 0;
+    temp_request->super.req_status.MPI_TAG = 0;
+    temp_request->super.req_status.MPI_ERROR = 0;
+    temp_request->super.req_status._cancelled = 0;
+    temp_request->super.req_status._ucount = 0;
+    *request = (ompi_request_t*)temp_request;
+
+    if (0 == rcount) {
+        ompi_request_complete(&temp_request->super, 1);
+        return MPI_SUCCESS;
+    }
+
+    /* one for every ibcast, and one for the loop below so that the
+       request cannot complete before all of them are started */
+    con = OBJ_NEW(ompi_coll_adapt_constant_allgather_context_t);
+    con->num_pending = size + 1;
+    con->request = (ompi_request_t*)temp_request;
+
+    /* every process starts the ibcasts in the same order, they reserve
+       the same tags everywhere */
+    for (int root = 0; root < size; root++) {
+        ompi_request_t *bcast_req = NULL;
+
+        err = ompi_coll_adapt_ibcast_generic((char *) rbuf + (ptrdiff_t) root * block_size,
+                                             rcount, rdtype, root, comm, &bcast_req, module,
+                                             trees[root],
+                                             mca_coll_adapt_component.adapt_iallgather_segment_size);
+        if (MPI_SUCCESS != err) {
+            return err;
+        }
+        ompi_request_set_callback(bcast_req, bcast_cb, con);
+    }
+
+    iallgather_bcast_done(con);
+
+    return MPI_SUCCESS;
+}
@@ -0,0 +1,554 @@
+/*
+ * Copyright (c) 2014-2020 The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+#include "ompi/communicator/communicator.h"
+#include "coll_adapt.h"
+#include "coll_adapt_algorithms.h"
+#include "coll_adapt_context.h"
+#include "coll_adapt_topocache.h"
+#include "ompi/constants.h"
+#include "ompi/mca/coll/base/coll_base_util.h"
+#include "ompi/mca/pml/pml.h"
+#include "ompi/mca/coll/base/coll_base_topo.h"
+
+/*
+ * MPI_Allreduce and MPI_Iallreduce are a reduce to the root of the tree
+ * followed by a bcast of the result on the same tree, done segment by
+ * segment: as soon as the root has reduced a segment it sends it back
+ * down, while the next segments are still on their way up. Every process
+ * reduces in place in rbuf, the contributions of the children are
+ * received into buffers of the inbuf free list. A segment moves through
+ *   irecv from each child -> op into rbuf -> isend to the parent
+ *   -> irecv of the result from the parent -> isend to each child
+ * and every step is started from the callback of the previous one.
+ */
+
+static int ompi_coll_adapt_iallreduce_generic(IALLREDUCE_ARGS,
+                                              ompi_coll_tree_t * tree, size_t seg_size);
+
+static int send_up(ompi_coll_adapt_constant_allreduce_context_t *con, int seg_index);
+static int send_down(ompi_coll_adapt_constant_allreduce_context_t *con, int seg_index);
+
+/* MPI_Allreduce and MPI_Iallreduce in the ADAPT module only work for commutative operations */
+
+/*
+ * Set up MCA parameters of MPI_Allreduce and MPI_Iallreduce
+ */
+int ompi_coll_adapt_iallreduce_register(void)
+{
+    mca_base_component_t *c = &mca_coll_adapt_component.super.collm_version;
+
+    mca_coll_adapt_component.adapt_iallreduce_algorithm = 1;
+    mca_base_component_var_register(c, "allreduce_algorithm",
+                                    "Algorithm of allreduce, 1: binomial, 2: in_order_binomial, 3: binary, 4: pipeline, 5: chain, 6: linear", MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                    OPAL_INFO_LVL_5, MCA_BASE_VAR_SCOPE_READONLY,
+                                    &mca_coll_adapt_component.adapt_iallreduce_algorithm);
+    if( (mca_coll_adapt_component.adapt_iallreduce_algorithm <= OMPI_COLL_ADAPT_ALGORITHM_TUNED) ||
+        (mca_coll_adapt_component.adapt_iallreduce_algorithm >= OMPI_COLL_ADAPT_ALGORITHM_COUNT) ) {
+        mca_coll_adapt_component.adapt_iallreduce_algorithm = 1;
+    }
+
+    mca_coll_adapt_component.adapt_iallreduce_segment_size = 163740;
+    mca_base_component_var_register(c, "allreduce_segment_size",
+                                    "Segment size in bytes used by default for allreduce algorithms. 0 bytes means no segmentation.",
+                                    MCA_BASE_VAR_TYPE_SIZE_T, NULL, 0, 0,
+                                    OPAL_INFO_LVL_5,
+                                    MCA_BASE_VAR_SCOPE_READONLY,
+                                    &mca_coll_adapt_component.adapt_iallreduce_segment_size);
+
+    mca_coll_adapt_component.adapt_iallreduce_max_send_requests = 2;
+    mca_base_component_var_register(c, "allreduce_max_send_requests",
+                                    "Maximum number of send requests of a leaf",
+                                    MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                    OPAL_INFO_LVL_5,
+                                    MCA_BASE_VAR_SCOPE_READONLY,
+                                    &mca_coll_adapt_component.adapt_iallreduce_max_send_requests);
+
+    mca_coll_adapt_component.adapt_iallreduce_max_recv_requests = 3;
+    mca_base_component_var_register(c, "allreduce_max_recv_requests",
+                                    "Maximum number of receive requests per child",
+                                    MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                    OPAL_INFO_LVL_5,
+                                    MCA_BASE_VAR_SCOPE_READONLY,
+                                    &mca_coll_adapt_component.adapt_iallreduce_max_recv_requests);
+
+    mca_coll_adapt_component.adapt_iallreduce_context_free_list = NULL;
+    return OMPI_SUCCESS;
+}
+
+/*
+ * Release the free list created in ompi_coll_adapt_iallreduce_generic
+ */
+int ompi_coll_adapt_iallreduce_fini(void)
+{
+    if (NULL != mca_coll_adapt_component.adapt_iallreduce_context_free_list) {
+        OBJ_RELEASE(mca_coll_adapt_component.adapt_iallreduce_context_free_list);
+        mca_coll_adapt_component.adapt_iallreduce_context_free_list = NULL;
+        OPAL_OUTPUT_VERBOSE((10, mca_coll_adapt_component.adapt_output, "iallreduce fini\n"));
+    }
+    return OMPI_SUCCESS;
+}
+
+static inline int seg_count_of(ompi_coll_adapt_constant_allreduce_context_t *con, int seg_index)
+{
+    if (seg_index == (con->num_segs - 1)) {
+        return (int) (con->count - (size_t) seg_index * con->seg_count);
+    }
+    return (int) con->seg_count;
+}
+
+static inline char *seg_buff_of(ompi_coll_adapt_constant_allreduce_context_t *con, int seg_index)
+{
+    return con->rbuf + (ptrdiff_t) seg_index * con->segment_increment;
+}
+
+static ompi_coll_adapt_allreduce_context_t *
+get_context(ompi_coll_adapt_constant_allreduce_context_t *con, int seg_index, int child_id)
+{
+    ompi_coll_adapt_allreduce_context_t *context =
+        (ompi_coll_adapt_allreduce_context_t *) opal_free_list_wait(mca_coll_adapt_component.
+                                                                   adapt_iallreduce_context_free_list);
+    context->seg_index = seg_index;
+    context->child_id = child_id;
+    context->con = con;
+    context->inbuf = NULL;
+    return context;
+}
+
+static inline void return_context(ompi_coll_adapt_allreduce_context_t *context)
+{
+    opal_free_list_return(mca_coll_adapt_component.adapt_iallreduce_context_free_list,
+                          (opal_free_list_item_t *) context);
+}
+
+/*
+ * Account for one finished operation, complete the request after the last one
+ */
+static void iallreduce_op_done(ompi_coll_adapt_constant_allreduce_context_t *con)
+{
+    int32_t num_done = opal_atomic_add_fetch_32(&con->num_done, 1);
+
+    if (num_done == con->num_ops) {
+        ompi_request_t *temp_req = con->request;
+        OPAL_OUTPUT_VERBOSE((30, mca_coll_adapt_component.adapt_output,
+                             "[%d]: iallreduce done\n", con->rank));
+        OBJ_RELEASE(con);
+        ompi_request_complete(temp_req, 1);
+    }
+}
+
+/*
+ * Callback function of the isend of the result to a child
+ */
+static int send_down_cb(ompi_request_t * req)
+{
+    ompi_coll_adapt_allreduce_context_t *context =
+        (ompi_coll_adapt_allreduce_context_t *) req->req_complete_cb_data;
+    ompi_coll_adapt_constant_allreduce_context_t *con = context->con;
+
+    OPAL_OUTPUT_VERBOSE((30, mca_coll_adapt_component.adapt_output,
+                         "[%d]: iallreduce_send_down_cb, child %d, seg_id %d\n", con->rank,
+                         context->child_id, context->seg_index));
+    return_context(context);
+    req->req_free(&req);
+    iallreduce_op_done(con);
+    return 1;
+}
+
+/*
+ * Callback function of the irecv of the result from the parent
+ */
+static int recv_down_cb(ompi_request_t * req)
+{
+    ompi_coll_adapt_allreduce_context_t *context =
+        (ompi_coll_adapt_allreduce_context_t *) req->req_complete_cb_data;
+    ompi_coll_adapt_constant_allreduce_context_t *con = context->con;
+    int seg_index = context->seg_index, err;
+
+    OPAL_OUTPUT_VERBOSE((30, mca_coll_adapt_component.adapt_output,
+                         "[%d]: iallreduce_recv_down_cb, seg_id %d\n", con->rank, seg_index));
+    return_context(context);
+    req->req_free(&req);
+
+    err = send_down(con, seg_index);
+    if (MPI_SUCCESS != err) {
+        return err;
+    }
+    iallreduce_op_done(con);
+    return 1;
+}
+
+/*
+ * Callback function of the isend of a reduced segment to the parent
+ */
+static int send_up_cb(ompi_request_t * req)
+{
+    ompi_coll_adapt_allreduce_context_t *context =
+        (ompi_coll_adapt_allreduce_context_t *) req->req_complete_cb_data;
+    ompi_coll_adapt_constant_allreduce_context_t *con = context->con;
+    ompi_request_t *recv_req;
+    int err;
+
+    OPAL_OUTPUT_VERBOSE((30, mca_coll_adapt_component.adapt_output,
+                         "[%d]: iallreduce_send_up_cb, seg_id %d\n", con->rank,
+                         context->seg_index));
+    req->req_free(&req);
+
+    /* the segment left rbuf, the result can be received in its place */
+    OPAL_OUTPUT_VERBOSE((30, mca_coll_adapt_component.adapt_output,
+                         "[%d]: In send_up_cb, create irecv for seg %d, peer %d, tag %d\n",
+                         con->rank, context->seg_index, con->tree->tree_prev,
+                         con->down_tag - context->seg_index));
+    err = MCA_PML_CALL(irecv(seg_buff_of(con, context->seg_index),
+                             seg_count_of(con, context->seg_index), con->datatype,
+                             con->tree->tree_prev, con->down_tag - context->seg_index,
+                             con->comm, &recv_req));
+    if (MPI_SUCCESS != err) {
+        return err;
+    }
+    ompi_request_set_callback(recv_req, recv_down_cb, context);
+
+    /* a leaf keeps max_send_requests segments in flight */
+    if (0 == con->tree->tree_nextsize) {
+        int32_t next = opal_atomic_fetch_add_32(&con->next_send_seg, 1);
+        if (next < con->num_segs) {
+            err = send_up(con, next);
+            if (MPI_SUCCESS != err) {
+                return err;
+            }
+        }
+    }
+
+    iallreduce_op_done(con);
+    return 1;
+}
+
+/*
+ * Send a segment of rbuf to the parent
+ */
+static int send_up(ompi_coll_adapt_constant_allreduce_context_t *con, int seg_index)
+{
+    ompi_coll_adapt_allreduce_context_t *context = get_context(con, seg_index, -1);
+    ompi_request_t *send_req;
+    int err;
+
+    OPAL_OUTPUT_VERBOSE((30, mca_coll_adapt_component.adapt_output,
+                         "[%d]: create isend to seg %d, peer %d, tag %d\n",
+                         con->rank, seg_index, con->tree->tree_prev, con->up_tag - seg_index));
+    err = MCA_PML_CALL(isend(seg_buff_of(con, seg_index), seg_count_of(con, seg_index),
+                             con->datatype, con->tree->tree_prev, con->up_tag - seg_index,
+                             MCA_PML_BASE_SEND_STANDARD, con->comm, &send_req));
+    if (MPI_SUCCESS != err) {
+        return_context(context);
+        return err;
+    }
+    ompi_request_set_callback(send_req, send_up_cb, context);
+    return MPI_SUCCESS;
+}
+
+/*
+ * Send the result of a segment to all the children
+ */
+static int send_down(ompi_coll_adapt_constant_allreduce_context_t *con, int seg_index)
+{
+    for (int i = 0; i < con->tree->tree_nextsize; i++) {
+        ompi_coll_adapt_allreduce_context_t *context = get_context(con, seg_index, i);
+        ompi_request_t *send_req;
+        int err;
+
+        OPAL_OUTPUT_VERBOSE((30, mca_coll_adapt_component.adapt_output,
+                             "[%d]: create isend of the result of seg %d, peer %d, tag %d\n",
+                             con->rank, seg_index, con->tree->tree_next[i],
+                             con->down_tag - seg_index));
+        err = MCA_PML_CALL(isend(seg_buff_of(con, seg_index), seg_count_of(con, seg_index),
+                                 con->datatype, con->tree->tree_next[i],
+                                 con->down_tag - seg_index,
+                                 MCA_PML_BASE_SEND_STANDARD, con->comm, &send_req));
+        if (MPI_SUCCESS != err) {
+            return_context(context);
+            return err;
+        }
+        ompi_request_set_callback(send_req, send_down_cb, context);
+    }
+    return MPI_SUCCESS;
+}
+
+static int recv_up_cb(ompi_request_t * req);
+
+/*
+ * Receive the contribution of a child to a segment
+ */
+static int recv_up(ompi_coll_adapt_constant_allreduce_context_t *con, int seg_index, int child_id)
+{
+    ompi_coll_adapt_allreduce_context_t *context = get_context(con, seg_index, child_id);
+    ompi_request_t *recv_req;
+    int err;
+
+    context->inbuf = (ompi_coll_adapt_inbuf_t *) opal_free_list_wait(&con->inbuf_list);
+    OPAL_OUTPUT_VERBOSE((30, mca_coll_adapt_component.adapt_output,
+                         "[%d]: create irecv for seg %d, peer %d, inbuf %p, tag %d\n",
+                         con->rank, seg_index, con->tree->tree_next[child_id],
+                         (void *) context->inbuf, con->up_tag - seg_index));
+    err = MCA_PML_CALL(irecv(context->inbuf->buff - con->lower_bound,
+                             seg_count_of(con, seg_index), con->datatype,
+                             con->tree->tree_next[child_id], con->up_tag - seg_index,
+                             con->comm, &recv_req));
+    if (MPI_SUCCESS != err) {
+        opal_free_list_return(&con->inbuf_list, (opal_free_list_item_t *) context->inbuf);
+        return_context(context);
+        return err;
+    }
+    ompi_request_set_callback(recv_req, recv_up_cb, context);
+    return MPI_SUCCESS;
+}
+
+/*
+ * Callback function of the irecv of a contribution from a child
+ */
+static int recv_up_cb(ompi_request_t * req)
+{
+    ompi_coll_adapt_allreduce_context_t *context =
+        (ompi_coll_adapt_allreduce_context_t *) req->req_complete_cb_data;
+    ompi_coll_adapt_constant_allreduce_context_t *con = context->con;
+    int seg_index = context->seg_index, err;
+    int32_t new_id, num_recv;
+
+    OPAL_OUTPUT_VERBOSE((30, mca_coll_adapt_component.adapt_output,
+                         "[%d]: iallreduce_recv_up_cb, child %d, seg_id %d\n", con->rank,
+                         context->child_id, seg_index));
+    req->req_free(&req);
+
+    /* Did we still need to receive subsequent fragments from this child ? */
+    new_id = opal_atomic_add_fetch_32(&con->next_recv_segs[context->child_id], 1);
+    if (new_id < con->num_segs) {
+        err = recv_up(con, new_id, context->child_id);
+        if (MPI_SUCCESS != err) {
+            return err;
+        }
+    }
+
+    /* Op inbuf and rbuf to rbuf */
+    OPAL_THREAD_LOCK(&con->mutex_op);
+    ompi_op_reduce(con->op, context->inbuf->buff - con->lower_bound, seg_buff_of(con, seg_index),
+                   seg_count_of(con, seg_index), con->datatype);
+    OPAL_THREAD_UNLOCK(&con->mutex_op);
+    opal_free_list_return(&con->inbuf_list, (opal_free_list_item_t *) context->inbuf);
+    return_context(context);
+
+    /* The last child completes the segment: the root has the result,
+       the others pass it on to their parent */
+    num_recv = opal_atomic_add_fetch_32(&con->seg_recv_count[seg_index], 1);
+    if (num_recv == con->tree->tree_nextsize) {
+        if (con->rank == con->tree->tree_root) {
+            err = send_down(con, seg_index);
+        } else {
+            err = send_up(con, seg_index);
+        }
+        if (MPI_SUCCESS != err) {
+            return err;
+        }
+    }
+
+    iallreduce_op_done(con);
+    return 1;
+}
+
+int ompi_coll_adapt_iallreduce(const void *sbuf, void *rbuf, int count, struct ompi_datatype_t *dtype,
+                               struct ompi_op_t *op, struct ompi_communicator_t *comm,
+                               ompi_request_t ** request, mca_coll_base_module_t * module)
+{
+    /* Fall-back if operation is commutative */
+    if (!ompi_op_is_commute(op)){
+        mca_coll_adapt_module_t *adapt_module = (mca_coll_adapt_module_t *) module;
+        OPAL_OUTPUT_VERBOSE((30, mca_coll_adapt_component.adapt_output,
+                    "ADAPT cannot handle allreduce with this (non-commutative) operation. It needs to fall back on another component\n"));
+        return adapt_module->previous_iallreduce(sbuf, rbuf, count, dtype, op,
+                                                 comm, request,
+                                                 adapt_module->previous_iallreduce_module);
+    }
+
+    OPAL_OUTPUT_VERBOSE((10, mca_coll_adapt_component.adapt_output,
+                         "iallreduce algorithm %d, coll_adapt_iallreduce_segment_size %zu, coll_adapt_iallreduce_max_send_requests %d, coll_adapt_iallreduce_max_recv_requests %d\n",
+                         mca_coll_adapt_component.adapt_iallreduce_algorithm,
+                         mca_coll_adapt_component.adapt_iallreduce_segment_size,
+                         mca_coll_adapt_component.adapt_iallreduce_max_send_requests,
+                         mca_coll_adapt_component.adapt_iallreduce_max_recv_requests));
+
+    return ompi_coll_adapt_iallreduce_generic(sbuf, rbuf, count, dtype, op, comm, request, module,
+                                              adapt_module_cached_topology(module, comm, 0, mca_coll_adapt_component.adapt_iallreduce_algorithm),
+                                              mca_coll_adapt_component.adapt_iallreduce_segment_size);
+}
+
+
+static int ompi_coll_adapt_iallreduce_generic(const void *sbuf, void *rbuf, int count,
+                                              struct ompi_datatype_t *dtype, struct ompi_op_t *op,
+                                              struct ompi_communicator_t *comm, ompi_request_t ** request,
+                                              mca_coll_base_module_t * module, ompi_coll_tree_t * tree,
+                                              size_t seg_size)
+{
+    ptrdiff_t extent, lower_bound, segment_increment;
+    ptrdiff_t true_lower_bound, true_extent, real_seg_size;
+    size_t typelng;
+    int seg_count = count, num_segs, rank, err, min;
+    int nchildren = tree->tree_nextsize;
+    ompi_coll_base_nbc_request_t *temp_request = NULL;
+    ompi_coll_adapt_constant_allreduce_context_t *con;
+
+    /* Determine number of segments and number of elements sent per operation */
+    rank = ompi_comm_rank(comm);
+    ompi_datatype_get_extent(dtype, &lower_bound, &extent);
+    ompi_datatype_type_size(dtype, &typelng);
+    COLL_BASE_COMPUTED_SEGCOUNT(seg_size, typelng, seg_count);
+    num_segs = (0 == count) ? 0 : (count + seg_count - 1) / seg_count;
+    segment_increment = (ptrdiff_t) seg_count *extent;
+    ompi_datatype_get_true_extent(dtype, &true_lower_bound, &true_extent);
+    real_seg_size = true_extent + (ptrdiff_t) (seg_count - 1) * extent;
+
+    /* Atomically set up free list */
+    if (NULL == mca_coll_adapt_component.adapt_iallreduce_context_free_list) {
+        opal_free_list_t* fl = OBJ_NEW(opal_free_list_t);
+        opal_free_list_init(fl,
+                            sizeof(ompi_coll_adapt_allreduce_context_t),
+                            opal_cache_line_size,
+                            OBJ_CLASS(ompi_coll_adapt_allreduce_context_t),
+                            0, opal_cache_line_size,
+                            mca_coll_adapt_component.adapt_context_free_list_min,
+                            mca_coll_adapt_component.adapt_context_free_list_max,
+                            mca_coll_adapt_component.adapt_context_free_list_inc,
+                            NULL, 0, NULL, NULL, NULL);
+        if( !OPAL_ATOMIC_COMPARE_EXCHANGE_STRONG_PTR((opal_atomic_intptr_t *)&mca_coll_adapt_component.adapt_iallreduce_context_free_list,
+                                                     &(intptr_t){0}, fl) ) {
+            OBJ_RELEASE(fl);
+        }
+    }
+
+    /* Set up request */
+    temp_request = OBJ_NEW(ompi_coll_base_nbc_request_t);
+    OMPI_REQUEST_INIT(&temp_request->super, false);
+    temp_request->super.req_state = OMPI_REQUEST_ACTIVE;
+    temp_request->super.req_type = OMPI_REQUEST_COLL;
+    temp_request->super.req_free = ompi_coll_adapt_request_free;
+    temp_request->super.req_status.MPI_SOURCE = 0;
+    temp_request->super.req_status.MPI_TAG = 0;
+    temp_request->super.req_status.MPI_ERROR = 0;
+    temp_request->super.req_status._cancelled = 0;
+    temp_request->super.req_status._ucount = 0;
+    *request = (ompi_request_t*)temp_request;
+
+    /* The reduction is done in place in rbuf */
+    if (MPI_IN_PLACE != sbuf && 0 < count) {
+        err = ompi_datatype_copy_content_same_ddt(dtype, count, (char *) rbuf, (char *) sbuf);
+        if (MPI_SUCCESS != err) {
+            ompi_coll_adapt_request_free((ompi_request_t **) &temp_request);
+            *request = MPI_REQUEST_NULL;
+            return err;
+        }
+    }
+
+    if (0 == num_segs) {
+        ompi_request_complete(&temp_request->super, 1);
+        return MPI_SUCCESS;
+    }
+
+    /* Set constant context for send and recv call back */
+    con = OBJ_NEW(ompi_coll_adapt_constant_allreduce_context_t);
+    con->count = count;
+    con->seg_count = seg_count;
+    con->datatype = dtype;
+    con->comm = comm;
+    con->segment_increment = segment_increment;
+    con->lower_bound = lower_bound;
+    con->num_segs = num_segs;
+    con->rank = rank;
+    con->op = op;
+    con->tree = tree;
+    con->rbuf = (char *) rbuf;
+    con->request = (ompi_request_t*)temp_request;
+    con->up_tag = ompi_coll_base_nbc_reserve_tags(comm, 2 * num_segs);
+    con->down_tag = con->up_tag - num_segs;
+    con->next_send_seg = 0;
+    con->num_done = 0;
+    /* every contribution received and every result sent to a child, the
+       segments sent to the parent and the results received from it, and
+       one for the setup below so that the request cannot complete under
+       its feet */
+    con->num_ops = 2 * nchildren * num_segs + 1;
+    if (rank != tree->tree_root) {
+        con->num_ops += 2 * num_segs;
+    }
+
+    OPAL_OUTPUT_VERBOSE((30, mca_coll_adapt_component.adapt_output,
+                         "[%d]: start iallreduce root %d tag %d num_segs %d\n", rank,
+                         tree->tree_root, con->up_tag, num_segs));
+
+    /* If the current process is not leaf */
+    if (nchildren > 0) {
+        size_t num_allocate_elems = mca_coll_adapt_component.adapt_inbuf_free_list_min;
+        if (((size_t) nchildren * num_segs) < num_allocate_elems) {
+            num_allocate_elems = nchildren * num_segs;
+        }
+        opal_free_list_init(&con->inbuf_list,
+                            sizeof(ompi_coll_adapt_inbuf_t) + real_seg_size,
+                            opal_cache_line_size,
+                            OBJ_CLASS(ompi_coll_adapt_inbuf_t),
+                            0, opal_cache_line_size,
+                            num_allocate_elems,
+                            mca_coll_adapt_component.adapt_inbuf_free_list_max,
+                            mca_coll_adapt_component.adapt_inbuf_free_list_inc,
+                            NULL, 0, NULL, NULL, NULL);
+
+        con->next_recv_segs = (opal_atomic_int32_t *) malloc(sizeof(opal_atomic_int32_t) * nchildren);
+        con->seg_recv_count = (opal_atomic_int32_t *) calloc(num_segs, sizeof(opal_atomic_int32_t));
+        if (NULL == con->next_recv_segs || NULL == con->seg_recv_count) {
+            OBJ_RELEASE(con);
+            ompi_coll_adapt_request_free((ompi_request_t **) &temp_request);
+            *request = MPI_REQUEST_NULL;
+            return OMPI_ERR_OUT_OF_RESOURCE;
+        }
+
+        /* For the first batch of segments */
+        min = mca_coll_adapt_component.adapt_iallreduce_max_recv_requests;
+        if (num_segs < min) {
+            min = num_segs;
+        }
+        for (int32_t i = 0; i < nchildren; i++) {
+            con->next_recv_segs[i] = min - 1;
+        }
+        for (int32_t seg_index = 0; seg_index < min; seg_index++) {
+            for (int32_t i = 0; i < nchildren; i++) {
+                err = recv_up(con, seg_index, i);
+                if (MPI_SUCCESS != err) {
+                    return err;
+                }
+            }
+        }
+    }
+
+    /* Leaf nodes */
+    else {
+        min = mca_coll_adapt_component.adapt_iallreduce_max_send_requests;
+        if (num_segs < min) {
+            min = num_segs;
+        }
+        con->next_send_seg = min;
+        for (int32_t seg_index = 0; seg_index < min; seg_index++) {
+            err = send_up(con, seg_index);
+            if (MPI_SUCCESS != err) {
+                return err;
+            }
+        }
+    }
+
+    iallreduce_op_done(con);
+
+    return MPI_SUCCESS;
+}
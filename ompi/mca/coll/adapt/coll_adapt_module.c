@@ -54,6 +54,8 @@
 static void adapt_module_construct(mca_coll_adapt_module_t * module)
 {
     module->topo_cache    = NULL;
+    module->topo_all_roots = NULL;
+    module->topo_all_roots_size = 0;
     module->adapt_enabled = false;
 }
 
@@ -70,6 +72,7 @@ static void adapt_module_destruct(mca_coll_adapt_module_t * module)
         OBJ_RELEASE(module->topo_cache);
         module->topo_cache = NULL;
     }
+    adapt_module_free_topology_all_roots(module);
     module->adapt_enabled = false;
 }
 
@@ -109,6 +112,8 @@ static int adapt_module_enable(mca_coll_base_module_t * module,
 
     ADAPT_SAVE_PREV_COLL_API(reduce);
     ADAPT_SAVE_PREV_COLL_API(ireduce);
+    ADAPT_SAVE_PREV_COLL_API(allreduce);
+    ADAPT_SAVE_PREV_COLL_API(iallreduce);
 
     return OMPI_SUCCESS;
 }
@@ -161,9 +166,9 @@ mca_coll_base_module_t *ompi_coll_adapt_comm_query(struct ompi_communicator_t *
 
     /* All is good -- return a module */
     adapt_module->super.coll_module_enable = adapt_module_enable;
-    adapt_module->super.coll_allgather = NULL;
+    adapt_module->super.coll_allgather = ompi_coll_adapt_allgather;
     adapt_module->super.coll_allgatherv = NULL;
-    adapt_module->super.coll_allreduce = NULL;
+    adapt_module->super.coll_allreduce = ompi_coll_adapt_allreduce;
     adapt_module->super.coll_alltoall = NULL;
     adapt_module->super.coll_alltoallw = NULL;
     adapt_module->super.coll_barrier = NULL;
@@ -178,7 +183,8 @@ mca_coll_base_module_t *ompi_coll_adapt_comm_query(struct ompi_communicator_t *
     adapt_module->super.coll_scatterv = NULL;
     adapt_module->super.coll_ibcast = ompi_coll_adapt_ibcast;
     adapt_module->super.coll_ireduce = ompi_coll_adapt_ireduce;
-    adapt_module->super.coll_iallreduce = NULL;
+    adapt_module->super.coll_iallgather = ompi_coll_adapt_iallgather;
+    adapt_module->super.coll_iallreduce = ompi_coll_adapt_iallreduce;
 
     opal_output_verbose(10, ompi_coll_base_framework.framework_output,
                         "coll:adapt:comm_query (%d/%s): pick me! pick me!",
@@ -103,3 +103,49 @@ ompi_coll_tree_t* adapt_module_cached_topology(
     return tree;
 }
 
+
+ompi_coll_tree_t** adapt_module_cached_topology_all_roots(
+    mca_coll_base_module_t *module,
+    struct ompi_communicator_t *comm,
+    ompi_coll_adapt_algorithm_t algorithm)
+{
+    mca_coll_adapt_module_t *adapt_module = (mca_coll_adapt_module_t*)module;
+    int size = ompi_comm_size(comm);
+
+    if (NULL != adapt_module->topo_all_roots) {
+        if (adapt_module->topo_all_roots_algorithm == algorithm) {
+            return adapt_module->topo_all_roots;
+        }
+        adapt_module_free_topology_all_roots(adapt_module);
+    }
+
+    /* one tree per root, all of them are needed by every call */
+    adapt_module->topo_all_roots = (ompi_coll_tree_t **) calloc(size, sizeof(ompi_coll_tree_t *));
+    if (NULL == adapt_module->topo_all_roots) {
+        return NULL;
+    }
+    adapt_module->topo_all_roots_size = size;
+    for (int root = 0; root < size; ++root) {
+        adapt_module->topo_all_roots[root] = create_topology(algorithm, root, comm);
+        if (NULL == adapt_module->topo_all_roots[root]) {
+            adapt_module_free_topology_all_roots(adapt_module);
+            return NULL;
+        }
+    }
+    adapt_module->topo_all_roots_algorithm = algorithm;
+    return adapt_module->topo_all_roots;
+}
+
+void adapt_module_free_topology_all_roots(mca_coll_adapt_module_t *adapt_module)
+{
+    if (NULL == adapt_module->topo_all_roots) {
+        return;
+    }
+    for (int root = 0; root < adapt_module->topo_all_roots_size; ++root) {
+        if (NULL != adapt_module->topo_all_roots[root]) {
+            ompi_coll_base_topo_destroy_tree(&adapt_module->topo_all_roots[root]);
+        }
+    }
+    free(adapt_module->topo_all_roots);
+    adapt_module->topo_all_roots = NULL;
+}
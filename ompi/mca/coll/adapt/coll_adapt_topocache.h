@@ -35,4 +35,12 @@ OMPI_DECLSPEC ompi_coll_tree_t* adapt_module_cached_topology(
     int root,
     ompi_coll_adapt_algorithm_t algorithm);
 
+/* trees of the given algorithm rooted at each rank of the communicator */
+OMPI_DECLSPEC ompi_coll_tree_t** adapt_module_cached_topology_all_roots(
+    mca_coll_base_module_t *module,
+    struct ompi_communicator_t *comm,
+    ompi_coll_adapt_algorithm_t algorithm);
+
+void adapt_module_free_topology_all_roots(mca_coll_adapt_module_t *adapt_module);
+
 #endif /* MCA_COLL_ADAPT_TOPOCACHE_H */
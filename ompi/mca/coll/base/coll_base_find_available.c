@@ -33,6 +33,7 @@
 #include "ompi/constants.h"
 #include "opal/class/opal_list.h"
 #include "opal/util/output.h"
+#include "opal/util/timings.h"
 #include "ompi/mca/mca.h"
 #include "opal/mca/base/base.h"
 #include "opal/mca/base/mca_base_component_repository.h"
@@ -66,6 +67,8 @@ int mca_coll_base_find_available(bool enable_progress_threads,
 {
     mca_base_component_list_item_t *cli, *next;
     const mca_base_component_t *component;
+    int ret;
+    OPAL_TIMING_ENV_INIT(coll_query);
 
     /* The list of components that we should check has already been
        established in mca_coll_base_open. */
@@ -76,8 +79,9 @@ int mca_coll_base_find_available(bool enable_progress_threads,
         /* Call a subroutine to do the work, because the component may
            represent different versions of the coll MCA. */
 
-        if (OMPI_SUCCESS != init_query(component, enable_progress_threads,
-                                       enable_mpi_threads)) {
+        ret = init_query(component, enable_progress_threads, enable_mpi_threads);
+        OPAL_TIMING_ENV_NEXT(coll_query, "%s", component->mca_component_name);
+        if (OMPI_SUCCESS != ret) {
             /* If the component doesn't want to run, then close it.
                Now close it out and release it from the DSO repository (if it's there). */
             opal_list_remove_item(&ompi_coll_base_framework.framework_components, &cli->super);
@@ -43,6 +43,7 @@ BEGIN_C_DECLS
         mca_coll_basic_component;
     extern int mca_coll_basic_priority;
     extern int mca_coll_basic_crossover;
+    extern int mca_coll_basic_neighbor_aggregation_limit;
 
     /* API functions */
 
@@ -281,8 +282,25 @@ BEGIN_C_DECLS
                                            struct ompi_communicator_t *comm, mca_coll_base_module_t *module);
 
 
+/* routes of the aggregated neighborhood collectives, see
+   coll_basic_neighbor_aggr.c */
+struct mca_coll_basic_neighbor_plan_t;
+typedef struct mca_coll_basic_neighbor_plan_t mca_coll_basic_neighbor_plan_t;
+    /* node aware neighborhood collectives for (distributed) graph communicators */
+    bool mca_coll_basic_neighbor_aggregate(struct ompi_communicator_t *comm);
+    int mca_coll_basic_neighbor_allgather_aggr(const void *sbuf, int scount, struct ompi_datatype_t *sdtype,
+                                               void *rbuf, int rcount, struct ompi_datatype_t *rdtype,
+                                               struct ompi_communicator_t *comm, mca_coll_base_module_t *module,
+                                               int indegree, const int *in, int outdegree, const int *out);
+    int mca_coll_basic_neighbor_alltoall_aggr(const void *sbuf, int scount, struct ompi_datatype_t *sdtype,
+                                              void *rbuf, int rcount, struct ompi_datatype_t *rdtype,
+                                              struct ompi_communicator_t *comm, mca_coll_base_module_t *module,
+                                              int indegree, const int *in, int outdegree, const int *out);
+    void mca_coll_basic_neighbor_plan_free(mca_coll_basic_neighbor_plan_t *plan);
+
 struct mca_coll_basic_module_t {
     mca_coll_base_module_t super;
+    mca_coll_basic_neighbor_plan_t *neighbor_plan;
 };
 typedef struct mca_coll_basic_module_t mca_coll_basic_module_t;
 OMPI_DECLSPEC OBJ_CLASS_DECLARATION(mca_coll_basic_module_t);
@@ -44,6 +44,7 @@ const char *mca_coll_basic_component_version_string =
  */
 int mca_coll_basic_priority = 10;
 int mca_coll_basic_crossover = 4;
+int mca_coll_basic_neighbor_aggregation_limit = 4096;
 
 /*
  * Local function
@@ -102,12 +103,33 @@ basic_register(void)
                                            OPAL_INFO_LVL_9,
                                            MCA_BASE_VAR_SCOPE_READONLY,
                                            &mca_coll_basic_crossover);
+    mca_coll_basic_neighbor_aggregation_limit = 4096;
+    (void) mca_base_component_var_register(&mca_coll_basic_component.collm_version, "neighbor_aggregation_limit",
+                                           "Largest block (in bytes) for which the neighborhood collectives of graph and "
+                                           "distributed graph communicators combine the blocks to the neighbors on a "
+                                           "remote node into one message (0 disables the aggregation). Has to be the same on all processes",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_6,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_coll_basic_neighbor_aggregation_limit);
 
     return OMPI_SUCCESS;
 }
 
+static void
+mca_coll_basic_module_construct(mca_coll_basic_module_t *module)
+{
+    module->neighbor_plan = NULL;
+}
+
+static void
+mca_coll_basic_module_destruct(mca_coll_basic_module_t *module)
+{
+    mca_coll_basic_neighbor_plan_free(module->neighbor_plan);
+}
+
 OBJ_CLASS_INSTANCE(mca_coll_basic_module_t,
                    mca_coll_base_module_t,
-                   NULL,
-                   NULL);
+                   mca_coll_basic_module_construct,
+                   mca_coll_basic_module_destruct);
 
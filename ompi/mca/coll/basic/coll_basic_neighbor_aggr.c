@@ -0,0 +1,640 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The Open MPI Project.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+#include "coll_basic.h"
+
+#include <stdlib.h>
+
+#include "mpi.h"
+#include "ompi/constants.h"
+#include "ompi/datatype/ompi_datatype.h"
+#include "ompi/mca/coll/coll.h"
+#include "ompi/mca/pml/pml.h"
+#include "ompi/mca/coll/base/coll_tags.h"
+#include "ompi/mca/coll/base/coll_base_util.h"
+#include "ompi/proc/proc.h"
+#include "opal/mca/pmix/pmix-internal.h"
+
+/*
+ * Node aware neighborhood exchange for graph and distributed graph
+ * communicators.
+ *
+ * The out edges of a process to a remote node that hosts more than one
+ * of its neighbors form a group. The blocks of a group travel as one
+ * message to a proxy, the neighbor of the group with the lowest rank,
+ * which hands them on to the other neighbors on its node through the
+ * shared memory transport of the pml. Edges within the node and single
+ * edges to a node are served directly, like in the plain algorithms.
+ *
+ * The routes are set up by the first aggregated call on a communicator
+ * and kept on the module: every process tells each of its out neighbors
+ * which process delivers the block, and sends the final destinations of
+ * a group to its proxy. A proxy forwards the blocks ordered by the rank
+ * of their origin, a process receiving forwarded blocks posts the
+ * receives in the same order, so that multiple edges between the same
+ * processes are matched in the order of the edge lists as required.
+ *
+ * The routes are set up whatever the size of the blocks, all processes
+ * with neighbors take part. Whether a block is aggregated is decided per
+ * edge: the origin by the size it sends, the proxy and the destination by
+ * the size they receive. MPI requires both sides of an edge to agree on
+ * that size, the sizes of different edges may differ.
+ */
+
+#define NEIGHBOR_AGGR_TAG_ROUTE (MCA_COLL_BASE_TAG_NEIGHBOR_END + 1)
+#define NEIGHBOR_AGGR_TAG_LIST  (MCA_COLL_BASE_TAG_NEIGHBOR_END + 2)
+#define NEIGHBOR_AGGR_TAG_AGGR  (MCA_COLL_BASE_TAG_NEIGHBOR_END + 3)
+#define NEIGHBOR_AGGR_TAG_FWD   (MCA_COLL_BASE_TAG_NEIGHBOR_END + 4)
+
+struct mca_coll_basic_neighbor_plan_t {
+    /* per out edge: group the block is sent with, -1 if sent directly */
+    int *out_group;
+    /* out edges of group g are group_edges[group_start[g]..group_start[g+1]-1] */
+    int ngroups;
+    int *group_start;
+    int *group_edges;
+    int *group_proxy;
+
+    /* per in edge: process the block is received from. This is the
+       origin for a direct edge, the own rank if the block is part of an
+       aggregated message to this process, the proxy otherwise. */
+    int *in_route;
+    /* in edges received from a proxy, in the order they are forwarded */
+    int nfwd_in;
+    int *fwd_in;
+
+    /* aggregated messages to this process, ordered by origin. The
+       blocks of message m are proxied_dest/slot[proxied_start[m]..] */
+    int nproxied;
+    int *proxied_src;
+    int *proxied_start;
+    int *proxied_dest;
+    /* own in edge the block is stored to, -1 if it is forwarded */
+    int *proxied_slot;
+
+    int nreqs;
+};
+
+void mca_coll_basic_neighbor_plan_free (mca_coll_basic_neighbor_plan_t *plan)
+{
+    if (NULL == plan) {
+        return;
+    }
+    free (plan->out_group);
+    free (plan->group_start);
+    free (plan->group_edges);
+    free (plan->group_proxy);
+    free (plan->in_route);
+    free (plan->fwd_in);
+    free (plan->proxied_src);
+    free (plan->proxied_start);
+    free (plan->proxied_dest);
+    free (plan->proxied_slot);
+    free (plan);
+}
+
+/* has to be the same on all processes, the first call sets up the routes */
+bool mca_coll_basic_neighbor_aggregate (struct ompi_communicator_t *comm)
+{
+    return 0 < mca_coll_basic_neighbor_aggregation_limit && 1 < ompi_comm_size (comm) &&
+        !OMPI_COMM_IS_INTER(comm);
+}
+
+static int neighbor_nodeid (ompi_proc_t *proc, uint32_t *nodeid)
+{
+    uint32_t val, *pval = &val;
+    int rc;
+
+    OPAL_MODEX_RECV_VALUE(rc, PMIX_NODEID, &(proc->super.proc_name), &pval, PMIX_UINT32);
+    if (PMIX_SUCCESS != rc) {
+        return OMPI_ERROR;
+    }
+    *nodeid = val;
+    return OMPI_SUCCESS;
+}
+
+/* sort key for the forwarded blocks: origin rank, then edge index */
+typedef struct {
+    int src;
+    int index;
+} neighbor_aggr_pair_t;
+
+static int neighbor_aggr_pair_cmp (const void *a, const void *b)
+{
+    const neighbor_aggr_pair_t *pa = (const neighbor_aggr_pair_t *) a;
+    const neighbor_aggr_pair_t *pb = (const neighbor_aggr_pair_t *) b;
+
+    if (pa->src != pb->src) {
+        return (pa->src < pb->src) ? -1 : 1;
+    }
+    return (pa->index < pb->index) ? -1 : (pa->index > pb->index);
+}
+
+/* find the groups of the out edges and the proxy of each group */
+static int neighbor_plan_groups (mca_coll_basic_neighbor_plan_t *plan, struct ompi_communicator_t *comm,
+                                 int outdegree, const int *out)
+{
+    const int rank = ompi_comm_rank (comm);
+    uint32_t my_node, *nodes = NULL;
+    int *counts = NULL, *pos = NULL;
+    int k, g, ngroups = 0, rc = OMPI_SUCCESS;
+
+    plan->out_group = (int *) malloc ((outdegree + 1) * sizeof (int));
+    plan->group_start = (int *) malloc ((outdegree + 1) * sizeof (int));
+    nodes = (uint32_t *) malloc ((outdegree + 1) * sizeof (uint32_t));
+    counts = (int *) calloc (outdegree + 1, sizeof (int));
+    if (NULL == plan->out_group || NULL == plan->group_start || NULL == nodes || NULL == counts) {
+        rc = OMPI_ERR_OUT_OF_RESOURCE;
+        goto exit;
+    }
+
+    for (k = 0 ; k < outdegree ; ++k) {
+        plan->out_group[k] = -1;
+    }
+    plan->group_start[0] = 0;
+
+    if (OMPI_SUCCESS != neighbor_nodeid (ompi_proc_local (), &my_node)) {
+        /* no node information, everything goes direct */
+        goto exit;
+    }
+
+    for (k = 0 ; k < outdegree ; ++k) {
+        uint32_t node;
+
+        if (MPI_PROC_NULL == out[k] || rank == out[k]) {
+            continue;
+        }
+        if (OMPI_SUCCESS != neighbor_nodeid (ompi_comm_peer_lookup (comm, out[k]), &node) ||
+            my_node == node) {
+            continue;
+        }
+        for (g = 0 ; g < ngroups && nodes[g] != node ; ++g);
+        if (g == ngroups) {
+            nodes[ngroups++] = node;
+        }
+        plan->out_group[k] = g;
+        counts[g]++;
+    }
+
+    /* a single edge to a node is cheaper when sent directly */
+    pos = (int *) malloc ((ngroups + 1) * sizeof (int));
+    if (NULL == pos) {
+        rc = OMPI_ERR_OUT_OF_RESOURCE;
+        goto exit;
+    }
+    for (g = 0, plan->ngroups = 0 ; g < ngroups ; ++g) {
+        if (counts[g] < 2) {
+            pos[g] = -1;
+            continue;
+        }
+        pos[g] = plan->ngroups;
+        plan->group_start[plan->ngroups + 1] = plan->group_start[plan->ngroups] + counts[g];
+        plan->ngroups++;
+    }
+
+    plan->group_edges = (int *) malloc ((plan->group_start[plan->ngroups] + 1) * sizeof (int));
+    plan->group_proxy = (int *) malloc ((plan->ngroups + 1) * sizeof (int));
+    if (NULL == plan->group_edges || NULL == plan->group_proxy) {
+        rc = OMPI_ERR_OUT_OF_RESOURCE;
+        goto exit;
+    }
+    for (g = 0 ; g < plan->ngroups ; ++g) {
+        counts[g] = plan->group_start[g];
+        plan->group_proxy[g] = -1;
+    }
+    for (k = 0 ; k < outdegree ; ++k) {
+        if (-1 == plan->out_group[k]) {
+            continue;
+        }
+        g = plan->out_group[k] = pos[plan->out_group[k]];
+        if (-1 == g) {
+            continue;
+        }
+        plan->group_edges[counts[g]++] = k;
+        if (-1 == plan->group_proxy[g] || out[k] < plan->group_proxy[g]) {
+            plan->group_proxy[g] = out[k];
+        }
+    }
+
+ exit:
+    free (nodes);
+    free (counts);
+    free (pos);
+    return rc;
+}
+
+/*
+ * Set up the routes of the neighborhood of this process. Collective over
+ * the neighbors of the communicator.
+ */
+static int neighbor_plan_create (struct ompi_communicator_t *comm, mca_coll_base_module_t *module,
+                                 int indegree, const int *in, int outdegree, const int *out,
+                                 mca_coll_basic_neighbor_plan_t **plan_out)
+{
+    const int rank = ompi_comm_rank (comm);
+    mca_coll_basic_neighbor_plan_t *plan;
+    int *hdr_in = NULL, *hdr_out = NULL, *lists = NULL, *list_start = NULL;
+    neighbor_aggr_pair_t *order = NULL;
+    ompi_request_t **reqs = NULL;
+    int rc, j, k, g, m, i, nreqs, nlist, nforwards;
+
+    plan = (mca_coll_basic_neighbor_plan_t *) calloc (1, sizeof (*plan));
+    if (NULL == plan) {
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+
+    rc = neighbor_plan_groups (plan, comm, outdegree, out);
+    if (OMPI_SUCCESS != rc) {
+        goto exit;
+    }
+
+    /* route header per edge: the process delivering the block, and for
+       the first edge of a group to its proxy the size of the group */
+    hdr_in = (int *) malloc ((2 * indegree + 1) * sizeof (int));
+    hdr_out = (int *) malloc ((2 * outdegree + 1) * sizeof (int));
+    list_start = (int *) malloc ((indegree + 1) * sizeof (int));
+    plan->in_route = (int *) malloc ((indegree + 1) * sizeof (int));
+    reqs = ompi_coll_base_comm_get_reqs (module->base_data, indegree + outdegree);
+    if (NULL == hdr_in || NULL == hdr_out || NULL == list_start || NULL == plan->in_route ||
+        (NULL == reqs && 0 < indegree + outdegree)) {
+        rc = OMPI_ERR_OUT_OF_RESOURCE;
+        goto exit;
+    }
+
+    for (k = 0 ; k < outdegree ; ++k) {
+        hdr_out[2 * k] = rank;
+        hdr_out[2 * k + 1] = 0;
+    }
+    for (g = 0 ; g < plan->ngroups ; ++g) {
+        bool first = true;
+
+        for (i = plan->group_start[g] ; i < plan->group_start[g + 1] ; ++i) {
+            k = plan->group_edges[i];
+            hdr_out[2 * k] = plan->group_proxy[g];
+            if (first && out[k] == plan->group_proxy[g]) {
+                hdr_out[2 * k + 1] = plan->group_start[g + 1] - plan->group_start[g];
+                first = false;
+            }
+        }
+    }
+
+    nreqs = 0;
+    for (j = 0 ; j < indegree ; ++j) {
+        /* an edge from MPI_PROC_NULL is direct */
+        hdr_in[2 * j] = in[j];
+        hdr_in[2 * j + 1] = 0;
+        rc = MCA_PML_CALL(irecv(hdr_in + 2 * j, 2, MPI_INT, in[j], NEIGHBOR_AGGR_TAG_ROUTE,
+                                comm, reqs + nreqs));
+        if (OMPI_SUCCESS != rc) goto exit_reqs;
+        nreqs++;
+    }
+    for (k = 0 ; k < outdegree ; ++k) {
+        rc = MCA_PML_CALL(isend(hdr_out + 2 * k, 2, MPI_INT, out[k], NEIGHBOR_AGGR_TAG_ROUTE,
+                                MCA_PML_BASE_SEND_STANDARD, comm, reqs + nreqs));
+        if (OMPI_SUCCESS != rc) goto exit_reqs;
+        nreqs++;
+    }
+    rc = ompi_request_wait_all (nreqs, reqs, MPI_STATUSES_IGNORE);
+    if (OMPI_SUCCESS != rc) goto exit_reqs;
+
+    /* destinations of the aggregated messages to this process */
+    for (j = 0, nlist = 0, plan->nproxied = 0 ; j < indegree ; ++j) {
+        list_start[j] = nlist;
+        nlist += hdr_in[2 * j + 1];
+        plan->nproxied += (0 < hdr_in[2 * j + 1]);
+    }
+    list_start[indegree] = nlist;
+    lists = (int *) malloc ((nlist + 1) * sizeof (int));
+    if (NULL == lists) {
+        rc = OMPI_ERR_OUT_OF_RESOURCE;
+        goto exit;
+    }
+
+    nreqs = 0;
+    for (j = 0 ; j < indegree ; ++j) {
+        if (0 == hdr_in[2 * j + 1]) {
+            continue;
+        }
+        rc = MCA_PML_CALL(irecv(lists + list_start[j], hdr_in[2 * j + 1], MPI_INT, in[j],
+                                NEIGHBOR_AGGR_TAG_LIST, comm, reqs + nreqs));
+        if (OMPI_SUCCESS != rc) goto exit_reqs;
+        nreqs++;
+    }
+    for (g = 0 ; g < plan->ngroups ; ++g) {
+        /* the destinations are stored in hdr_out, the headers are sent */
+        for (i = plan->group_start[g] ; i < plan->group_start[g + 1] ; ++i) {
+            hdr_out[i] = out[plan->group_edges[i]];
+        }
+        rc = MCA_PML_CALL(isend(hdr_out + plan->group_start[g],
+                                plan->group_start[g + 1] - plan->group_start[g], MPI_INT,
+                                plan->group_proxy[g], NEIGHBOR_AGGR_TAG_LIST,
+                                MCA_PML_BASE_SEND_STANDARD, comm, reqs + nreqs));
+        if (OMPI_SUCCESS != rc) goto exit_reqs;
+        nreqs++;
+    }
+    rc = ompi_request_wait_all (nreqs, reqs, MPI_STATUSES_IGNORE);
+    if (OMPI_SUCCESS != rc) goto exit_reqs;
+
+    /* in edges: direct, part of an aggregated message, or forwarded */
+    order = (neighbor_aggr_pair_t *) malloc ((indegree + 1) * sizeof (*order));
+    plan->fwd_in = (int *) malloc ((indegree + 1) * sizeof (int));
+    if (NULL == order || NULL == plan->fwd_in) {
+        rc = OMPI_ERR_OUT_OF_RESOURCE;
+        goto exit;
+    }
+    for (j = 0, plan->nfwd_in = 0 ; j < indegree ; ++j) {
+        plan->in_route[j] = hdr_in[2 * j];
+        if (hdr_in[2 * j] != in[j] && hdr_in[2 * j] != rank) {
+            order[plan->nfwd_in].src = in[j];
+            order[plan->nfwd_in++].index = j;
+        }
+    }
+    qsort (order, plan->nfwd_in, sizeof (*order), neighbor_aggr_pair_cmp);
+    for (i = 0 ; i < plan->nfwd_in ; ++i) {
+        plan->fwd_in[i] = order[i].index;
+    }
+
+    /* aggregated messages ordered by origin */
+    plan->proxied_src = (int *) malloc ((plan->nproxied + 1) * sizeof (int));
+    plan->proxied_start = (int *) malloc ((plan->nproxied + 1) * sizeof (int));
+    plan->proxied_dest = (int *) malloc ((nlist + 1) * sizeof (int));
+    plan->proxied_slot = (int *) malloc ((nlist + 1) * sizeof (int));
+    if (NULL == plan->proxied_src || NULL == plan->proxied_start ||
+        NULL == plan->proxied_dest || NULL == plan->proxied_slot) {
+        rc = OMPI_ERR_OUT_OF_RESOURCE;
+        goto exit;
+    }
+    for (j = 0, m = 0 ; j < indegree ; ++j) {
+        if (0 < hdr_in[2 * j + 1]) {
+            order[m].src = in[j];
+            order[m++].index = j;
+        }
+    }
+    qsort (order, plan->nproxied, sizeof (*order), neighbor_aggr_pair_cmp);
+
+    plan->proxied_start[0] = 0;
+    for (m = 0, nforwards = 0 ; m < plan->nproxied ; ++m) {
+        int src = order[m].src, first = list_start[order[m].index];
+        int n = hdr_in[2 * order[m].index + 1], slot = 0;
+
+        plan->proxied_src[m] = src;
+        plan->proxied_start[m + 1] = plan->proxied_start[m] + n;
+        for (i = 0 ; i < n ; ++i) {
+            int idx = plan->proxied_start[m] + i;
+
+            plan->proxied_dest[idx] = lists[first + i];
+            plan->proxied_slot[idx] = -1;
+            if (rank != lists[first + i]) {
+                nforwards++;
+                continue;
+            }
+            /* the blocks to this process fill its in edges from src
+               that are part of an aggregated message, in order */
+            for ( ; slot < indegree ; ++slot) {
+                if (in[slot] == src && hdr_in[2 * slot] == rank) {
+                    plan->proxied_slot[idx] = slot++;
+                    break;
+                }
+            }
+            if (-1 == plan->proxied_slot[idx]) {
+                rc = OMPI_ERR_BAD_PARAM;
+                goto exit;
+            }
+        }
+    }
+
+    plan->nreqs = indegree + outdegree + plan->nproxied + plan->ngroups + nforwards;
+    *plan_out = plan;
+    plan = NULL;
+    goto exit;
+
+ exit_reqs:
+    ompi_coll_base_free_reqs (reqs, nreqs);
+ exit:
+    mca_coll_basic_neighbor_plan_free (plan);
+    free (hdr_in);
+    free (hdr_out);
+    free (lists);
+    free (list_start);
+    free (order);
+    return rc;
+}
+
+static int neighbor_plan_get (struct ompi_communicator_t *comm, mca_coll_base_module_t *module,
+                              int indegree, const int *in, int outdegree, const int *out,
+                              mca_coll_basic_neighbor_plan_t **plan)
+{
+    mca_coll_basic_module_t *basic_module = (mca_coll_basic_module_t *) module;
+    int rc;
+
+    if (NULL == basic_module->neighbor_plan) {
+        rc = neighbor_plan_create (comm, module, indegree, in, outdegree, out,
+                                   &basic_module->neighbor_plan);
+        if (OMPI_SUCCESS != rc) {
+            return rc;
+        }
+    }
+    *plan = basic_module->neighbor_plan;
+    return OMPI_SUCCESS;
+}
+
+/*
+ * Common part of neighbor_allgather and neighbor_alltoall: for the
+ * allgather every out edge sends the same block, and an aggregated
+ * message carries the block once.
+ */
+static int neighbor_exchange (const void *sbuf, int scount, struct ompi_datatype_t *sdtype,
+                              void *rbuf, int rcount, struct ompi_datatype_t *rdtype,
+                              struct ompi_communicator_t *comm, mca_coll_base_module_t *module,
+                              int indegree, const int *in, int outdegree, const int *out,
+                              bool alltoall, int tag)
+{
+    mca_coll_basic_neighbor_plan_t *plan;
+    ptrdiff_t lb, rdextent, sdextent, rgap = 0, sgap = 0;
+    size_t rspan = 0, sspan = 0, roffset, soffset;
+    char *rtmp = NULL, *stmp = NULL;
+    ompi_request_t **reqs;
+    size_t ssize, rsize;
+    bool send_aggr, recv_aggr;
+    int rc, i, j, k, g, m, nreqs = 0, aggr_first, ngroups, nproxied, nfwd_in;
+
+    if (0 == (indegree + outdegree)) {
+        return OMPI_SUCCESS;
+    }
+
+    rc = neighbor_plan_get (comm, module, indegree, in, outdegree, out, &plan);
+    if (OMPI_SUCCESS != rc) {
+        return rc;
+    }
+
+    ompi_datatype_get_extent (rdtype, &lb, &rdextent);
+    ompi_datatype_get_extent (sdtype, &lb, &sdextent);
+
+    /* the origin of an edge decides by what it sends, the proxy and the
+       destination by what they receive, which is the same size */
+    ompi_datatype_type_size (sdtype, &ssize);
+    ompi_datatype_type_size (rdtype, &rsize);
+    send_aggr = ssize * (size_t) scount <= (size_t) mca_coll_basic_neighbor_aggregation_limit;
+    recv_aggr = rsize * (size_t) rcount <= (size_t) mca_coll_basic_neighbor_aggregation_limit;
+    ngroups  = send_aggr ? plan->ngroups : 0;
+    nproxied = recv_aggr ? plan->nproxied : 0;
+    nfwd_in  = recv_aggr ? plan->nfwd_in : 0;
+
+    if (alltoall && 0 < nproxied) {
+        rspan = opal_datatype_span (&rdtype->super, (int64_t) rcount * plan->proxied_start[nproxied],
+                                    &rgap);
+        rtmp = (char *) malloc (rspan + 1);
+    }
+    if (alltoall && 0 < ngroups) {
+        sspan = opal_datatype_span (&sdtype->super, (int64_t) scount * plan->group_start[ngroups],
+                                    &sgap);
+        stmp = (char *) malloc (sspan + 1);
+    }
+    reqs = ompi_coll_base_comm_get_reqs (module->base_data, plan->nreqs);
+    if ((alltoall && 0 < nproxied && NULL == rtmp) ||
+        (alltoall && 0 < ngroups && NULL == stmp) || NULL == reqs) {
+        rc = OMPI_ERR_OUT_OF_RESOURCE;
+        goto exit;
+    }
+
+    /* post receives first: direct blocks, forwarded blocks, and the
+       aggregated messages this process is the proxy of */
+    for (j = 0 ; j < indegree ; ++j) {
+        if (recv_aggr && plan->in_route[j] != in[j]) {
+            continue;
+        }
+        rc = MCA_PML_CALL(irecv((char *) rbuf + j * rcount * rdextent, rcount, rdtype, in[j],
+                                tag, comm, reqs + nreqs));
+        if (OMPI_SUCCESS != rc) goto exit_reqs;
+        nreqs++;
+    }
+    for (i = 0 ; i < nfwd_in ; ++i) {
+        j = plan->fwd_in[i];
+        rc = MCA_PML_CALL(irecv((char *) rbuf + j * rcount * rdextent, rcount, rdtype,
+                                plan->in_route[j], NEIGHBOR_AGGR_TAG_FWD, comm, reqs + nreqs));
+        if (OMPI_SUCCESS != rc) goto exit_reqs;
+        nreqs++;
+    }
+    aggr_first = nreqs;
+    for (m = 0 ; m < nproxied ; ++m) {
+        int n = plan->proxied_start[m + 1] - plan->proxied_start[m];
+
+        if (alltoall) {
+            rc = MCA_PML_CALL(irecv(rtmp - rgap + plan->proxied_start[m] * rcount * rdextent,
+                                    n * rcount, rdtype, plan->proxied_src[m],
+                                    NEIGHBOR_AGGR_TAG_AGGR, comm, reqs + nreqs));
+        } else {
+            /* the block goes to the first own edge, an allgather group
+               always contains the proxy */
+            for (i = plan->proxied_start[m] ; -1 == plan->proxied_slot[i] ; ++i);
+            rc = MCA_PML_CALL(irecv((char *) rbuf + plan->proxied_slot[i] * rcount * rdextent,
+                                    rcount, rdtype, plan->proxied_src[m],
+                                    NEIGHBOR_AGGR_TAG_AGGR, comm, reqs + nreqs));
+        }
+        if (OMPI_SUCCESS != rc) goto exit_reqs;
+        nreqs++;
+    }
+
+    /* direct blocks and aggregated messages */
+    for (k = 0 ; k < outdegree ; ++k) {
+        if (send_aggr && -1 != plan->out_group[k]) {
+            continue;
+        }
+        /* remove cast from const when the pml layer is updated to take
+         * a const for the send buffer. */
+        rc = MCA_PML_CALL(isend((char *) sbuf + (alltoall ? k * scount * sdextent : 0), scount, sdtype,
+                                out[k], tag, MCA_PML_BASE_SEND_STANDARD, comm, reqs + nreqs));
+        if (OMPI_SUCCESS != rc) goto exit_reqs;
+        nreqs++;
+    }
+    for (g = 0 ; g < ngroups ; ++g) {
+        int n = plan->group_start[g + 1] - plan->group_start[g];
+
+        if (alltoall) {
+            soffset = plan->group_start[g] * scount * sdextent;
+            for (i = plan->group_start[g] ; i < plan->group_start[g + 1] ; ++i) {
+                k = plan->group_edges[i];
+                rc = ompi_datatype_copy_content_same_ddt (sdtype, scount,
+                                                          stmp - sgap + i * scount * sdextent,
+                                                          (char *) sbuf + k * scount * sdextent);
+                if (OMPI_SUCCESS != rc) goto exit_reqs;
+            }
+            rc = MCA_PML_CALL(isend(stmp - sgap + soffset, n * scount, sdtype, plan->group_proxy[g],
+                                    NEIGHBOR_AGGR_TAG_AGGR, MCA_PML_BASE_SEND_STANDARD,
+                                    comm, reqs + nreqs));
+        } else {
+            rc = MCA_PML_CALL(isend((void *) sbuf, scount, sdtype, plan->group_proxy[g],
+                                    NEIGHBOR_AGGR_TAG_AGGR, MCA_PML_BASE_SEND_STANDARD,
+                                    comm, reqs + nreqs));
+        }
+        if (OMPI_SUCCESS != rc) goto exit_reqs;
+        nreqs++;
+    }
+
+    /* hand on the aggregated messages, in the order of their origin */
+    for (m = 0 ; m < nproxied ; ++m) {
+        char *block = NULL;
+
+        rc = ompi_request_wait (reqs + aggr_first + m, MPI_STATUS_IGNORE);
+        if (OMPI_SUCCESS != rc) goto exit_reqs;
+
+        for (i = plan->proxied_start[m] ; i < plan->proxied_start[m + 1] ; ++i) {
+            if (alltoall) {
+                block = rtmp - rgap + i * rcount * rdextent;
+            } else if (NULL == block) {
+                for (j = plan->proxied_start[m] ; -1 == plan->proxied_slot[j] ; ++j);
+                block = (char *) rbuf + plan->proxied_slot[j] * rcount * rdextent;
+            }
+            if (-1 != plan->proxied_slot[i]) {
+                roffset = plan->proxied_slot[i] * rcount * rdextent;
+                if ((char *) rbuf + roffset != block) {
+                    rc = ompi_datatype_copy_content_same_ddt (rdtype, rcount, (char *) rbuf + roffset, block);
+                    if (OMPI_SUCCESS != rc) goto exit_reqs;
+                }
+                continue;
+            }
+            rc = MCA_PML_CALL(isend(block, rcount, rdtype, plan->proxied_dest[i],
+                                    NEIGHBOR_AGGR_TAG_FWD, MCA_PML_BASE_SEND_STANDARD,
+                                    comm, reqs + nreqs));
+            if (OMPI_SUCCESS != rc) goto exit_reqs;
+            nreqs++;
+        }
+    }
+
+    rc = ompi_request_wait_all (nreqs, reqs, MPI_STATUSES_IGNORE);
+    if (OMPI_SUCCESS != rc) goto exit_reqs;
+    goto exit;
+
+ exit_reqs:
+    ompi_coll_base_free_reqs (reqs, nreqs);
+ exit:
+    free (rtmp);
+    free (stmp);
+    return rc;
+}
+
+int mca_coll_basic_neighbor_alltoall_aggr (const void *sbuf, int scount, struct ompi_datatype_t *sdtype,
+                                           void *rbuf, int rcount, struct ompi_datatype_t *rdtype,
+                                           struct ompi_communicator_t *comm, mca_coll_base_module_t *module,
+                                           int indegree, const int *in, int outdegree, const int *out)
+{
+    return neighbor_exchange (sbuf, scount, sdtype, rbuf, rcount, rdtype, comm, module,
+                              indegree, in, outdegree, out, true, MCA_COLL_BASE_TAG_ALLTOALL);
+}
+
+int mca_coll_basic_neighbor_allgather_aggr (const void *sbuf, int scount, struct ompi_datatype_t *sdtype,
+                                            void *rbuf, int rcount, struct ompi_datatype_t *rdtype,
+                                            struct ompi_communicator_t *comm, mca_coll_base_module_t *module,
+                                            int indegree, const int *in, int outdegree, const int *out)
+{
+    return neighbor_exchange (sbuf, scount, sdtype, rbuf, rcount, rdtype, comm, module,
+                              indegree, in, outdegree, out, false, MCA_COLL_BASE_TAG_ALLGATHER);
+}
@@ -139,6 +139,11 @@ mca_coll_basic_neighbor_allgather_graph(const void *sbuf, int scount,
         edges += graph->index[rank - 1];
     }
 
+    if (mca_coll_basic_neighbor_aggregate (comm)) {
+        return mca_coll_basic_neighbor_allgather_aggr (sbuf, scount, sdtype, rbuf, rcount, rdtype,
+                                                       comm, module, degree, edges, degree, edges);
+    }
+
     ompi_datatype_get_extent(rdtype, &lb, &extent);
     reqs = preqs = ompi_coll_base_comm_get_reqs( module->base_data, 2 * degree);
     if( NULL == reqs ) { return OMPI_ERR_OUT_OF_RESOURCE; }
@@ -190,6 +195,11 @@ mca_coll_basic_neighbor_allgather_dist_graph(const void *sbuf, int scount,
     inedges = dist_graph->in;
     outedges = dist_graph->out;
 
+    if (mca_coll_basic_neighbor_aggregate (comm)) {
+        return mca_coll_basic_neighbor_allgather_aggr (sbuf, scount, sdtype, rbuf, rcount, rdtype, comm, module,
+                                                       indegree, inedges, outdegree, outedges);
+    }
+
     ompi_datatype_get_extent(rdtype, &lb, &extent);
     reqs = preqs = ompi_coll_base_comm_get_reqs( module->base_data, indegree + outdegree);
     if( NULL == reqs ) { return OMPI_ERR_OUT_OF_RESOURCE; }
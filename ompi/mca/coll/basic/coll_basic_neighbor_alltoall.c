@@ -161,6 +161,11 @@ mca_coll_basic_neighbor_alltoall_graph(const void *sbuf, int scount, struct ompi
         edges += graph->index[rank - 1];
     }
 
+    if (mca_coll_basic_neighbor_aggregate (comm)) {
+        return mca_coll_basic_neighbor_alltoall_aggr (sbuf, scount, sdtype, rbuf, rcount, rdtype,
+                                                      comm, module, degree, edges, degree, edges);
+    }
+
     ompi_datatype_get_extent(rdtype, &lb, &rdextent);
     ompi_datatype_get_extent(sdtype, &lb, &sdextent);
     reqs = preqs = ompi_coll_base_comm_get_reqs( module->base_data, 2 * degree);
@@ -219,6 +224,11 @@ mca_coll_basic_neighbor_alltoall_dist_graph(const void *sbuf, int scount,struct
     inedges = dist_graph->in;
     outedges = dist_graph->out;
 
+    if (mca_coll_basic_neighbor_aggregate (comm)) {
+        return mca_coll_basic_neighbor_alltoall_aggr (sbuf, scount, sdtype, rbuf, rcount, rdtype, comm, module,
+                                                      indegree, inedges, outdegree, outedges);
+    }
+
     ompi_datatype_get_extent(rdtype, &lb, &rdextent);
     ompi_datatype_get_extent(sdtype, &lb, &sdextent);
     reqs = preqs = ompi_coll_base_comm_get_reqs( module->base_data, indegree + outdegree);
@@ -30,6 +30,7 @@
 #include "ompi/mca/coll/coll.h"
 #include "ompi/mca/coll/base/coll_base_util.h"
 #include "opal/sys/atomic.h"
+#include "opal/class/opal_hash_table.h"
 
 BEGIN_C_DECLS
 
@@ -38,19 +39,9 @@ BEGIN_C_DECLS
 /* the debug level */
 #define NBC_DLEVEL 0
 
-/* enable schedule caching - undef NBC_CACHE_SCHEDULE to deactivate it */
-/* TODO: this whole schedule cache stuff does not work with the tmbuf
- * :-( - first, the tmpbuf must not be freed if a schedule using it is
- * still in the cache and second, the tmpbuf used by the schedule must
- * be attached to the handle that uses this schedule !!!!
- * I.E., THIS IS EXPERIMENTAL AND MIGHT NOT WORK */
-/* It also leaks memory because the schedule is never cleaned up when
-   the communicator is destroyed, so don't use it for now */
-#ifdef NBC_CACHE_SCHEDULE
-#undef NBC_CACHE_SCHEDULE
-#endif
-#define NBC_SCHED_DICT_UPPER 1024 /* max. number of dict entries */
-#define NBC_SCHED_DICT_LOWER 512  /* nuber of dict entries after wipe, if SCHED_DICT_UPPER is reached */
+/* schedule caching: the number of schedules kept per communicator is
+ * set by the schedule_cache_size MCA parameter, 0 (the default) disables
+ * the cache */
 
 /********************* end of LibNBC tuning parameters ************************/
 
@@ -77,6 +68,7 @@ extern int libnbc_ibcast_knomial_radix;
 extern int libnbc_iexscan_algorithm;
 extern int libnbc_ireduce_algorithm;
 extern int libnbc_iscan_algorithm;
+extern int libnbc_schedule_cache_size;
 
 struct ompi_coll_libnbc_component_t {
     mca_coll_base_component_2_4_0_t super;
@@ -84,6 +76,8 @@ struct ompi_coll_libnbc_component_t {
     opal_list_t active_requests;
     opal_atomic_int32_t active_comms;
     opal_mutex_t lock;                /* protect access to the active_requests list */
+    opal_atomic_size_t sched_cache_hits;
+    opal_atomic_size_t sched_cache_misses;
 };
 typedef struct ompi_coll_libnbc_component_t ompi_coll_libnbc_component_t;
 
@@ -94,14 +88,9 @@ struct ompi_coll_libnbc_module_t {
     mca_coll_base_module_t super;
     opal_mutex_t mutex;
     bool comm_registered;
-#ifdef NBC_CACHE_SCHEDULE
-  void *NBC_Dict[NBC_NUM_COLL]; /* this should point to a struct
-                                      hb_tree, but since this is a
-                                      public header-file, this would be
-                                      an include mess :-(. So let's void
-                                      it ...*/
-  int NBC_Dict_size[NBC_NUM_COLL];
-#endif
+    /* schedule cache, the list is in least recently used order */
+    opal_hash_table_t sched_cache;
+    opal_list_t sched_cache_lru;
 };
 typedef struct ompi_coll_libnbc_module_t ompi_coll_libnbc_module_t;
 OBJ_CLASS_DECLARATION(ompi_coll_libnbc_module_t);
@@ -113,12 +102,22 @@ struct NBC_Schedule {
     volatile int size;
     volatile int current_round_offset;
     char *data;
+    void *tmpbuf;  /* temporary buffer owned by a cached schedule */
 };
 
 typedef struct NBC_Schedule NBC_Schedule;
 
 OBJ_CLASS_DECLARATION(NBC_Schedule);
 
+/* a round of the schedule of a persistent operation */
+struct NBC_Persistent_round {
+    long row_offset;  /* offset of the round in the schedule */
+    int first;        /* first request of the round in persistent_reqs */
+    int count;        /* number of sends and receives of the round */
+    bool comm_only;   /* no local operation in the round */
+};
+typedef struct NBC_Persistent_round NBC_Persistent_round;
+
 struct ompi_coll_libnbc_request_t {
     ompi_coll_base_nbc_request_t super;
     MPI_Comm comm;
@@ -130,6 +129,12 @@ struct ompi_coll_libnbc_request_t {
     NBC_Comminfo *comminfo;
     NBC_Schedule *schedule;
     void *tmpbuf; /* temporary buffer e.g. used for Reduce */
+    /* persistent operations: the pml requests of all rounds are created
+     * once and restarted by every MPI_Start */
+    ompi_request_t **persistent_reqs;
+    NBC_Persistent_round *persistent_rounds;
+    int persistent_num_rounds;
+    int persistent_round;
     /* TODO: we should make a handle pointer to a state later (that the user
      * can move request handles) */
 };
@@ -34,6 +34,7 @@
 #include "mpi.h"
 #include "ompi/mca/coll/coll.h"
 #include "ompi/communicator/communicator.h"
+#include "opal/mca/base/mca_base_pvar.h"
 
 /*
  * Public string showing the coll ompi_libnbc component version number
@@ -92,6 +93,8 @@ static mca_base_var_enum_value_t ireduce_algorithms[] = {
     {0, NULL}
 };
 
+int libnbc_schedule_cache_size = 0;            /* schedules cached per communicator */
+
 int libnbc_iscan_algorithm = 0;             /* iscan user forced algorithm */
 static mca_base_var_enum_value_t iscan_algorithms[] = {
     {0, "ignore"},
@@ -159,6 +162,9 @@ libnbc_open(void)
        a non-blocking collective started */
     mca_coll_libnbc_component.active_comms = 0;
 
+    mca_coll_libnbc_component.sched_cache_hits = 0;
+    mca_coll_libnbc_component.sched_cache_misses = 0;
+
     return OMPI_SUCCESS;
 }
 
@@ -280,6 +286,32 @@ libnbc_register(void)
                                     &libnbc_iscan_algorithm);
     OBJ_RELEASE(new_enum);
 
+    libnbc_schedule_cache_size = 0;
+    (void) mca_base_component_var_register(&mca_coll_libnbc_component.super.collm_version,
+                                           "schedule_cache_size",
+                                           "Number of schedules kept per communicator for reuse by later collective operations with the same arguments, the least recently used ones are dropped first. A cached schedule keeps its temporary buffers, which can be as large as the message (default: 0, the cache is disabled)",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_6,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &libnbc_schedule_cache_size);
+
+    (void) mca_base_component_pvar_register(&mca_coll_libnbc_component.super.collm_version,
+                                            "schedule_cache_hits",
+                                            "Number of collective operations that reused a cached schedule",
+                                            OPAL_INFO_LVL_4, MCA_BASE_PVAR_CLASS_COUNTER,
+                                            MCA_BASE_VAR_TYPE_SIZE_T, NULL, MCA_BASE_VAR_BIND_NO_OBJECT,
+                                            MCA_BASE_PVAR_FLAG_READONLY | MCA_BASE_PVAR_FLAG_CONTINUOUS,
+                                            NULL, NULL, NULL,
+                                            (void *) &mca_coll_libnbc_component.sched_cache_hits);
+    (void) mca_base_component_pvar_register(&mca_coll_libnbc_component.super.collm_version,
+                                            "schedule_cache_misses",
+                                            "Number of collective operations that looked up the schedule cache and had to build their schedule",
+                                            OPAL_INFO_LVL_4, MCA_BASE_PVAR_CLASS_COUNTER,
+                                            MCA_BASE_VAR_TYPE_SIZE_T, NULL, MCA_BASE_VAR_BIND_NO_OBJECT,
+                                            MCA_BASE_PVAR_FLAG_READONLY | MCA_BASE_PVAR_FLAG_CONTINUOUS,
+                                            NULL, NULL, NULL,
+                                            (void *) &mca_coll_libnbc_component.sched_cache_misses);
+
     return OMPI_SUCCESS;
 }
 
@@ -480,6 +512,8 @@ libnbc_module_construct(ompi_coll_libnbc_module_t *module)
 {
     OBJ_CONSTRUCT(&module->mutex, opal_mutex_t);
     module->comm_registered = false;
+    OBJ_CONSTRUCT(&module->sched_cache, opal_hash_table_t);
+    OBJ_CONSTRUCT(&module->sched_cache_lru, opal_list_t);
 }
 
 
@@ -488,6 +522,10 @@ libnbc_module_destruct(ompi_coll_libnbc_module_t *module)
 {
     OBJ_DESTRUCT(&module->mutex);
 
+    /* the active operations hold their own reference to the schedule */
+    OPAL_LIST_DESTRUCT(&module->sched_cache_lru);
+    OBJ_DESTRUCT(&module->sched_cache);
+
     /* if we ever were used for a collective op, do the progress cleanup. */
     if (true == module->comm_registered) {
         int32_t tmp =
@@ -529,6 +567,8 @@ request_start(size_t count, ompi_request_t ** requests)
 
         handle->super.super.req_complete = REQUEST_PENDING;
         handle->nbc_complete = false;
+        handle->row_offset = 0;
+        handle->persistent_round = 0;
 
         res = NBC_Start(handle);
         if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
@@ -561,7 +601,8 @@ request_free(struct ompi_request_t **ompi_req)
         return MPI_ERR_REQUEST;
     }
 
-    OMPI_COLL_LIBNBC_REQUEST_RETURN(request);
+    /* persistent requests still hold their schedule and pml requests */
+    NBC_Return_handle(request);
     *ompi_req = MPI_REQUEST_NULL;
 
     return OMPI_SUCCESS;
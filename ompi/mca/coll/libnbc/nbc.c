@@ -51,11 +51,14 @@ static void nbc_schedule_constructor (NBC_Schedule *schedule) {
   schedule->size = sizeof (int);
   schedule->current_round_offset = 0;
   schedule->data = calloc (1, schedule->size);
+  schedule->tmpbuf = NULL;
 }
 
 static void nbc_schedule_destructor (NBC_Schedule *schedule) {
   free (schedule->data);
   schedule->data = NULL;
+  free (schedule->tmpbuf);
+  schedule->tmpbuf = NULL;
 }
 
 OBJ_CLASS_INSTANCE(NBC_Schedule, opal_object_t, nbc_schedule_constructor,
@@ -299,19 +302,131 @@ int NBC_Sched_commit(NBC_Schedule *schedule) {
  * to be called *only* from the progress thread !!! */
 static inline void NBC_Free (NBC_Handle* handle) {
 
+  /* if the nbc_I<collective> attached some data, the temporary buffer
+   * of a cached schedule stays with the schedule */
+  if (NULL != handle->tmpbuf) {
+    if (NULL == handle->schedule || handle->tmpbuf != handle->schedule->tmpbuf) {
+      free((void*)handle->tmpbuf);
+    }
+    handle->tmpbuf = NULL;
+  }
+
   if (NULL != handle->schedule) {
     /* release schedule */
     OBJ_RELEASE (handle->schedule);
     handle->schedule = NULL;
   }
 
-  /* if the nbc_I<collective> attached some data */
-  /* problems with schedule cache here, see comment (TODO) in
-   * nbc_internal.h */
-  if (NULL != handle->tmpbuf) {
-    free((void*)handle->tmpbuf);
-    handle->tmpbuf = NULL;
+  if (NULL != handle->persistent_rounds) {
+    NBC_Persistent_round *last = handle->persistent_rounds + handle->persistent_num_rounds - 1;
+    for (int i = 0 ; i < last->first + last->count ; ++i) {
+      ompi_request_free (handle->persistent_reqs + i);
+    }
+    free (handle->persistent_reqs);
+    free (handle->persistent_rounds);
+    handle->persistent_reqs = NULL;
+    handle->persistent_rounds = NULL;
+    handle->persistent_num_rounds = 0;
+  }
+}
+
+/* walks the schedule of a persistent operation once and creates the pml
+ * requests of all its rounds, NBC_Start_round only has to restart them */
+static int nbc_persistent_init (NBC_Handle *handle) {
+  char *ptr, *data = handle->schedule->data;
+  NBC_Persistent_round *round;
+  NBC_Args_send sendargs;
+  NBC_Args_recv recvargs;
+  NBC_Fn_type type;
+  int num, num_rounds, num_reqs, res = OMPI_SUCCESS;
+  void *buf;
+
+  /* the first pass counts the rounds and requests, the second one creates them */
+  for (int pass = 0 ; pass < 2 ; ++pass) {
+    ptr = data;
+    num_rounds = 0;
+    num_reqs = 0;
+    do {
+      round = pass ? handle->persistent_rounds + num_rounds : NULL;
+      if (NULL != round) {
+        round->row_offset = (long) (ptr - data);
+        round->first = num_reqs;
+        round->comm_only = true;
+      }
+
+      NBC_GET_BYTES(ptr,num);
+      for (int i = 0 ; i < num ; ++i) {
+        memcpy (&type, ptr, sizeof (type));
+        switch(type) {
+          case SEND:
+            NBC_GET_BYTES(ptr,sendargs);
+            if (NULL != round) {
+              buf = sendargs.tmpbuf ? (char *) handle->tmpbuf + (long) sendargs.buf : (void *) sendargs.buf;
+              res = MCA_PML_CALL(isend_init(buf, sendargs.count, sendargs.datatype, sendargs.dest, handle->tag,
+                                            MCA_PML_BASE_SEND_STANDARD,
+                                            sendargs.local ? handle->comm->c_local_comm : handle->comm,
+                                            handle->persistent_reqs + num_reqs));
+            }
+            num_reqs += (OMPI_SUCCESS == res);
+            break;
+          case RECV:
+            NBC_GET_BYTES(ptr,recvargs);
+            if (NULL != round) {
+              buf = recvargs.tmpbuf ? (char *) handle->tmpbuf + (long) recvargs.buf : recvargs.buf;
+              res = MCA_PML_CALL(irecv_init(buf, recvargs.count, recvargs.datatype, recvargs.source, handle->tag,
+                                            recvargs.local ? handle->comm->c_local_comm : handle->comm,
+                                            handle->persistent_reqs + num_reqs));
+            }
+            num_reqs += (OMPI_SUCCESS == res);
+            break;
+          case OP:
+            ptr += sizeof (NBC_Args_op);
+            break;
+          case COPY:
+            ptr += sizeof (NBC_Args_copy);
+            break;
+          case UNPACK:
+            ptr += sizeof (NBC_Args_unpack);
+            break;
+          default:
+            NBC_Error ("nbc_persistent_init: bad type %li at offset %li", (long)type, (long) (ptr - data));
+            res = OMPI_ERROR;
+        }
+        if (NULL != round && (SEND != type && RECV != type)) {
+          round->comm_only = false;
+        }
+        if (OMPI_SUCCESS != res) {
+          /* the requests created so far are released by NBC_Free */
+          if (NULL != round) {
+            round->count = num_reqs - round->first;
+            handle->persistent_num_rounds = num_rounds + 1;
+          }
+          return res;
+        }
+      }
+
+      if (NULL != round) {
+        round->count = num_reqs - round->first;
+      }
+      num_rounds++;
+      /* skip the delimiter, 0 ends the schedule */
+    } while (0 != *ptr++);
+
+    if (0 == pass) {
+      handle->persistent_rounds = (NBC_Persistent_round *) malloc (num_rounds * sizeof (NBC_Persistent_round));
+      handle->persistent_reqs = (ompi_request_t **) malloc ((num_reqs ? num_reqs : 1) * sizeof (ompi_request_t *));
+      if (NULL == handle->persistent_rounds || NULL == handle->persistent_reqs) {
+        free (handle->persistent_rounds);
+        free (handle->persistent_reqs);
+        handle->persistent_rounds = NULL;
+        handle->persistent_reqs = NULL;
+        return OMPI_ERR_OUT_OF_RESOURCE;
+      }
+    }
   }
+
+  handle->persistent_num_rounds = num_rounds;
+  return OMPI_SUCCESS;
 }
 
 /* progresses a request
@@ -319,7 +434,7 @@ static inline void NBC_Free (NBC_Handle* handle) {
  * to be called *only* from the progress thread !!! */
 int NBC_Progress(NBC_Handle *handle) {
   int res, ret=NBC_CONTINUE;
-  bool flag;
+  bool flag, last_round;
   unsigned long size = 0;
   char *delim;
 
@@ -357,7 +472,9 @@ int NBC_Progress(NBC_Handle *handle) {
                 handle->super.super.req_status.MPI_ERROR = subreq->req_status.MPI_ERROR;
             }
             handle->req_count--;
-            ompi_request_free(&subreq);
+            if (NULL == handle->persistent_reqs) {
+                ompi_request_free(&subreq);
+            }
         } else {
             flag = false;
             break;
@@ -372,8 +489,10 @@ int NBC_Progress(NBC_Handle *handle) {
   if (flag) {
     /* reset handle for next round */
     if (NULL != handle->req_array) {
-      /* free request array */
-      free (handle->req_array);
+      /* free request array, the requests of persistent operations are kept */
+      if (NULL == handle->persistent_reqs) {
+        free (handle->req_array);
+      }
       handle->req_array = NULL;
     }
 
@@ -390,16 +509,22 @@ int NBC_Progress(NBC_Handle *handle) {
       return res;
     }
 
-    /* adjust delim to start of current round */
-    NBC_DEBUG(5, "NBC_Progress: going in schedule %p to row-offset: %li\n", handle->schedule, handle->row_offset);
-    delim = handle->schedule->data + handle->row_offset;
-    NBC_DEBUG(10, "delim: %p\n", delim);
-    nbc_get_round_size(delim, &size);
-    NBC_DEBUG(10, "size: %li\n", size);
-    /* adjust delim to end of current round -> delimiter */
-    delim = delim + size;
+    if (NULL != handle->persistent_rounds) {
+      /* the rounds are known already, no need to walk the schedule */
+      last_round = ++handle->persistent_round == handle->persistent_num_rounds;
+    } else {
+      /* adjust delim to start of current round */
+      NBC_DEBUG(5, "NBC_Progress: going in schedule %p to row-offset: %li\n", handle->schedule, handle->row_offset);
+      delim = handle->schedule->data + handle->row_offset;
+      NBC_DEBUG(10, "delim: %p\n", delim);
+      nbc_get_round_size(delim, &size);
+      NBC_DEBUG(10, "size: %li\n", size);
+      /* adjust delim to end of current round -> delimiter */
+      delim = delim + size;
+      last_round = *delim == 0;
+    }
 
-    if (*delim == 0) {
+    if (last_round) {
       /* this was the last round - we're done */
       NBC_DEBUG(5, "NBC_Progress last round finished - we're done\n");
 
@@ -414,7 +539,11 @@ int NBC_Progress(NBC_Handle *handle) {
     NBC_DEBUG(5, "NBC_Progress round finished - goto next round\n");
     /* move delim to start of next round */
     /* initializing handle for new virgin round */
-    handle->row_offset = (intptr_t) (delim + 1) - (intptr_t) handle->schedule->data;
+    if (NULL != handle->persistent_rounds) {
+      handle->row_offset = handle->persistent_rounds[handle->persistent_round].row_offset;
+    } else {
+      handle->row_offset = (intptr_t) (delim + 1) - (intptr_t) handle->schedule->data;
+    }
     /* kick it off */
     res = NBC_Start_round(handle);
     if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
@@ -445,6 +574,25 @@ static inline int NBC_Start_round(NBC_Handle *handle) {
   NBC_GET_BYTES(ptr,num);
   NBC_DEBUG(10, "start_round round at offset %d : posting %i operations\n", handle->row_offset, num);
 
+  if (NULL != handle->persistent_rounds) {
+    NBC_Persistent_round *round = handle->persistent_rounds + handle->persistent_round;
+
+    handle->req_array = handle->persistent_reqs + round->first;
+    handle->req_count = 0;
+    if (round->comm_only) {
+      /* nothing to execute locally, restart all requests of the round at once */
+      if (round->count > 0) {
+        res = MCA_PML_CALL(start(round->count, handle->req_array));
+        if (OMPI_SUCCESS != res) {
+          NBC_Error ("Error in MCA_PML_CALL(start) (%i)", res);
+          return res;
+        }
+        handle->req_count = round->count;
+      }
+      num = 0;
+    }
+  }
+
   for (int i = 0 ; i < num ; ++i) {
     int offset = (intptr_t)(ptr - handle->schedule->data);
 
@@ -457,6 +605,14 @@ static inline int NBC_Start_round(NBC_Handle *handle) {
                   sendargs.count, sendargs.datatype, sendargs.dest, handle->tag);
         /* get an additional request */
         handle->req_count++;
+        if (NULL != handle->persistent_reqs) {
+          res = MCA_PML_CALL(start(1, handle->req_array + handle->req_count - 1));
+          if (OMPI_SUCCESS != res) {
+            NBC_Error ("Error in MCA_PML_CALL(start) (%i)", res);
+            return res;
+          }
+          break;
+        }
         /* get buffer */
         if(sendargs.tmpbuf) {
           buf1=(char*)handle->tmpbuf+(long)sendargs.buf;
@@ -492,6 +648,14 @@ static inline int NBC_Start_round(NBC_Handle *handle) {
                   recvargs.datatype, recvargs.source, handle->tag);
         /* get an additional request - TODO: req_count NOT thread safe */
         handle->req_count++;
+        if (NULL != handle->persistent_reqs) {
+          res = MCA_PML_CALL(start(1, handle->req_array + handle->req_count - 1));
+          if (OMPI_SUCCESS != res) {
+            NBC_Error ("Error in MCA_PML_CALL(start) (%i)", res);
+            return res;
+          }
+          break;
+        }
         /* get buffer */
         if(recvargs.tmpbuf) {
           buf1=(char*)handle->tmpbuf+(long)recvargs.buf;
@@ -612,51 +776,9 @@ void NBC_Return_handle(ompi_coll_libnbc_request_t *request) {
 
 int  NBC_Init_comm(MPI_Comm comm, NBC_Comminfo *comminfo) {
 
-#ifdef NBC_CACHE_SCHEDULE
-  /* initialize the NBC_ALLTOALL SchedCache tree */
-  comminfo->NBC_Dict[NBC_ALLTOALL] = hb_tree_new((dict_cmp_func)NBC_Alltoall_args_compare, NBC_SchedCache_args_delete_key_dummy, NBC_SchedCache_args_delete);
-  if(comminfo->NBC_Dict[NBC_ALLTOALL] == NULL) { printf("Error in hb_tree_new()\n"); return OMPI_ERROR;; }
-  NBC_DEBUG(1, "added tree at address %lu\n", (unsigned long)comminfo->NBC_Dict[NBC_ALLTOALL]);
-  comminfo->NBC_Dict_size[NBC_ALLTOALL] = 0;
-  /* initialize the NBC_ALLGATHER SchedCache tree */
-  comminfo->NBC_Dict[NBC_ALLGATHER] = hb_tree_new((dict_cmp_func)NBC_Allgather_args_compare, NBC_SchedCache_args_delete_key_dummy, NBC_SchedCache_args_delete);
-  if(comminfo->NBC_Dict[NBC_ALLGATHER] == NULL) { printf("Error in hb_tree_new()\n"); return OMPI_ERROR;; }
-  NBC_DEBUG(1, "added tree at address %lu\n", (unsigned long)comminfo->NBC_Dict[NBC_ALLGATHER]);
-  comminfo->NBC_Dict_size[NBC_ALLGATHER] = 0;
-  /* initialize the NBC_ALLREDUCE SchedCache tree */
-  comminfo->NBC_Dict[NBC_ALLREDUCE] = hb_tree_new((dict_cmp_func)NBC_Allreduce_args_compare, NBC_SchedCache_args_delete_key_dummy, NBC_SchedCache_args_delete);
-  if(comminfo->NBC_Dict[NBC_ALLREDUCE] == NULL) { printf("Error in hb_tree_new()\n"); return OMPI_ERROR;; }
-  NBC_DEBUG(1, "added tree at address %lu\n", (unsigned long)comminfo->NBC_Dict[NBC_ALLREDUCE]);
-  comminfo->NBC_Dict_size[NBC_ALLREDUCE] = 0;
-  /* initialize the NBC_BARRIER SchedCache tree - is not needed -
-   * schedule is hung off directly */
-  comminfo->NBC_Dict_size[NBC_BARRIER] = 0;
-  /* initialize the NBC_BCAST SchedCache tree */
-  comminfo->NBC_Dict[NBC_BCAST] = hb_tree_new((dict_cmp_func)NBC_Bcast_args_compare, NBC_SchedCache_args_delete_key_dummy, NBC_SchedCache_args_delete);
-  if(comminfo->NBC_Dict[NBC_BCAST] == NULL) { printf("Error in hb_tree_new()\n"); return OMPI_ERROR;; }
-  NBC_DEBUG(1, "added tree at address %lu\n", (unsigned long)comminfo->NBC_Dict[NBC_BCAST]);
-  comminfo->NBC_Dict_size[NBC_BCAST] = 0;
-  /* initialize the NBC_GATHER SchedCache tree */
-  comminfo->NBC_Dict[NBC_GATHER] = hb_tree_new((dict_cmp_func)NBC_Gather_args_compare, NBC_SchedCache_args_delete_key_dummy, NBC_SchedCache_args_delete);
-  if(comminfo->NBC_Dict[NBC_GATHER] == NULL) { printf("Error in hb_tree_new()\n"); return OMPI_ERROR;; }
-  NBC_DEBUG(1, "added tree at address %lu\n", (unsigned long)comminfo->NBC_Dict[NBC_GATHER]);
-  comminfo->NBC_Dict_size[NBC_GATHER] = 0;
-  /* initialize the NBC_REDUCE SchedCache tree */
-  comminfo->NBC_Dict[NBC_REDUCE] = hb_tree_new((dict_cmp_func)NBC_Reduce_args_compare, NBC_SchedCache_args_delete_key_dummy, NBC_SchedCache_args_delete);
-  if(comminfo->NBC_Dict[NBC_REDUCE] == NULL) { printf("Error in hb_tree_new()\n"); return OMPI_ERROR;; }
-  NBC_DEBUG(1, "added tree at address %lu\n", (unsigned long)comminfo->NBC_Dict[NBC_REDUCE]);
-  comminfo->NBC_Dict_size[NBC_REDUCE] = 0;
-  /* initialize the NBC_SCAN SchedCache tree */
-  comminfo->NBC_Dict[NBC_SCAN] = hb_tree_new((dict_cmp_func)NBC_Scan_args_compare, NBC_SchedCache_args_delete_key_dummy, NBC_SchedCache_args_delete);
-  if(comminfo->NBC_Dict[NBC_SCAN] == NULL) { printf("Error in hb_tree_new()\n"); return OMPI_ERROR;; }
-  NBC_DEBUG(1, "added tree at address %lu\n", (unsigned long)comminfo->NBC_Dict[NBC_SCAN]);
-  comminfo->NBC_Dict_size[NBC_SCAN] = 0;
-  /* initialize the NBC_SCATTER SchedCache tree */
-  comminfo->NBC_Dict[NBC_SCATTER] = hb_tree_new((dict_cmp_func)NBC_Scatter_args_compare, NBC_SchedCache_args_delete_key_dummy, NBC_SchedCache_args_delete);
-  if(comminfo->NBC_Dict[NBC_SCATTER] == NULL) { printf("Error in hb_tree_new()\n"); return OMPI_ERROR;; }
-  NBC_DEBUG(1, "added tree at address %lu\n", (unsigned long)comminfo->NBC_Dict[NBC_SCATTER]);
-  comminfo->NBC_Dict_size[NBC_SCATTER] = 0;
-#endif
+  if (0 < libnbc_schedule_cache_size) {
+    return opal_hash_table_init (&comminfo->sched_cache, libnbc_schedule_cache_size);
+  }
 
   return OMPI_SUCCESS;
 }
@@ -718,6 +840,10 @@ int NBC_Schedule_request(NBC_Schedule *schedule, ompi_communicator_t *comm,
   handle->schedule = NULL;
   handle->row_offset = 0;
   handle->nbc_complete = persistent ? true : false;
+  handle->persistent_reqs = NULL;
+  handle->persistent_rounds = NULL;
+  handle->persistent_num_rounds = 0;
+  handle->persistent_round = 0;
 
   /******************** Do the tag and shadow comm administration ...  ***************/
 
@@ -747,22 +873,146 @@ int NBC_Schedule_request(NBC_Schedule *schedule, ompi_communicator_t *comm,
 
   NBC_DEBUG(3, "got tag %i\n", handle->tag);
 
-  handle->tmpbuf = tmpbuf;
+  /* a schedule out of the cache comes with its own temporary buffer */
+  handle->tmpbuf = (NULL != tmpbuf) ? tmpbuf : schedule->tmpbuf;
   handle->schedule = schedule;
+
+  if (persistent) {
+    ret = nbc_persistent_init (handle);
+    if (OMPI_SUCCESS != ret) {
+      /* the caller releases the schedule and the temporary buffer */
+      handle->schedule = NULL;
+      handle->tmpbuf = NULL;
+      NBC_Return_handle (handle);
+      return ret;
+    }
+  }
+
   *request = (ompi_request_t *) handle;
 
   return OMPI_SUCCESS;
 }
 
-#ifdef NBC_CACHE_SCHEDULE
-void NBC_SchedCache_args_delete_key_dummy(void *k) {
-    /* do nothing because the key and the data element are identical :-)
-     * both (the single one :) is freed in NBC_<COLLOP>_args_delete() */
+/* an entry of the schedule cache of a communicator */
+typedef struct {
+  opal_list_item_t super;
+  NBC_Sched_key key;
+  NBC_Schedule *schedule;
+} NBC_Sched_cache_entry;
+
+static void nbc_sched_cache_entry_constructor (NBC_Sched_cache_entry *entry) {
+  entry->schedule = NULL;
 }
 
-void NBC_SchedCache_args_delete(void *entry) {
-  struct NBC_dummyarg *tmp = (struct NBC_dummyarg*)entry;
-  OBJ_RELEASE(tmp->schedule);
-  free(entry);
+static void nbc_sched_cache_entry_destructor (NBC_Sched_cache_entry *entry) {
+  if (NULL != entry->schedule) {
+    OBJ_RELEASE(entry->schedule);
+  }
+}
+
+static OBJ_CLASS_INSTANCE(NBC_Sched_cache_entry, opal_list_item_t,
+                          nbc_sched_cache_entry_constructor,
+                          nbc_sched_cache_entry_destructor);
+
+void NBC_Sched_key_init (NBC_Sched_key *key, int coll, int alg, int root,
+                         const void *sendbuf, size_t sendcount, MPI_Datatype sendtype,
+                         void *recvbuf, size_t recvcount, MPI_Datatype recvtype, MPI_Op op) {
+  /* the key is hashed and compared as a whole, including the padding */
+  memset (key, 0, sizeof (*key));
+  key->coll = coll;
+  key->alg = alg;
+  key->root = root;
+  key->sendbuf = sendbuf;
+  key->sendcount = sendcount;
+  key->sendtype = sendtype;
+  key->recvbuf = recvbuf;
+  key->recvcount = recvcount;
+  key->recvtype = recvtype;
+  key->op = op;
+}
+
+/* A derived datatype or user defined operation may be freed and its
+ * handle reused for a different one, so only schedules of predefined
+ * ones are cached. */
+static inline bool nbc_sched_cacheable (const NBC_Sched_key *key) {
+  if (0 >= libnbc_schedule_cache_size) {
+    return false;
+  }
+  if (NULL != key->sendtype && !ompi_datatype_is_predefined (key->sendtype)) {
+    return false;
+  }
+  if (NULL != key->recvtype && !ompi_datatype_is_predefined (key->recvtype)) {
+    return false;
+  }
+  return NULL == key->op || ompi_op_is_intrinsic (key->op);
+}
+
+/* Returns the cached schedule for key with a reference for the caller,
+ * or NULL if the schedule has to be built. */
+NBC_Schedule *NBC_Sched_cache_lookup (ompi_coll_libnbc_module_t *module, const NBC_Sched_key *key) {
+  NBC_Sched_cache_entry *entry;
+  int ret;
+
+  if (!nbc_sched_cacheable (key)) {
+    return NULL;
+  }
+
+  ret = opal_hash_table_get_value_ptr (&module->sched_cache, key, sizeof (*key), (void **) &entry);
+  if (OPAL_SUCCESS != ret ||
+      /* the temporary buffer is still in use by an earlier operation */
+      (NULL != entry->schedule->tmpbuf && 1 < entry->schedule->super.obj_reference_count)) {
+    (void) OPAL_THREAD_ADD_FETCH_SIZE_T(&mca_coll_libnbc_component.sched_cache_misses, 1);
+    return NULL;
+  }
+
+  /* move the entry to the front of the lru list */
+  opal_list_remove_item (&module->sched_cache_lru, &entry->super);
+  opal_list_prepend (&module->sched_cache_lru, &entry->super);
+  (void) OPAL_THREAD_ADD_FETCH_SIZE_T(&mca_coll_libnbc_component.sched_cache_hits, 1);
+
+  OBJ_RETAIN(entry->schedule);
+  return entry->schedule;
+}
+
+/* Adds a newly built schedule to the cache. The cached schedule takes
+ * over the temporary buffer if there is one, *tmpbuf is set to NULL in
+ * that case. */
+void NBC_Sched_cache_insert (ompi_coll_libnbc_module_t *module, const NBC_Sched_key *key,
+                             NBC_Schedule *schedule, void **tmpbuf) {
+  NBC_Sched_cache_entry *entry;
+  int ret;
+
+  if (!nbc_sched_cacheable (key) ||
+      OPAL_SUCCESS == opal_hash_table_get_value_ptr (&module->sched_cache, key, sizeof (*key),
+                                                     (void **) &entry)) {
+    /* the cached schedule with the same key is in use */
+    return;
+  }
+
+  if (opal_list_get_size (&module->sched_cache_lru) >= (size_t) libnbc_schedule_cache_size) {
+    /* drop the least recently used schedule */
+    entry = (NBC_Sched_cache_entry *) opal_list_remove_last (&module->sched_cache_lru);
+    (void) opal_hash_table_remove_value_ptr (&module->sched_cache, &entry->key, sizeof (entry->key));
+    OBJ_RELEASE(entry);
+  }
+
+  entry = OBJ_NEW(NBC_Sched_cache_entry);
+  if (NULL == entry) {
+    return;
+  }
+  entry->key = *key;
+
+  ret = opal_hash_table_set_value_ptr (&module->sched_cache, &entry->key, sizeof (entry->key), entry);
+  if (OPAL_SUCCESS != ret) {
+    OBJ_RELEASE(entry);
+    return;
+  }
+  opal_list_prepend (&module->sched_cache_lru, &entry->super);
+
+  OBJ_RETAIN(schedule);
+  entry->schedule = schedule;
+  if (NULL != tmpbuf) {
+    schedule->tmpbuf = *tmpbuf;
+    *tmpbuf = NULL;
+  }
 }
-#endif
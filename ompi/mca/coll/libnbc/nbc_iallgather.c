@@ -29,26 +29,6 @@ static inline int allgather_sched_recursivedoubling(
     int scount, struct ompi_datatype_t *sdtype, void *rbuf, int rcount,
     struct ompi_datatype_t *rdtype);
 
-#ifdef NBC_CACHE_SCHEDULE
-/* tree comparison function for schedule cache */
-int NBC_Allgather_args_compare(NBC_Allgather_args *a, NBC_Allgather_args *b, void *param) {
-  if ((a->sendbuf == b->sendbuf) &&
-      (a->sendcount == b->sendcount) &&
-      (a->sendtype == b->sendtype) &&
-      (a->recvbuf == b->recvbuf) &&
-      (a->recvcount == b->recvcount) &&
-      (a->recvtype == b->recvtype) ) {
-    return 0;
-  }
-
-  if( a->sendbuf < b->sendbuf ) {
-    return -1;
-  }
-
-  return 1;
-}
-#endif
-
 static int nbc_allgather_init(const void* sendbuf, int sendcount, MPI_Datatype sendtype, void* recvbuf, int recvcount,
                               MPI_Datatype recvtype, struct ompi_communicator_t *comm, ompi_request_t ** request,
                               mca_coll_base_module_t *module, bool persistent)
@@ -57,9 +37,7 @@ static int nbc_allgather_init(const void* sendbuf, int sendcount, MPI_Datatype s
   MPI_Aint rcvext;
   NBC_Schedule *schedule;
   char *rbuf, inplace;
-#ifdef NBC_CACHE_SCHEDULE
-  NBC_Allgather_args *args, *found, search;
-#endif
+  NBC_Sched_key key;
   enum { NBC_ALLGATHER_LINEAR, NBC_ALLGATHER_RDBL} alg;
   ompi_coll_libnbc_module_t *libnbc_module = (ompi_coll_libnbc_module_t*) module;
 
@@ -102,17 +80,12 @@ static int nbc_allgather_init(const void* sendbuf, int sendcount, MPI_Datatype s
     return nbc_get_noop_request(persistent, request);
   }
 
-#ifdef NBC_CACHE_SCHEDULE
-  /* search schedule in communicator specific tree */
-  search.sendbuf = sendbuf;
-  search.sendcount = sendcount;
-  search.sendtype = sendtype;
-  search.recvbuf = recvbuf;
-  search.recvcount = recvcount;
-  search.recvtype = recvtype;
-  found = (NBC_Allgather_args *) hb_tree_search ((hb_tree*)libnbc_module->NBC_Dict[NBC_ALLGATHER], &search);
-  if (NULL == found) {
-#endif
+  /* search schedule in communicator specific cache, only the schedule
+   * of a persistent operation copies the own data */
+  NBC_Sched_key_init (&key, NBC_ALLGATHER, 2 * alg + persistent, -1, sendbuf, sendcount, sendtype,
+                      recvbuf, recvcount, recvtype, NULL);
+  schedule = NBC_Sched_cache_lookup (libnbc_module, &key);
+  if (NULL == schedule) {
     schedule = OBJ_NEW(NBC_Schedule);
     if (OPAL_UNLIKELY(NULL == schedule)) {
       return OMPI_ERR_OUT_OF_RESOURCE;
@@ -152,34 +125,8 @@ static int nbc_allgather_init(const void* sendbuf, int sendcount, MPI_Datatype s
       return res;
     }
 
-#ifdef NBC_CACHE_SCHEDULE
-    /* save schedule to tree */
-    args = (NBC_Allgather_args *) malloc (sizeof (args));
-    args->sendbuf = sendbuf;
-    args->sendcount = sendcount;
-    args->sendtype = sendtype;
-    args->recvbuf = recvbuf;
-    args->recvcount = recvcount;
-    args->recvtype = recvtype;
-    args->schedule = schedule;
-
-    res = hb_tree_insert ((hb_tree *) libnbc_module->NBC_Dict[NBC_ALLGATHER], args, args, 0);
-    if (res != 0) {
-      free (args);
-    } else {
-      OBJ_RETAIN(schedule);
-    }
-
-    /* increase number of elements for A2A */
-    if (++libnbc_module->NBC_Dict_size[NBC_ALLGATHER] > NBC_SCHED_DICT_UPPER) {
-      NBC_SchedCache_dictwipe ((hb_tree *) libnbc_module->NBC_Dict[NBC_ALLGATHER], &libnbc_module->NBC_Dict_size[NBC_ALLGATHER]);
-    }
-  } else {
-    /* found schedule */
-    schedule = found->schedule;
-    OBJ_RETAIN(schedule);
+    NBC_Sched_cache_insert (libnbc_module, &key, schedule, NULL);
   }
-#endif
 
   res = NBC_Schedule_request(schedule, comm, libnbc_module, persistent, request, NULL);
   if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
@@ -42,25 +42,6 @@ static inline int allred_sched_redscat_allgather(
     const void *sbuf, void *rbuf, MPI_Op op, char inplace,
     NBC_Schedule *schedule, void *tmpbuf, struct ompi_communicator_t *comm);
 
-#ifdef NBC_CACHE_SCHEDULE
-/* tree comparison function for schedule cache */
-int NBC_Allreduce_args_compare(NBC_Allreduce_args *a, NBC_Allreduce_args *b, void *param) {
-  if ((a->sendbuf == b->sendbuf) &&
-      (a->recvbuf == b->recvbuf) &&
-      (a->count == b->count) &&
-      (a->datatype == b->datatype) &&
-      (a->op == b->op)) {
-    return 0;
-  }
-
-  if( a->sendbuf < b->sendbuf ) {
-    return -1;
-  }
-
-  return 1;
-}
-#endif
-
 static int nbc_allreduce_init(const void* sendbuf, void* recvbuf, int count, MPI_Datatype datatype, MPI_Op op,
                               struct ompi_communicator_t *comm, ompi_request_t ** request,
                               mca_coll_base_module_t *module, bool persistent)
@@ -69,9 +50,7 @@ static int nbc_allreduce_init(const void* sendbuf, void* recvbuf, int count, MPI
   ptrdiff_t ext, lb;
   NBC_Schedule *schedule;
   size_t size;
-#ifdef NBC_CACHE_SCHEDULE
-  NBC_Allreduce_args *args, *found, search;
-#endif
+  NBC_Sched_key key;
   enum { NBC_ARED_BINOMIAL, NBC_ARED_RING, NBC_ARED_REDSCAT_ALLGATHER, NBC_ARED_RDBL } alg;
   char inplace;
   void *tmpbuf = NULL;
@@ -106,12 +85,6 @@ static int nbc_allreduce_init(const void* sendbuf, void* recvbuf, int count, MPI
     return nbc_get_noop_request(persistent, request);
   }
 
-  span = opal_datatype_span(&datatype->super, count, &gap);
-  tmpbuf = malloc (span);
-  if (OPAL_UNLIKELY(NULL == tmpbuf)) {
-    return OMPI_ERR_OUT_OF_RESOURCE;
-  }
-
   alg = NBC_ARED_RING;  /* default generic selection */
   /* algorithm selection */
   int nprocs_pof2 = opal_next_poweroftwo(p) >> 1;
@@ -131,16 +104,17 @@ static int nbc_allreduce_init(const void* sendbuf, void* recvbuf, int count, MPI
     else if (libnbc_iallreduce_algorithm == 4)
       alg = NBC_ARED_RDBL;
   }
-#ifdef NBC_CACHE_SCHEDULE
-  /* search schedule in communicator specific tree */
-  search.sendbuf = sendbuf;
-  search.recvbuf = recvbuf;
-  search.count = count;
-  search.datatype = datatype;
-  search.op = op;
-  found = (NBC_Allreduce_args *) hb_tree_search ((hb_tree *) libnbc_module->NBC_Dict[NBC_ALLREDUCE], &search);
-  if (NULL == found) {
-#endif
+  /* search schedule in communicator specific cache */
+  NBC_Sched_key_init (&key, NBC_ALLREDUCE, alg, -1, sendbuf, count, datatype,
+                      recvbuf, count, datatype, op);
+  schedule = NBC_Sched_cache_lookup (libnbc_module, &key);
+  if (NULL == schedule) {
+    span = opal_datatype_span(&datatype->super, count, &gap);
+    tmpbuf = malloc (span);
+    if (OPAL_UNLIKELY(NULL == tmpbuf)) {
+      return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+
     schedule = OBJ_NEW(NBC_Schedule);
     if (NULL == schedule) {
       free(tmpbuf);
@@ -180,36 +154,8 @@ static int nbc_allreduce_init(const void* sendbuf, void* recvbuf, int count, MPI
       return res;
     }
 
-#ifdef NBC_CACHE_SCHEDULE
-    /* save schedule to tree */
-    args = (NBC_Allreduce_args *) malloc (sizeof(args));
-    if (NULL != args) {
-      args->sendbuf = sendbuf;
-      args->recvbuf = recvbuf;
-      args->count = count;
-      args->datatype = datatype;
-      args->op = op;
-      args->schedule = schedule;
-      res = hb_tree_insert ((hb_tree *) libnbc_module->NBC_Dict[NBC_ALLREDUCE], args, args, 0);
-      if (0 == res) {
-        OBJ_RETAIN(schedule);
-
-        /* increase number of elements for A2A */
-        if (++libnbc_module->NBC_Dict_size[NBC_ALLREDUCE] > NBC_SCHED_DICT_UPPER) {
-          NBC_SchedCache_dictwipe ((hb_tree *) libnbc_module->NBC_Dict[NBC_ALLREDUCE],
-                                   &libnbc_module->NBC_Dict_size[NBC_ALLREDUCE]);
-        }
-      } else {
-        NBC_Error("error in dict_insert() (%i)", res);
-        free (args);
-      }
-    }
-  } else {
-    /* found schedule */
-    schedule = found->schedule;
-    OBJ_RETAIN(schedule);
+    NBC_Sched_cache_insert (libnbc_module, &key, schedule, &tmpbuf);
   }
-#endif
 
   res = NBC_Schedule_request (schedule, comm, libnbc_module, persistent, request, tmpbuf);
   if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
@@ -33,26 +33,6 @@ static inline int a2a_sched_diss(int rank, int p, MPI_Aint sndext, MPI_Aint rcve
 static inline int a2a_sched_inplace(int rank, int p, NBC_Schedule* schedule, void* buf, int count,
                                    MPI_Datatype type, MPI_Aint ext, ptrdiff_t gap, MPI_Comm comm);
 
-#ifdef NBC_CACHE_SCHEDULE
-/* tree comparison function for schedule cache */
-int NBC_Alltoall_args_compare(NBC_Alltoall_args *a, NBC_Alltoall_args *b, void *param) {
-  if ((a->sendbuf == b->sendbuf) &&
-      (a->sendcount == b->sendcount) &&
-      (a->sendtype == b->sendtype) &&
-      (a->recvbuf == b->recvbuf) &&
-      (a->recvcount == b->recvcount) &&
-      (a->recvtype == b->recvtype)) {
-    return 0;
-  }
-
-  if( a->sendbuf < b->sendbuf ) {
-    return -1;
-  }
-
-  return 1;
-}
-#endif
-
 /* simple linear MPI_Ialltoall the (simple) algorithm just sends to all nodes */
 static int nbc_alltoall_init(const void* sendbuf, int sendcount, MPI_Datatype sendtype, void* recvbuf, int recvcount,
                              MPI_Datatype recvtype, struct ompi_communicator_t *comm, ompi_request_t ** request,
@@ -63,9 +43,7 @@ static int nbc_alltoall_init(const void* sendbuf, int sendcount, MPI_Datatype se
   size_t a2asize, sndsize;
   NBC_Schedule *schedule;
   MPI_Aint rcvext, sndext;
-#ifdef NBC_CACHE_SCHEDULE
-  NBC_Alltoall_args *args, *found, search;
-#endif
+  NBC_Sched_key key;
   char *rbuf, *sbuf, inplace;
   enum {NBC_A2A_LINEAR, NBC_A2A_PAIRWISE, NBC_A2A_DISS, NBC_A2A_INPLACE} alg;
   void *tmpbuf = NULL;
@@ -111,8 +89,14 @@ static int nbc_alltoall_init(const void* sendbuf, int sendcount, MPI_Datatype se
   } else
     alg = NBC_A2A_LINEAR; /*NBC_A2A_PAIRWISE;*/
 
-  /* allocate temp buffer if we need one */
-  if (alg == NBC_A2A_INPLACE) {
+  /* search schedule in communicator specific cache, the dissemination
+   * algorithm fills the temporary buffer before the schedule runs */
+  NBC_Sched_key_init (&key, NBC_ALLTOALL, alg, -1, sendbuf, sendcount, sendtype,
+                      recvbuf, recvcount, recvtype, NULL);
+  schedule = (alg == NBC_A2A_DISS) ? NULL : NBC_Sched_cache_lookup (libnbc_module, &key);
+
+  /* allocate temp buffer if we need one, a cached schedule comes with its own */
+  if (NULL == schedule && alg == NBC_A2A_INPLACE) {
     span = opal_datatype_span(&recvtype->super, recvcount, &gap);
     tmpbuf = malloc(span);
     if (OPAL_UNLIKELY(NULL == tmpbuf)) {
@@ -180,17 +164,7 @@ static int nbc_alltoall_init(const void* sendbuf, int sendcount, MPI_Datatype se
     }
   }
 
-#ifdef NBC_CACHE_SCHEDULE
-  /* search schedule in communicator specific tree */
-  search.sendbuf = sendbuf;
-  search.sendcount = sendcount;
-  search.sendtype = sendtype;
-  search.recvbuf = recvbuf;
-  search.recvcount = recvcount;
-  search.recvtype = recvtype;
-  found = (NBC_Alltoall_args *) hb_tree_search ((hb_tree *) libnbc_module->NBC_Dict[NBC_ALLTOALL], &search);
-  if (NULL == found) {
-#endif
+  if (NULL == schedule) {
     /* not found - generate new schedule */
     schedule = OBJ_NEW(NBC_Schedule);
     if (OPAL_UNLIKELY(NULL == schedule)) {
@@ -239,37 +213,10 @@ static int nbc_alltoall_init(const void* sendbuf, int sendcount, MPI_Datatype se
       return res;
     }
 
-#ifdef NBC_CACHE_SCHEDULE
-    /* save schedule to tree */
-    args = (NBC_Alltoall_args *) malloc (sizeof (args));
-    if (NULL != args) {
-      args->sendbuf = sendbuf;
-      args->sendcount = sendcount;
-      args->sendtype = sendtype;
-      args->recvbuf = recvbuf;
-      args->recvcount = recvcount;
-      args->recvtype = recvtype;
-      args->schedule = schedule;
-      res = hb_tree_insert ((hb_tree *) libnbc_module->NBC_Dict[NBC_ALLTOALL], args, args, 0);
-      if (0 == res) {
-        OBJ_RETAIN(schedule);
-
-        /* increase number of elements for A2A */
-        if (++libnbc_module->NBC_Dict_size[NBC_ALLTOALL] > NBC_SCHED_DICT_UPPER) {
-          NBC_SchedCache_dictwipe ((hb_tree *) libnbc_module->NBC_Dict[NBC_ALLTOALL],
-                                   &libnbc_module->NBC_Dict_size[NBC_ALLTOALL]);
-        }
-      } else {
-        NBC_Error("error in dict_insert() (%i)", res);
-        free (args);
-      }
+    if (alg != NBC_A2A_DISS) {
+      NBC_Sched_cache_insert (libnbc_module, &key, schedule, &tmpbuf);
     }
-  } else {
-    /* found schedule */
-    schedule = found->schedule;
-    OBJ_RETAIN(schedule);
   }
-#endif
 
   res = NBC_Schedule_request(schedule, comm, libnbc_module, persistent, request, tmpbuf);
   if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
@@ -23,27 +23,6 @@
  */
 #include "nbc_internal.h"
 
-#ifdef NBC_CACHE_SCHEDULE
-/* tree comparison function for schedule cache */
-int NBC_Gather_args_compare(NBC_Gather_args *a, NBC_Gather_args *b, void *param) {
-  if ((a->sendbuf == b->sendbuf) &&
-      (a->sendcount == b->sendcount) &&
-      (a->sendtype == b->sendtype) &&
-      (a->recvbuf == b->recvbuf) &&
-      (a->recvcount == b->recvcount) &&
-      (a->recvtype == b->recvtype) &&
-      (a->root == b->root)) {
-    return 0;
-  }
-
-  if( a->sendbuf < b->sendbuf ) {
-    return -1;
-  }
-
-  return 1;
-}
-#endif
-
 static int nbc_gather_init(const void* sendbuf, int sendcount, MPI_Datatype sendtype, void* recvbuf,
                            int recvcount, MPI_Datatype recvtype, int root,
                            struct ompi_communicator_t *comm, ompi_request_t ** request,
@@ -53,6 +32,7 @@ static int nbc_gather_init(const void* sendbuf, int sendcount, MPI_Datatype send
   NBC_Schedule *schedule;
   char *rbuf, inplace = 0;
   ompi_coll_libnbc_module_t *libnbc_module = (ompi_coll_libnbc_module_t*) module;
+  NBC_Sched_key key;
 
   rank = ompi_comm_rank (comm);
   if (root == rank) {
@@ -73,21 +53,17 @@ static int nbc_gather_init(const void* sendbuf, int sendcount, MPI_Datatype send
     sendtype = recvtype;
   }
 
-#ifdef NBC_CACHE_SCHEDULE
-  NBC_Gather_args *args, *found, search;
-
-  /* search schedule in communicator specific tree */
-  search.sendbuf = sendbuf;
-  search.sendcount = sendcount;
-  search.sendtype = sendtype;
-  search.recvbuf = recvbuf;
-  search.recvcount = recvcount;
-  search.recvtype = recvtype;
-  search.root = root;
-  found = (NBC_Gather_args *) hb_tree_search ((hb_tree *) libnbc_module->NBC_Dict[NBC_GATHER],
-                                              &search);
-  if (NULL == found) {
-#endif
+  /* search schedule in communicator specific cache, the receive
+   * arguments are only significant at the root */
+  if (rank == root) {
+    NBC_Sched_key_init (&key, NBC_GATHER, 0, root, sendbuf, sendcount, sendtype,
+                        recvbuf, recvcount, recvtype, NULL);
+  } else {
+    NBC_Sched_key_init (&key, NBC_GATHER, 0, root, sendbuf, sendcount, sendtype,
+                        NULL, 0, NULL, NULL);
+  }
+  schedule = NBC_Sched_cache_lookup (libnbc_module, &key);
+  if (NULL == schedule) {
     schedule = OBJ_NEW(NBC_Schedule);
     if (OPAL_UNLIKELY(NULL == schedule)) {
       return OMPI_ERR_OUT_OF_RESOURCE;
@@ -131,38 +107,8 @@ static int nbc_gather_init(const void* sendbuf, int sendcount, MPI_Datatype send
       return res;
     }
 
-#ifdef NBC_CACHE_SCHEDULE
-    /* save schedule to tree */
-    args = (NBC_Gather_args *) malloc (sizeof (args));
-    if (NULL != args) {
-      args->sendbuf = sendbuf;
-      args->sendcount = sendcount;
-      args->sendtype = sendtype;
-      args->recvbuf = recvbuf;
-      args->recvcount = recvcount;
-      args->recvtype = recvtype;
-      args->root = root;
-      args->schedule = schedule;
-      res = hb_tree_insert ((hb_tree *) libnbc_module->NBC_Dict[NBC_GATHER], args, args, 0);
-      if (0 == res) {
-        OBJ_RETAIN(schedule);
-
-        /* increase number of elements for A2A */
-        if (++libnbc_module->NBC_Dict_size[NBC_GATHER] > NBC_SCHED_DICT_UPPER) {
-          NBC_SchedCache_dictwipe ((hb_tree *) libnbc_module->NBC_Dict[NBC_GATHER],
-                                   &libnbc_module->NBC_Dict_size[NBC_GATHER]);
-        }
-      } else {
-        NBC_Error("error in dict_insert() (%i)", res);
-        free (args);
-      }
-    }
-  } else {
-    /* found schedule */
-    schedule = found->schedule;
-    OBJ_RETAIN(schedule);
+    NBC_Sched_cache_insert (libnbc_module, &key, schedule, NULL);
   }
-#endif
 
   res = NBC_Schedule_request(schedule, comm, libnbc_module, persistent, request, NULL);
   if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
@@ -45,7 +45,6 @@
 #include <assert.h>
 #include <math.h>
 #include <string.h>
-#include "libdict/dict.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -168,107 +167,30 @@ int NBC_Sched_unpack (void *inbuf, char tmpinbuf, size_t count, MPI_Datatype dat
 int NBC_Sched_barrier (NBC_Schedule *schedule);
 int NBC_Sched_commit (NBC_Schedule *schedule);
 
-#ifdef NBC_CACHE_SCHEDULE
-/* this is a dummy structure which is used to get the schedule out of
- * the collop specific structure. The schedule pointer HAS to be at the
- * first position and should NOT BE REORDERED by the compiler (C
- * guarantees that */
-struct NBC_dummyarg {
-  NBC_Schedule *schedule;
-};
-
-typedef struct {
-  NBC_Schedule *schedule;
-  void *sendbuf;
-  int sendcount;
-  MPI_Datatype sendtype;
-  void* recvbuf;
-  int recvcount;
-  MPI_Datatype recvtype;
-} NBC_Alltoall_args;
-int NBC_Alltoall_args_compare(NBC_Alltoall_args *a, NBC_Alltoall_args *b, void *param);
-
+/* schedule cache: everything a cached schedule has been built from. The
+ * schedules contain the absolute addresses of the user buffers, so the
+ * buffers are part of the key. */
 typedef struct {
-  NBC_Schedule *schedule;
-  void *sendbuf;
-  int sendcount;
-  MPI_Datatype sendtype;
-  void* recvbuf;
-  int recvcount;
-  MPI_Datatype recvtype;
-} NBC_Allgather_args;
-int NBC_Allgather_args_compare(NBC_Allgather_args *a, NBC_Allgather_args *b, void *param);
-
-typedef struct {
-  NBC_Schedule *schedule;
-  void *sendbuf;
-  void* recvbuf;
-  int count;
-  MPI_Datatype datatype;
-  MPI_Op op;
-} NBC_Allreduce_args;
-int NBC_Allreduce_args_compare(NBC_Allreduce_args *a, NBC_Allreduce_args *b, void *param);
-
-typedef struct {
-  NBC_Schedule *schedule;
-  void *buffer;
-  int count;
-  MPI_Datatype datatype;
+  int coll;
+  int alg;
+  int segsize;  /* tuning parameters of the algorithm, 0 if unused */
+  int radix;
   int root;
-} NBC_Bcast_args;
-int NBC_Bcast_args_compare(NBC_Bcast_args *a, NBC_Bcast_args *b, void *param);
-
-typedef struct {
-  NBC_Schedule *schedule;
-  void *sendbuf;
-  int sendcount;
+  const void *sendbuf;
+  void *recvbuf;
+  size_t sendcount;
+  size_t recvcount;
   MPI_Datatype sendtype;
-  void* recvbuf;
-  int recvcount;
   MPI_Datatype recvtype;
-  int root;
-} NBC_Gather_args;
-int NBC_Gather_args_compare(NBC_Gather_args *a, NBC_Gather_args *b, void *param);
-
-typedef struct {
-  NBC_Schedule *schedule;
-  void *sendbuf;
-  void* recvbuf;
-  int count;
-  MPI_Datatype datatype;
   MPI_Op op;
-  int root;
-} NBC_Reduce_args;
-int NBC_Reduce_args_compare(NBC_Reduce_args *a, NBC_Reduce_args *b, void *param);
-
-typedef struct {
-  NBC_Schedule *schedule;
-  void *sendbuf;
-  void* recvbuf;
-  int count;
-  MPI_Datatype datatype;
-  MPI_Op op;
-} NBC_Scan_args;
-int NBC_Scan_args_compare(NBC_Scan_args *a, NBC_Scan_args *b, void *param);
-
-typedef struct {
-  NBC_Schedule *schedule;
-  void *sendbuf;
-  int sendcount;
-  MPI_Datatype sendtype;
-  void* recvbuf;
-  int recvcount;
-  MPI_Datatype recvtype;
-  int root;
-} NBC_Scatter_args;
-int NBC_Scatter_args_compare(NBC_Scatter_args *a, NBC_Scatter_args *b, void *param);
-
-/* Schedule cache structures/functions */
-void NBC_SchedCache_args_delete(void *entry);
-void NBC_SchedCache_args_delete_key_dummy(void *k);
-
-#endif
+} NBC_Sched_key;
 
+void NBC_Sched_key_init (NBC_Sched_key *key, int coll, int alg, int root,
+                         const void *sendbuf, size_t sendcount, MPI_Datatype sendtype,
+                         void *recvbuf, size_t recvcount, MPI_Datatype recvtype, MPI_Op op);
+NBC_Schedule *NBC_Sched_cache_lookup (ompi_coll_libnbc_module_t *module, const NBC_Sched_key *key);
+void NBC_Sched_cache_insert (ompi_coll_libnbc_module_t *module, const NBC_Sched_key *key,
+                             NBC_Schedule *schedule, void **tmpbuf);
 
 int NBC_Start(NBC_Handle *handle);
 int NBC_Schedule_request(NBC_Schedule *schedule, ompi_communicator_t *comm,
@@ -557,18 +479,6 @@ static inline int NBC_Unpack(void *src, int srccount, MPI_Datatype srctype, void
   return OMPI_SUCCESS;
 }
 
-/* deletes elements from dict_in until low watermark is reached */
-static inline void NBC_SchedCache_dictwipe(hb_tree *dict_in, int *size) {
-  hb_itor *itor;
-
-  itor = hb_itor_new(dict_in);
-  for (; hb_itor_valid(itor) && (*size>NBC_SCHED_DICT_LOWER); hb_itor_next(itor)) {
-    hb_tree_remove(dict_in, hb_itor_key(itor), 0);
-    *size = *size-1;
-  }
-  hb_itor_destroy(itor);
-}
-
 #define NBC_IN_PLACE(sendbuf, recvbuf, inplace) \
 { \
   inplace = 0; \
@@ -23,27 +23,6 @@
  */
 #include "nbc_internal.h"
 
-#ifdef NBC_CACHE_SCHEDULE
-/* tree comparison function for schedule cache */
-int NBC_Scatter_args_compare(NBC_Scatter_args *a, NBC_Scatter_args *b, void *param) {
-    if ((a->sendbuf == b->sendbuf) &&
-        (a->sendcount == b->sendcount) &&
-        (a->sendtype == b->sendtype) &&
-        (a->recvbuf == b->recvbuf) &&
-        (a->recvcount == b->recvcount) &&
-        (a->recvtype == b->recvtype) &&
-        (a->root == b->root)) {
-        return 0;
-    }
-
-    if (a->sendbuf < b->sendbuf) {
-        return -1;
-    }
-
-    return 1;
-}
-#endif
-
 /* simple linear MPI_Iscatter */
 static int nbc_scatter_init (const void* sendbuf, int sendcount, MPI_Datatype sendtype,
                              void* recvbuf, int recvcount, MPI_Datatype recvtype, int root,
@@ -54,6 +33,7 @@ static int nbc_scatter_init (const void* sendbuf, int sendcount, MPI_Datatype se
   NBC_Schedule *schedule;
   char *sbuf, inplace = 0;
   ompi_coll_libnbc_module_t *libnbc_module = (ompi_coll_libnbc_module_t*) module;
+  NBC_Sched_key key;
 
 
   rank = ompi_comm_rank (comm);
@@ -70,20 +50,17 @@ static int nbc_scatter_init (const void* sendbuf, int sendcount, MPI_Datatype se
     }
   }
 
-#ifdef NBC_CACHE_SCHEDULE
-  NBC_Scatter_args *args, *found, search;
-
-  /* search schedule in communicator specific tree */
-  search.sendbuf=sendbuf;
-  search.sendcount=sendcount;
-  search.sendtype=sendtype;
-  search.recvbuf=recvbuf;
-  search.recvcount=recvcount;
-  search.recvtype=recvtype;
-  search.root=root;
-  found = (NBC_Scatter_args *) hb_tree_search ((hb_tree *) libnbc_module->NBC_Dict[NBC_SCATTER], &search);
-  if (NULL == found) {
-#endif
+  /* search schedule in communicator specific cache, the send
+   * arguments are only significant at the root */
+  if (rank == root) {
+    NBC_Sched_key_init (&key, NBC_SCATTER, 0, root, sendbuf, sendcount, sendtype,
+                        recvbuf, recvcount, recvtype, NULL);
+  } else {
+    NBC_Sched_key_init (&key, NBC_SCATTER, 0, root, NULL, 0, NULL,
+                        recvbuf, recvcount, recvtype, NULL);
+  }
+  schedule = NBC_Sched_cache_lookup (libnbc_module, &key);
+  if (NULL == schedule) {
     schedule = OBJ_NEW(NBC_Schedule);
     if (OPAL_UNLIKELY(NULL == schedule)) {
       return OMPI_ERR_OUT_OF_RESOURCE;
@@ -126,38 +103,9 @@ static int nbc_scatter_init (const void* sendbuf, int sendcount, MPI_Datatype se
       OBJ_RELEASE(schedule);
       return res;
     }
-#ifdef NBC_CACHE_SCHEDULE
-    /* save schedule to tree */
-    args = (NBC_Scatter_args *) malloc (sizeof (args));
-    if (NULL != args) {
-      args->sendbuf = sendbuf;
-      args->sendcount = sendcount;
-      args->sendtype = sendtype;
-      args->recvbuf = recvbuf;
-      args->recvcount = recvcount;
-      args->recvtype = recvtype;
-      args->root = root;
-      args->schedule = schedule;
-      res = hb_tree_insert ((hb_tree *) libnbc_module->NBC_Dict[NBC_SCATTER], args, args, 0);
-      if (0 == res) {
-        OBJ_RETAIN(schedule);
 
-        /* increase number of elements for A2A */
-        if (++libnbc_module->NBC_Dict_size[NBC_SCATTER] > NBC_SCHED_DICT_UPPER) {
-          NBC_SchedCache_dictwipe ((hb_tree *) libnbc_module->NBC_Dict[NBC_SCATTER],
-                                   &libnbc_module->NBC_Dict_size[NBC_SCATTER]);
-        }
-      } else {
-        NBC_Error("error in dict_insert() (%i)", res);
-        free (args);
-      }
-    }
-  } else {
-    /* found schedule */
-    schedule = found->schedule;
-    OBJ_RETAIN(schedule);
+    NBC_Sched_cache_insert (libnbc_module, &key, schedule, NULL);
   }
-#endif
 
   res = NBC_Schedule_request(schedule, comm, libnbc_module, persistent, request, NULL);
   if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
@@ -34,6 +34,8 @@ extern int   ompi_coll_tuned_stream;
 extern int   ompi_coll_tuned_priority;
 extern bool  ompi_coll_tuned_use_dynamic_rules;
 extern char* ompi_coll_tuned_dynamic_rules_filename;
+extern bool  ompi_coll_tuned_online_tuning;
+extern int   ompi_coll_tuned_online_tuning_samples;
 extern int   ompi_coll_tuned_init_tree_fanout;
 extern int   ompi_coll_tuned_init_chain_fanout;
 extern int   ompi_coll_tuned_init_max_requests;
@@ -72,6 +74,23 @@ struct coll_tuned_force_algorithm_params_t {
 };
 typedef struct coll_tuned_force_algorithm_params_t coll_tuned_force_algorithm_params_t;
 
+/* online selection of the algorithm for the message sizes between two
+   consecutive powers of two, on one communicator */
+#define COLL_TUNED_ONLINE_BUCKETS 48
+
+struct ompi_coll_tuned_online_bucket_t {
+    COLLTYPE_T coll;
+    int index;
+    int algorithm;       /* locked in algorithm, 0 while exploring, -1 for none */
+    int candidate;       /* algorithm being measured */
+    int calls;           /* calls made with the candidate */
+    int best_algorithm;
+    double best_time;
+    double start;        /* of the current call */
+    double elapsed;      /* local time of the timed calls of the candidate */
+};
+typedef struct ompi_coll_tuned_online_bucket_t ompi_coll_tuned_online_bucket_t;
+
 /* the indices to the MCA params so that modules can look them up at open / comm create time  */
 extern coll_tuned_force_algorithm_mca_param_indices_t ompi_coll_tuned_forced_params[COLLCOUNT];
 /* the actual max algorithm values (readonly), loaded at component open */
@@ -215,8 +234,19 @@ struct mca_coll_tuned_module_t {
 
     /* the communicator rules for each MPI collective for ONLY my comsize */
     ompi_coll_com_rule_t *com_rules[COLLCOUNT];
+
+    /* the state of the online selection for each MPI collective */
+    ompi_coll_tuned_online_bucket_t *online[COLLCOUNT];
 };
 typedef struct mca_coll_tuned_module_t mca_coll_tuned_module_t;
 OBJ_CLASS_DECLARATION(mca_coll_tuned_module_t);
 
+/* Online selection */
+ompi_coll_tuned_online_bucket_t *ompi_coll_tuned_online_create(COLLTYPE_T coll);
+int ompi_coll_tuned_online_begin(mca_coll_tuned_module_t *tuned_module, COLLTYPE_T coll,
+                                 size_t msg_size, ompi_coll_tuned_online_bucket_t **measured);
+bool ompi_coll_tuned_online_end(mca_coll_tuned_module_t *tuned_module,
+                                ompi_coll_tuned_online_bucket_t *bucket, int err,
+                                struct ompi_communicator_t *comm);
+
 #endif  /* MCA_COLL_TUNED_EXPORT_H */
@@ -191,6 +191,26 @@ static int tuned_register(void)
                                            MCA_BASE_VAR_SCOPE_READONLY,
                                            &ompi_coll_tuned_dynamic_rules_filename);
 
+    (void) mca_base_component_var_register(&mca_coll_tuned_component.super.collm_version,
+                                           "online_tuning",
+                                           "Select the algorithms online: for each communicator, collective and power of two message size, every algorithm is used for the first calls and the fastest one is kept. Applies to allgather, allreduce, alltoall, barrier, bcast, reduce, reduce_scatter and reduce_scatter_block with commutative operations, after the forced algorithms and the dynamic rules file",
+                                           MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
+                                           OPAL_INFO_LVL_6,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &ompi_coll_tuned_online_tuning);
+
+    ompi_coll_tuned_online_tuning_samples = 4;
+    (void) mca_base_component_var_register(&mca_coll_tuned_component.super.collm_version,
+                                           "online_tuning_samples",
+                                           "Number of timed calls of each algorithm in the online selection, after one untimed call",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_6,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &ompi_coll_tuned_online_tuning_samples);
+    if (ompi_coll_tuned_online_tuning_samples < 1) {
+        ompi_coll_tuned_online_tuning_samples = 1;
+    }
+
     /* register forced params */
     ompi_coll_tuned_allreduce_intra_check_forced_init(&ompi_coll_tuned_forced_params[ALLREDUCE]);
     ompi_coll_tuned_alltoall_intra_check_forced_init(&ompi_coll_tuned_forced_params[ALLTOALL]);
@@ -276,8 +296,18 @@ mca_coll_tuned_module_construct(mca_coll_tuned_module_t *module)
     for( int i = 0; i < COLLCOUNT; i++ ) {
         tuned_module->user_forced[i].algorithm = 0;
         tuned_module->com_rules[i] = NULL;
+        tuned_module->online[i] = NULL;
+    }
+}
+
+static void
+mca_coll_tuned_module_destruct(mca_coll_tuned_module_t *module)
+{
+    for( int i = 0; i < COLLCOUNT; i++ ) {
+        free(module->online[i]);
+        module->online[i] = NULL;
     }
 }
 
 OBJ_CLASS_INSTANCE(mca_coll_tuned_module_t, mca_coll_base_module_t,
-                   mca_coll_tuned_module_construct, NULL);
+                   mca_coll_tuned_module_construct, mca_coll_tuned_module_destruct);
@@ -27,6 +27,7 @@
 #include "ompi/constants.h"
 #include "ompi/datatype/ompi_datatype.h"
 #include "ompi/communicator/communicator.h"
+#include "ompi/op/op.h"
 #include "ompi/mca/coll/base/base.h"
 #include "ompi/mca/coll/coll.h"
 #include "ompi/mca/coll/base/coll_tags.h"
@@ -40,6 +41,8 @@
  * Else
  *      use forced rules (-coll_tuned_dynamic_ALG_intra_algorithm = algorithm-number)
  * Else
+ *      select online (-coll_tuned_online_tuning = 1), for the collectives that support it
+ * Else
  *      use fixed (compiled) rule set (or nested ifs)
  *
  */
@@ -90,6 +93,26 @@ ompi_coll_tuned_allreduce_intra_dec_dynamic (const void *sbuf, void *rbuf, int c
         } /* found a method */
     } /*end if any com rules to check */
 
+    /* select the algorithm online */
+    if (NULL != tuned_module->online[ALLREDUCE] && ompi_op_is_commute(op)) {
+        ompi_coll_tuned_online_bucket_t *bucket;
+        size_t dsize;
+        int alg, err;
+
+        ompi_datatype_type_size(dtype, &dsize);
+        dsize *= (size_t) count;
+        alg = ompi_coll_tuned_online_begin(tuned_module, ALLREDUCE, dsize, &bucket);
+        if (alg) {
+            err = ompi_coll_tuned_allreduce_intra_do_this(sbuf, rbuf, count, dtype, op,
+                                                          comm, module, alg,
+                                                          tuned_module->user_forced[ALLREDUCE].tree_fanout,
+                                                          tuned_module->user_forced[ALLREDUCE].segsize);
+            if (ompi_coll_tuned_online_end(tuned_module, bucket, err, comm)) {
+                return err;
+            }
+        }
+    }
+
     return ompi_coll_tuned_allreduce_intra_dec_fixed (sbuf, rbuf, count, dtype, op,
                                                       comm, module);
 }
@@ -147,6 +170,28 @@ int ompi_coll_tuned_alltoall_intra_dec_dynamic(const void *sbuf, int scount,
         } /* found a method */
     } /*end if any com rules to check */
 
+    /* select the algorithm online */
+    if (NULL != tuned_module->online[ALLTOALL]) {
+        ompi_coll_tuned_online_bucket_t *bucket;
+        size_t dsize;
+        int alg, err;
+
+        ompi_datatype_type_size(rdtype, &dsize);
+        dsize *= (size_t) rcount;
+        alg = ompi_coll_tuned_online_begin(tuned_module, ALLTOALL, dsize, &bucket);
+        if (alg) {
+            err = ompi_coll_tuned_alltoall_intra_do_this(sbuf, scount, sdtype,
+                                                         rbuf, rcount, rdtype,
+                                                         comm, module, alg,
+                                                         tuned_module->user_forced[ALLTOALL].tree_fanout,
+                                                         tuned_module->user_forced[ALLTOALL].segsize,
+                                                         tuned_module->user_forced[ALLTOALL].max_requests);
+            if (ompi_coll_tuned_online_end(tuned_module, bucket, err, comm)) {
+                return err;
+            }
+        }
+    }
+
     return ompi_coll_tuned_alltoall_intra_dec_fixed (sbuf, scount, sdtype,
                                                      rbuf, rcount, rdtype,
                                                      comm, module);
@@ -240,6 +285,23 @@ int ompi_coll_tuned_barrier_intra_dec_dynamic(struct ompi_communicator_t *comm,
         } /* found a method */
     } /*end if any com rules to check */
 
+    /* select the algorithm online */
+    if (NULL != tuned_module->online[BARRIER]) {
+        ompi_coll_tuned_online_bucket_t *bucket;
+        size_t dsize = 0;
+        int alg, err;
+
+        alg = ompi_coll_tuned_online_begin(tuned_module, BARRIER, dsize, &bucket);
+        if (alg) {
+            err = ompi_coll_tuned_barrier_intra_do_this(comm, module, alg,
+                                                        tuned_module->user_forced[BARRIER].tree_fanout,
+                                                        tuned_module->user_forced[BARRIER].segsize);
+            if (ompi_coll_tuned_online_end(tuned_module, bucket, err, comm)) {
+                return err;
+            }
+        }
+    }
+
     return ompi_coll_tuned_barrier_intra_dec_fixed (comm, module);
 }
 
@@ -289,6 +351,26 @@ int ompi_coll_tuned_bcast_intra_dec_dynamic(void *buf, int count,
     } /*end if any com rules to check */
 
 
+    /* select the algorithm online */
+    if (NULL != tuned_module->online[BCAST]) {
+        ompi_coll_tuned_online_bucket_t *bucket;
+        size_t dsize;
+        int alg, err;
+
+        ompi_datatype_type_size(dtype, &dsize);
+        dsize *= (size_t) count;
+        alg = ompi_coll_tuned_online_begin(tuned_module, BCAST, dsize, &bucket);
+        if (alg) {
+            err = ompi_coll_tuned_bcast_intra_do_this(buf, count, dtype, root,
+                                                      comm, module, alg,
+                                                      tuned_module->user_forced[BCAST].chain_fanout,
+                                                      tuned_module->user_forced[BCAST].segsize);
+            if (ompi_coll_tuned_online_end(tuned_module, bucket, err, comm)) {
+                return err;
+            }
+        }
+    }
+
     return ompi_coll_tuned_bcast_intra_dec_fixed (buf, count, dtype, root,
                                                   comm, module);
 }
@@ -343,6 +425,27 @@ int ompi_coll_tuned_reduce_intra_dec_dynamic( const void *sbuf, void *rbuf,
         } /* found a method */
     } /*end if any com rules to check */
 
+    /* select the algorithm online */
+    if (NULL != tuned_module->online[REDUCE] && ompi_op_is_commute(op)) {
+        ompi_coll_tuned_online_bucket_t *bucket;
+        size_t dsize;
+        int alg, err;
+
+        ompi_datatype_type_size(dtype, &dsize);
+        dsize *= (size_t) count;
+        alg = ompi_coll_tuned_online_begin(tuned_module, REDUCE, dsize, &bucket);
+        if (alg) {
+            err = ompi_coll_tuned_reduce_intra_do_this(sbuf, rbuf, count, dtype,
+                                                       op, root, comm, module, alg,
+                                                       tuned_module->user_forced[REDUCE].chain_fanout,
+                                                       tuned_module->user_forced[REDUCE].segsize,
+                                                       tuned_module->user_forced[REDUCE].max_requests);
+            if (ompi_coll_tuned_online_end(tuned_module, bucket, err, comm)) {
+                return err;
+            }
+        }
+    }
+
     return ompi_coll_tuned_reduce_intra_dec_fixed (sbuf, rbuf, count, dtype,
                                                    op, root, comm, module);
 }
@@ -398,6 +501,29 @@ int ompi_coll_tuned_reduce_scatter_intra_dec_dynamic(const void *sbuf, void *rbu
         } /* found a method */
     } /*end if any com rules to check */
 
+    /* select the algorithm online */
+    if (NULL != tuned_module->online[REDUCESCATTER] && ompi_op_is_commute(op)) {
+        ompi_coll_tuned_online_bucket_t *bucket;
+        size_t dsize, total_count = 0;
+        int alg, err;
+
+        for (int i = 0; i < ompi_comm_size(comm); i++) {
+            total_count += (size_t) rcounts[i];
+        }
+        ompi_datatype_type_size(dtype, &dsize);
+        dsize *= total_count;
+        alg = ompi_coll_tuned_online_begin(tuned_module, REDUCESCATTER, dsize, &bucket);
+        if (alg) {
+            err = ompi_coll_tuned_reduce_scatter_intra_do_this(sbuf, rbuf, rcounts, dtype,
+                                                               op, comm, module, alg,
+                                                               tuned_module->user_forced[REDUCESCATTER].chain_fanout,
+                                                               tuned_module->user_forced[REDUCESCATTER].segsize);
+            if (ompi_coll_tuned_online_end(tuned_module, bucket, err, comm)) {
+                return err;
+            }
+        }
+    }
+
     return ompi_coll_tuned_reduce_scatter_intra_dec_fixed (sbuf, rbuf, rcounts,
                                                            dtype, op, comm, module);
 }
@@ -452,6 +578,26 @@ int ompi_coll_tuned_reduce_scatter_block_intra_dec_dynamic(const void *sbuf, voi
         } /* found a method */
     } /* end if any com rules to check */
 
+    /* select the algorithm online */
+    if (NULL != tuned_module->online[REDUCESCATTERBLOCK] && ompi_op_is_commute(op)) {
+        ompi_coll_tuned_online_bucket_t *bucket;
+        size_t dsize;
+        int alg, err;
+
+        ompi_datatype_type_size(dtype, &dsize);
+        dsize *= (size_t) rcount;
+        alg = ompi_coll_tuned_online_begin(tuned_module, REDUCESCATTERBLOCK, dsize, &bucket);
+        if (alg) {
+            err = ompi_coll_tuned_reduce_scatter_block_intra_do_this(sbuf, rbuf, rcount, dtype,
+                                                                     op, comm, module, alg,
+                                                                     tuned_module->user_forced[REDUCESCATTERBLOCK].chain_fanout,
+                                                                     tuned_module->user_forced[REDUCESCATTERBLOCK].segsize);
+            if (ompi_coll_tuned_online_end(tuned_module, bucket, err, comm)) {
+                return err;
+            }
+        }
+    }
+
     return ompi_coll_tuned_reduce_scatter_block_intra_dec_fixed (sbuf, rbuf, rcount,
                                                                  dtype, op, comm, module);
 }
@@ -511,6 +657,27 @@ int ompi_coll_tuned_allgather_intra_dec_dynamic(const void *sbuf, int scount,
         }
     }
 
+    /* select the algorithm online */
+    if (NULL != tuned_module->online[ALLGATHER]) {
+        ompi_coll_tuned_online_bucket_t *bucket;
+        size_t dsize;
+        int alg, err;
+
+        ompi_datatype_type_size(rdtype, &dsize);
+        dsize *= (size_t) rcount;
+        alg = ompi_coll_tuned_online_begin(tuned_module, ALLGATHER, dsize, &bucket);
+        if (alg) {
+            err = ompi_coll_tuned_allgather_intra_do_this(sbuf, scount, sdtype,
+                                                          rbuf, rcount, rdtype,
+                                                          comm, module, alg,
+                                                          tuned_module->user_forced[ALLGATHER].tree_fanout,
+                                                          tuned_module->user_forced[ALLGATHER].segsize);
+            if (ompi_coll_tuned_online_end(tuned_module, bucket, err, comm)) {
+                return err;
+            }
+        }
+    }
+
     /* Use default decision */
     return ompi_coll_tuned_allgather_intra_dec_fixed (sbuf, scount, sdtype,
                                                       rbuf, rcount, rdtype,
@@ -153,9 +153,17 @@ ompi_coll_tuned_forced_getvalues( enum COLLTYPE type,
         int need_dynamic_decision = 0;                                  \
         ompi_coll_tuned_forced_getvalues( (TYPE), &((TMOD)->user_forced[(TYPE)]) ); \
         (TMOD)->com_rules[(TYPE)] = NULL;                               \
+        if( !ompi_coll_tuned_use_dynamic_rules ) {                      \
+            /* the online selection still uses the forced parameters */ \
+            (TMOD)->user_forced[(TYPE)].algorithm = 0;                  \
+        }                                                               \
         if( 0 != (TMOD)->user_forced[(TYPE)].algorithm ) {              \
             need_dynamic_decision = 1;                                  \
         }                                                               \
+        (TMOD)->online[(TYPE)] = ompi_coll_tuned_online_create((TYPE)); \
+        if( NULL != (TMOD)->online[(TYPE)] ) {                          \
+            need_dynamic_decision = 1;                                  \
+        }                                                               \
         if( NULL != mca_coll_tuned_component.all_base_rules ) {         \
             (TMOD)->com_rules[(TYPE)]                                   \
                 = ompi_coll_tuned_get_com_rule_ptr( mca_coll_tuned_component.all_base_rules, \
@@ -207,7 +215,7 @@ tuned_module_enable( mca_coll_base_module_t *module,
         return OMPI_ERROR;
     }
 
-    if (ompi_coll_tuned_use_dynamic_rules) {
+    if (ompi_coll_tuned_use_dynamic_rules || ompi_coll_tuned_online_tuning) {
         OPAL_OUTPUT((ompi_coll_tuned_stream,"coll:tuned:module_init MCW & Dynamic"));
 
         /**
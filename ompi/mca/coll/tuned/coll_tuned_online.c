@@ -0,0 +1,175 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/*
+ * Online selection of the algorithms.
+ *
+ * For each communicator, collective and power of two message size bucket
+ * every algorithm is used in turn for a few calls. The time of these
+ * calls is summed locally, and the maximum of the sums over the processes
+ * is agreed upon with an allreduce once all calls of a candidate are
+ * done, so that all processes lock in the same algorithm once all
+ * candidates were measured. The first call of each candidate is not
+ * timed, it builds the topologies the algorithm caches on the
+ * communicator.
+ *
+ * All processes have to go through the same buckets in the same order,
+ * so the bucket is chosen from a message size that is identical on every
+ * process: the size of the whole message for allreduce, bcast and reduce,
+ * the per peer block for alltoall and the sum of all the receive counts
+ * for reduce_scatter, barrier only has one bucket. Every algorithm also
+ * has to be valid for the operation, non commutative reductions are left
+ * to the other decisions.
+ */
+
+#include "ompi_config.h"
+
+#include "mpi.h"
+#include "ompi/constants.h"
+#include "ompi/communicator/communicator.h"
+#include "ompi/mca/coll/base/coll_base_functions.h"
+#include "ompi/mca/coll/base/coll_base_util.h"
+#include "opal/util/clock_gettime.h"
+#include "coll_tuned.h"
+
+bool ompi_coll_tuned_online_tuning = false;
+int  ompi_coll_tuned_online_tuning_samples = 4;
+
+static inline double online_now(void)
+{
+    struct timespec tp;
+
+    (void) opal_clock_gettime(&tp);
+    return (double) tp.tv_sec + (double) tp.tv_nsec / 1.0e+9;
+}
+
+static inline int online_bucket_index(size_t msg_size)
+{
+    int b = 0;
+
+    while (0 != msg_size && b < COLL_TUNED_ONLINE_BUCKETS - 1) {
+        msg_size >>= 1;
+        b++;
+    }
+    return b;
+}
+
+ompi_coll_tuned_online_bucket_t *ompi_coll_tuned_online_create(COLLTYPE_T coll)
+{
+    ompi_coll_tuned_online_bucket_t *buckets;
+
+    if (!ompi_coll_tuned_online_tuning) {
+        return NULL;
+    }
+    switch (coll) {
+    case ALLGATHER:
+    case ALLREDUCE:
+    case ALLTOALL:
+    case BARRIER:
+    case BCAST:
+    case REDUCE:
+    case REDUCESCATTER:
+    case REDUCESCATTERBLOCK:
+        break;
+    default:
+        return NULL;
+    }
+    /* nothing to choose from */
+    if (ompi_coll_tuned_forced_max_algorithms[coll] < 3) {
+        return NULL;
+    }
+
+    buckets = (ompi_coll_tuned_online_bucket_t *) calloc(COLL_TUNED_ONLINE_BUCKETS,
+                                                         sizeof(ompi_coll_tuned_online_bucket_t));
+    if (NULL == buckets) {
+        return NULL;
+    }
+    for (int i = 0; i < COLL_TUNED_ONLINE_BUCKETS; i++) {
+        buckets[i].coll = coll;
+        buckets[i].index = i;
+        buckets[i].candidate = 1;
+    }
+    return buckets;
+}
+
+int ompi_coll_tuned_online_begin(mca_coll_tuned_module_t *tuned_module, COLLTYPE_T coll,
+                                 size_t msg_size, ompi_coll_tuned_online_bucket_t **measured)
+{
+    ompi_coll_tuned_online_bucket_t *bucket =
+        &tuned_module->online[coll][online_bucket_index(msg_size)];
+
+    if (0 != bucket->algorithm) {
+        /* locked in, or given up on */
+        *measured = NULL;
+        return (bucket->algorithm > 0) ? bucket->algorithm : 0;
+    }
+    *measured = bucket;
+    bucket->start = online_now();
+    return bucket->candidate;
+}
+
+/* move to the next candidate, lock in the fastest after the last one */
+static void online_next_candidate(ompi_coll_tuned_online_bucket_t *bucket)
+{
+    bucket->calls = 0;
+    bucket->elapsed = 0.0;
+    if (++bucket->candidate < ompi_coll_tuned_forced_max_algorithms[bucket->coll]) {
+        return;
+    }
+    /* -1 leaves the bucket to the other decisions when no algorithm
+       was usable */
+    bucket->algorithm = (0 != bucket->best_algorithm) ? bucket->best_algorithm : -1;
+    OPAL_OUTPUT((ompi_coll_tuned_stream, "coll:tuned:online collective %d (%s) bucket %d: algorithm %d in %g s",
+                 bucket->coll, mca_coll_base_colltype_to_str(bucket->coll),
+                 bucket->index, bucket->best_algorithm, bucket->best_time));
+}
+
+bool ompi_coll_tuned_online_end(mca_coll_tuned_module_t *tuned_module,
+                                ompi_coll_tuned_online_bucket_t *bucket, int err,
+                                struct ompi_communicator_t *comm)
+{
+    double elapsed;
+
+    if (NULL == bucket) {
+        return true;
+    }
+    elapsed = online_now() - bucket->start;
+
+    if (MPI_ERR_UNSUPPORTED_OPERATION == err) {
+        /* the algorithm does not support this communicator, the same on
+           all the processes: the call is made again by the caller */
+        online_next_candidate(bucket);
+        return false;
+    }
+    if (OMPI_SUCCESS != err) {
+        return true;
+    }
+
+    if (0 != bucket->calls++) {
+        bucket->elapsed += elapsed;
+    }
+    if (bucket->calls <= ompi_coll_tuned_online_tuning_samples) {
+        return true;
+    }
+
+    elapsed = bucket->elapsed;
+    err = ompi_coll_base_allreduce_intra_recursivedoubling(MPI_IN_PLACE, &elapsed, 1, MPI_DOUBLE,
+                                                           MPI_MAX, comm, &tuned_module->super);
+    if (OMPI_SUCCESS != err) {
+        /* without an agreement there is no safe choice, stop here */
+        bucket->algorithm = -1;
+        return true;
+    }
+    if (0 == bucket->best_algorithm || elapsed < bucket->best_time) {
+        bucket->best_algorithm = bucket->candidate;
+        bucket->best_time = elapsed;
+    }
+    online_next_candidate(bucket);
+    return true;
+}
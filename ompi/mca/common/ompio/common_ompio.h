@@ -84,6 +84,10 @@
 #define NO_REFINEMENT                   6
 #define SIMPLE_PLUS                     7
 
+/*AGGREGATOR PLACEMENT*/
+#define OMPIO_AGGR_PLACEMENT_RANK       0
+#define OMPIO_AGGR_PLACEMENT_TOPO       1
+
 #define OMPIO_LOCK_ENTIRE_REGION  10
 #define OMPIO_LOCK_SELECTIVE      11
 
@@ -101,6 +105,16 @@
 #define OMPIO_PERM_NULL               -1
 #define OMPIO_IOVEC_INITIAL_SIZE      100
 
+/* header at offset 0 of a file stored compressed by fcoll/vulcan */
+#define OMPIO_COMPRESSED_MAGIC        0x4f435a46  /* "OCZF" */
+#define OMPIO_COMPRESSED_VERSION      1
+
+typedef struct mca_common_ompio_compressed_header_t {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t block_size;  /* bytes of data per compressed frame */
+} mca_common_ompio_compressed_header_t;
+
 enum ompio_fs_type
 {
     NONE = 0,
@@ -198,6 +212,17 @@ struct ompio_file_t {
     mca_common_ompio_io_array_t *f_io_array;
     int                      f_num_of_io_entries;
 
+    /* write-behind/read-ahead cache of the individual operations,
+       see common_ompio_cache.h */
+    char                    *f_cache_buf;
+    size_t                   f_cache_size;
+    OMPI_MPI_OFFSET_TYPE     f_cache_offset;
+    size_t                   f_cache_len;
+    bool                     f_cache_dirty;
+
+    /* block size of a file stored compressed by fcoll/vulcan, 0 otherwise */
+    size_t                   f_compressed_block_size;
+
     /* Hooks for modules to hang things */
     mca_base_component_t *f_fs_component;
     mca_base_component_t *f_fcoll_component;
@@ -320,6 +345,7 @@ OMPI_DECLSPEC int mca_common_ompio_file_get_size (ompio_file_t *ompio_fh, OMPI_M
 OMPI_DECLSPEC int mca_common_ompio_file_get_position (ompio_file_t *fh,OMPI_MPI_OFFSET_TYPE *offset);
 OMPI_DECLSPEC int mca_common_ompio_set_explicit_offset (ompio_file_t *fh, OMPI_MPI_OFFSET_TYPE offset);
 OMPI_DECLSPEC int mca_common_ompio_set_file_defaults (ompio_file_t *fh);
+OMPI_DECLSPEC int mca_common_ompio_check_compressed (ompio_file_t *fh, bool collective);
 OMPI_DECLSPEC int mca_common_ompio_set_view (ompio_file_t *fh,  OMPI_MPI_OFFSET_TYPE disp,
                                              ompi_datatype_t *etype,  ompi_datatype_t *filetype, const char *datarep,
                                              opal_info_t *info);
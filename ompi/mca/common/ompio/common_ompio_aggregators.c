@@ -35,6 +35,8 @@
 #include "ompi/datatype/ompi_datatype.h"
 #include "ompi/info/info.h"
 #include "ompi/request/request.h"
+#include "opal/mca/hwloc/base/base.h"
+#include "opal/mca/pmix/pmix-internal.h"
 
 #include <math.h>
 #include <unistd.h>
@@ -51,9 +53,14 @@
 ** 2. fview_based_grouping: analysis the fileview to detect regular patterns
 ** 3. cart_based_grouping: uses a cartesian communicator to derive certain (probable) properties
 **    of the access pattern
+**
+** With the aggregator_placement parameter set to topology, the groups of a given number of
+** aggregators are formed out of the processes of a node instead of contiguous ranks.
 */
 
 static double cost_calc (int P, int P_agg, size_t Data_proc, size_t coll_buffer, int dim );
+static int topo_grouping (ompio_file_t *fh, int num_groups, mca_common_ompio_contg *contg_groups);
+static int topo_layout (ompio_file_t *fh, int *layout);
 #define DIM1 1
 #define DIM2 2
 
@@ -197,6 +204,14 @@ int  mca_common_ompio_forced_grouping ( ompio_file_t *fh,
     int k=0, p=0, g=0;
     int total_procs = 0; 
 
+    if ( OMPIO_AGGR_PLACEMENT_TOPO == OMPIO_MCA_GET(fh, aggregator_placement) ) {
+        int ret = topo_grouping ( fh, num_groups, contg_groups );
+        if ( OMPI_ERR_NOT_AVAILABLE != ret ) {
+            return ret;
+        }
+        /* the layout is unknown, fall back to contiguous ranks */
+    }
+
     for ( k=0, p=0; p<num_groups; p++ ) {
         if ( p < rest ) {
             contg_groups[p].procs_per_contg_group = group_size+1;
@@ -225,6 +240,239 @@ int  mca_common_ompio_forced_grouping ( ompio_file_t *fh,
     return OMPI_SUCCESS;
 }
 
+/*
+** Topology aware grouping. Every node gets a share of the aggregators
+** proportional to its number of processes, and the processes of a node
+** are split into groups in the order of the socket they are bound to.
+** The shuffle of a group hence stays within a node, and the aggregators
+** are spread evenly across the nodes (and the sockets of a node). With
+** fewer aggregators than nodes, a group spans neighbouring nodes and no
+** node hosts more than one aggregator.
+**
+** Returns OMPI_ERR_NOT_AVAILABLE on every process if the node of a
+** process is unknown.
+*/
+static int topo_grouping (ompio_file_t *fh,
+                          int num_groups,
+                          mca_common_ompio_contg *contg_groups)
+{
+    int *layout = NULL, *order = NULL, *tmp = NULL, *count = NULL;
+    int *node_start = NULL, *node_groups = NULL;
+    int num_nodes = 0, remaining, best;
+    int i, n, g, k, key, pass, size, group_size, rest;
+    int ret = OMPI_SUCCESS;
+
+    layout = (int *) malloc ( 2 * fh->f_size * sizeof(int));
+    order  = (int *) malloc ( fh->f_size * sizeof(int));
+    tmp    = (int *) malloc ( fh->f_size * sizeof(int));
+    count  = (int *) malloc ( (fh->f_size + 1) * sizeof(int));
+    if ( NULL == layout || NULL == order || NULL == tmp || NULL == count ) {
+        opal_output (1, "OUT OF MEMORY\n");
+        ret = OMPI_ERR_OUT_OF_RESOURCE;
+        goto exit;
+    }
+
+    ret = topo_layout ( fh, layout );
+    if ( OMPI_SUCCESS != ret ) {
+        goto exit;
+    }
+
+    /* Order the processes by node, socket and rank: a stable counting sort
+    ** on the socket and then on the node, both keys being ranks. */
+    for ( i = 0; i < fh->f_size; i++ ) {
+        tmp[i] = i;
+    }
+    for ( pass = 1; pass >= 0; pass-- ) {
+        memset ( count, 0, (fh->f_size + 1) * sizeof(int));
+        for ( i = 0; i < fh->f_size; i++ ) {
+            count[layout[2*tmp[i] + pass] + 1]++;
+        }
+        for ( k = 0; k < fh->f_size; k++ ) {
+            count[k+1] += count[k];
+        }
+        for ( i = 0; i < fh->f_size; i++ ) {
+            key = layout[2*tmp[i] + pass];
+            order[count[key]++] = tmp[i];
+        }
+        if ( 1 == pass ) {
+            memcpy ( tmp, order, fh->f_size * sizeof(int));
+        }
+    }
+
+    for ( i = 0; i < fh->f_size; i++ ) {
+        if ( 0 == i || layout[2*order[i]] != layout[2*order[i-1]] ) {
+            num_nodes++;
+        }
+    }
+    node_start  = (int *) malloc ( (num_nodes + 1) * sizeof(int));
+    node_groups = (int *) malloc ( num_nodes * sizeof(int));
+    if ( NULL == node_start || NULL == node_groups ) {
+        opal_output (1, "OUT OF MEMORY\n");
+        ret = OMPI_ERR_OUT_OF_RESOURCE;
+        goto exit;
+    }
+    for ( i = 0, n = 0; i < fh->f_size; i++ ) {
+        if ( 0 == i || layout[2*order[i]] != layout[2*order[i-1]] ) {
+            node_start[n++] = i;
+        }
+    }
+    node_start[num_nodes] = fh->f_size;
+
+    if ( num_groups < num_nodes ) {
+        for ( g = 0; g < num_groups; g++ ) {
+            int first = node_start[(g * num_nodes) / num_groups];
+            int last  = node_start[((g + 1) * num_nodes) / num_groups];
+
+            contg_groups[g].procs_per_contg_group = last - first;
+            memcpy ( contg_groups[g].procs_in_contg_group, &order[first],
+                     (last - first) * sizeof(int));
+        }
+        goto exit;
+    }
+
+    /* one aggregator per node, the remaining ones go one at a time to the
+    ** node with the most processes per aggregator */
+    for ( n = 0; n < num_nodes; n++ ) {
+        node_groups[n] = 1;
+    }
+    for ( remaining = num_groups - num_nodes; remaining > 0; remaining-- ) {
+        best = -1;
+        for ( n = 0; n < num_nodes; n++ ) {
+            size = node_start[n+1] - node_start[n];
+            if ( node_groups[n] >= size ) {
+                continue;
+            }
+            if ( -1 == best ||
+                 size * node_groups[best] > (node_start[best+1] - node_start[best]) * node_groups[n] ) {
+                best = n;
+            }
+        }
+        if ( -1 == best ) {
+            break;
+        }
+        node_groups[best]++;
+    }
+
+    for ( n = 0, g = 0; n < num_nodes; n++ ) {
+        size = node_start[n+1] - node_start[n];
+        group_size = size / node_groups[n];
+        rest = size % node_groups[n];
+        for ( i = 0, k = node_start[n]; i < node_groups[n]; i++, g++ ) {
+            contg_groups[g].procs_per_contg_group = ( i < rest ) ? group_size + 1 : group_size;
+            memcpy ( contg_groups[g].procs_in_contg_group, &order[k],
+                     contg_groups[g].procs_per_contg_group * sizeof(int));
+            k += contg_groups[g].procs_per_contg_group;
+        }
+    }
+
+exit:
+    free ( layout );
+    free ( order );
+    free ( tmp );
+    free ( count );
+    free ( node_start );
+    free ( node_groups );
+
+    return ret;
+}
+
+typedef struct {
+    int node;
+    int socket;
+    int rank;
+} topo_layout_entry_t;
+
+static int topo_layout_cmp_node (const void *a, const void *b)
+{
+    const topo_layout_entry_t *ea = (const topo_layout_entry_t *) a;
+    const topo_layout_entry_t *eb = (const topo_layout_entry_t *) b;
+
+    if ( ea->node != eb->node ) {
+        return ( ea->node < eb->node ) ? -1 : 1;
+    }
+    return ea->rank - eb->rank;
+}
+
+static int topo_layout_cmp_socket (const void *a, const void *b)
+{
+    const topo_layout_entry_t *ea = (const topo_layout_entry_t *) a;
+    const topo_layout_entry_t *eb = (const topo_layout_entry_t *) b;
+
+    if ( ea->node != eb->node ) {
+        return ( ea->node < eb->node ) ? -1 : 1;
+    }
+    if ( ea->socket != eb->socket ) {
+        return ( ea->socket < eb->socket ) ? -1 : 1;
+    }
+    return ea->rank - eb->rank;
+}
+
+/*
+** Node and socket of every process, identified by the lowest rank on
+** them: layout[2*rank] and layout[2*rank+1]. Every process contributes
+** its own node id and socket to an allgather, the peers are not looked
+** up since that would create the proc of every process of the
+** communicator.
+*/
+static int topo_layout (ompio_file_t *fh, int *layout)
+{
+    topo_layout_entry_t *entries = NULL;
+    uint32_t nodeid, *pnodeid = &nodeid;
+    char *socket;
+    int my_location[2];
+    int i, first, rc;
+
+    OPAL_MODEX_RECV_VALUE_OPTIONAL(rc, PMIX_NODEID, &OPAL_PROC_MY_NAME, &pnodeid, PMIX_UINT32);
+    my_location[0] = ( PMIX_SUCCESS == rc ) ? (int) nodeid : -1;
+    /* an unbound process is accounted to the first socket of its node */
+    socket = opal_hwloc_base_get_location ( opal_process_info.locality, HWLOC_OBJ_SOCKET, 0 );
+    my_location[1] = ( NULL != socket ) ? atoi ( socket ) : 0;
+    free ( socket );
+
+    rc = fh->f_comm->c_coll->coll_allgather ( my_location, 2, MPI_INT,
+                                              layout, 2, MPI_INT,
+                                              fh->f_comm,
+                                              fh->f_comm->c_coll->coll_allgather_module );
+    if ( OMPI_SUCCESS != rc ) {
+        return rc;
+    }
+
+    entries = (topo_layout_entry_t *) malloc ( fh->f_size * sizeof(topo_layout_entry_t));
+    if ( NULL == entries ) {
+        opal_output (1, "OUT OF MEMORY\n");
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+    for ( i = 0; i < fh->f_size; i++ ) {
+        if ( -1 == layout[2*i] ) {
+            free ( entries );
+            return OMPI_ERR_NOT_AVAILABLE;
+        }
+        entries[i].node   = layout[2*i];
+        entries[i].socket = layout[2*i+1];
+        entries[i].rank   = i;
+    }
+
+    /* the first entry of a node (socket) after sorting has the lowest rank */
+    qsort ( entries, fh->f_size, sizeof(topo_layout_entry_t), topo_layout_cmp_node );
+    for ( i = 0, first = 0; i < fh->f_size; i++ ) {
+        if ( entries[i].node != entries[first].node ) {
+            first = i;
+        }
+        layout[2*entries[i].rank] = entries[first].rank;
+    }
+    qsort ( entries, fh->f_size, sizeof(topo_layout_entry_t), topo_layout_cmp_socket );
+    for ( i = 0, first = 0; i < fh->f_size; i++ ) {
+        if ( entries[i].node != entries[first].node ||
+             entries[i].socket != entries[first].socket ) {
+            first = i;
+        }
+        layout[2*entries[i].rank + 1] = entries[first].rank;
+    }
+
+    free ( entries );
+    return OMPI_SUCCESS;
+}
+
 int mca_common_ompio_fview_based_grouping(ompio_file_t *fh,
                      		          int *num_groups,
 				          mca_common_ompio_contg *contg_groups)
@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2026      The Open MPI Project.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+
+#include "ompi/info/info.h"
+#include "ompi/mca/fbtl/fbtl.h"
+
+#include "common_ompio.h"
+#include "common_ompio_cache.h"
+
+void mca_common_ompio_cache_init (ompio_file_t *fh)
+{
+    opal_cstring_t *cache_str;
+    int flag, cache_size;
+
+    cache_size = OMPIO_MCA_GET(fh, cache_size);
+    opal_info_get (fh->f_info, "ompio_cache_size", &cache_str, &flag);
+    if ( flag ) {
+        /* Info object trumps mca parameter value */
+        sscanf ( cache_str->string, "%d", &cache_size );
+        OMPIO_MCA_PRINT_INFO(fh, "ompio_cache_size", cache_str->string, "");
+        OBJ_RELEASE(cache_str);
+    }
+
+    fh->f_cache_buf    = NULL;
+    fh->f_cache_size   = ( 0 < cache_size ) ? (size_t) cache_size : 0;
+    fh->f_cache_offset = 0;
+    fh->f_cache_len    = 0;
+    fh->f_cache_dirty  = false;
+}
+
+void mca_common_ompio_cache_fini (ompio_file_t *fh)
+{
+    free ( fh->f_cache_buf );
+    fh->f_cache_buf  = NULL;
+    fh->f_cache_len  = 0;
+    fh->f_cache_dirty = false;
+}
+
+/* single contiguous access through the fbtl, the io array of the
+   operation in progress is restored afterwards */
+static ssize_t cache_io (ompio_file_t *fh, OMPI_MPI_OFFSET_TYPE offset,
+                         void *buf, size_t len, bool is_write)
+{
+    mca_common_ompio_io_array_t entry;
+    mca_common_ompio_io_array_t *io_array = fh->f_io_array;
+    int num_of_io_entries = fh->f_num_of_io_entries;
+    ssize_t ret;
+
+    entry.memory_address = buf;
+    entry.offset = (IOVBASE_TYPE *)(intptr_t) offset;
+    entry.length = len;
+
+    fh->f_io_array = &entry;
+    fh->f_num_of_io_entries = 1;
+    if ( is_write ) {
+        ret = fh->f_fbtl->fbtl_pwritev (fh);
+    }
+    else {
+        ret = fh->f_fbtl->fbtl_preadv (fh);
+    }
+    fh->f_io_array = io_array;
+    fh->f_num_of_io_entries = num_of_io_entries;
+
+    return ret;
+}
+
+int mca_common_ompio_cache_flush (ompio_file_t *fh)
+{
+    ssize_t ret = 0;
+
+    if ( fh->f_cache_dirty && 0 < fh->f_cache_len ) {
+        ret = cache_io (fh, fh->f_cache_offset, fh->f_cache_buf, fh->f_cache_len, true);
+    }
+    fh->f_cache_len   = 0;
+    fh->f_cache_dirty = false;
+
+    if ( 0 > ret ) {
+        opal_output (1, "mca_common_ompio_cache_flush: error writing cached data\n");
+        return (int) ret;
+    }
+    return OMPI_SUCCESS;
+}
+
+/* Whether the current io array should go through the cache: only
+   accesses smaller than the buffer are worth copying. */
+static bool cache_use (ompio_file_t *fh, size_t *total)
+{
+    int i;
+
+    *total = 0;
+    for ( i = 0; i < fh->f_num_of_io_entries; i++ ) {
+        *total += fh->f_io_array[i].length;
+    }
+    if ( *total >= fh->f_cache_size ) {
+        return false;
+    }
+
+    if ( NULL == fh->f_cache_buf ) {
+        fh->f_cache_buf = (char *) malloc ( fh->f_cache_size );
+    }
+    return NULL != fh->f_cache_buf;
+}
+
+ssize_t mca_common_ompio_cache_pwritev (ompio_file_t *fh)
+{
+    OMPI_MPI_OFFSET_TYPE off, end;
+    size_t total, len;
+    int i, ret;
+
+    if ( !cache_use (fh, &total) ) {
+        /* the data written might overlap with what is cached */
+        ret = mca_common_ompio_cache_flush (fh);
+        if ( OMPI_SUCCESS != ret ) {
+            return ret;
+        }
+        return fh->f_fbtl->fbtl_pwritev (fh);
+    }
+
+    if ( !fh->f_cache_dirty ) {
+        /* drop the data read ahead */
+        fh->f_cache_len = 0;
+    }
+
+    for ( i = 0; i < fh->f_num_of_io_entries; i++ ) {
+        off = (OMPI_MPI_OFFSET_TYPE)(intptr_t) fh->f_io_array[i].offset;
+        len = fh->f_io_array[i].length;
+        end = fh->f_cache_offset + (OMPI_MPI_OFFSET_TYPE) fh->f_cache_len;
+
+        /* the cached data has to stay contiguous, write it out if the
+           new piece would leave a gap or does not fit behind it */
+        if ( 0 < fh->f_cache_len &&
+             ( off < fh->f_cache_offset || off > end ||
+               off + (OMPI_MPI_OFFSET_TYPE) len >
+               fh->f_cache_offset + (OMPI_MPI_OFFSET_TYPE) fh->f_cache_size ) ) {
+            ret = mca_common_ompio_cache_flush (fh);
+            if ( OMPI_SUCCESS != ret ) {
+                return ret;
+            }
+        }
+        if ( 0 == fh->f_cache_len ) {
+            fh->f_cache_offset = off;
+            fh->f_cache_dirty  = true;
+        }
+
+        memcpy ( fh->f_cache_buf + (off - fh->f_cache_offset),
+                 fh->f_io_array[i].memory_address, len );
+        if ( (size_t)(off - fh->f_cache_offset) + len > fh->f_cache_len ) {
+            fh->f_cache_len = (size_t)(off - fh->f_cache_offset) + len;
+        }
+    }
+
+    return (ssize_t) total;
+}
+
+ssize_t mca_common_ompio_cache_preadv (ompio_file_t *fh)
+{
+    OMPI_MPI_OFFSET_TYPE off, end;
+    size_t total, len, avail;
+    ssize_t bytes_read = 0, ret_code;
+    int i, ret;
+
+    /* data written through the cache has to be visible to the read */
+    if ( fh->f_cache_dirty ) {
+        ret = mca_common_ompio_cache_flush (fh);
+        if ( OMPI_SUCCESS != ret ) {
+            return ret;
+        }
+    }
+
+    if ( !cache_use (fh, &total) ) {
+        return fh->f_fbtl->fbtl_preadv (fh);
+    }
+
+    for ( i = 0; i < fh->f_num_of_io_entries; i++ ) {
+        off = (OMPI_MPI_OFFSET_TYPE)(intptr_t) fh->f_io_array[i].offset;
+        len = fh->f_io_array[i].length;
+        end = fh->f_cache_offset + (OMPI_MPI_OFFSET_TYPE) fh->f_cache_len;
+
+        if ( 0 == fh->f_cache_len || off < fh->f_cache_offset ||
+             off + (OMPI_MPI_OFFSET_TYPE) len > end ) {
+            /* read a whole buffer starting at this piece, the following
+               sequential reads are served out of memory */
+            ret_code = cache_io (fh, off, fh->f_cache_buf, fh->f_cache_size, false);
+            if ( 0 > ret_code ) {
+                fh->f_cache_len = 0;
+                return ret_code;
+            }
+            fh->f_cache_offset = off;
+            fh->f_cache_len    = (size_t) ret_code;
+            end = off + ret_code;
+        }
+
+        /* a short read at the end of the file */
+        avail = ( off + (OMPI_MPI_OFFSET_TYPE) len > end ) ? (size_t)(end - off) : len;
+        memcpy ( fh->f_io_array[i].memory_address,
+                 fh->f_cache_buf + (off - fh->f_cache_offset), avail );
+        bytes_read += avail;
+    }
+
+    return bytes_read;
+}
@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2026      The Open MPI Project.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#ifndef MCA_COMMON_OMPIO_CACHE_H
+#define MCA_COMMON_OMPIO_CACHE_H
+
+/*
+ * Write-behind and read-ahead cache of the individual file operations.
+ *
+ * Every file handle owns (at most) one buffer of f_cache_size bytes. It
+ * either holds data written by this process which has not been passed
+ * to the fbtl yet, or data read ahead of the last individual read. Small
+ * adjacent writes are coalesced in the buffer, small reads are served
+ * out of it. The buffer is flushed on sync, close, collective operations
+ * and every operation that changes or reports the size of the file. It
+ * is not used in atomic mode.
+ */
+
+#define OMPIO_CACHE_ENABLED(_fh) (0 < (_fh)->f_cache_size && 0 == (_fh)->f_atomicity)
+
+void mca_common_ompio_cache_init (ompio_file_t *fh);
+void mca_common_ompio_cache_fini (ompio_file_t *fh);
+
+/* write the cached data to the file and drop any data read ahead */
+int mca_common_ompio_cache_flush (ompio_file_t *fh);
+
+/* replacements for fbtl_preadv/fbtl_pwritev for fh->f_io_array */
+ssize_t mca_common_ompio_cache_preadv (ompio_file_t *fh);
+ssize_t mca_common_ompio_cache_pwritev (ompio_file_t *fh);
+
+#endif
@@ -40,11 +40,14 @@
 #include <unistd.h>
 #include <math.h>
 #include "common_ompio.h"
+#include "common_ompio_cache.h"
 #include "ompi/mca/topo/topo.h"
 
 static mca_common_ompio_generate_current_file_view_fn_t generate_current_file_view_fn;
 static mca_common_ompio_get_mca_parameter_value_fn_t get_mca_parameter_value_fn;
 
+static int compressed_probe (ompio_file_t *fh);
+
 int mca_common_ompio_file_open (ompi_communicator_t *comm,
                                 const char *filename,
                                 int amode,
@@ -183,6 +186,14 @@ int mca_common_ompio_file_open (ompi_communicator_t *comm,
 	}
     }
 
+    if ( true == use_sharedfp ) {
+        /* has to be known before the fcoll component is selected */
+        ret = compressed_probe (ompio_fh);
+        if ( OMPI_SUCCESS != ret ) {
+            goto fn_fail;
+        }
+    }
+
     /* Set default file view */
     mca_common_ompio_set_view(ompio_fh,
                               0,
@@ -232,6 +243,7 @@ int mca_common_ompio_file_open (ompi_communicator_t *comm,
 int mca_common_ompio_file_close (ompio_file_t *ompio_fh)
 {
     int ret = OMPI_SUCCESS;
+    int flush_ret = OMPI_SUCCESS;
     int delete_flag = 0;
     char name[256];
 
@@ -240,6 +252,13 @@ int mca_common_ompio_file_close (ompio_file_t *ompio_fh)
         return OMPI_SUCCESS;
     }
 
+    /* A failed flush is reported once the file is closed, the other
+       processes still wait in the barrier below */
+    if ( NULL != ompio_fh->f_fbtl ) {
+        flush_ret = mca_common_ompio_cache_flush (ompio_fh);
+    }
+    mca_common_ompio_cache_fini (ompio_fh);
+
     ret = ompio_fh->f_comm->c_coll->coll_barrier ( ompio_fh->f_comm, ompio_fh->f_comm->c_coll->coll_barrier_module);
     if ( OMPI_SUCCESS != ret ) {
         /* Not sure what to do */
@@ -377,6 +396,9 @@ int mca_common_ompio_file_close (ompio_file_t *ompio_fh)
         ompi_comm_free (&ompio_fh->f_comm);
     }
 
+    if ( OMPI_SUCCESS != flush_ret ) {
+        return flush_ret;
+    }
     return ret;
 }
 
@@ -385,6 +407,10 @@ int mca_common_ompio_file_get_size (ompio_file_t *ompio_fh,
 {
     int ret = OMPI_SUCCESS;
 
+    ret = mca_common_ompio_cache_flush (ompio_fh);
+    if ( OMPI_SUCCESS != ret ) {
+        return ret;
+    }
     ret = ompio_fh->f_fs->fs_file_get_size (ompio_fh, size);
 
     return ret;
@@ -429,6 +455,7 @@ int mca_common_ompio_set_file_defaults (ompio_file_t *fh)
        fh->f_io_array = NULL;
        fh->f_perm = OMPIO_PERM_NULL;
        fh->f_flags = 0;
+       fh->f_compressed_block_size = 0;
        
        fh->f_bytes_per_agg = OMPIO_MCA_GET(fh, bytes_per_agg);
        opal_info_get (fh->f_info, "cb_buffer_size", &stripe_str, &flag);
@@ -488,6 +515,8 @@ int mca_common_ompio_set_file_defaults (ompio_file_t *fh)
                                     types,
                                     &fh->f_iov_type);
        ompi_datatype_commit (&fh->f_iov_type);
+
+       mca_common_ompio_cache_init (fh);
        
        return OMPI_SUCCESS;
    }
@@ -496,6 +525,69 @@ int mca_common_ompio_set_file_defaults (ompio_file_t *fh)
    }
 }
 
+/*
+ * A file written with compression by fcoll/vulcan starts with a header
+ * giving the block size of its frames. The file can then only be
+ * accessed through the collective operations of vulcan, which decode
+ * the frames in the terms of the header.
+ */
+static int compressed_probe (ompio_file_t *fh)
+{
+    mca_common_ompio_compressed_header_t header;
+    mca_common_ompio_io_array_t entry;
+    uint64_t block_size = 0;
+    ssize_t ret_code;
+    int ret;
+
+    if ( OMPIO_ROOT == fh->f_rank ) {
+        memset (&header, 0, sizeof(header));
+        entry.memory_address = &header;
+        entry.offset = (IOVBASE_TYPE *)(intptr_t) 0;
+        entry.length = sizeof(header);
+
+        fh->f_io_array = &entry;
+        fh->f_num_of_io_entries = 1;
+        /* a file that cannot be read (write only) is treated as plain */
+        ret_code = fh->f_fbtl->fbtl_preadv (fh);
+        fh->f_io_array = NULL;
+        fh->f_num_of_io_entries = 0;
+
+        if ( sizeof(header) == (size_t) ret_code &&
+             OMPIO_COMPRESSED_MAGIC == header.magic &&
+             OMPIO_COMPRESSED_VERSION == header.version ) {
+            block_size = header.block_size;
+        }
+    }
+
+    ret = fh->f_comm->c_coll->coll_bcast (&block_size, 1, MPI_UINT64_T, OMPIO_ROOT,
+                                          fh->f_comm, fh->f_comm->c_coll->coll_bcast_module);
+    if ( OMPI_SUCCESS != ret ) {
+        return ret;
+    }
+    fh->f_compressed_block_size = (size_t) block_size;
+    return OMPI_SUCCESS;
+}
+
+/*
+ * The frames of a compressed file are only decoded by the collective
+ * operations of fcoll/vulcan. Any other access would hand out or
+ * overwrite the raw frames.
+ */
+int mca_common_ompio_check_compressed (ompio_file_t *fh, bool collective)
+{
+    if ( 0 == fh->f_compressed_block_size ) {
+        return OMPI_SUCCESS;
+    }
+    if ( collective && NULL != fh->f_fcoll_component &&
+         0 == strcmp (fh->f_fcoll_component->mca_component_name, "vulcan") ) {
+        return OMPI_SUCCESS;
+    }
+
+    opal_output (1, "File %s is stored compressed and can only be accessed with "
+                 "collective operations of the vulcan fcoll component\n", fh->f_filename);
+    return OMPI_ERR_NOT_SUPPORTED;
+}
+
 
 int mca_common_ompio_file_delete (const char *filename,
                                   struct opal_info_t *info)
@@ -34,6 +34,7 @@
 #include "common_ompio.h"
 #include "common_ompio_request.h"
 #include "common_ompio_buffer.h"
+#include "common_ompio_cache.h"
 #include <unistd.h>
 #include <math.h>
 
@@ -81,6 +82,11 @@ int mca_common_ompio_file_read (ompio_file_t *fh,
       return ret;
     }
 
+    ret = mca_common_ompio_check_compressed (fh, false);
+    if ( OMPI_SUCCESS != ret ) {
+        return ret;
+    }
+
     if ( 0 == count ) {
         if ( MPI_STATUS_IGNORE != status ) {
             status->_ucount = 0;
@@ -168,7 +174,12 @@ int mca_common_ompio_file_read (ompio_file_t *fh,
                                           &fh->f_num_of_io_entries);
 
         if (fh->f_num_of_io_entries) {
-            ret_code = fh->f_fbtl->fbtl_preadv (fh);
+            if ( OMPIO_CACHE_ENABLED(fh) ) {
+                ret_code = mca_common_ompio_cache_preadv (fh);
+            }
+            else {
+                ret_code = fh->f_fbtl->fbtl_preadv (fh);
+            }
             if ( 0<= ret_code ) {
                 real_bytes_read+=(size_t)ret_code;
             }
@@ -245,6 +256,18 @@ int mca_common_ompio_file_iread (ompio_file_t *fh,
       return ret;
     }
 
+    ret = mca_common_ompio_check_compressed (fh, false);
+    if ( OMPI_SUCCESS != ret ) {
+        return ret;
+    }
+
+    /* the operation bypasses the cache, data written through it has to
+       be visible */
+    ret = mca_common_ompio_cache_flush (fh);
+    if ( OMPI_SUCCESS != ret ) {
+        return ret;
+    }
+
     mca_common_ompio_request_alloc ( &ompio_req, MCA_OMPIO_REQUEST_READ);
 
     if ( 0 == count ) {
@@ -411,6 +434,15 @@ int mca_common_ompio_file_read_all (ompio_file_t *fh,
 {
     int ret = OMPI_SUCCESS;
 
+    ret = mca_common_ompio_check_compressed (fh, true);
+    if ( OMPI_SUCCESS != ret ) {
+        return ret;
+    }
+
+    ret = mca_common_ompio_cache_flush (fh);
+    if ( OMPI_SUCCESS != ret ) {
+        return ret;
+    }
 
     if ( !( fh->f_flags & OMPIO_DATAREP_NATIVE ) &&
          !(datatype == &ompi_mpi_byte.dt  ||
@@ -489,7 +521,22 @@ int mca_common_ompio_file_iread_all (ompio_file_t *fp,
 {
     int ret = OMPI_SUCCESS;
 
-    if ( NULL != fp->f_fcoll->fcoll_file_iread_all ) {
+    ret = mca_common_ompio_check_compressed (fp, true);
+    if ( OMPI_SUCCESS != ret ) {
+        return ret;
+    }
+
+    ret = mca_common_ompio_cache_flush (fp);
+    if ( OMPI_SUCCESS != ret ) {
+        return ret;
+    }
+
+    /* the fcoll components do not convert the data, other data
+       representations use the individual operations which do */
+    if ( NULL != fp->f_fcoll->fcoll_file_iread_all &&
+         ( (fp->f_flags & OMPIO_DATAREP_NATIVE) ||
+           datatype == &ompi_mpi_byte.dt ||
+           datatype == &ompi_mpi_char.dt ) ) {
 	ret = fp->f_fcoll->fcoll_file_iread_all (fp,
 						 buf,
 						 count,
@@ -251,7 +251,11 @@ int mca_common_ompio_set_view (ompio_file_t *fh,
         if ( num_groups > fh->f_size ) {
             num_groups = fh->f_size;
         }
-        mca_common_ompio_forced_grouping ( fh, num_groups, contg_groups);
+        ret = mca_common_ompio_forced_grouping ( fh, num_groups, contg_groups);
+        if ( OMPI_SUCCESS != ret ) {
+            opal_output(1, "mca_common_ompio_set_view: mca_io_ompio_forced_grouping failed\n");
+            goto exit;
+        }
     }
     else {
         if ( SIMPLE != OMPIO_MCA_GET(fh, grouping_option) && 
@@ -356,6 +360,10 @@ int mca_common_ompio_set_view (ompio_file_t *fh,
         /* user requested using an info object to disable collective buffering. */
         preferred = mca_fcoll_base_component_lookup ("individual");
     }
+    if ( 0 < fh->f_compressed_block_size ) {
+        /* only vulcan can decode the frames of a compressed file */
+        preferred = mca_fcoll_base_component_lookup ("vulcan");
+    }
     ret = mca_fcoll_base_file_select (fh, (mca_base_component_t *)preferred);
     if ( OMPI_SUCCESS != ret ) {
         opal_output(1, "mca_common_ompio_set_view: mca_fcoll_base_file_select() failed\n");
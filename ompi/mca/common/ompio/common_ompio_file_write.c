@@ -32,6 +32,7 @@
 #include "common_ompio.h"
 #include "common_ompio_request.h"
 #include "common_ompio_buffer.h"
+#include "common_ompio_cache.h"
 #include <unistd.h>
 #include <math.h>
 
@@ -61,6 +62,11 @@ int mca_common_ompio_file_write (ompio_file_t *fh,
       return ret;
     }
 
+    ret = mca_common_ompio_check_compressed (fh, false);
+    if ( OMPI_SUCCESS != ret ) {
+        return ret;
+    }
+
     
     if ( 0 == count ) {
         if ( MPI_STATUS_IGNORE != status ) {
@@ -151,7 +157,12 @@ int mca_common_ompio_file_write (ompio_file_t *fh,
                                           &fh->f_num_of_io_entries);
 
         if (fh->f_num_of_io_entries) {
-            ret_code =fh->f_fbtl->fbtl_pwritev (fh);
+            if ( OMPIO_CACHE_ENABLED(fh) ) {
+                ret_code = mca_common_ompio_cache_pwritev (fh);
+            }
+            else {
+                ret_code =fh->f_fbtl->fbtl_pwritev (fh);
+            }
             if ( 0<= ret_code ) {
                 real_bytes_written+= (size_t)ret_code;
             }
@@ -220,7 +231,18 @@ int mca_common_ompio_file_iwrite (ompio_file_t *fh,
         ret = MPI_ERR_READ_ONLY;
       return ret;
     }
+
+    ret = mca_common_ompio_check_compressed (fh, false);
+    if ( OMPI_SUCCESS != ret ) {
+        return ret;
+    }
     
+    /* the operation bypasses the cache and might overlap with it */
+    ret = mca_common_ompio_cache_flush (fh);
+    if ( OMPI_SUCCESS != ret ) {
+        return ret;
+    }
+
     mca_common_ompio_request_alloc ( &ompio_req, MCA_OMPIO_REQUEST_WRITE);
 
     if ( 0 == count ) {
@@ -387,6 +409,16 @@ int mca_common_ompio_file_write_all (ompio_file_t *fh,
                                      ompi_status_public_t *status)
 {
     int ret = OMPI_SUCCESS;
+
+    ret = mca_common_ompio_check_compressed (fh, true);
+    if ( OMPI_SUCCESS != ret ) {
+        return ret;
+    }
+
+    ret = mca_common_ompio_cache_flush (fh);
+    if ( OMPI_SUCCESS != ret ) {
+        return ret;
+    }
     
     if ( !( fh->f_flags & OMPIO_DATAREP_NATIVE ) &&
          !(datatype == &ompi_mpi_byte.dt  ||
@@ -467,7 +499,22 @@ int mca_common_ompio_file_iwrite_all (ompio_file_t *fp,
 {
     int ret = OMPI_SUCCESS;
 
-    if ( NULL != fp->f_fcoll->fcoll_file_iwrite_all ) {
+    ret = mca_common_ompio_check_compressed (fp, true);
+    if ( OMPI_SUCCESS != ret ) {
+        return ret;
+    }
+
+    ret = mca_common_ompio_cache_flush (fp);
+    if ( OMPI_SUCCESS != ret ) {
+        return ret;
+    }
+
+    /* the fcoll components do not convert the data, other data
+       representations use the individual operations which do */
+    if ( NULL != fp->f_fcoll->fcoll_file_iwrite_all &&
+         ( (fp->f_flags & OMPIO_DATAREP_NATIVE) ||
+           datatype == &ompi_mpi_byte.dt ||
+           datatype == &ompi_mpi_char.dt ) ) {
 	ret = fp->f_fcoll->fcoll_file_iwrite_all (fp,
 						  buf,
 						  count,
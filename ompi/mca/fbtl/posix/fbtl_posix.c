@@ -316,3 +316,42 @@ bool mca_fbtl_posix_check_atomicity ( ompio_file_t *file)
 #endif
     return true;
 }
+
+/*
+ * Data sieving reads (and for writes also rewrites) the whole extent
+ * covered by the io array, gaps included. It only pays off for many
+ * small pieces separated by small gaps, with a sufficient fraction of
+ * the extent actually being accessed. The entries have to be ordered
+ * by offset and must not overlap.
+ */
+bool mca_fbtl_posix_check_datasieving ( ompio_file_t *fh, bool enabled )
+{
+    size_t total_bytes, total_gap = 0;
+    off_t offset, end_offset;
+    int i, num_entries = fh->f_num_of_io_entries;
+
+    if ( !enabled || num_entries < 2 ) {
+        return false;
+    }
+
+    total_bytes = fh->f_io_array[0].length;
+    end_offset  = (off_t)fh->f_io_array[0].offset + (off_t)fh->f_io_array[0].length;
+    for ( i=1; i < num_entries; i++ ) {
+        offset = (off_t)fh->f_io_array[i].offset;
+        if ( offset < end_offset ) {
+            return false;
+        }
+        total_gap   += (size_t)(offset - end_offset);
+        total_bytes += fh->f_io_array[i].length;
+        end_offset   = offset + (off_t)fh->f_io_array[i].length;
+    }
+
+    if ( 0 == total_gap ||
+         total_bytes / num_entries > mca_fbtl_posix_max_block_size ||
+         total_gap / (num_entries - 1) > mca_fbtl_posix_max_gap_size ||
+         total_bytes * 100 < (total_bytes + total_gap) * (size_t) mca_fbtl_posix_min_density ) {
+        return false;
+    }
+
+    return true;
+}
@@ -31,9 +31,11 @@
 extern int mca_fbtl_posix_priority;
 extern bool mca_fbtl_posix_read_datasieving;
 extern bool mca_fbtl_posix_write_datasieving;
+extern bool mca_fbtl_posix_independent_write_datasieving;
 extern size_t mca_fbtl_posix_max_block_size;
 extern size_t mca_fbtl_posix_max_gap_size;
 extern size_t mca_fbtl_posix_max_tmpbuf_size;
+extern int mca_fbtl_posix_min_density;
 
 BEGIN_C_DECLS
 
@@ -65,6 +67,7 @@ ssize_t mca_fbtl_posix_ipwritev (ompio_file_t *file,
 bool mca_fbtl_posix_progress     ( mca_ompio_request_t *req);
 void mca_fbtl_posix_request_free ( mca_ompio_request_t *req);
 bool mca_fbtl_posix_check_atomicity ( ompio_file_t *file);
+bool mca_fbtl_posix_check_datasieving ( ompio_file_t *file, bool enabled);
 
 int mca_fbtl_posix_lock ( struct flock *lock, ompio_file_t *fh, int op, 
                           OMPI_MPI_OFFSET_TYPE iov_offset, off_t len, int flags,
@@ -39,9 +39,11 @@ const char *mca_fbtl_posix_component_version_string =
 int mca_fbtl_posix_priority = 10;
 bool mca_fbtl_posix_read_datasieving  = true;
 bool mca_fbtl_posix_write_datasieving = true;
+bool mca_fbtl_posix_independent_write_datasieving = false;
 size_t mca_fbtl_posix_max_block_size  = 1048576;  // 1MB
 size_t mca_fbtl_posix_max_gap_size    = 4096;     // Size of a block in many linux fs
 size_t mca_fbtl_posix_max_tmpbuf_size = 67108864; // 64 MB
+int mca_fbtl_posix_min_density = 10;               // percent
 /*
  * Private functions
  */
@@ -110,6 +112,15 @@ static int register_component(void)
                                            OPAL_INFO_LVL_9,
                                            MCA_BASE_VAR_SCOPE_READONLY,
                                            &mca_fbtl_posix_max_tmpbuf_size );
+
+    mca_fbtl_posix_min_density = 10;
+    (void) mca_base_component_var_register(&mca_fbtl_posix_component.fbtlm_version,
+                                           "min_density", "Minimum percentage of the file extent covered by an iovec that has to be "
+                                           "accessed for data sieving. A lower ratio will disable data sieving. Default: 10.",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_fbtl_posix_min_density );
     
     mca_fbtl_posix_read_datasieving  = true;
     (void) mca_base_component_var_register(&mca_fbtl_posix_component.fbtlm_version,
@@ -129,6 +140,17 @@ static int register_component(void)
                                            MCA_BASE_VAR_SCOPE_READONLY,
                                            &mca_fbtl_posix_write_datasieving );
 
+    mca_fbtl_posix_independent_write_datasieving  = false;
+    (void) mca_base_component_var_register(&mca_fbtl_posix_component.fbtlm_version,
+                                           "independent_write_datasieving", "Parameter indicating whether to perform data sieving for "
+                                           "independent write operations. The sieved region is locked, but other writes are not "
+                                           "unless the file system requires it: only enable this if no other process writes into "
+                                           "the gaps concurrently. Default: false.",
+                                           MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_fbtl_posix_independent_write_datasieving );
+
     
     return OMPI_SUCCESS;
 }
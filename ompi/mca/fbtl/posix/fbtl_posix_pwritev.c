@@ -51,29 +51,15 @@ ssize_t  mca_fbtl_posix_pwritev(ompio_file_t *fh )
     }
     
     if ( fh->f_num_of_io_entries > 1 ) {
-        bool do_data_sieving = true;
+        /* the read-modify-write is protected against other processes by
+           the file lock, but not against other threads of this process.
+           Independent writes of other processes do not necessarily lock,
+           sieving them is only done on request */
+        bool enabled = mca_fbtl_posix_write_datasieving &&
+            ((fh->f_flags & OMPIO_COLLECTIVE_OP) || mca_fbtl_posix_independent_write_datasieving);
+        bool do_data_sieving = mca_fbtl_posix_check_datasieving (fh, enabled) &&
+            !ompi_mpi_thread_multiple;
 
-        size_t avg_gap_size=0;
-        size_t avg_block_size = 0;
-        off_t prev_offset = (off_t)fh->f_io_array[0].offset;
-        int i;
-        for ( i=0; i< fh->f_num_of_io_entries; i++ ) {
-            avg_block_size += fh->f_io_array[i].length;
-            avg_gap_size   += (size_t)((off_t)fh->f_io_array[i].offset - prev_offset);
-            prev_offset     = (off_t)fh->f_io_array[i].offset;
-        }
-        avg_block_size = avg_block_size / fh->f_num_of_io_entries;
-        avg_gap_size = avg_gap_size / fh->f_num_of_io_entries;
-
-        if ( false == mca_fbtl_posix_write_datasieving      ||
-             0     == avg_gap_size                          ||
-             avg_block_size > mca_fbtl_posix_max_block_size ||
-             avg_gap_size   > mca_fbtl_posix_max_gap_size   ||
-             ompi_mpi_thread_multiple                       ||
-             !(fh->f_flags & OMPIO_COLLECTIVE_OP)            ) {
-            do_data_sieving = false;
-        }
-                
         if ( do_data_sieving) {
             bytes_written = mca_fbtl_posix_pwritev_datasieving (fh, &lock, &lock_counter);
         }
@@ -181,8 +167,19 @@ ssize_t mca_fbtl_posix_pwritev_datasieving (ompio_file_t *fh, struct flock *lock
             bufsize = len;
         }
         
-        // Read the entire block.
-        ret = mca_fbtl_posix_lock ( lock, fh, F_WRLCK, start, len, OMPIO_LOCK_ENTIRE_REGION, lock_counter ); 
+        // Read the entire block. The fcoll components hand out disjoint file
+        // domains, but independent writes of other processes might modify the
+        // gaps of this region: always lock it for those, so that at least
+        // concurrent sieving writes do not overwrite each other.
+        if ( !(fh->f_flags & OMPIO_COLLECTIVE_OP) ) {
+            int32_t orig_flags = fh->f_flags;
+            fh->f_flags &= ~(OMPIO_LOCK_NEVER | OMPIO_LOCK_NOT_THIS_OP);
+            ret = mca_fbtl_posix_lock ( lock, fh, F_WRLCK, start, len, OMPIO_LOCK_ENTIRE_REGION, lock_counter );
+            fh->f_flags = orig_flags;
+        }
+        else {
+            ret = mca_fbtl_posix_lock ( lock, fh, F_WRLCK, start, len, OMPIO_LOCK_ENTIRE_REGION, lock_counter );
+        }
         if ( 0 < ret ) {
             opal_output(1, "mca_fbtl_posix_pwritev_datasieving: error in mca_fbtl_posix_lock() ret=%d: %s",
                         ret, strerror(errno));
@@ -193,8 +190,9 @@ ssize_t mca_fbtl_posix_pwritev_datasieving (ompio_file_t *fh, struct flock *lock
         }
         
         int retries=0;
+        total_bytes = 0;
         while ( total_bytes < len ) {
-            ret_code = pread (fh->fd, temp_buf, len, start);
+            ret_code = pread (fh->fd, temp_buf+total_bytes, len-total_bytes, start+total_bytes);
             if ( ret_code == -1 ) {
                 opal_output(1, "mca_fbtl_posix_pwritev_datasieving: error in pread:%s", strerror(errno));
                 mca_fbtl_posix_unlock ( lock, fh, lock_counter);
@@ -213,7 +211,12 @@ ssize_t mca_fbtl_posix_pwritev_datasieving (ompio_file_t *fh, struct flock *lock
             }
             total_bytes += ret_code;
         }
-        
+        if ( total_bytes < len ) {
+            // the region extends beyond the end of the file, the gaps
+            // in there read as zeros
+            memset (temp_buf + total_bytes, 0, len - total_bytes);
+        }
+
         // Copy the elements to write into temporary buffer.
         size_t pos = 0;
         size_t num_bytes;
@@ -41,6 +41,8 @@ extern int mca_fcoll_vulcan_priority;
 extern int mca_fcoll_vulcan_num_groups;
 extern int mca_fcoll_vulcan_write_chunksize;
 extern int mca_fcoll_vulcan_async_io;
+extern bool mca_fcoll_vulcan_compression;
+extern size_t mca_fcoll_vulcan_compression_block_size;
 
 OMPI_MODULE_DECLSPEC extern mca_fcoll_base_component_2_0_0_t mca_fcoll_vulcan_component;
 
@@ -56,12 +58,30 @@ int mca_fcoll_vulcan_component_file_unquery (ompio_file_t *file);
 int mca_fcoll_vulcan_module_init (ompio_file_t *file);
 int mca_fcoll_vulcan_module_finalize (ompio_file_t *file);
 
+int mca_fcoll_vulcan_file_read_all (ompio_file_t *fh,
+                                    void *buf,
+                                    int count,
+                                    struct ompi_datatype_t *datatype,
+                                    ompi_status_public_t * status);
+
+int mca_fcoll_vulcan_file_iread_all (ompio_file_t *fh,
+                                     void *buf,
+                                     int count,
+                                     struct ompi_datatype_t *datatype,
+                                     ompi_request_t **request);
+
 int mca_fcoll_vulcan_file_write_all (ompio_file_t *fh,
                                      const void *buf,
                                      int count,
                                      struct ompi_datatype_t *datatype,
                                      ompi_status_public_t * status);
 
+int mca_fcoll_vulcan_file_iwrite_all (ompio_file_t *fh,
+                                      const void *buf,
+                                      int count,
+                                      struct ompi_datatype_t *datatype,
+                                      ompi_request_t **request);
+
 
 END_C_DECLS
 
@@ -44,6 +44,8 @@ int mca_fcoll_vulcan_priority = 10;
 int mca_fcoll_vulcan_num_groups = 1;
 int mca_fcoll_vulcan_write_chunksize = -1;
 int mca_fcoll_vulcan_async_io = 0;
+bool mca_fcoll_vulcan_compression = false;
+size_t mca_fcoll_vulcan_compression_block_size = 1048576;
 
 /*
  * Local function
@@ -111,5 +113,24 @@ vulcan_register(void)
                                            OPAL_INFO_LVL_9,
                                            MCA_BASE_VAR_SCOPE_READONLY, &mca_fcoll_vulcan_async_io);
 
+    mca_fcoll_vulcan_compression = false;
+    (void) mca_base_component_var_register(&mca_fcoll_vulcan_component.fcollm_version,
+                                           "compression", "Compress the data written by the aggregators into self-describing "
+                                           "blocks. Only applies to files empty when first written. Files written this way "
+                                           "are recognized when opened and can only be accessed through collective "
+                                           "operations of this component. Can be overridden by the "
+                                           "vulcan_compression info key. Default: false",
+                                           MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY, &mca_fcoll_vulcan_compression);
+
+    mca_fcoll_vulcan_compression_block_size = 1048576;
+    (void) mca_base_component_var_register(&mca_fcoll_vulcan_component.fcollm_version,
+                                           "compression_block_size", "Size of the blocks of the file compressed independently, "
+                                           "recorded in the file when it is created. Can be overridden by the vulcan_compression_block_size info key. Default: 1048576 bytes",
+                                           MCA_BASE_VAR_TYPE_SIZE_T, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY, &mca_fcoll_vulcan_compression_block_size);
+
     return OMPI_SUCCESS;
 }
@@ -0,0 +1,450 @@
+/*
+ * Copyright (c) 2026      The Open MPI Project.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+#include "fcoll_vulcan.h"
+#include "fcoll_vulcan_internal.h"
+
+#include "mpi.h"
+#include "ompi/constants.h"
+#include "ompi/info/info.h"
+#include "ompi/communicator/communicator.h"
+#include "ompi/mca/fs/fs.h"
+#include "ompi/mca/fbtl/fbtl.h"
+#include "ompi/mca/common/ompio/common_ompio.h"
+
+/*
+ * Compression of the data written by the aggregators.
+ *
+ * Compression is decided when a file is first written and only for an
+ * empty file, which then starts with a mca_common_ompio_compressed_header_t
+ * giving the block size. The file is split into logical blocks of
+ * block_size bytes. Block k is stored in a frame at offset
+ * file header + k * (block_size + frame header): a header telling how the
+ * block has been encoded, the block size and how many bytes of it hold
+ * data, followed by the encoded data. A block that does not shrink is stored
+ * as is, the frame is large enough for it. Every block can thus be
+ * located and decoded on its own, a block never written (a hole of the
+ * file) reads as zeros.
+ *
+ * The aggregator domains are aligned to the block size, a block is only
+ * ever modified by a single aggregator. Blocks partially written in a
+ * cycle are read, decoded and merged first.
+ *
+ * The encoding targets arrays of smooth floating point values: every
+ * 8 byte word is xor-ed with the previous one, and only the non-zero
+ * bytes of the result are stored, preceded by a mask byte.
+ */
+
+#define VULCAN_FRAME_MAGIC  0x4f435a31  /* "OCZ1" */
+#define VULCAN_CODEC_NONE   0
+#define VULCAN_CODEC_XOR    1
+
+typedef struct vulcan_frame_header {
+    uint32_t magic;
+    uint32_t codec;
+    uint64_t block_size;  /* has to match the one of the file header */
+    uint64_t raw_len;     /* bytes of the logical block holding data */
+    uint64_t stored_len;  /* bytes following the header */
+} vulcan_frame_header;
+
+#define VULCAN_FRAME_SIZE(_bs) ((_bs) + sizeof(vulcan_frame_header))
+#define VULCAN_FRAME_OFFSET(_bs, _index) ((OMPI_MPI_OFFSET_TYPE) sizeof(mca_common_ompio_compressed_header_t) + \
+                                          (_index) * (OMPI_MPI_OFFSET_TYPE) VULCAN_FRAME_SIZE(_bs))
+
+/* the block size asked for by the user, 0 if compression is not requested */
+size_t mca_fcoll_vulcan_compress_requested (ompio_file_t *fh)
+{
+    opal_cstring_t *info_str;
+    bool compression = mca_fcoll_vulcan_compression;
+    size_t block_size = mca_fcoll_vulcan_compression_block_size;
+    long long value;
+    int flag;
+
+    /* Info object trumps mca parameter value */
+    if (OPAL_SUCCESS == opal_info_get_bool (fh->f_info, "vulcan_compression", &compression, &flag) &&
+        flag) {
+        OMPIO_MCA_PRINT_INFO(fh, "vulcan_compression", compression ? "true" : "false", "");
+    }
+    if (!compression) {
+        return 0;
+    }
+
+    opal_info_get (fh->f_info, "vulcan_compression_block_size", &info_str, &flag);
+    if (flag) {
+        if (1 == sscanf (info_str->string, "%lld", &value) && 0 < value) {
+            block_size = (size_t) value;
+        }
+        OMPIO_MCA_PRINT_INFO(fh, "vulcan_compression_block_size", info_str->string, "");
+        OBJ_RELEASE(info_str);
+    }
+
+    return block_size;
+}
+
+/* the frames are always decoded in the terms of the file header */
+size_t mca_fcoll_vulcan_compress_block_size (ompio_file_t *fh)
+{
+    return fh->f_compressed_block_size;
+}
+
+/* returns the number of bytes stored in dst, 0 if the data does not shrink */
+static size_t xor_encode (const char *src, size_t len, char *dst)
+{
+    uint64_t word, prev = 0, x;
+    size_t in, out = 0, mask_pos;
+    unsigned char mask;
+    int b;
+
+    for (in = 0; in + sizeof(uint64_t) <= len; in += sizeof(uint64_t)) {
+        if (out + sizeof(uint64_t) + 1 > len) {
+            return 0;
+        }
+        memcpy (&word, src + in, sizeof(uint64_t));
+        x = word ^ prev;
+        prev = word;
+
+        mask_pos = out++;
+        mask = 0;
+        for (b = 0; b < 8; b++) {
+            if (0 != ((x >> (8 * b)) & 0xff)) {
+                mask |= (unsigned char) (1 << b);
+                dst[out++] = (char) ((x >> (8 * b)) & 0xff);
+            }
+        }
+        dst[mask_pos] = (char) mask;
+    }
+
+    if (out + (len - in) >= len) {
+        return 0;
+    }
+    memcpy (dst + out, src + in, len - in);
+    return out + (len - in);
+}
+
+static int xor_decode (const char *src, size_t stored_len, char *dst, size_t len)
+{
+    uint64_t prev = 0, x;
+    size_t in = 0, out;
+    unsigned char mask;
+    int b;
+
+    for (out = 0; out + sizeof(uint64_t) <= len; out += sizeof(uint64_t)) {
+        if (in >= stored_len) {
+            return OMPI_ERROR;
+        }
+        mask = (unsigned char) src[in++];
+        x = 0;
+        for (b = 0; b < 8; b++) {
+            if (mask & (1 << b)) {
+                if (in >= stored_len) {
+                    return OMPI_ERROR;
+                }
+                x |= ((uint64_t) (unsigned char) src[in++]) << (8 * b);
+            }
+        }
+        prev ^= x;
+        memcpy (dst + out, &prev, sizeof(uint64_t));
+    }
+
+    if (stored_len - in != len - out) {
+        return OMPI_ERROR;
+    }
+    memcpy (dst + out, src + in, len - out);
+    return OMPI_SUCCESS;
+}
+
+/* single contiguous access through the fbtl, the io array of the cycle
+   is restored afterwards */
+static ssize_t frame_io (ompio_file_t *fh, OMPI_MPI_OFFSET_TYPE offset,
+                         char *buf, size_t len, bool is_write)
+{
+    mca_common_ompio_io_array_t entry;
+    mca_common_ompio_io_array_t *io_array = fh->f_io_array;
+    int num_of_io_entries = fh->f_num_of_io_entries;
+    ssize_t ret;
+
+    entry.memory_address = buf;
+    entry.offset = (IOVBASE_TYPE *)(intptr_t) offset;
+    entry.length = len;
+
+    fh->f_io_array = &entry;
+    fh->f_num_of_io_entries = 1;
+    if (is_write) {
+        ret = fh->f_fbtl->fbtl_pwritev (fh);
+    }
+    else {
+        ret = fh->f_fbtl->fbtl_preadv (fh);
+    }
+    fh->f_io_array = io_array;
+    fh->f_num_of_io_entries = num_of_io_entries;
+
+    return ret;
+}
+
+/*
+ * Collective, called before a write is set up. A file that is still
+ * empty gets compressed if the user asked for it: rank 0 writes the file
+ * header. A file holding plain data is never turned into a compressed one.
+ */
+int mca_fcoll_vulcan_compress_init (ompio_file_t *fh)
+{
+    mca_common_ompio_compressed_header_t header;
+    OMPI_MPI_OFFSET_TYPE file_size = 0;
+    uint64_t block_size;
+    int ret;
+
+    if (0 < fh->f_compressed_block_size) {
+        return OMPI_SUCCESS;
+    }
+    block_size = mca_fcoll_vulcan_compress_requested (fh);
+    if (0 == block_size) {
+        return OMPI_SUCCESS;
+    }
+
+    /* a pending write could still be filling the file */
+    mca_fcoll_vulcan_coll_wait_pending (fh);
+
+    if (OMPIO_ROOT == fh->f_rank) {
+        ret = fh->f_fs->fs_file_get_size (fh, &file_size);
+        if (OMPI_SUCCESS != ret || 0 < file_size) {
+            block_size = 0;
+        }
+        else {
+            header.magic      = OMPIO_COMPRESSED_MAGIC;
+            header.version    = OMPIO_COMPRESSED_VERSION;
+            header.block_size = block_size;
+            if (sizeof(header) != (size_t) frame_io (fh, 0, (char *) &header, sizeof(header), true)) {
+                block_size = 0;
+            }
+        }
+    }
+
+    ret = fh->f_comm->c_coll->coll_bcast (&block_size, 1, MPI_UINT64_T, OMPIO_ROOT,
+                                          fh->f_comm, fh->f_comm->c_coll->coll_bcast_module);
+    if (OMPI_SUCCESS != ret) {
+        return ret;
+    }
+    fh->f_compressed_block_size = (size_t) block_size;
+    return OMPI_SUCCESS;
+}
+
+/* read and decode block index into raw, the part beyond raw_len is zero */
+static int frame_load (ompio_file_t *fh, size_t block_size, OMPI_MPI_OFFSET_TYPE index,
+                       char *frame, char *raw, size_t *raw_len)
+{
+    vulcan_frame_header header;
+    ssize_t ret;
+
+    memset (raw, 0, block_size);
+    *raw_len = 0;
+
+    ret = frame_io (fh, VULCAN_FRAME_OFFSET(block_size, index),
+                    frame, VULCAN_FRAME_SIZE(block_size), false);
+    if (0 > ret) {
+        return (int) ret;
+    }
+    if ((size_t) ret < sizeof(header)) {
+        /* beyond the end of the file */
+        return OMPI_SUCCESS;
+    }
+
+    memcpy (&header, frame, sizeof(header));
+    if (0 == header.magic) {
+        /* a hole of the file */
+        return OMPI_SUCCESS;
+    }
+    if (VULCAN_FRAME_MAGIC != header.magic || header.block_size != block_size ||
+        header.raw_len > block_size ||
+        header.stored_len > (size_t) ret - sizeof(header)) {
+        opal_output (1, "vulcan: invalid compressed block %lld\n", (long long) index);
+        return OMPI_ERROR;
+    }
+
+    if (VULCAN_CODEC_NONE == header.codec && header.stored_len == header.raw_len) {
+        memcpy (raw, frame + sizeof(header), header.raw_len);
+    }
+    else if (VULCAN_CODEC_XOR != header.codec ||
+             OMPI_SUCCESS != xor_decode (frame + sizeof(header), header.stored_len,
+                                         raw, header.raw_len)) {
+        opal_output (1, "vulcan: cannot decode compressed block %lld\n", (long long) index);
+        return OMPI_ERROR;
+    }
+
+    *raw_len = header.raw_len;
+    return OMPI_SUCCESS;
+}
+
+static int frame_store (ompio_file_t *fh, size_t block_size, OMPI_MPI_OFFSET_TYPE index,
+                        char *frame, const char *raw, size_t raw_len)
+{
+    vulcan_frame_header header;
+    ssize_t ret;
+
+    header.magic      = VULCAN_FRAME_MAGIC;
+    header.block_size = block_size;
+    header.raw_len    = raw_len;
+    header.stored_len = xor_encode (raw, raw_len, frame + sizeof(header));
+    if (0 < header.stored_len) {
+        header.codec = VULCAN_CODEC_XOR;
+    }
+    else {
+        header.codec      = VULCAN_CODEC_NONE;
+        header.stored_len = raw_len;
+        memcpy (frame + sizeof(header), raw, raw_len);
+    }
+    memcpy (frame, &header, sizeof(header));
+
+    ret = frame_io (fh, VULCAN_FRAME_OFFSET(block_size, index),
+                    frame, sizeof(header) + header.stored_len, true);
+    return (0 > ret) ? (int) ret : OMPI_SUCCESS;
+}
+
+/*
+ * Length of the next piece of the io array starting at entry *i, position
+ * *pos that lies before block_end. Returns 0 once the io array is done or
+ * the next piece belongs to a later block.
+ */
+static size_t next_piece (ompio_file_t *fh, int i, size_t pos,
+                          OMPI_MPI_OFFSET_TYPE block_end, OMPI_MPI_OFFSET_TYPE *offset)
+{
+    size_t len;
+
+    if (i >= fh->f_num_of_io_entries) {
+        return 0;
+    }
+    *offset = (OMPI_MPI_OFFSET_TYPE)(intptr_t) fh->f_io_array[i].offset + pos;
+    if (*offset >= block_end) {
+        return 0;
+    }
+    len = fh->f_io_array[i].length - pos;
+    if (*offset + (OMPI_MPI_OFFSET_TYPE) len > block_end) {
+        len = (size_t) (block_end - *offset);
+    }
+    return len;
+}
+
+#define ADVANCE_PIECE(_fh, _i, _pos, _len) {              \
+    _pos += _len;                                          \
+    if (_pos == (_fh)->f_io_array[_i].length) {            \
+        _i++;                                              \
+        _pos = 0;                                          \
+    }                                                      \
+}
+
+/* replacement of fbtl_pwritev for the sorted fh->f_io_array of a cycle */
+ssize_t mca_fcoll_vulcan_compress_pwritev (ompio_file_t *fh, size_t block_size)
+{
+    OMPI_MPI_OFFSET_TYPE index, block_start, block_end, offset;
+    size_t pos = 0, jpos, len, covered, raw_len;
+    ssize_t bytes_written = 0;
+    char *raw, *frame;
+    int i = 0, j, ret = OMPI_SUCCESS;
+
+    raw   = (char *) malloc (block_size);
+    frame = (char *) malloc (VULCAN_FRAME_SIZE(block_size));
+    if (NULL == raw || NULL == frame) {
+        free (raw);
+        free (frame);
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+
+    while (i < fh->f_num_of_io_entries) {
+        if (0 == fh->f_io_array[i].length) {
+            i++;
+            continue;
+        }
+        offset      = (OMPI_MPI_OFFSET_TYPE)(intptr_t) fh->f_io_array[i].offset + pos;
+        index       = offset / (OMPI_MPI_OFFSET_TYPE) block_size;
+        block_start = index * (OMPI_MPI_OFFSET_TYPE) block_size;
+        block_end   = block_start + (OMPI_MPI_OFFSET_TYPE) block_size;
+
+        /* the current content is only needed if the block is not overwritten entirely */
+        covered = 0;
+        j = i;
+        jpos = pos;
+        while (0 < (len = next_piece (fh, j, jpos, block_end, &offset))) {
+            covered += len;
+            ADVANCE_PIECE(fh, j, jpos, len);
+        }
+        if (covered < block_size) {
+            ret = frame_load (fh, block_size, index, frame, raw, &raw_len);
+            if (OMPI_SUCCESS != ret) {
+                break;
+            }
+        }
+        else {
+            raw_len = 0;
+        }
+
+        while (0 < (len = next_piece (fh, i, pos, block_end, &offset))) {
+            memcpy (raw + (offset - block_start),
+                    (char *) fh->f_io_array[i].memory_address + pos, len);
+            if ((size_t) (offset - block_start) + len > raw_len) {
+                raw_len = (size_t) (offset - block_start) + len;
+            }
+            bytes_written += len;
+            ADVANCE_PIECE(fh, i, pos, len);
+        }
+
+        ret = frame_store (fh, block_size, index, frame, raw, raw_len);
+        if (OMPI_SUCCESS != ret) {
+            break;
+        }
+    }
+
+    free (raw);
+    free (frame);
+    return (OMPI_SUCCESS == ret) ? bytes_written : ret;
+}
+
+/* replacement of fbtl_preadv for the sorted fh->f_io_array of a cycle */
+ssize_t mca_fcoll_vulcan_compress_preadv (ompio_file_t *fh, size_t block_size)
+{
+    OMPI_MPI_OFFSET_TYPE index, block_start, block_end, offset;
+    size_t pos = 0, len, raw_len;
+    ssize_t bytes_read = 0;
+    char *raw, *frame;
+    int i = 0, ret = OMPI_SUCCESS;
+
+    raw   = (char *) malloc (block_size);
+    frame = (char *) malloc (VULCAN_FRAME_SIZE(block_size));
+    if (NULL == raw || NULL == frame) {
+        free (raw);
+        free (frame);
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+
+    while (i < fh->f_num_of_io_entries) {
+        if (0 == fh->f_io_array[i].length) {
+            i++;
+            continue;
+        }
+        offset      = (OMPI_MPI_OFFSET_TYPE)(intptr_t) fh->f_io_array[i].offset + pos;
+        index       = offset / (OMPI_MPI_OFFSET_TYPE) block_size;
+        block_start = index * (OMPI_MPI_OFFSET_TYPE) block_size;
+        block_end   = block_start + (OMPI_MPI_OFFSET_TYPE) block_size;
+
+        ret = frame_load (fh, block_size, index, frame, raw, &raw_len);
+        if (OMPI_SUCCESS != ret) {
+            break;
+        }
+
+        while (0 < (len = next_piece (fh, i, pos, block_end, &offset))) {
+            memcpy ((char *) fh->f_io_array[i].memory_address + pos,
+                    raw + (offset - block_start), len);
+            bytes_read += len;
+            ADVANCE_PIECE(fh, i, pos, len);
+        }
+    }
+
+    free (raw);
+    free (frame);
+    return (OMPI_SUCCESS == ret) ? bytes_read : ret;
+}
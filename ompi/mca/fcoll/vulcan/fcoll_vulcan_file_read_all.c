@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2008-2021 University of Houston. All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+#include "fcoll_vulcan.h"
+#include "fcoll_vulcan_internal.h"
+
+#include "mpi.h"
+#include "ompi/constants.h"
+#include "ompi/mca/fcoll/fcoll.h"
+#include "ompi/mca/fcoll/base/base.h"
+#include "ompi/mca/common/ompio/common_ompio.h"
+#include "ompi/mca/common/ompio/common_ompio_request.h"
+#include "ompi/mca/pml/pml.h"
+
+static int read_init (ompio_file_t *fh, mca_io_ompio_aggregator_data *aggr_data,
+                      int read_chunksize, int read_synchType, ompi_request_t **request);
+static int scatter_init (int index, mca_io_ompio_aggregator_data *data, ompi_request_t **reqs);
+static bool read_advance (mca_fcoll_vulcan_coll_state_t *state);
+
+
+int mca_fcoll_vulcan_file_read_all (ompio_file_t *fh,
+                                    void *buf,
+                                    int count,
+                                    struct ompi_datatype_t *datatype,
+                                    ompi_status_public_t *status)
+{
+    ompi_request_t *req = MPI_REQUEST_NULL;
+    int ret;
+
+    /* The blocking read runs the same pipeline as the non-blocking one,
+       the progress engine overlaps the read of a cycle with the scatter
+       of the previous one. Waiting on the request also lets earlier
+       non-blocking operations on the file finish first. */
+    ret = mca_fcoll_vulcan_file_iread_all (fh, buf, count, datatype, &req);
+    if (OMPI_SUCCESS != ret) {
+        return ret;
+    }
+
+    return ompi_request_wait (&req, status);
+}
+
+
+int mca_fcoll_vulcan_file_iread_all (ompio_file_t *fh,
+                                     void *buf,
+                                     int count,
+                                     struct ompi_datatype_t *datatype,
+                                     ompi_request_t **request)
+{
+    mca_fcoll_vulcan_coll_state_t *state;
+    int ret;
+
+    state = (mca_fcoll_vulcan_coll_state_t *) malloc (sizeof(mca_fcoll_vulcan_coll_state_t));
+    if (NULL == state) {
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+
+    /* Same domains and cycles as for writes, with the shuffle reversed:
+       the aggregator reads a cycle into its buffer and sends the pieces
+       to the processes that posted the receives. */
+    ret = mca_fcoll_vulcan_coll_setup (fh, buf, count, datatype, state);
+    if (OMPI_SUCCESS != ret) {
+        mca_fcoll_vulcan_coll_cleanup (state);
+        free (state);
+        return ret;
+    }
+
+    if (NULL != fh->f_fbtl->fbtl_ipreadv) {
+        state->io_synch_type = 1;
+    }
+    state->advance = read_advance;
+
+    return mca_fcoll_vulcan_coll_start (fh, state, MCA_OMPIO_REQUEST_READ_ALL, request);
+}
+
+
+/*
+ * Read pipeline, double-buffered like the write path: cycle index is read
+ * into one buffer while the data of cycle index-1 is sent out of the
+ * other one. The requests of the two cycles in flight are kept in reqs
+ * and prev_reqs, a cycle is only set up once the transfers of cycle
+ * index-2, which used the same buffer and request array, have completed.
+ * Returns true once the last cycle has been delivered.
+ */
+static bool read_advance (mca_fcoll_vulcan_coll_state_t *state)
+{
+    ompio_file_t *fh = state->fh;
+    int i, ret;
+
+    for (;;) {
+        if (state->io_pending) {
+            if (!mca_fcoll_vulcan_coll_test_io (state)) {
+                return false;
+            }
+            state->io_pending = false;
+
+            /* the receives are posted, send even if the read failed so
+               that the other processes do not hang */
+            if (NOT_AGGR_INDEX != state->aggr_index) {
+                ret = scatter_init (state->index - 1, state->aggr_data[state->aggr_index],
+                                    &state->reqs[state->aggr_index*(state->procs_per_group + 1)]);
+                if (OMPI_SUCCESS != ret && OMPI_SUCCESS == state->error) {
+                    state->error = ret;
+                }
+            }
+        }
+
+        if (!mca_fcoll_vulcan_coll_test_reqs (state, state->prev_reqs)) {
+            return false;
+        }
+        if (OMPI_SUCCESS != state->error || state->index == state->cycles) {
+            return mca_fcoll_vulcan_coll_test_reqs (state, state->reqs);
+        }
+
+        SWAP_REQUESTS(state->reqs, state->prev_reqs);
+        for (i = 0; i < state->num_aggrs; i++) {
+            ret = mca_fcoll_vulcan_shuffle_init (state->index, state->cycles, state->aggr_list[i],
+                                                 fh->f_rank, state->aggr_data[i], true,
+                                                 &state->reqs[i*(state->procs_per_group + 1)]);
+            if (OMPI_SUCCESS != ret) {
+                state->error = ret;
+                break;
+            }
+        }
+        if (OMPI_SUCCESS != state->error) {
+            /* wait for what has been posted already */
+            continue;
+        }
+        SWAP_AGGR_POINTERS(state->aggr_data, state->num_aggrs);
+
+        if (NOT_AGGR_INDEX != state->aggr_index) {
+            ret = read_init (fh, state->aggr_data[state->aggr_index], state->io_chunksize,
+                             state->io_synch_type, &state->req_io);
+            if (OMPI_SUCCESS != ret) {
+                state->error = ret;
+            }
+        }
+        state->io_pending = true;
+        state->index++;
+    }
+}
+
+
+static int read_init (ompio_file_t *fh,
+                      mca_io_ompio_aggregator_data *aggr_data,
+                      int read_chunksize,
+                      int read_synchType,
+                      ompi_request_t **request )
+{
+    int ret = OMPI_SUCCESS;
+    ssize_t ret_temp = 0;
+    int last_array_pos = 0;
+    int last_pos = 0;
+    mca_ompio_request_t *ompio_req = NULL;
+
+    mca_common_ompio_request_alloc ( &ompio_req, MCA_OMPIO_REQUEST_READ );
+
+    if (aggr_data->prev_num_io_entries) {
+        /* the io_array of a cycle never holds more than read_chunksize bytes */
+        mca_fcoll_vulcan_split_iov_array (fh, aggr_data->prev_io_array,
+                                          aggr_data->prev_num_io_entries,
+                                          &last_array_pos, &last_pos,
+                                          read_chunksize);
+
+        if (1 == read_synchType && 0 == aggr_data->compress_block) {
+            ret = fh->f_fbtl->fbtl_ipreadv(fh, (ompi_request_t *) ompio_req);
+            if(0 > ret) {
+                opal_output (1, "vulcan_read_all: fbtl_ipreadv failed\n");
+                ompio_req->req_ompi.req_status.MPI_ERROR = ret;
+                ompio_req->req_ompi.req_status._ucount = 0;
+                ompi_request_complete (&ompio_req->req_ompi, false);
+            }
+            ret = OMPI_SUCCESS;
+        }
+        else {
+            fh->f_flags |= OMPIO_COLLECTIVE_OP;
+            if (0 < aggr_data->compress_block) {
+                ret_temp = mca_fcoll_vulcan_compress_preadv (fh, aggr_data->compress_block);
+            }
+            else {
+                ret_temp = fh->f_fbtl->fbtl_preadv(fh);
+            }
+            fh->f_flags &= ~OMPIO_COLLECTIVE_OP;
+            if(0 > ret_temp) {
+                opal_output (1, "vulcan_read_all: fbtl_preadv failed\n");
+                ret = ret_temp;
+                ret_temp = 0;
+            }
+
+            ompio_req->req_ompi.req_status.MPI_ERROR = ret;
+            ompio_req->req_ompi.req_status._ucount = ret_temp;
+            ompi_request_complete (&ompio_req->req_ompi, false);
+            ret = OMPI_SUCCESS;
+        }
+
+        free(fh->f_io_array);
+        free(aggr_data->prev_io_array);
+    }
+    else {
+        ompio_req->req_ompi.req_status.MPI_ERROR = OMPI_SUCCESS;
+        ompio_req->req_ompi.req_status._ucount = 0;
+        ompi_request_complete (&ompio_req->req_ompi, false);
+    }
+
+    *request = (ompi_request_t *) ompio_req;
+
+    fh->f_io_array=NULL;
+    fh->f_num_of_io_entries=0;
+
+    return ret;
+}
+
+
+/*
+ * Send the data of cycle index out of the buffer it has been read into,
+ * using the types built by the shuffle.
+ */
+static int scatter_init (int index, mca_io_ompio_aggregator_data *data, ompi_request_t **reqs)
+{
+    size_t datatype_size;
+    int i, ret;
+
+    for (i = 0; i < data->procs_per_group; i++) {
+        if (MPI_DATATYPE_NULL == data->prev_recvtype[i]) {
+            continue;
+        }
+        opal_datatype_type_size (&data->prev_recvtype[i]->super, &datatype_size);
+        if (0 == datatype_size) {
+            continue;
+        }
+        ret = MCA_PML_CALL(isend(data->prev_global_buf,
+                                 1,
+                                 data->prev_recvtype[i],
+                                 data->procs_in_group[i],
+                                 FCOLL_VULCAN_SHUFFLE_TAG+index,
+                                 MCA_PML_BASE_SEND_STANDARD,
+                                 data->comm,
+                                 &reqs[i]));
+        if (OMPI_SUCCESS != ret) {
+            return ret;
+        }
+    }
+
+    return OMPI_SUCCESS;
+}
@@ -21,6 +21,7 @@
 
 #include "ompi_config.h"
 #include "fcoll_vulcan.h"
+#include "fcoll_vulcan_internal.h"
 
 #include "mpi.h"
 #include "ompi/constants.h"
@@ -34,72 +35,20 @@
 #include <unistd.h>
 
 #define DEBUG_ON 0
-#define NOT_AGGR_INDEX -1
-
-/*Used for loading file-offsets per aggregator*/
-typedef struct mca_io_ompio_local_io_array{
-    OMPI_MPI_OFFSET_TYPE offset;
-    MPI_Aint             length;
-    int                  process_id;
-}mca_io_ompio_local_io_array;
-
-typedef struct mca_io_ompio_aggregator_data {
-    int *disp_index, *sorted, *fview_count, n;
-    int *max_disp_index;
-    int **blocklen_per_process;
-    MPI_Aint **displs_per_process, total_bytes, bytes_per_cycle, total_bytes_written;
-    MPI_Comm comm;
-    char *buf, *global_buf, *prev_global_buf;
-    ompi_datatype_t **recvtype, **prev_recvtype;
-    struct iovec *global_iov_array;
-    int current_index, current_position;
-    int bytes_to_write_in_cycle, bytes_remaining, procs_per_group;    
-    int *procs_in_group, iov_index;
-    int bytes_sent, prev_bytes_sent;
-    struct iovec *decoded_iov;
-    int bytes_to_write, prev_bytes_to_write;
-    mca_common_ompio_io_array_t *io_array, *prev_io_array;
-    int num_io_entries, prev_num_io_entries;
-} mca_io_ompio_aggregator_data;
-
-
-#define SWAP_REQUESTS(_r1,_r2) { \
-    ompi_request_t **_t=_r1;     \
-    _r1=_r2;                     \
-    _r2=_t;}
-
-#define SWAP_AGGR_POINTERS(_aggr,_num) {                        \
-    int _i;                                                     \
-    char *_t;                                                   \
-    for (_i=0; _i<_num; _i++ ) {                                \
-        _aggr[_i]->prev_io_array=_aggr[_i]->io_array;             \
-        _aggr[_i]->prev_num_io_entries=_aggr[_i]->num_io_entries; \
-        _aggr[_i]->prev_bytes_sent=_aggr[_i]->bytes_sent;         \
-        _aggr[_i]->prev_bytes_to_write=_aggr[_i]->bytes_to_write; \
-        _t=_aggr[_i]->prev_global_buf;                            \
-        _aggr[_i]->prev_global_buf=_aggr[_i]->global_buf;         \
-        _aggr[_i]->global_buf=_t;                                 \
-        _t=(char *)_aggr[_i]->recvtype;                           \
-        _aggr[_i]->recvtype=_aggr[_i]->prev_recvtype;             \
-        _aggr[_i]->prev_recvtype=(ompi_datatype_t **)_t;          }                                                             \
-}
-
 
 
-static int shuffle_init ( int index, int cycles, int aggregator, int rank, 
-                          mca_io_ompio_aggregator_data *data, 
-                          ompi_request_t **reqs );
 static int write_init (ompio_file_t *fh, int aggregator, mca_io_ompio_aggregator_data *aggr_data,
                         int write_chunksize, int write_synchType, ompi_request_t **request);
-int mca_fcoll_vulcan_break_file_view ( struct iovec *decoded_iov, int iov_count, 
-                                        struct iovec *local_iov_array, int local_count, 
+static bool write_advance (mca_fcoll_vulcan_coll_state_t *state);
+int mca_fcoll_vulcan_break_file_view ( struct iovec *decoded_iov, int iov_count,
+                                        struct iovec *local_iov_array, int local_count,
                                         struct iovec ***broken_decoded_iovs, int **broken_iov_counts,
-                                        struct iovec ***broken_iov_arrays, int **broken_counts, 
+                                        struct iovec ***broken_iov_arrays, int **broken_counts,
                                         MPI_Aint **broken_total_lengths,
-                                        int stripe_count, size_t stripe_size); 
+                                        int stripe_count, size_t stripe_size);
 
 
-int mca_fcoll_vulcan_get_configuration (ompio_file_t *fh, int num_io_procs, 
+int mca_fcoll_vulcan_get_configuration (ompio_file_t *fh, int num_io_procs,
                                         int num_groups, size_t max_data);
 
 
@@ -107,12 +56,7 @@ static int local_heap_sort (mca_io_ompio_local_io_array *io_array,
 			    int num_entries,
 			    int *sorted);
 
-int mca_fcoll_vulcan_split_iov_array ( ompio_file_t *fh, mca_common_ompio_io_array_t *work_array,
-                                             int num_entries, int *last_array_pos, int *last_pos_in_field,
-                                             int chunk_size );
-
-
-static int mca_fcoll_vulcan_minmax ( ompio_file_t *fh, struct iovec *iov, int iov_count,  int num_aggregators, 
+static int mca_fcoll_vulcan_minmax ( ompio_file_t *fh, struct iovec *iov, int iov_count,  int num_aggregators,
                                      long *new_stripe_size);
 
 
@@ -124,39 +68,288 @@ int mca_fcoll_vulcan_file_write_all (ompio_file_t *fh,
 {
     int index = 0;
     int cycles = 0;
+    int ret =0, i;
+    ompi_request_t *req_iwrite = MPI_REQUEST_NULL;
+    mca_io_ompio_aggregator_data **aggr_data=NULL;
+    mca_fcoll_vulcan_coll_state_t state;
+    int nreqs;
+
+    int aggr_index = NOT_AGGR_INDEX;
+    int write_synch_type = 2;
+
+#if OMPIO_FCOLL_WANT_TIME_BREAKDOWN
+    double write_time = 0.0, start_write_time = 0.0, end_write_time = 0.0;
+    double exch_write = 0.0, start_exch = 0.0, end_exch = 0.0;
+    mca_common_ompio_print_entry nentry;
+#endif
+
+    if( (1 == mca_fcoll_vulcan_async_io) && (NULL == fh->f_fbtl->fbtl_ipwritev) ) {
+        opal_output (1, "vulcan_write_all: fbtl Does NOT support ipwritev() (asynchrounous write) \n");
+        return MPI_ERR_UNSUPPORTED_OPERATION;
+    }
+
+    /* the shuffle tags of a pending non-blocking operation on this
+       file would match ours */
+    mca_fcoll_vulcan_coll_wait_pending (fh);
+
+    ret = mca_fcoll_vulcan_compress_init (fh);
+    if (OMPI_SUCCESS != ret) {
+        return ret;
+    }
+
+    /**************************************************************************
+     ** 1.-6. Decode the buffer, exchange the file view and set up the
+     **       aggregator domains
+     **************************************************************************/
+    ret = mca_fcoll_vulcan_coll_setup (fh, buf, count, datatype, &state);
+    if (OMPI_SUCCESS != ret) {
+        goto exit;
+    }
+
+    if ( MPI_STATUS_IGNORE != status ) {
+	status->_ucount = state.max_data;
+    }
+
+    aggr_data  = state.aggr_data;
+    aggr_index = state.aggr_index;
+    cycles     = state.cycles;
+    nreqs      = (state.procs_per_group + 1) * state.num_aggrs;
+
+#if OMPIO_FCOLL_WANT_TIME_BREAKDOWN
+    start_exch = MPI_Wtime();
+#endif
+
+    // In fact it should be: if ((1 == mca_fcoll_vulcan_async_io) && (NULL != fh->f_fbtl->fbtl_ipwritev))
+    // But we've already tested that.
+    if( (1 == mca_fcoll_vulcan_async_io) ||
+        ( (0 == mca_fcoll_vulcan_async_io) && (NULL != fh->f_fbtl->fbtl_ipwritev) && (2 < cycles) ) ) {
+        write_synch_type = 1;
+    }
+
+    if ( cycles > 0 ) {
+        for ( i=0; i<state.num_aggrs; i++ ) {
+            ret = mca_fcoll_vulcan_shuffle_init ( 0, cycles, state.aggr_list[i], fh->f_rank, aggr_data[i],
+                                                  false, &state.reqs[i*(state.procs_per_group + 1)] );
+            if ( OMPI_SUCCESS != ret ) {
+                goto exit;
+            }
+        }
+        // Register progress function that should be used by ompi_request_wait
+        if (NOT_AGGR_INDEX != aggr_index)  {
+            mca_common_ompio_register_progress ();
+        }
+    }
+
+    ret = ompi_request_wait_all ( nreqs, state.reqs, MPI_STATUS_IGNORE);
+
+    for (index = 1; index < cycles; index++) {
+        SWAP_AGGR_POINTERS(aggr_data, state.num_aggrs);
+
+        if(NOT_AGGR_INDEX != aggr_index) {
+#if OMPIO_FCOLL_WANT_TIME_BREAKDOWN
+            start_write_time = MPI_Wtime();
+#endif
+            ret = write_init (fh, state.aggr_list[aggr_index], aggr_data[aggr_index],
+                              state.io_chunksize, write_synch_type, &req_iwrite);
+            if (OMPI_SUCCESS != ret){
+                goto exit;
+            }
+#if OMPIO_FCOLL_WANT_TIME_BREAKDOWN
+            end_write_time = MPI_Wtime();
+            write_time += end_write_time - start_write_time;
+#endif
+        }
+
+        for ( i=0; i<state.num_aggrs; i++ ) {
+            ret = mca_fcoll_vulcan_shuffle_init ( index, cycles, state.aggr_list[i], fh->f_rank, aggr_data[i],
+                                                  false, &state.reqs[i*(state.procs_per_group + 1)] );
+            if ( OMPI_SUCCESS != ret ) {
+                goto exit;
+            }
+        }
+
+        ret = ompi_request_wait_all ( nreqs, state.reqs, MPI_STATUS_IGNORE);
+        if (OMPI_SUCCESS != ret){
+            goto exit;
+        }
+
+        if(NOT_AGGR_INDEX != aggr_index) {
+            ret = ompi_request_wait(&req_iwrite, MPI_STATUS_IGNORE);
+            if (OMPI_SUCCESS != ret){
+                goto exit;
+            }
+        }
+    } /* end  for (index = 0; index < cycles; index++) */
+
+    if ( cycles > 0 ) {
+        SWAP_AGGR_POINTERS(aggr_data, state.num_aggrs);
+
+        if(NOT_AGGR_INDEX != aggr_index) {
+#if OMPIO_FCOLL_WANT_TIME_BREAKDOWN
+            start_write_time = MPI_Wtime();
+#endif
+            ret = write_init (fh, state.aggr_list[aggr_index], aggr_data[aggr_index],
+                              state.io_chunksize, write_synch_type, &req_iwrite);
+            if (OMPI_SUCCESS != ret){
+                goto exit;
+            }
+#if OMPIO_FCOLL_WANT_TIME_BREAKDOWN
+            end_write_time = MPI_Wtime();
+            write_time += end_write_time - start_write_time;
+#endif
+        }
+
+        if(NOT_AGGR_INDEX != aggr_index) {
+            ret = ompi_request_wait(&req_iwrite, MPI_STATUS_IGNORE);
+            if (OMPI_SUCCESS != ret){
+                goto exit;
+            }
+        }
+    }
+
+#if OMPIO_FCOLL_WANT_TIME_BREAKDOWN
+    end_exch = MPI_Wtime();
+    exch_write += end_exch - start_exch;
+    nentry.time[0] = write_time;
+    nentry.time[1] = state.comm_time;
+    nentry.time[2] = exch_write;
+    nentry.aggregator = 0;
+    for ( i=0; i<state.num_aggrs; i++ ) {
+        if (state.aggr_list[i] == fh->f_rank)
+	nentry.aggregator = 1;
+    }
+    nentry.nprocs_for_coll = state.num_aggrs;
+    if (!mca_common_ompio_full_print_queue(fh->f_coll_write_time)){
+        mca_common_ompio_register_print_entry(fh->f_coll_write_time,
+                                               nentry);
+    }
+#endif
+
+
+exit :
+    mca_fcoll_vulcan_coll_cleanup (&state);
+
+    return OMPI_SUCCESS;
+}
+
+
+int mca_fcoll_vulcan_file_iwrite_all (ompio_file_t *fh,
+                                      const void *buf,
+                                      int count,
+                                      struct ompi_datatype_t *datatype,
+                                      ompi_request_t **request)
+{
+    mca_fcoll_vulcan_coll_state_t *state;
+    int ret;
+
+    if( (1 == mca_fcoll_vulcan_async_io) && (NULL == fh->f_fbtl->fbtl_ipwritev) ) {
+        opal_output (1, "vulcan_iwrite_all: fbtl Does NOT support ipwritev() (asynchrounous write) \n");
+        return MPI_ERR_UNSUPPORTED_OPERATION;
+    }
+
+    ret = mca_fcoll_vulcan_compress_init (fh);
+    if (OMPI_SUCCESS != ret) {
+        return ret;
+    }
+
+    state = (mca_fcoll_vulcan_coll_state_t *) malloc (sizeof(mca_fcoll_vulcan_coll_state_t));
+    if (NULL == state) {
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+
+    /* The exchange of the file view is the only collective step and is
+       done right away. The shuffle and write cycles are driven by the
+       progress engine, the cycles of an earlier non-blocking operation
+       on the same file have to finish first since they use the same tags. */
+    ret = mca_fcoll_vulcan_coll_setup (fh, buf, count, datatype, state);
+    if (OMPI_SUCCESS != ret) {
+        mca_fcoll_vulcan_coll_cleanup (state);
+        free (state);
+        return ret;
+    }
+
+    /* the write of a cycle must not block the progress engine */
+    if (NULL != fh->f_fbtl->fbtl_ipwritev) {
+        state->io_synch_type = 1;
+    }
+    state->advance = write_advance;
+
+    return mca_fcoll_vulcan_coll_start (fh, state, MCA_OMPIO_REQUEST_WRITE_ALL, request);
+}
+
+
+/*
+ * Write pipeline of the non-blocking operation: cycle index is shuffled
+ * while cycle index-1 is written, a step is started once both have
+ * completed. Returns true once the last cycle is on disk.
+ */
+static bool write_advance (mca_fcoll_vulcan_coll_state_t *state)
+{
+    ompio_file_t *fh = state->fh;
+    int i, ret;
+
+    while (mca_fcoll_vulcan_coll_test_io (state) &&
+           mca_fcoll_vulcan_coll_test_reqs (state, state->reqs)) {
+        if (OMPI_SUCCESS != state->error || state->index > state->cycles) {
+            return true;
+        }
+
+        if (0 < state->index) {
+            SWAP_AGGR_POINTERS(state->aggr_data, state->num_aggrs);
+
+            if (NOT_AGGR_INDEX != state->aggr_index) {
+                ret = write_init (fh, state->aggr_list[state->aggr_index],
+                                  state->aggr_data[state->aggr_index],
+                                  state->io_chunksize, state->io_synch_type, &state->req_io);
+                if (OMPI_SUCCESS != ret) {
+                    state->error = ret;
+                }
+            }
+        }
+
+        for (i = 0; OMPI_SUCCESS == state->error && state->index < state->cycles &&
+                 i < state->num_aggrs; i++) {
+            ret = mca_fcoll_vulcan_shuffle_init (state->index, state->cycles, state->aggr_list[i],
+                                                 fh->f_rank, state->aggr_data[i], false,
+                                                 &state->reqs[i*(state->procs_per_group + 1)]);
+            if (OMPI_SUCCESS != ret) {
+                state->error = ret;
+            }
+        }
+        state->index++;
+    }
+
+    return false;
+}
+
+
+int mca_fcoll_vulcan_coll_setup (ompio_file_t *fh, const void *buf, int count,
+                                 struct ompi_datatype_t *datatype,
+                                 mca_fcoll_vulcan_coll_state_t *state)
+{
     int ret =0, l, i, j, bytes_per_cycle;
     uint32_t iov_count = 0;
-    struct iovec *decoded_iov = NULL;
     struct iovec *local_iov_array=NULL;
     uint32_t total_fview_count = 0;
     int local_count = 0;
-    ompi_request_t **reqs = NULL;
-    ompi_request_t *req_iwrite = MPI_REQUEST_NULL;
     mca_io_ompio_aggregator_data **aggr_data=NULL;
-    
+
     int *displs = NULL;
     int vulcan_num_io_procs;
-    size_t max_data = 0;
     MPI_Aint *total_bytes_per_process = NULL;
-    
-    struct iovec **broken_iov_arrays=NULL;
-    struct iovec **broken_decoded_iovs=NULL;
-    int *broken_counts=NULL;
-    int *broken_iov_counts=NULL;
-    MPI_Aint *broken_total_lengths=NULL;
+    size_t compress_block;
 
-    int aggr_index = NOT_AGGR_INDEX;
-    int write_synch_type = 2;
-    int write_chunksize, *result_counts=NULL;
-    
 #if OMPIO_FCOLL_WANT_TIME_BREAKDOWN
-    double write_time = 0.0, start_write_time = 0.0, end_write_time = 0.0;
-    double comm_time = 0.0, start_comm_time = 0.0, end_comm_time = 0.0;
-    double exch_write = 0.0, start_exch = 0.0, end_exch = 0.0;
-    mca_common_ompio_print_entry nentry;
+    double start_comm_time = 0.0, end_comm_time = 0.0;
 #endif
-    
-    
+
+    memset (state, 0, sizeof(mca_fcoll_vulcan_coll_state_t));
+    state->fh         = fh;
+    state->aggr_index = NOT_AGGR_INDEX;
+    state->req_io     = MPI_REQUEST_NULL;
+    state->io_synch_type = 2;
+    state->error      = OMPI_SUCCESS;
+
     /**************************************************************************
      ** 1.  In case the data is not contigous in memory, decode it into an iovec
      **************************************************************************/
@@ -167,85 +360,97 @@ int mca_fcoll_vulcan_file_write_all (ompio_file_t *fh,
     }
     bytes_per_cycle = fh->f_bytes_per_agg;
 
-    if( (1 == mca_fcoll_vulcan_async_io) && (NULL == fh->f_fbtl->fbtl_ipwritev) ) {
-        opal_output (1, "vulcan_write_all: fbtl Does NOT support ipwritev() (asynchrounous write) \n");
-        ret = MPI_ERR_UNSUPPORTED_OPERATION;
-        goto exit;
-    }
-
     /* since we want to overlap 2 iterations, define the bytes_per_cycle to be half of what
        the user requested */
     bytes_per_cycle =bytes_per_cycle/2;
-    write_chunksize = bytes_per_cycle;
-    
+    state->io_chunksize = bytes_per_cycle;
+    compress_block = mca_fcoll_vulcan_compress_block_size (fh);
+
     ret =   mca_common_ompio_decode_datatype ((struct ompio_file_t *) fh,
                                               datatype,
                                               count,
                                               buf,
-                                              &max_data,
+                                              &state->max_data,
                                               fh->f_mem_convertor,
-                                              &decoded_iov,
+                                              &state->decoded_iov,
                                               &iov_count);
     if (OMPI_SUCCESS != ret ){
         goto exit;
     }
-    
-    if ( MPI_STATUS_IGNORE != status ) {
-	status->_ucount = max_data;
-    }
-    
-    
-    ret = mca_fcoll_vulcan_get_configuration (fh, vulcan_num_io_procs, mca_fcoll_vulcan_num_groups, max_data);
+
+    ret = mca_fcoll_vulcan_get_configuration (fh, vulcan_num_io_procs, mca_fcoll_vulcan_num_groups, state->max_data);
     if (OMPI_SUCCESS != ret){
 	goto exit;
     }
 
-    aggr_data = (mca_io_ompio_aggregator_data **) malloc ( fh->f_num_aggrs * 
+    state->num_aggrs = fh->f_num_aggrs;
+    state->aggr_list = (int *) malloc (fh->f_num_aggrs * sizeof(int));
+    if (NULL == state->aggr_list) {
+        ret = OMPI_ERR_OUT_OF_RESOURCE;
+        goto exit;
+    }
+    memcpy (state->aggr_list, fh->f_aggr_list, fh->f_num_aggrs * sizeof(int));
+
+    aggr_data = (mca_io_ompio_aggregator_data **) calloc ( fh->f_num_aggrs,
                                                            sizeof(mca_io_ompio_aggregator_data*));
-    
+    if (NULL == aggr_data) {
+        ret = OMPI_ERR_OUT_OF_RESOURCE;
+        goto exit;
+    }
+    state->aggr_data = aggr_data;
+
     for ( i=0; i< fh->f_num_aggrs; i++ ) {
         // At this point we know the number of aggregators. If there is a correlation between
         // number of aggregators and number of IO nodes, we know how many aggr_data arrays we need
         // to allocate.
         aggr_data[i] = (mca_io_ompio_aggregator_data *) calloc ( 1, sizeof(mca_io_ompio_aggregator_data));
+        if (NULL == aggr_data[i]) {
+            ret = OMPI_ERR_OUT_OF_RESOURCE;
+            goto exit;
+        }
         aggr_data[i]->procs_per_group = fh->f_procs_per_group;
         aggr_data[i]->procs_in_group  = fh->f_procs_in_group;
         aggr_data[i]->comm = fh->f_comm;
         aggr_data[i]->buf  = (char *)buf;             // should not be used in the new version.
+        aggr_data[i]->compress_block = compress_block;
         // Identify if the process is an aggregator.
         // If so, aggr_index would be its index in "aggr_data" and "aggregators" arrays.
         if(fh->f_aggr_list[i] == fh->f_rank) {
-            aggr_index = i;
+            state->aggr_index = i;
         }
     }
-    
+
     /*********************************************************************
      *** 2. Generate the local offsets/lengths array corresponding to
      ***    this write operation
      ********************************************************************/
     ret = fh->f_generate_current_file_view( (struct ompio_file_t *) fh,
-					    max_data,
+					    state->max_data,
 					    &local_iov_array,
 					    &local_count);
     if (ret != OMPI_SUCCESS){
 	goto exit;
     }
-    
+
     /*************************************************************************
      ** 2b. Separate the local_iov_array entries based on the number of aggregators
      *************************************************************************/
     // Modifications for the even distribution:
     long domain_size;
     ret = mca_fcoll_vulcan_minmax ( fh, local_iov_array, local_count,  fh->f_num_aggrs, &domain_size);
-    
+    if ( 0 < compress_block && 0 < domain_size ) {
+        /* every compressed block has to be owned by a single aggregator */
+        domain_size = ((domain_size + (long) compress_block - 1) / (long) compress_block) * (long) compress_block;
+    }
+
     // broken_iov_arrays[0] contains broken_counts[0] entries to aggregator 0,
     // broken_iov_arrays[1] contains broken_counts[1] entries to aggregator 1, etc.
-    ret = mca_fcoll_vulcan_break_file_view ( decoded_iov, iov_count, 
-                                              local_iov_array, local_count, 
-                                              &broken_decoded_iovs, &broken_iov_counts,
-                                              &broken_iov_arrays, &broken_counts, 
-                                              &broken_total_lengths,
-                                              fh->f_num_aggrs, domain_size); 
+    ret = mca_fcoll_vulcan_break_file_view ( state->decoded_iov, iov_count,
+                                              local_iov_array, local_count,
+                                              &state->broken_decoded_iovs, &state->broken_iov_counts,
+                                              &state->broken_iov_arrays, &state->broken_counts,
+                                              &state->broken_total_lengths,
+                                              fh->f_num_aggrs, domain_size);
 
 
     /**************************************************************************
@@ -256,7 +461,7 @@ int mca_fcoll_vulcan_file_write_all (ompio_file_t *fh,
 #endif
     if ( 1 == mca_fcoll_vulcan_num_groups ) {
         ret = fh->f_comm->c_coll->coll_allreduce (MPI_IN_PLACE,
-                                                  broken_total_lengths,
+                                                  state->broken_total_lengths,
 						  fh->f_num_aggrs,
 						  MPI_LONG,
                                                   MPI_SUM,
@@ -275,8 +480,8 @@ int mca_fcoll_vulcan_file_write_all (ompio_file_t *fh,
             ret = OMPI_ERR_OUT_OF_RESOURCE;
             goto exit;
         }
-    
-        ret = ompi_fcoll_base_coll_allgather_array (broken_total_lengths,
+
+        ret = ompi_fcoll_base_coll_allgather_array (state->broken_total_lengths,
 						    fh->f_num_aggrs,
 						    MPI_LONG,
 						    total_bytes_per_process,
@@ -291,56 +496,56 @@ int mca_fcoll_vulcan_file_write_all (ompio_file_t *fh,
         }
 
         for ( i=0; i<fh->f_num_aggrs; i++ ) {
-            broken_total_lengths[i] = 0;
+            state->broken_total_lengths[i] = 0;
             for (j=0 ; j<fh->f_procs_per_group ; j++) {
-                broken_total_lengths[i] += total_bytes_per_process[j*fh->f_num_aggrs + i];
+                state->broken_total_lengths[i] += total_bytes_per_process[j*fh->f_num_aggrs + i];
             }
         }
         if (NULL != total_bytes_per_process) {
             free (total_bytes_per_process);
             total_bytes_per_process = NULL;
-        }    
+        }
     }
-    
+
 #if OMPIO_FCOLL_WANT_TIME_BREAKDOWN
     end_comm_time = MPI_Wtime();
-    comm_time += (end_comm_time - start_comm_time);
+    state->comm_time += (end_comm_time - start_comm_time);
 #endif
-    
-    cycles=0;
+
+    state->cycles=0;
     for ( i=0; i<fh->f_num_aggrs; i++ ) {
 #if DEBUG_ON
-        printf("%d: Overall broken_total_lengths[%d] = %ld\n", fh->f_rank, i, broken_total_lengths[i]);
+        printf("%d: Overall broken_total_lengths[%d] = %ld\n", fh->f_rank, i, state->broken_total_lengths[i]);
 #endif
-        if ( ceil((double)broken_total_lengths[i]/bytes_per_cycle) > cycles ) {
-            cycles = ceil((double)broken_total_lengths[i]/bytes_per_cycle);
+        if ( ceil((double)state->broken_total_lengths[i]/bytes_per_cycle) > state->cycles ) {
+            state->cycles = ceil((double)state->broken_total_lengths[i]/bytes_per_cycle);
         }
     }
-    
-    result_counts = (int *) malloc ( fh->f_num_aggrs * fh->f_procs_per_group * sizeof(int) );
-    if ( NULL == result_counts ) {
+
+    state->result_counts = (int *) malloc ( fh->f_num_aggrs * fh->f_procs_per_group * sizeof(int) );
+    if ( NULL == state->result_counts ) {
         ret = OMPI_ERR_OUT_OF_RESOURCE;
         goto exit;
     }
-    
+
 #if OMPIO_FCOLL_WANT_TIME_BREAKDOWN
     start_comm_time = MPI_Wtime();
 #endif
     if ( 1 == mca_fcoll_vulcan_num_groups ) {
-        ret = fh->f_comm->c_coll->coll_allgather(broken_counts,
+        ret = fh->f_comm->c_coll->coll_allgather(state->broken_counts,
 						 fh->f_num_aggrs,
 						 MPI_INT,
-						 result_counts,
+						 state->result_counts,
 						 fh->f_num_aggrs,
 						 MPI_INT,
 						 fh->f_comm,
-						 fh->f_comm->c_coll->coll_allgather_module);            
+						 fh->f_comm->c_coll->coll_allgather_module);
     }
     else {
-        ret = ompi_fcoll_base_coll_allgather_array (broken_counts,
+        ret = ompi_fcoll_base_coll_allgather_array (state->broken_counts,
 						    fh->f_num_aggrs,
 						    MPI_INT,
-						    result_counts,
+						    state->result_counts,
 						    fh->f_num_aggrs,
 						    MPI_INT,
 						    0,
@@ -353,15 +558,15 @@ int mca_fcoll_vulcan_file_write_all (ompio_file_t *fh,
     }
 #if OMPIO_FCOLL_WANT_TIME_BREAKDOWN
     end_comm_time = MPI_Wtime();
-    comm_time += (end_comm_time - start_comm_time);
+    state->comm_time += (end_comm_time - start_comm_time);
 #endif
-    
+
     /*************************************************************
      *** 4. Allgather the offset/lengths array from all processes
      *************************************************************/
     for ( i=0; i< fh->f_num_aggrs; i++ ) {
-        aggr_data[i]->total_bytes = broken_total_lengths[i];
-        aggr_data[i]->decoded_iov = broken_decoded_iovs[i];
+        aggr_data[i]->total_bytes = state->broken_total_lengths[i];
+        aggr_data[i]->decoded_iov = state->broken_decoded_iovs[i];
         aggr_data[i]->fview_count = (int *) malloc (fh->f_procs_per_group * sizeof (int));
         if (NULL == aggr_data[i]->fview_count) {
             opal_output (1, "OUT OF MEMORY\n");
@@ -369,7 +574,7 @@ int mca_fcoll_vulcan_file_write_all (ompio_file_t *fh,
             goto exit;
         }
         for ( j=0; j <fh->f_procs_per_group; j++ ) {
-            aggr_data[i]->fview_count[j] = result_counts[fh->f_num_aggrs*j+i];
+            aggr_data[i]->fview_count[j] = state->result_counts[fh->f_num_aggrs*j+i];
         }
         displs = (int*) malloc (fh->f_procs_per_group * sizeof (int));
         if (NULL == displs) {
@@ -377,14 +582,14 @@ int mca_fcoll_vulcan_file_write_all (ompio_file_t *fh,
             ret = OMPI_ERR_OUT_OF_RESOURCE;
             goto exit;
         }
-        
+
         displs[0] = 0;
         total_fview_count = aggr_data[i]->fview_count[0];
         for (j=1 ; j<fh->f_procs_per_group ; j++) {
             total_fview_count += aggr_data[i]->fview_count[j];
             displs[j] = displs[j-1] + aggr_data[i]->fview_count[j-1];
         }
-        
+
 #if DEBUG_ON
         printf("total_fview_count : %d\n", total_fview_count);
         if (fh->f_aggr_list[i] == fh->f_rank) {
@@ -397,7 +602,7 @@ int mca_fcoll_vulcan_file_write_all (ompio_file_t *fh,
             }
         }
 #endif
-    
+
         /* allocate the global iovec  */
         if (0 != total_fview_count) {
             aggr_data[i]->global_iov_array = (struct iovec*) malloc (total_fview_count *
@@ -406,15 +611,15 @@ int mca_fcoll_vulcan_file_write_all (ompio_file_t *fh,
                 opal_output(1, "OUT OF MEMORY\n");
                 ret = OMPI_ERR_OUT_OF_RESOURCE;
                 goto exit;
-            }            
+            }
         }
-    
+
 #if OMPIO_FCOLL_WANT_TIME_BREAKDOWN
         start_comm_time = MPI_Wtime();
 #endif
         if ( 1 == mca_fcoll_vulcan_num_groups ) {
-            ret = fh->f_comm->c_coll->coll_allgatherv (broken_iov_arrays[i],
-                                                      broken_counts[i],
+            ret = fh->f_comm->c_coll->coll_allgatherv (state->broken_iov_arrays[i],
+                                                      state->broken_counts[i],
                                                       fh->f_iov_type,
                                                       aggr_data[i]->global_iov_array,
                                                       aggr_data[i]->fview_count,
@@ -424,8 +629,8 @@ int mca_fcoll_vulcan_file_write_all (ompio_file_t *fh,
                                                       fh->f_comm->c_coll->coll_allgatherv_module );
         }
         else {
-            ret = ompi_fcoll_base_coll_allgatherv_array (broken_iov_arrays[i],
-							 broken_counts[i],
+            ret = ompi_fcoll_base_coll_allgatherv_array (state->broken_iov_arrays[i],
+							 state->broken_counts[i],
 							 fh->f_iov_type,
 							 aggr_data[i]->global_iov_array,
 							 aggr_data[i]->fview_count,
@@ -441,9 +646,9 @@ int mca_fcoll_vulcan_file_write_all (ompio_file_t *fh,
         }
 #if OMPIO_FCOLL_WANT_TIME_BREAKDOWN
         end_comm_time = MPI_Wtime();
-        comm_time += (end_comm_time - start_comm_time);
+        state->comm_time += (end_comm_time - start_comm_time);
 #endif
-        
+
         /****************************************************************************************
          *** 5. Sort the global offset/lengths list based on the offsets.
          *** The result of the sort operation is the 'sorted', an integer array,
@@ -461,18 +666,18 @@ int mca_fcoll_vulcan_file_write_all (ompio_file_t *fh,
             }
             ompi_fcoll_base_sort_iovec (aggr_data[i]->global_iov_array, total_fview_count, aggr_data[i]->sorted);
         }
-        
+
         if (NULL != local_iov_array){
             free(local_iov_array);
             local_iov_array = NULL;
         }
-        
+
         if (NULL != displs){
             free(displs);
             displs=NULL;
         }
-    
-    
+
+
 #if DEBUG_ON
         if (fh->f_aggr_list[i] == fh->f_rank) {
             uint32_t tv=0;
@@ -488,9 +693,9 @@ int mca_fcoll_vulcan_file_write_all (ompio_file_t *fh,
          *** 6. Determine the number of cycles required to execute this
          ***    operation
          *************************************************************/
-        
+
         aggr_data[i]->bytes_per_cycle = bytes_per_cycle;
-    
+
         if (fh->f_aggr_list[i] == fh->f_rank) {
             aggr_data[i]->disp_index = (int *)malloc (fh->f_procs_per_group * sizeof (int));
             if (NULL == aggr_data[i]->disp_index) {
@@ -505,22 +710,22 @@ int mca_fcoll_vulcan_file_write_all (ompio_file_t *fh,
                 ret = OMPI_ERR_OUT_OF_RESOURCE;
                 goto exit;
             }
-        
+
             aggr_data[i]->blocklen_per_process = (int **)calloc (fh->f_procs_per_group, sizeof (int*));
             if (NULL == aggr_data[i]->blocklen_per_process) {
                 opal_output (1, "OUT OF MEMORY\n");
                 ret = OMPI_ERR_OUT_OF_RESOURCE;
                 goto exit;
             }
-        
+
             aggr_data[i]->displs_per_process = (MPI_Aint **)calloc (fh->f_procs_per_group, sizeof (MPI_Aint*));
             if (NULL == aggr_data[i]->displs_per_process) {
                 opal_output (1, "OUT OF MEMORY\n");
                 ret = OMPI_ERR_OUT_OF_RESOURCE;
                 goto exit;
             }
-        
-            
+
+
             aggr_data[i]->global_buf       = (char *) malloc (bytes_per_cycle);
             aggr_data[i]->prev_global_buf  = (char *) malloc (bytes_per_cycle);
             if (NULL == aggr_data[i]->global_buf || NULL == aggr_data[i]->prev_global_buf){
@@ -528,10 +733,10 @@ int mca_fcoll_vulcan_file_write_all (ompio_file_t *fh,
                 ret = OMPI_ERR_OUT_OF_RESOURCE;
                 goto exit;
             }
-        
-            aggr_data[i]->recvtype = (ompi_datatype_t **) malloc (fh->f_procs_per_group  * 
+
+            aggr_data[i]->recvtype = (ompi_datatype_t **) malloc (fh->f_procs_per_group  *
                                                                   sizeof(ompi_datatype_t *));
-            aggr_data[i]->prev_recvtype = (ompi_datatype_t **) malloc (fh->f_procs_per_group  * 
+            aggr_data[i]->prev_recvtype = (ompi_datatype_t **) malloc (fh->f_procs_per_group  *
                                                                        sizeof(ompi_datatype_t *));
             if (NULL == aggr_data[i]->recvtype || NULL == aggr_data[i]->prev_recvtype) {
                 opal_output (1, "OUT OF MEMORY\n");
@@ -543,15 +748,12 @@ int mca_fcoll_vulcan_file_write_all (ompio_file_t *fh,
                 aggr_data[i]->prev_recvtype[l] = MPI_DATATYPE_NULL;
             }
         }
-    
-#if OMPIO_FCOLL_WANT_TIME_BREAKDOWN
-        start_exch = MPI_Wtime();
-#endif
-    }    
+    }
 
-    reqs = (ompi_request_t **)malloc ((fh->f_procs_per_group + 1 )*fh->f_num_aggrs *sizeof(ompi_request_t *));
+    state->reqs = (ompi_request_t **)malloc ((fh->f_procs_per_group + 1 )*fh->f_num_aggrs *sizeof(ompi_request_t *));
+    state->prev_reqs = (ompi_request_t **)malloc ((fh->f_procs_per_group + 1 )*fh->f_num_aggrs *sizeof(ompi_request_t *));
 
-    if ( NULL == reqs ) {
+    if ( NULL == state->reqs || NULL == state->prev_reqs ) {
         opal_output (1, "OUT OF MEMORY\n");
         ret = OMPI_ERR_OUT_OF_RESOURCE;
         goto exit;
@@ -559,149 +761,68 @@ int mca_fcoll_vulcan_file_write_all (ompio_file_t *fh,
 
     for (l=0,i=0; i < fh->f_num_aggrs; i++ ) {
         for ( j=0; j< (fh->f_procs_per_group+1); j++ ) {
-            reqs[l] = MPI_REQUEST_NULL;
+            state->reqs[l] = MPI_REQUEST_NULL;
+            state->prev_reqs[l] = MPI_REQUEST_NULL;
             l++;
         }
     }
 
-    // In fact it should be: if ((1 == mca_fcoll_vulcan_async_io) && (NULL != fh->f_fbtl->fbtl_ipwritev))
-    // But we've already tested that.
-    if( (1 == mca_fcoll_vulcan_async_io) ||
-        ( (0 == mca_fcoll_vulcan_async_io) && (NULL != fh->f_fbtl->fbtl_ipwritev) && (2 < cycles) ) ) {
-        write_synch_type = 1;
-    }
-
-    if ( cycles > 0 ) {
-        for ( i=0; i<fh->f_num_aggrs; i++ ) {
-            ret = shuffle_init ( 0, cycles, fh->f_aggr_list[i], fh->f_rank, aggr_data[i],
-                                 &reqs[i*(fh->f_procs_per_group + 1)] );
-            if ( OMPI_SUCCESS != ret ) {
-                goto exit;
-            }
-        }
-        // Register progress function that should be used by ompi_request_wait
-        if (NOT_AGGR_INDEX != aggr_index)  {
-            mca_common_ompio_register_progress ();
-        }
-    }
-
-    ret = ompi_request_wait_all ( (fh->f_procs_per_group + 1 )*fh->f_num_aggrs,
-                                  reqs, MPI_STATUS_IGNORE);
-
-    for (index = 1; index < cycles; index++) {
-        SWAP_AGGR_POINTERS(aggr_data, fh->f_num_aggrs);
-
-        if(NOT_AGGR_INDEX != aggr_index) {
-#if OMPIO_FCOLL_WANT_TIME_BREAKDOWN
-            start_write_time = MPI_Wtime();
-#endif
-            ret = write_init (fh, fh->f_aggr_list[aggr_index], aggr_data[aggr_index],
-                              write_chunksize, write_synch_type, &req_iwrite);
-            if (OMPI_SUCCESS != ret){
-                goto exit;
-            }
-#if OMPIO_FCOLL_WANT_TIME_BREAKDOWN
-            end_write_time = MPI_Wtime();
-            write_time += end_write_time - start_write_time;
-#endif
-        }
+exit:
+    free(displs);
+    free(local_iov_array);
+    free(total_bytes_per_process);
 
-        for ( i=0; i<fh->f_num_aggrs; i++ ) {
-            ret = shuffle_init ( index, cycles, fh->f_aggr_list[i], fh->f_rank, aggr_data[i],
-                                 &reqs[i*(fh->f_procs_per_group + 1)] );
-            if ( OMPI_SUCCESS != ret ) {
-                goto exit;
-            }
-        }
+    /* the group belongs to this operation from now on, the next
+       collective operation on the file sets up its own */
+    state->procs_per_group = fh->f_procs_per_group;
+    state->procs_in_group  = fh->f_procs_in_group;
+    fh->f_procs_in_group   = NULL;
+    fh->f_procs_per_group  = 0;
 
-        ret = ompi_request_wait_all ( (fh->f_procs_per_group + 1 )*fh->f_num_aggrs,
-                                      reqs, MPI_STATUS_IGNORE);
-        if (OMPI_SUCCESS != ret){
-            goto exit;
-        }
+    return ret;
+}
 
-        if(NOT_AGGR_INDEX != aggr_index) {
-            ret = ompi_request_wait(&req_iwrite, MPI_STATUS_IGNORE);
-            if (OMPI_SUCCESS != ret){
-                goto exit;
-            }
-        }
-    } /* end  for (index = 0; index < cycles; index++) */
 
-    if ( cycles > 0 ) {
-        SWAP_AGGR_POINTERS(aggr_data,fh->f_num_aggrs);
+void mca_fcoll_vulcan_coll_cleanup (mca_fcoll_vulcan_coll_state_t *state)
+{
+    mca_io_ompio_aggregator_data **aggr_data = state->aggr_data;
+    int i, j, l;
 
-        if(NOT_AGGR_INDEX != aggr_index) {
-#if OMPIO_FCOLL_WANT_TIME_BREAKDOWN
-            start_write_time = MPI_Wtime();
-#endif
-            ret = write_init (fh, fh->f_aggr_list[aggr_index], aggr_data[aggr_index],
-                              write_chunksize, write_synch_type, &req_iwrite);
-            if (OMPI_SUCCESS != ret){
-                goto exit;
-            }
-#if OMPIO_FCOLL_WANT_TIME_BREAKDOWN
-            end_write_time = MPI_Wtime();
-            write_time += end_write_time - start_write_time;
-#endif
-        }
+    if ( NULL != aggr_data ) {
 
-        if(NOT_AGGR_INDEX != aggr_index) {
-            ret = ompi_request_wait(&req_iwrite, MPI_STATUS_IGNORE);
-            if (OMPI_SUCCESS != ret){
-                goto exit;
+        for ( i=0; i< state->num_aggrs; i++ ) {
+            if ( NULL == aggr_data[i] ) {
+                continue;
             }
-        }
-    }
-        
-#if OMPIO_FCOLL_WANT_TIME_BREAKDOWN
-    end_exch = MPI_Wtime();
-    exch_write += end_exch - start_exch;
-    nentry.time[0] = write_time;
-    nentry.time[1] = comm_time;
-    nentry.time[2] = exch_write;
-    nentry.aggregator = 0;
-    for ( i=0; i<fh->f_num_aggrs; i++ ) {
-        if (fh->f_aggr_list[i] == fh->f_rank)
-	nentry.aggregator = 1;
-    }
-    nentry.nprocs_for_coll = fh->f_num_aggrs;
-    if (!mca_common_ompio_full_print_queue(fh->f_coll_write_time)){
-        mca_common_ompio_register_print_entry(fh->f_coll_write_time,
-                                               nentry);
-    }
-#endif
-    
-    
-exit :
-    
-    if ( NULL != aggr_data ) {
-        
-        for ( i=0; i< fh->f_num_aggrs; i++ ) {            
-            if (fh->f_aggr_list[i] == fh->f_rank) {
+            if (state->aggr_list[i] == state->fh->f_rank) {
                 if (NULL != aggr_data[i]->recvtype){
                     for (j =0; j< aggr_data[i]->procs_per_group; j++) {
                         if ( MPI_DATATYPE_NULL != aggr_data[i]->recvtype[j] ) {
                             ompi_datatype_destroy(&aggr_data[i]->recvtype[j]);
                         }
-                        if ( MPI_DATATYPE_NULL != aggr_data[i]->prev_recvtype[j] ) {
+                        if ( NULL != aggr_data[i]->prev_recvtype &&
+                             MPI_DATATYPE_NULL != aggr_data[i]->prev_recvtype[j] ) {
                             ompi_datatype_destroy(&aggr_data[i]->prev_recvtype[j]);
                         }
-			
+
                     }
-                    free(aggr_data[i]->recvtype);
-                    free(aggr_data[i]->prev_recvtype);
                 }
-                
+                free(aggr_data[i]->recvtype);
+                free(aggr_data[i]->prev_recvtype);
+
                 free (aggr_data[i]->disp_index);
                 free (aggr_data[i]->max_disp_index);
                 free (aggr_data[i]->global_buf);
                 free (aggr_data[i]->prev_global_buf);
                 for(l=0;l<aggr_data[i]->procs_per_group;l++){
-                    free (aggr_data[i]->blocklen_per_process[l]);
-                    free (aggr_data[i]->displs_per_process[l]);
+                    if (NULL != aggr_data[i]->blocklen_per_process) {
+                        free (aggr_data[i]->blocklen_per_process[l]);
+                    }
+                    if (NULL != aggr_data[i]->displs_per_process) {
+                        free (aggr_data[i]->displs_per_process[l]);
+                    }
                 }
-                
+
                 free (aggr_data[i]->blocklen_per_process);
                 free (aggr_data[i]->displs_per_process);
             }
@@ -709,30 +830,40 @@ exit :
             free (aggr_data[i]->global_iov_array);
             free (aggr_data[i]->fview_count);
             free (aggr_data[i]->decoded_iov);
-            
+
             free (aggr_data[i]);
         }
         free (aggr_data);
     }
-    free(displs);
-    free(decoded_iov);
-    free(broken_counts);
-    free(broken_total_lengths);
-    free(broken_iov_counts);
-    free(broken_decoded_iovs); // decoded_iov arrays[i] were freed as aggr_data[i]->decoded_iov;
-    if ( NULL != broken_iov_arrays ) {
-        for (i=0; i<fh->f_num_aggrs; i++ ) {
-            free(broken_iov_arrays[i]);
+    free(state->decoded_iov);
+    free(state->broken_counts);
+    free(state->broken_total_lengths);
+    free(state->broken_iov_counts);
+    free(state->broken_decoded_iovs); // decoded_iov arrays[i] were freed as aggr_data[i]->decoded_iov;
+    if ( NULL != state->broken_iov_arrays ) {
+        for (i=0; i<state->num_aggrs; i++ ) {
+            free(state->broken_iov_arrays[i]);
         }
     }
-    free(broken_iov_arrays);
-    free(fh->f_procs_in_group);
-    fh->f_procs_in_group=NULL;
-    fh->f_procs_per_group=0;
-    free(result_counts);
-    free(reqs);
-     
-    return OMPI_SUCCESS;
+    free(state->broken_iov_arrays);
+    free(state->procs_in_group);
+    free(state->aggr_list);
+    free(state->result_counts);
+    free(state->reqs);
+    free(state->prev_reqs);
+
+    state->aggr_data = NULL;
+    state->decoded_iov = NULL;
+    state->broken_counts = NULL;
+    state->broken_total_lengths = NULL;
+    state->broken_iov_counts = NULL;
+    state->broken_decoded_iovs = NULL;
+    state->broken_iov_arrays = NULL;
+    state->procs_in_group = NULL;
+    state->aggr_list = NULL;
+    state->result_counts = NULL;
+    state->reqs = NULL;
+    state->prev_reqs = NULL;
 }
 
 static int write_init (ompio_file_t *fh,
@@ -760,17 +891,23 @@ static int write_init (ompio_file_t *fh,
                                           &last_array_pos, &last_pos,
                                           write_chunksize);
 
-        if (1 == write_synchType) {
+        if (1 == write_synchType && 0 == aggr_data->compress_block) {
             ret = fh->f_fbtl->fbtl_ipwritev(fh, (ompi_request_t *) ompio_req);
             if(0 > ret) {
                 opal_output (1, "vulcan_write_all: fbtl_ipwritev failed\n");
                 ompio_req->req_ompi.req_status.MPI_ERROR = ret;
                 ompio_req->req_ompi.req_status._ucount = 0;
+                ompi_request_complete (&ompio_req->req_ompi, false);
             }
         }
         else {
             fh->f_flags |= OMPIO_COLLECTIVE_OP;
-            ret_temp = fh->f_fbtl->fbtl_pwritev(fh);
+            if (0 < aggr_data->compress_block) {
+                ret_temp = mca_fcoll_vulcan_compress_pwritev (fh, aggr_data->compress_block);
+            }
+            else {
+                ret_temp = fh->f_fbtl->fbtl_pwritev(fh);
+            }
             fh->f_flags &= ~OMPIO_COLLECTIVE_OP;
             if(0 > ret_temp) {
                 opal_output (1, "vulcan_write_all: fbtl_pwritev failed\n");
@@ -800,8 +937,16 @@ static int write_init (ompio_file_t *fh,
     return ret;
 }
 
-static int shuffle_init ( int index, int cycles, int aggregator, int rank, mca_io_ompio_aggregator_data *data, 
-                          ompi_request_t **reqs )
+/*
+ * Set up cycle index of the two-phase algorithm for one aggregator. For
+ * writes the aggregator posts the receives of the contributions into
+ * global_buf and every process sends its part. For reads the io_array is
+ * set up the same way, but only the receives into the user buffer are
+ * posted, the aggregator sends the data once it has been read.
+ */
+int mca_fcoll_vulcan_shuffle_init ( int index, int cycles, int aggregator, int rank,
+                                    mca_io_ompio_aggregator_data *data,
+                                    bool is_read, ompi_request_t **reqs )
 {
     int bytes_sent = 0;
     int blocks=0, temp_pindex;
@@ -1180,7 +1325,9 @@ static int shuffle_init ( int index, int cycles, int aggregator, int rank, mca_i
                     ompi_datatype_commit(&data->recvtype[i]);
                     opal_datatype_type_size(&data->recvtype[i]->super, &datatype_size);
                     
-                    if (datatype_size){
+                    /* for reads the type is kept to send the data out of
+                       global_buf, once the aggregator has read it */
+                    if (datatype_size && !is_read){
                         ret = MCA_PML_CALL(irecv(data->global_buf,
                                                  1,
                                                  data->recvtype[i],
@@ -1259,14 +1406,25 @@ static int shuffle_init ( int index, int cycles, int aggregator, int rank, mca_i
                                           &newType);
             ompi_datatype_commit(&newType);
 
-            ret = MCA_PML_CALL(isend((char *)send_mem_address,
-                                     1,
-                                     newType,
-                                     aggregator,
-                                     FCOLL_VULCAN_SHUFFLE_TAG+index,
-                                     MCA_PML_BASE_SEND_STANDARD,
-                                     data->comm,
-                                     &reqs[data->procs_per_group]));
+            if (is_read) {
+                ret = MCA_PML_CALL(irecv((char *)send_mem_address,
+                                         1,
+                                         newType,
+                                         aggregator,
+                                         FCOLL_VULCAN_SHUFFLE_TAG+index,
+                                         data->comm,
+                                         &reqs[data->procs_per_group]));
+            }
+            else {
+                ret = MCA_PML_CALL(isend((char *)send_mem_address,
+                                         1,
+                                         newType,
+                                         aggregator,
+                                         FCOLL_VULCAN_SHUFFLE_TAG+index,
+                                         MCA_PML_BASE_SEND_STANDARD,
+                                         data->comm,
+                                         &reqs[data->procs_per_group]));
+            }
             if ( MPI_DATATYPE_NULL != newType ) {
                 ompi_datatype_destroy(&newType);
             }
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2008-2021 University of Houston. All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#ifndef MCA_FCOLL_VULCAN_INTERNAL_H
+#define MCA_FCOLL_VULCAN_INTERNAL_H
+
+#include "ompi_config.h"
+
+#include "mpi.h"
+#include "ompi/request/request.h"
+#include "ompi/mca/common/ompio/common_ompio.h"
+#include "ompi/mca/common/ompio/common_ompio_request.h"
+
+BEGIN_C_DECLS
+
+#define NOT_AGGR_INDEX -1
+
+/*Used for loading file-offsets per aggregator*/
+typedef struct mca_io_ompio_local_io_array{
+    OMPI_MPI_OFFSET_TYPE offset;
+    MPI_Aint             length;
+    int                  process_id;
+}mca_io_ompio_local_io_array;
+
+typedef struct mca_io_ompio_aggregator_data {
+    int *disp_index, *sorted, *fview_count, n;
+    int *max_disp_index;
+    int **blocklen_per_process;
+    MPI_Aint **displs_per_process, total_bytes, bytes_per_cycle, total_bytes_written;
+    MPI_Comm comm;
+    char *buf, *global_buf, *prev_global_buf;
+    ompi_datatype_t **recvtype, **prev_recvtype;
+    struct iovec *global_iov_array;
+    int current_index, current_position;
+    int bytes_to_write_in_cycle, bytes_remaining, procs_per_group;
+    int *procs_in_group, iov_index;
+    int bytes_sent, prev_bytes_sent;
+    struct iovec *decoded_iov;
+    int bytes_to_write, prev_bytes_to_write;
+    mca_common_ompio_io_array_t *io_array, *prev_io_array;
+    int num_io_entries, prev_num_io_entries;
+    size_t compress_block;
+} mca_io_ompio_aggregator_data;
+
+
+#define SWAP_REQUESTS(_r1,_r2) { \
+    ompi_request_t **_t=_r1;     \
+    _r1=_r2;                     \
+    _r2=_t;}
+
+#define SWAP_AGGR_POINTERS(_aggr,_num) {                        \
+    int _i;                                                     \
+    char *_t;                                                   \
+    for (_i=0; _i<_num; _i++ ) {                                \
+        _aggr[_i]->prev_io_array=_aggr[_i]->io_array;             \
+        _aggr[_i]->prev_num_io_entries=_aggr[_i]->num_io_entries; \
+        _aggr[_i]->prev_bytes_sent=_aggr[_i]->bytes_sent;         \
+        _aggr[_i]->prev_bytes_to_write=_aggr[_i]->bytes_to_write; \
+        _t=_aggr[_i]->prev_global_buf;                            \
+        _aggr[_i]->prev_global_buf=_aggr[_i]->global_buf;         \
+        _aggr[_i]->global_buf=_t;                                 \
+        _t=(char *)_aggr[_i]->recvtype;                           \
+        _aggr[_i]->recvtype=_aggr[_i]->prev_recvtype;             \
+        _aggr[_i]->prev_recvtype=(ompi_datatype_t **)_t;          }                                                             \
+}
+
+struct mca_fcoll_vulcan_coll_state_t;
+typedef bool (*mca_fcoll_vulcan_advance_fn_t)(struct mca_fcoll_vulcan_coll_state_t *state);
+
+/**
+ * Everything a collective operation needs once the file view and the
+ * aggregator domains have been exchanged. The blocking write keeps it
+ * on the stack of the call, the other operations hang it off an ompio
+ * request and advance it from mca_common_ompio_progress().
+ */
+typedef struct mca_fcoll_vulcan_coll_state_t {
+    ompio_file_t *fh;
+    mca_io_ompio_aggregator_data **aggr_data;
+    /* the aggregator layout is copied out of the file handle, a later
+       collective operation on the same file replaces it */
+    int num_aggrs;
+    int *aggr_list;
+    int aggr_index;
+    int procs_per_group;
+    int *procs_in_group;
+
+    struct iovec *decoded_iov;
+    struct iovec **broken_iov_arrays;
+    struct iovec **broken_decoded_iovs;
+    int *broken_counts;
+    int *broken_iov_counts;
+    MPI_Aint *broken_total_lengths;
+    int *result_counts;
+    size_t max_data;
+
+    /* (procs_per_group + 1) requests per aggregator: one per process
+       of the group on the aggregator, plus the own contribution. The
+       read pipeline keeps the requests of the previous cycle in
+       prev_reqs while the next one is set up. */
+    ompi_request_t **reqs;
+    ompi_request_t **prev_reqs;
+    ompi_request_t *req_io;
+    bool io_pending;
+    int io_chunksize;
+    int io_synch_type;
+    int cycles;
+    int index;
+    int error;
+    mca_fcoll_vulcan_advance_fn_t advance;
+#if OMPIO_FCOLL_WANT_TIME_BREAKDOWN
+    double comm_time;
+#endif
+} mca_fcoll_vulcan_coll_state_t;
+
+int mca_fcoll_vulcan_coll_setup (ompio_file_t *fh, const void *buf, int count,
+                                 struct ompi_datatype_t *datatype,
+                                 mca_fcoll_vulcan_coll_state_t *state);
+void mca_fcoll_vulcan_coll_cleanup (mca_fcoll_vulcan_coll_state_t *state);
+
+int mca_fcoll_vulcan_shuffle_init (int index, int cycles, int aggregator, int rank,
+                                   mca_io_ompio_aggregator_data *data,
+                                   bool is_read, ompi_request_t **reqs);
+
+int mca_fcoll_vulcan_split_iov_array (ompio_file_t *fh, mca_common_ompio_io_array_t *work_array,
+                                      int num_entries, int *last_array_pos, int *last_pos_in_field,
+                                      int chunk_size);
+
+/* compression of the aggregator buffers, see fcoll_vulcan_compress.c */
+size_t mca_fcoll_vulcan_compress_requested (ompio_file_t *fh);
+size_t mca_fcoll_vulcan_compress_block_size (ompio_file_t *fh);
+int mca_fcoll_vulcan_compress_init (ompio_file_t *fh);
+ssize_t mca_fcoll_vulcan_compress_pwritev (ompio_file_t *fh, size_t block_size);
+ssize_t mca_fcoll_vulcan_compress_preadv (ompio_file_t *fh, size_t block_size);
+
+/* non-blocking operations */
+int mca_fcoll_vulcan_coll_start (ompio_file_t *fh, mca_fcoll_vulcan_coll_state_t *state,
+                                 mca_ompio_request_type_t type, ompi_request_t **request);
+bool mca_fcoll_vulcan_coll_test_reqs (mca_fcoll_vulcan_coll_state_t *state, ompi_request_t **reqs);
+bool mca_fcoll_vulcan_coll_test_io (mca_fcoll_vulcan_coll_state_t *state);
+void mca_fcoll_vulcan_coll_wait_pending (ompio_file_t *fh);
+
+END_C_DECLS
+
+#endif /* MCA_FCOLL_VULCAN_INTERNAL_H */
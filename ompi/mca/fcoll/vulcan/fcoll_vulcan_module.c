@@ -21,6 +21,7 @@
 
 #include "ompi_config.h"
 #include "fcoll_vulcan.h"
+#include "fcoll_vulcan_internal.h"
 
 #include <stdio.h>
 
@@ -37,10 +38,10 @@
 static mca_fcoll_base_module_1_0_0_t vulcan =  {
     mca_fcoll_vulcan_module_init,
     mca_fcoll_vulcan_module_finalize,
-    mca_fcoll_base_file_read_all,
-    NULL, /* iread_all */
+    mca_fcoll_vulcan_file_read_all,
+    mca_fcoll_vulcan_file_iread_all,
     mca_fcoll_vulcan_file_write_all,
-    NULL, /*iwrite_all */
+    mca_fcoll_vulcan_file_iwrite_all,
     NULL, /* progress */
     NULL  /* request_free */
 };
@@ -82,6 +83,9 @@ int mca_fcoll_vulcan_component_file_unquery (ompio_file_t *file)
 
 int mca_fcoll_vulcan_module_init (ompio_file_t *file)
 {
+    /* the compression info keys are only used by the first write, look
+       them up now so that they are kept on the info object of the file */
+    (void) mca_fcoll_vulcan_compress_requested (file);
     return OMPI_SUCCESS;
 }
 
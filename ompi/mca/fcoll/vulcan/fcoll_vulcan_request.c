@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2008-2021 University of Houston. All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+#include "fcoll_vulcan.h"
+#include "fcoll_vulcan_internal.h"
+
+#include "mpi.h"
+#include "ompi/constants.h"
+#include "ompi/request/request.h"
+#include "ompi/mca/common/ompio/common_ompio.h"
+#include "ompi/mca/common/ompio/common_ompio_request.h"
+#include "opal/runtime/opal_progress.h"
+
+/*
+ * Non-blocking collective operations of the vulcan component.
+ *
+ * The state of the operation hangs off an ompio request, whose progress
+ * function is invoked by mca_common_ompio_progress(). It only looks at
+ * the completion flags of the outstanding requests: ompi_request_test()
+ * would call opal_progress() again from within the progress engine.
+ */
+
+static bool vulcan_coll_progress (mca_ompio_request_t *req);
+static void vulcan_coll_request_free (mca_ompio_request_t *req);
+
+/*
+ * The operations on a file all use the same tags, so the cycles of a
+ * non-blocking operation only start once the earlier operations on the
+ * same file have completed locally. Since every process initiates them
+ * in the same order, messages still match in order.
+ */
+static bool vulcan_coll_pending (ompio_file_t *fh, mca_ompio_request_t *until)
+{
+    mca_ompio_request_t *req;
+    opal_list_item_t *litem;
+
+    OPAL_LIST_FOREACH(litem, &mca_common_ompio_pending_requests, opal_list_item_t) {
+        req = GET_OMPIO_REQ_FROM_ITEM(litem);
+        if (req == until) {
+            break;
+        }
+        if (vulcan_coll_progress == req->req_progress_fn &&
+            !REQUEST_COMPLETE(&req->req_ompi) &&
+            ((mca_fcoll_vulcan_coll_state_t *) req->req_data)->fh == fh) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void mca_fcoll_vulcan_coll_wait_pending (ompio_file_t *fh)
+{
+    while (vulcan_coll_pending (fh, NULL)) {
+        opal_progress ();
+    }
+}
+
+int mca_fcoll_vulcan_coll_start (ompio_file_t *fh, mca_fcoll_vulcan_coll_state_t *state,
+                                 mca_ompio_request_type_t type, ompi_request_t **request)
+{
+    mca_ompio_request_t *ompio_req = NULL;
+
+    mca_common_ompio_request_alloc (&ompio_req, type);
+    ompio_req->req_data        = state;
+    ompio_req->req_progress_fn = vulcan_coll_progress;
+    ompio_req->req_free_fn     = vulcan_coll_request_free;
+
+    mca_common_ompio_register_progress ();
+
+    /* nothing to do if no process contributes any data */
+    if (0 == state->cycles) {
+        ompio_req->req_ompi.req_status.MPI_ERROR = OMPI_SUCCESS;
+        ompio_req->req_ompi.req_status._ucount = state->max_data;
+        mca_fcoll_vulcan_coll_cleanup (state);
+        ompi_request_complete (&ompio_req->req_ompi, false);
+    }
+
+    *request = (ompi_request_t *) ompio_req;
+    return OMPI_SUCCESS;
+}
+
+static bool vulcan_coll_test_req (mca_fcoll_vulcan_coll_state_t *state, ompi_request_t **req)
+{
+    if (MPI_REQUEST_NULL == *req) {
+        return true;
+    }
+    if (!REQUEST_COMPLETE(*req)) {
+        return false;
+    }
+    if (OMPI_SUCCESS != (*req)->req_status.MPI_ERROR && OMPI_SUCCESS == state->error) {
+        state->error = (*req)->req_status.MPI_ERROR;
+    }
+    ompi_request_free (req);
+    return true;
+}
+
+bool mca_fcoll_vulcan_coll_test_reqs (mca_fcoll_vulcan_coll_state_t *state, ompi_request_t **reqs)
+{
+    int i, nreqs = (state->procs_per_group + 1) * state->num_aggrs;
+    bool done = true;
+
+    for (i = 0; i < nreqs; i++) {
+        if (!vulcan_coll_test_req (state, &reqs[i])) {
+            done = false;
+        }
+    }
+
+    return done;
+}
+
+bool mca_fcoll_vulcan_coll_test_io (mca_fcoll_vulcan_coll_state_t *state)
+{
+    return vulcan_coll_test_req (state, &state->req_io);
+}
+
+static bool vulcan_coll_progress (mca_ompio_request_t *req)
+{
+    mca_fcoll_vulcan_coll_state_t *state = (mca_fcoll_vulcan_coll_state_t *) req->req_data;
+
+    if (vulcan_coll_pending (state->fh, req)) {
+        return false;
+    }
+    if (!state->advance (state)) {
+        return false;
+    }
+
+    req->req_ompi.req_status.MPI_ERROR = state->error;
+    req->req_ompi.req_status._ucount = (OMPI_SUCCESS == state->error) ? state->max_data : 0;
+
+    /* the buffers are not needed anymore, release them right away
+       instead of waiting for the request to be freed */
+    mca_fcoll_vulcan_coll_cleanup (state);
+    return true;
+}
+
+static void vulcan_coll_request_free (mca_ompio_request_t *req)
+{
+    mca_fcoll_vulcan_coll_state_t *state = (mca_fcoll_vulcan_coll_state_t *) req->req_data;
+
+    if (NULL != state) {
+        mca_fcoll_vulcan_coll_cleanup (state);
+        free (state);
+        req->req_data = NULL;
+    }
+}
@@ -536,6 +536,9 @@ int mca_io_ompio_get_mca_parameter_value ( char *mca_parameter_name, int name_le
     else if ( !strncmp ( mca_parameter_name, "cycle_buffer_size", name_length )) {
         return mca_io_ompio_cycle_buffer_size;
     }
+    else if ( !strncmp ( mca_parameter_name, "cache_size", name_length )) {
+        return mca_io_ompio_cache_size;
+    }
     else if ( !strncmp ( mca_parameter_name, "max_aggregators_ratio", name_length )) {
         return mca_io_ompio_max_aggregators_ratio;
     }
@@ -545,6 +548,9 @@ int mca_io_ompio_get_mca_parameter_value ( char *mca_parameter_name, int name_le
     else if ( !strncmp ( mca_parameter_name, "grouping_option", name_length )) {
         return mca_io_ompio_grouping_option;
     }
+    else if ( !strncmp ( mca_parameter_name, "aggregator_placement", name_length )) {
+        return mca_io_ompio_aggregator_placement;
+    }
     else if ( !strncmp ( mca_parameter_name, "coll_timing_info", name_length )) {
         return mca_io_ompio_coll_timing_info;
     }
@@ -47,6 +47,8 @@ int mca_io_ompio_overwrite_amode = 1;
 int mca_io_ompio_verbose_info_parsing = 0;
 
 int mca_io_ompio_grouping_option=5;
+int mca_io_ompio_aggregator_placement=OMPIO_AGGR_PLACEMENT_RANK;
+int mca_io_ompio_cache_size = 0;
 
 /*
  * Private functions
@@ -177,6 +179,19 @@ static int register_component(void)
                                            MCA_BASE_VAR_SCOPE_READONLY,
                                            &mca_io_ompio_cycle_buffer_size);
 
+    mca_io_ompio_cache_size = 0;
+    (void) mca_base_component_var_register(&mca_io_ompio_component.io_version,
+                                           "cache_size",
+                                           "Size of the per file buffer coalescing small individual writes "
+                                           "and reading ahead of small individual reads. The buffer is flushed "
+                                           "on sync, close and collective operations, and not used in atomic "
+                                           "mode. Can be overridden with the ompio_cache_size info key "
+                                           "0: no buffering (default)",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_io_ompio_cache_size);
+
     mca_io_ompio_bytes_per_agg = OMPIO_PREALLOC_MAX_BUF_SIZE;
     (void) mca_base_component_var_register(&mca_io_ompio_component.io_version,
                                            "bytes_per_agg",
@@ -208,6 +223,19 @@ static int register_component(void)
                                            MCA_BASE_VAR_SCOPE_READONLY,
                                            &mca_io_ompio_grouping_option);
 
+    mca_io_ompio_aggregator_placement = OMPIO_AGGR_PLACEMENT_RANK;
+    (void) mca_base_component_var_register(&mca_io_ompio_component.io_version,
+                                           "aggregator_placement",
+                                           "Placement of the aggregators chosen by the simple grouping or "
+                                           "requested through num_aggregators/cb_nodes "
+                                           "0: contiguous groups in rank order (default) "
+                                           "1: groups made of processes of the same node, aggregators "
+                                           "spread evenly across the nodes and sockets",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_io_ompio_aggregator_placement);
+
     mca_io_ompio_max_aggregators_ratio = 8;
     (void) mca_base_component_var_register(&mca_io_ompio_component.io_version,
                                            "max_aggregators_ratio",
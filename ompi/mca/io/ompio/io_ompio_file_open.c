@@ -40,6 +40,7 @@
 #include <math.h>
 #include "io_ompio.h"
 #include "ompi/mca/common/ompio/common_ompio_request.h"
+#include "ompi/mca/common/ompio/common_ompio_cache.h"
 #include "ompi/mca/topo/topo.h"
 
 int mca_io_ompio_file_open (ompi_communicator_t *comm,
@@ -115,6 +116,11 @@ int mca_io_ompio_file_preallocate (ompi_file_t *fh,
     data = (mca_common_ompio_data_t *) fh->f_io_selected_data;
 
     OPAL_THREAD_LOCK(&fh->f_lock);
+    ret = mca_common_ompio_cache_flush (&data->ompio_fh);
+    if ( OMPI_SUCCESS != ret ) {
+        OPAL_THREAD_UNLOCK(&fh->f_lock);
+        return ret;
+    }
     tmp = diskspace;
 
     ret = data->ompio_fh.f_comm->c_coll->coll_bcast (&tmp,
@@ -211,6 +217,12 @@ int mca_io_ompio_file_preallocate (ompi_file_t *fh,
 
 exit:     
     free ( buf );
+    if ( OMPIO_ROOT == data->ompio_fh.f_rank ) {
+        int flush_ret = mca_common_ompio_cache_flush (&data->ompio_fh);
+        if ( OMPI_SUCCESS == ret ) {
+            ret = flush_ret;
+        }
+    }
     fh->f_comm->c_coll->coll_bcast ( &ret, 1, MPI_INT, OMPIO_ROOT, fh->f_comm,
                                    fh->f_comm->c_coll->coll_bcast_module);
     
@@ -233,6 +245,12 @@ int mca_io_ompio_file_set_size (ompi_file_t *fh,
 
     tmp = size;
     OPAL_THREAD_LOCK(&fh->f_lock);
+    /* cached data written out later on would extend the file again */
+    ret = mca_common_ompio_cache_flush (&data->ompio_fh);
+    if ( OMPI_SUCCESS != ret ) {
+        OPAL_THREAD_UNLOCK(&fh->f_lock);
+        return ret;
+    }
     ret = data->ompio_fh.f_comm->c_coll->coll_bcast (&tmp,
                                                     1,
                                                     OMPI_OFFSET_DATATYPE,
@@ -337,6 +355,12 @@ int mca_io_ompio_file_set_atomicity (ompi_file_t *fh,
 
     bool result;
     if ( flag ) {
+        /* the cache is not used in atomic mode */
+        ret = mca_common_ompio_cache_flush (&data->ompio_fh);
+        if ( OMPI_SUCCESS != ret ) {
+            OPAL_THREAD_UNLOCK(&fh->f_lock);
+            return ret;
+        }
         result = data->ompio_fh.f_fbtl->fbtl_check_atomicity(&data->ompio_fh);
         if ( result ) {
             data->ompio_fh.f_atomicity = flag;
@@ -380,6 +404,14 @@ int mca_io_ompio_file_sync (ompi_file_t *fh)
         return MPI_ERR_OTHER;
     }
 
+    /* write out the cached data and drop what has been read ahead, writes
+       of other processes become visible with this call */
+    ret = mca_common_ompio_cache_flush (&data->ompio_fh);
+    if ( OMPI_SUCCESS != ret ) {
+        OPAL_THREAD_UNLOCK(&fh->f_lock);
+        return ret;
+    }
+
     if ( data->ompio_fh.f_amode & MPI_MODE_RDONLY ) {
         OPAL_THREAD_UNLOCK(&fh->f_lock);
         return MPI_ERR_ACCESS;
@@ -467,8 +499,8 @@ int mca_io_ompio_file_seek (ompi_file_t *fh,
         }
         break;
     case MPI_SEEK_END:
-        ret = data->ompio_fh.f_fs->fs_file_get_size (&data->ompio_fh,
-                                                     &temp_offset2);
+        ret = mca_common_ompio_file_get_size (&data->ompio_fh,
+                                              &temp_offset2);
         mca_io_ompio_file_get_eof_offset (&data->ompio_fh,
                                           temp_offset2, &temp_offset);
         offset += temp_offset;
@@ -118,6 +118,12 @@ struct ompi_osc_rdma_component_t {
 
     /** memory alignmen to be used for new windows */
     size_t memory_alignment;
+
+    /** Default value of the coalesce info key for new windows */
+    bool coalesce;
+
+    /** largest number of bytes combined into one transfer when coalescing */
+    unsigned int coalesce_size;
 };
 typedef struct ompi_osc_rdma_component_t ompi_osc_rdma_component_t;
 
@@ -160,6 +166,9 @@ struct ompi_osc_rdma_module_t {
 
     bool acc_use_amo;
 
+    /** small puts and accumulates are combined per target (coalesce info key) */
+    bool coalesce;
+
     /** whether the group is located on a single node */
     bool single_node;
 
@@ -297,6 +306,14 @@ struct ompi_osc_rdma_module_t {
     /** number of time a get had to be retried */
     unsigned long get_retry_count;
 
+    /** number of puts and accumulates combined with a previous operation */
+    unsigned long coalesced_count;
+
+    /** peers with buffered operations */
+    ompi_osc_rdma_peer_t **coalesce_peers;
+    int coalesce_peer_count;
+    int coalesce_peer_size;
+
     /** outstanding atomic operations */
     opal_atomic_int32_t pending_ops;
 };
@@ -589,6 +606,13 @@ static inline void ompi_osc_rdma_sync_rdma_dec (ompi_osc_rdma_sync_t *rdma_sync)
     ompi_osc_rdma_sync_rdma_dec_always (rdma_sync);
 }
 
+/**
+ * @brief start the transfers of the operations buffered for all peers
+ *
+ * @param[in] module          osc rdma module
+ */
+int ompi_osc_rdma_coalesce_flush_all (ompi_osc_rdma_module_t *module);
+
 /**
  * @brief complete all outstanding rdma operations to all peers
  *
@@ -596,6 +620,10 @@ static inline void ompi_osc_rdma_sync_rdma_dec (ompi_osc_rdma_sync_t *rdma_sync)
  */
 static inline void ompi_osc_rdma_sync_rdma_complete (ompi_osc_rdma_sync_t *sync)
 {
+    if (sync->module->coalesce_peer_count) {
+        (void) ompi_osc_rdma_coalesce_flush_all (sync->module);
+    }
+
 #if !defined(BTL_VERSION) || (BTL_VERSION < 310)
     do {
         opal_progress ();
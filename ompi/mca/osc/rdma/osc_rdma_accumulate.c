@@ -812,6 +812,12 @@ int ompi_osc_rdma_compare_and_swap (const void *origin_addr, const void *compare
         return OMPI_ERR_RMA_SYNC;
     }
 
+    /* accumulates to the same target are ordered */
+    ret = ompi_osc_rdma_acc_coalesce_flush (peer);
+    if (OPAL_UNLIKELY(OMPI_SUCCESS != ret)) {
+        return ret;
+    }
+
     ret = ompi_datatype_get_true_extent(dt, &true_lb, &true_extent);
     if (OPAL_UNLIKELY(OMPI_SUCCESS != ret)) {
         return ret;
@@ -880,28 +886,21 @@ int ompi_osc_rdma_compare_and_swap (const void *origin_addr, const void *compare
 }
 
 
-static inline
-int ompi_osc_rdma_rget_accumulate_internal (ompi_win_t *win, const void *origin_addr, int origin_count,
-                                            ompi_datatype_t *origin_datatype, void *result_addr, int result_count,
-                                            ompi_datatype_t *result_datatype,  int target_rank, MPI_Aint target_disp,
-                                            int target_count, ompi_datatype_t *target_datatype, ompi_op_t *op,
-                                            ompi_request_t **request_out)
+static int ompi_osc_rdma_rget_accumulate_sync (ompi_osc_rdma_sync_t *sync, ompi_osc_rdma_peer_t *peer,
+                                               const void *origin_addr, int origin_count,
+                                               ompi_datatype_t *origin_datatype, void *result_addr, int result_count,
+                                               ompi_datatype_t *result_datatype, MPI_Aint target_disp,
+                                               int target_count, ompi_datatype_t *target_datatype, ompi_op_t *op,
+                                               ompi_request_t **request_out)
 {
-    ompi_osc_rdma_module_t *module = GET_MODULE(win);
+    ompi_osc_rdma_module_t *module = sync->module;
     mca_btl_base_registration_handle_t *target_handle;
     uint64_t target_address;
     ptrdiff_t target_lb, target_span;
     ompi_osc_rdma_request_t *rdma_request = NULL;
     bool lock_acquired = false;
-    ompi_osc_rdma_sync_t *sync;
-    ompi_osc_rdma_peer_t *peer;
     int ret;
 
-    sync = ompi_osc_rdma_module_sync_lookup (module, target_rank, &peer);
-    if (OPAL_UNLIKELY(NULL == sync)) {
-        return OMPI_ERR_RMA_SYNC;
-    }
-
     if (request_out) {
         OMPI_OSC_RDMA_REQUEST_ALLOC(module, peer, rdma_request);
         *request_out = &rdma_request->super;
@@ -966,6 +965,154 @@ int ompi_osc_rdma_rget_accumulate_internal (ompi_win_t *win, const void *origin_
     return ret;
 }
 
+static inline
+int ompi_osc_rdma_rget_accumulate_internal (ompi_win_t *win, const void *origin_addr, int origin_count,
+                                            ompi_datatype_t *origin_datatype, void *result_addr, int result_count,
+                                            ompi_datatype_t *result_datatype,  int target_rank, MPI_Aint target_disp,
+                                            int target_count, ompi_datatype_t *target_datatype, ompi_op_t *op,
+                                            ompi_request_t **request_out)
+{
+    ompi_osc_rdma_module_t *module = GET_MODULE(win);
+    ompi_osc_rdma_sync_t *sync;
+    ompi_osc_rdma_peer_t *peer;
+    int ret;
+
+    sync = ompi_osc_rdma_module_sync_lookup (module, target_rank, &peer);
+    if (OPAL_UNLIKELY(NULL == sync)) {
+        return OMPI_ERR_RMA_SYNC;
+    }
+
+    /* accumulates to the same target are ordered */
+    ret = ompi_osc_rdma_acc_coalesce_flush (peer);
+    if (OPAL_UNLIKELY(OMPI_SUCCESS != ret)) {
+        return ret;
+    }
+
+    return ompi_osc_rdma_rget_accumulate_sync (sync, peer, origin_addr, origin_count, origin_datatype,
+                                               result_addr, result_count, result_datatype, target_disp,
+                                               target_count, target_datatype, op, request_out);
+}
+
+/*
+ * Accumulates buffered with ompi_osc_rdma_acc_coalesce() are applied as
+ * one accumulate. The operation is not waited for: if it is still in
+ * flight the buffer is handed over to it and freed on its completion,
+ * the next accumulates are buffered in a new one. Completion is ensured
+ * by the synchronization like for any other accumulate.
+ */
+int ompi_osc_rdma_acc_coalesce_flush (ompi_osc_rdma_peer_t *peer)
+{
+    ompi_osc_rdma_coalesce_t *coalesce = peer->coalesce;
+    ompi_osc_rdma_request_t *rdma_request;
+    ompi_request_t *request;
+    int ret, count;
+
+    if (NULL == coalesce || 0 == coalesce->acc_count) {
+        return OMPI_SUCCESS;
+    }
+
+    count = coalesce->acc_count;
+    coalesce->acc_count = 0;
+
+    ret = ompi_osc_rdma_rget_accumulate_sync (coalesce->sync, peer, coalesce->acc_buffer, count, coalesce->acc_dt,
+                                              NULL, 0, NULL, coalesce->acc_disp, count, coalesce->acc_dt,
+                                              coalesce->acc_op, &request);
+    if (OPAL_UNLIKELY(OMPI_SUCCESS != ret)) {
+        return ret;
+    }
+
+    if (REQUEST_COMPLETE(request)) {
+        return ompi_request_free (&request);
+    }
+
+    /* coalescing is only done without threads, the request cannot
+       complete before it is updated here */
+    rdma_request = (ompi_osc_rdma_request_t *) request;
+    rdma_request->to_free = coalesce->acc_buffer;
+    rdma_request->internal = true;
+    coalesce->acc_buffer = NULL;
+
+    return OMPI_SUCCESS;
+}
+
+/*
+ * Buffer a small accumulate of a predefined datatype if it continues the
+ * accumulates buffered for the peer. Returns OMPI_ERR_NOT_AVAILABLE if
+ * the operation has to be started on its own.
+ */
+static int ompi_osc_rdma_acc_coalesce (ompi_osc_rdma_sync_t *sync, ompi_osc_rdma_peer_t *peer, const void *origin_addr,
+                                       int origin_count, ompi_datatype_t *origin_datatype, ptrdiff_t target_disp,
+                                       int target_count, ompi_datatype_t *target_datatype, ompi_op_t *op)
+{
+    ompi_osc_rdma_module_t *module = sync->module;
+    mca_btl_base_registration_handle_t *target_handle;
+    ompi_osc_rdma_coalesce_t *coalesce;
+    uint64_t target_address;
+    ptrdiff_t lb, extent;
+    size_t size;
+    int ret;
+
+    if (ompi_osc_rdma_peer_local_base (peer) || opal_using_threads () || origin_datatype != target_datatype ||
+        origin_count != target_count || !ompi_datatype_is_predefined (origin_datatype) ||
+        !ompi_op_is_intrinsic (op) || &ompi_mpi_op_no_op.op == op) {
+        return OMPI_ERR_NOT_AVAILABLE;
+    }
+
+    ompi_datatype_type_size (origin_datatype, &size);
+    ompi_datatype_get_extent (origin_datatype, &lb, &extent);
+    if ((ptrdiff_t) size != extent || 0 != lb) {
+        /* pair types like MPI_DOUBLE_INT have holes, the elements are
+           not packed in the buffer */
+        return OMPI_ERR_NOT_AVAILABLE;
+    }
+    size *= origin_count;
+    if (0 == size || size >= mca_osc_rdma_component.coalesce_size) {
+        return OMPI_ERR_NOT_AVAILABLE;
+    }
+
+    ret = osc_rdma_get_remote_segment (module, peer, target_disp, size, &target_address, &target_handle);
+    if (OPAL_UNLIKELY(OMPI_SUCCESS != ret)) {
+        return ret;
+    }
+
+    coalesce = ompi_osc_rdma_coalesce_get (module, peer, sync);
+    if (OPAL_UNLIKELY(NULL == coalesce)) {
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+
+    if (NULL == coalesce->acc_buffer) {
+        coalesce->acc_buffer = malloc (mca_osc_rdma_component.coalesce_size);
+        if (OPAL_UNLIKELY(NULL == coalesce->acc_buffer)) {
+            return OMPI_ERR_OUT_OF_RESOURCE;
+        }
+    }
+
+    if (coalesce->acc_count && (coalesce->acc_op != op || coalesce->acc_dt != origin_datatype ||
+                                coalesce->acc_handle != target_handle ||
+                                coalesce->acc_address + coalesce->acc_count * extent != target_address ||
+                                (coalesce->acc_count + origin_count) * extent > mca_osc_rdma_component.coalesce_size)) {
+        ret = ompi_osc_rdma_acc_coalesce_flush (peer);
+        if (OPAL_UNLIKELY(OMPI_SUCCESS != ret)) {
+            return ret;
+        }
+    }
+
+    if (0 == coalesce->acc_count) {
+        coalesce->acc_op = op;
+        coalesce->acc_dt = origin_datatype;
+        coalesce->acc_disp = target_disp;
+        coalesce->acc_address = target_address;
+        coalesce->acc_handle = target_handle;
+    } else {
+        ++module->coalesced_count;
+    }
+
+    memcpy (coalesce->acc_buffer + coalesce->acc_count * extent, origin_addr, size);
+    coalesce->acc_count += origin_count;
+
+    return OMPI_SUCCESS;
+}
+
 int ompi_osc_rdma_get_accumulate (const void *origin_addr, int origin_count, ompi_datatype_t *origin_datatype,
                                   void *result_addr, int result_count, ompi_datatype_t *result_datatype,
                                   int target_rank, MPI_Aint target_disp, int target_count, ompi_datatype_t *target_datatype,
@@ -1017,10 +1164,29 @@ int ompi_osc_rdma_accumulate (const void *origin_addr, int origin_count, ompi_da
                               ptrdiff_t target_disp, int target_count, ompi_datatype_t *target_datatype, ompi_op_t *op,
                               ompi_win_t *win)
 {
+    ompi_osc_rdma_module_t *module = GET_MODULE(win);
+
     OSC_RDMA_VERBOSE(MCA_BASE_VERBOSE_TRACE, "acc: 0x%lx, %d, %s, %d, 0x%lx, %d, %s, %s, %s",
                      (unsigned long) origin_addr, origin_count, origin_datatype->name, target_rank,
                      (unsigned long) target_disp, target_count, target_datatype->name, op->o_name, win->w_name);
 
+    if (module->coalesce) {
+        ompi_osc_rdma_sync_t *sync;
+        ompi_osc_rdma_peer_t *peer;
+        int ret;
+
+        sync = ompi_osc_rdma_module_sync_lookup (module, target_rank, &peer);
+        if (OPAL_UNLIKELY(NULL == sync)) {
+            return OMPI_ERR_RMA_SYNC;
+        }
+
+        ret = ompi_osc_rdma_acc_coalesce (sync, peer, origin_addr, origin_count, origin_datatype, target_disp,
+                                          target_count, target_datatype, op);
+        if (OMPI_ERR_NOT_AVAILABLE != ret) {
+            return ret;
+        }
+    }
+
     return ompi_osc_rdma_rget_accumulate_internal (win, origin_addr, origin_count, origin_datatype, NULL, 0,
                                                    NULL, target_rank, target_disp, target_count, target_datatype,
                                                    op, NULL);
@@ -41,5 +41,11 @@ int ompi_osc_rdma_rget_accumulate (const void *origin_addr, int origin_count, om
                                    int target_rank, MPI_Aint target_disp, int target_count, ompi_datatype_t *target_datatype,
                                    ompi_op_t *op, ompi_win_t *win, ompi_request_t **request);
 
+/**
+ * @brief apply the accumulates buffered for a peer
+ *
+ * @param[in] peer            peer object
+ */
+int ompi_osc_rdma_acc_coalesce_flush (ompi_osc_rdma_peer_t *peer);
 
 #endif /* OSC_RDMA_ACCUMULATE_H */
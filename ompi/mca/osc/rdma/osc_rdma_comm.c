@@ -17,6 +17,7 @@
 #include "osc_rdma_sync.h"
 #include "osc_rdma_request.h"
 #include "osc_rdma_dynamic.h"
+#include "osc_rdma_accumulate.h"
 
 #include "ompi/mca/osc/base/osc_base_obj_convert.h"
 #include "opal/align.h"
@@ -535,6 +536,176 @@ int ompi_osc_rdma_put_contig (ompi_osc_rdma_sync_t *sync, ompi_osc_rdma_peer_t *
     return ret;
 }
 
+static int ompi_osc_rdma_put_coalesce_flush (ompi_osc_rdma_peer_t *peer)
+{
+    ompi_osc_rdma_coalesce_t *coalesce = peer->coalesce;
+    ompi_osc_rdma_sync_t *sync;
+    ompi_osc_rdma_frag_t *frag;
+    mca_btl_base_rdma_completion_fn_t cbfunc;
+    void *cbcontext;
+    size_t len;
+    int ret;
+
+    if (NULL == coalesce || 0 == coalesce->put_len) {
+        return OMPI_SUCCESS;
+    }
+
+    sync = coalesce->sync;
+    frag = coalesce->put_frag;
+    len = coalesce->put_len;
+    coalesce->put_frag = NULL;
+    coalesce->put_len = 0;
+
+    /* the fragment is returned by the completion callback, see ompi_osc_rdma_put_contig() */
+    if (ompi_osc_rdma_use_btl_flush (sync->module)) {
+        cbcontext = (void *) sync->module;
+        cbfunc = ompi_osc_rdma_put_complete_flush;
+    } else {
+        cbcontext = (void *) sync;
+        cbfunc = ompi_osc_rdma_put_complete;
+    }
+
+    ret = ompi_osc_rdma_put_real (sync, peer, coalesce->put_address, coalesce->put_handle, coalesce->put_buffer,
+                                  frag->handle, len, cbfunc, cbcontext, frag);
+    if (OPAL_UNLIKELY(OMPI_SUCCESS != ret)) {
+        ompi_osc_rdma_cleanup_rdma (sync, false, frag, NULL, NULL);
+    }
+
+    return ret;
+}
+
+ompi_osc_rdma_coalesce_t *ompi_osc_rdma_coalesce_get (ompi_osc_rdma_module_t *module, ompi_osc_rdma_peer_t *peer,
+                                                      ompi_osc_rdma_sync_t *sync)
+{
+    ompi_osc_rdma_coalesce_t *coalesce = peer->coalesce;
+
+    if (NULL == coalesce) {
+        coalesce = peer->coalesce = (ompi_osc_rdma_coalesce_t *) calloc (1, sizeof (*coalesce));
+        if (OPAL_UNLIKELY(NULL == coalesce)) {
+            return NULL;
+        }
+    }
+
+    if (coalesce->sync != sync) {
+        /* operations buffered under another synchronization object go first */
+        if (OMPI_SUCCESS != ompi_osc_rdma_put_coalesce_flush (peer) ||
+            OMPI_SUCCESS != ompi_osc_rdma_acc_coalesce_flush (peer)) {
+            return NULL;
+        }
+        coalesce->sync = sync;
+    }
+
+    if (!coalesce->listed) {
+        if (module->coalesce_peer_count == module->coalesce_peer_size) {
+            int size = module->coalesce_peer_size ? 2 * module->coalesce_peer_size : 16;
+            ompi_osc_rdma_peer_t **tmp;
+
+            tmp = (ompi_osc_rdma_peer_t **) realloc (module->coalesce_peers, size * sizeof (tmp[0]));
+            if (OPAL_UNLIKELY(NULL == tmp)) {
+                return NULL;
+            }
+            module->coalesce_peers = tmp;
+            module->coalesce_peer_size = size;
+        }
+        module->coalesce_peers[module->coalesce_peer_count++] = peer;
+        coalesce->listed = true;
+    }
+
+    return coalesce;
+}
+
+int ompi_osc_rdma_coalesce_flush_all (ompi_osc_rdma_module_t *module)
+{
+    int count = module->coalesce_peer_count, ret = OMPI_SUCCESS, rc;
+
+    module->coalesce_peer_count = 0;
+
+    for (int i = 0 ; i < count ; ++i) {
+        ompi_osc_rdma_peer_t *peer = module->coalesce_peers[i];
+
+        peer->coalesce->listed = false;
+        rc = ompi_osc_rdma_put_coalesce_flush (peer);
+        if (OMPI_SUCCESS == rc) {
+            rc = ompi_osc_rdma_acc_coalesce_flush (peer);
+        }
+        if (OPAL_UNLIKELY(OMPI_SUCCESS != rc)) {
+            ret = rc;
+        }
+    }
+
+    return ret;
+}
+
+/*
+ * Buffer a small contiguous put if it continues the data buffered for
+ * the peer. Returns OMPI_ERR_NOT_AVAILABLE if the operation has to be
+ * started on its own.
+ */
+static int ompi_osc_rdma_put_coalesce (ompi_osc_rdma_sync_t *sync, ompi_osc_rdma_peer_t *peer, const void *origin_addr,
+                                       int origin_count, ompi_datatype_t *origin_datatype, ptrdiff_t target_disp,
+                                       int target_count, ompi_datatype_t *target_datatype)
+{
+    ompi_osc_rdma_module_t *module = sync->module;
+    mca_btl_base_module_t *btl = ompi_osc_rdma_selected_btl (module, peer->data_btl_index);
+    size_t limit = min(mca_osc_rdma_component.coalesce_size, btl->btl_put_limit);
+    mca_btl_base_registration_handle_t *target_handle;
+    ompi_osc_rdma_coalesce_t *coalesce;
+    ptrdiff_t origin_gap, target_gap;
+    uint64_t target_address;
+    size_t len;
+    int ret;
+
+    if (ompi_osc_rdma_peer_local_base (peer) || opal_using_threads () ||
+        !ompi_datatype_is_contiguous_memory_layout (origin_datatype, origin_count) ||
+        !ompi_datatype_is_contiguous_memory_layout (target_datatype, target_count)) {
+        return OMPI_ERR_NOT_AVAILABLE;
+    }
+
+    len = opal_datatype_span (&origin_datatype->super, origin_count, &origin_gap);
+    if (0 == len || len >= limit) {
+        return OMPI_ERR_NOT_AVAILABLE;
+    }
+    (void) opal_datatype_span (&target_datatype->super, target_count, &target_gap);
+
+    ret = osc_rdma_get_remote_segment (module, peer, target_disp, target_gap + len,
+                                       &target_address, &target_handle);
+    if (OPAL_UNLIKELY(OMPI_SUCCESS != ret)) {
+        return ret;
+    }
+    target_address += target_gap;
+
+    coalesce = ompi_osc_rdma_coalesce_get (module, peer, sync);
+    if (OPAL_UNLIKELY(NULL == coalesce)) {
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+
+    if (coalesce->put_len && (coalesce->put_handle != target_handle ||
+                              coalesce->put_address + coalesce->put_len != target_address ||
+                              coalesce->put_len + len > limit)) {
+        ret = ompi_osc_rdma_put_coalesce_flush (peer);
+        if (OPAL_UNLIKELY(OMPI_SUCCESS != ret)) {
+            return ret;
+        }
+    }
+
+    if (0 == coalesce->put_len) {
+        ret = ompi_osc_rdma_frag_alloc (module, limit, &coalesce->put_frag, &coalesce->put_buffer);
+        if (OPAL_UNLIKELY(OMPI_SUCCESS != ret)) {
+            /* no buffer space, put directly */
+            return OMPI_ERR_NOT_AVAILABLE;
+        }
+        coalesce->put_address = target_address;
+        coalesce->put_handle = target_handle;
+    } else {
+        ++module->coalesced_count;
+    }
+
+    memcpy (coalesce->put_buffer + coalesce->put_len, (const char *) origin_addr + origin_gap, len);
+    coalesce->put_len += len;
+
+    return OMPI_SUCCESS;
+}
+
 static void ompi_osc_rdma_get_complete (struct mca_btl_base_module_t *btl, struct mca_btl_base_endpoint_t *endpoint,
                                         void *local_address, mca_btl_base_registration_handle_t *local_handle,
                                         void *context, void *data, int status)
@@ -831,6 +1002,14 @@ int ompi_osc_rdma_put (const void *origin_addr, int origin_count, ompi_datatype_
         return OMPI_ERR_RMA_SYNC;
     }
 
+    if (module->coalesce) {
+        int ret = ompi_osc_rdma_put_coalesce (sync, peer, origin_addr, origin_count, origin_datatype,
+                                              target_disp, target_count, target_datatype);
+        if (OMPI_ERR_NOT_AVAILABLE != ret) {
+            return ret;
+        }
+    }
+
     return ompi_osc_rdma_put_w_req (sync, origin_addr, origin_count, origin_datatype, peer, target_disp,
                                     target_count, target_datatype, NULL);
 }
@@ -122,4 +122,18 @@ int ompi_osc_rdma_put_contig (ompi_osc_rdma_sync_t *sync, ompi_osc_rdma_peer_t *
                               mca_btl_base_registration_handle_t *target_handle, void *source_buffer, size_t size,
                               ompi_osc_rdma_request_t *request);
 
+/**
+ * @brief buffer state of a peer for coalesced operations
+ *
+ * @param[in] module          osc rdma module
+ * @param[in] peer            peer object
+ * @param[in] sync            sync object the operation is issued on
+ *
+ * Allocates the state on first use and adds the peer to the peers
+ * flushed by ompi_osc_rdma_coalesce_flush_all(). Operations buffered
+ * under a different sync object are started first.
+ */
+ompi_osc_rdma_coalesce_t *ompi_osc_rdma_coalesce_get (ompi_osc_rdma_module_t *module, ompi_osc_rdma_peer_t *peer,
+                                                      ompi_osc_rdma_sync_t *sync);
+
 #endif /* OMPI_OSC_RDMA_COMM_H */
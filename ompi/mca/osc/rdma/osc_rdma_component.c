@@ -205,6 +205,22 @@ static int ompi_osc_rdma_component_register (void)
                                            MCA_BASE_VAR_SCOPE_GROUP, &mca_osc_rdma_component.acc_single_intrinsic);
     free(description_str);
 
+    mca_osc_rdma_component.coalesce = false;
+    opal_asprintf(&description_str, "Combine small puts and accumulates to adjacent locations of the same target "
+             "into one transfer until the next synchronization. Info key of same name overrides this value "
+             "(default: %s)", mca_osc_rdma_component.coalesce ? "true" : "false");
+    (void) mca_base_component_var_register(&mca_osc_rdma_component.super.osc_version, "coalesce", description_str,
+                                           MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0, OPAL_INFO_LVL_5,
+                                           MCA_BASE_VAR_SCOPE_GROUP, &mca_osc_rdma_component.coalesce);
+    free(description_str);
+
+    mca_osc_rdma_component.coalesce_size = 4096;
+    (void) mca_base_component_var_register(&mca_osc_rdma_component.super.osc_version, "coalesce_size",
+                                           "Largest number of bytes combined into one transfer when coalescing "
+                                           "operations. Only smaller operations are buffered (default: 4096)",
+                                           MCA_BASE_VAR_TYPE_UNSIGNED_INT, NULL, 0, 0, OPAL_INFO_LVL_6,
+                                           MCA_BASE_VAR_SCOPE_GROUP, &mca_osc_rdma_component.coalesce_size);
+
     mca_osc_rdma_component.acc_use_amo = true;
     opal_asprintf(&description_str, "Enable the use of network atomic memory operations when using single "
              "intrinsic optimizations. If not set network compare-and-swap will be "
@@ -307,6 +323,13 @@ static int ompi_osc_rdma_component_register (void)
                                              ompi_osc_rdma_pvar_read, NULL, NULL,
                                              (void *) (intptr_t) offsetof (ompi_osc_rdma_module_t, put_retry_count));
 
+    (void) mca_base_component_pvar_register (&mca_osc_rdma_component.super.osc_version, "coalesced_count",
+                                             "Number of puts and accumulates combined with a previous operation",
+                                             OPAL_INFO_LVL_4, MCA_BASE_PVAR_CLASS_COUNTER, MCA_BASE_VAR_TYPE_UNSIGNED_LONG,
+                                             NULL, MCA_BASE_VAR_BIND_MPI_WIN, MCA_BASE_PVAR_FLAG_CONTINUOUS,
+                                             ompi_osc_rdma_pvar_read, NULL, NULL,
+                                             (void *) (intptr_t) offsetof (ompi_osc_rdma_module_t, coalesced_count));
+
     (void) mca_base_component_pvar_register (&mca_osc_rdma_component.super.osc_version, "get_retry_count",
                                              "Number of times get transaction were retried due to resource limitations",
                                              OPAL_INFO_LVL_4, MCA_BASE_PVAR_CLASS_COUNTER, MCA_BASE_VAR_TYPE_UNSIGNED_LONG,
@@ -1308,6 +1331,7 @@ static int ompi_osc_rdma_component_select (struct ompi_win_t *win, void **base,
     module->no_locks       = check_config_value_bool ("no_locks", info);
     module->locking_mode   = mca_osc_rdma_component.locking_mode;
     module->acc_single_intrinsic = check_config_value_bool ("acc_single_intrinsic", info);
+    module->coalesce = check_config_value_bool ("coalesce", info);
     module->acc_use_amo = mca_osc_rdma_component.acc_use_amo;
     module->network_amo_max_count = mca_osc_rdma_component.network_amo_max_count;
 
@@ -142,6 +142,7 @@ int ompi_osc_rdma_free(ompi_win_t *win)
 
     free (module->peer_array);
     free (module->outstanding_lock_array);
+    free (module->coalesce_peers);
     mca_mpool_base_default_module->mpool_free(mca_mpool_base_default_module,
                                               module->free_after);
     free (module->selected_btls);
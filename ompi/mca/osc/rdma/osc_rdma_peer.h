@@ -15,6 +15,45 @@
 #include "osc_rdma_types.h"
 
 struct ompi_osc_rdma_module_t;
+struct ompi_osc_rdma_sync_t;
+struct ompi_osc_rdma_frag_t;
+
+/**
+ * @brief small operations to a peer combined into one transfer
+ *
+ * Puts to adjacent target addresses are collected in a registered
+ * fragment and written with a single btl put. Accumulates with the same
+ * operation and predefined datatype to adjacent target elements are
+ * collected in acc_buffer and applied as one accumulate. Both are
+ * started when a non-adjacent operation comes in, when the buffer is
+ * full, and before any synchronization waits for outstanding rdma
+ * operations.
+ */
+struct ompi_osc_rdma_coalesce_t {
+    /** sync object the buffered operations were issued on */
+    struct ompi_osc_rdma_sync_t *sync;
+
+    /** peer is in the module's list of peers with buffered operations */
+    bool listed;
+
+    /** buffered puts: put_len bytes for target address put_address */
+    struct ompi_osc_rdma_frag_t *put_frag;
+    char *put_buffer;
+    uint64_t put_address;
+    mca_btl_base_registration_handle_t *put_handle;
+    size_t put_len;
+
+    /** buffered accumulates: acc_count elements of acc_dt to be combined
+     * with acc_op starting at displacement acc_disp */
+    char *acc_buffer;
+    ptrdiff_t acc_disp;
+    uint64_t acc_address;
+    mca_btl_base_registration_handle_t *acc_handle;
+    int acc_count;
+    struct ompi_datatype_t *acc_dt;
+    struct ompi_op_t *acc_op;
+};
+typedef struct ompi_osc_rdma_coalesce_t ompi_osc_rdma_coalesce_t;
 
 /**
  * @brief osc rdma peer object
@@ -50,6 +89,9 @@ struct ompi_osc_rdma_peer_t {
 
     /** index into BTL array */
     uint8_t state_btl_index;
+
+    /** small operations buffered for this peer (coalesce info key) */
+    struct ompi_osc_rdma_coalesce_t *coalesce;
 };
 typedef struct ompi_osc_rdma_peer_t ompi_osc_rdma_peer_t;
 
@@ -54,6 +54,8 @@ struct ompi_osc_sm_component_t {
     ompi_osc_base_component_t super;
 
     char *backing_directory;
+    /** default of the acc_single_intrinsic info key */
+    bool acc_single_intrinsic;
 };
 typedef struct ompi_osc_sm_component_t ompi_osc_sm_component_t;
 OMPI_DECLSPEC extern ompi_osc_sm_component_t mca_osc_sm_component;
@@ -72,6 +74,9 @@ struct ompi_osc_sm_module_t {
     opal_shmem_ds_t seg_ds;
     void *segment_base;
     bool noncontig;
+    /** accumulate operations only touch single elements of predefined
+        datatypes, 4 and 8 byte elements are updated with atomics */
+    bool acc_single_intrinsic;
 
     size_t *sizes;
     void **bases;
@@ -20,6 +20,125 @@
 
 #include "osc_sm.h"
 
+/*
+ * Accumulate operations on a single 4 or 8 byte element of a predefined
+ * datatype. When the application promised with acc_single_intrinsic that
+ * no accumulate operation touches anything bigger, all of them are done
+ * with processor atomics and the accumulate lock of the target is not
+ * needed. Whether an element takes this path only depends on its datatype
+ * and address, so the same element is never updated both ways.
+ */
+static inline bool
+ompi_osc_sm_use_atomics(ompi_osc_sm_module_t *module, struct ompi_datatype_t *dt,
+                        const void *remote_address)
+{
+    size_t size = dt->super.size;
+
+    return module->acc_single_intrinsic && ompi_datatype_is_predefined(dt) &&
+        (4 == size || 8 == size) && 0 == ((uintptr_t) remote_address & (size - 1));
+}
+
+/* integer sum, replace and bitwise operations map onto atomics, the
+   others are applied to a copy that is swapped in if the element did not
+   change in the meantime. no_op is a plain load of the aligned element
+   where the platform loads it in one access. */
+#define OSC_SM_ATOMIC_FUNCTIONS(bits)                                            \
+static inline void                                                               \
+ompi_osc_sm_atomic_fop_##bits(const void *origin_addr, void *result_addr,        \
+                              struct ompi_datatype_t *dt, void *remote_address,  \
+                              struct ompi_op_t *op)                              \
+{                                                                                \
+    opal_atomic_int##bits##_t *addr = (opal_atomic_int##bits##_t *) remote_address; \
+    bool is_int = !!(OMPI_DATATYPE_FLAG_DATA_INT & dt->super.flags);             \
+    int##bits##_t origin = 0, old, new_value;                                    \
+                                                                                 \
+    if (op != &ompi_mpi_op_no_op.op) {                                           \
+        memcpy(&origin, origin_addr, sizeof(origin));                            \
+    }                                                                            \
+                                                                                 \
+    if (op == &ompi_mpi_op_no_op.op && sizeof(old) <= sizeof(intptr_t)) {        \
+        old = *((volatile int##bits##_t *) remote_address);                      \
+        opal_atomic_rmb();                                                       \
+    } else if (op == &ompi_mpi_op_replace.op) {                                  \
+        old = opal_atomic_swap_##bits(addr, origin);                             \
+    } else if (is_int && op == &ompi_mpi_op_sum.op) {                            \
+        old = opal_atomic_fetch_add_##bits(addr, origin);                        \
+    } else if (is_int && op == &ompi_mpi_op_band.op) {                           \
+        old = opal_atomic_fetch_and_##bits(addr, origin);                        \
+    } else if (is_int && op == &ompi_mpi_op_bor.op) {                            \
+        old = opal_atomic_fetch_or_##bits(addr, origin);                         \
+    } else if (is_int && op == &ompi_mpi_op_bxor.op) {                           \
+        old = opal_atomic_fetch_xor_##bits(addr, origin);                        \
+    } else {                                                                     \
+        old = *((volatile int##bits##_t *) remote_address);                      \
+        do {                                                                     \
+            new_value = old;                                                     \
+            if (op != &ompi_mpi_op_no_op.op) {                                   \
+                ompi_op_reduce(op, &origin, &new_value, 1, dt);                  \
+            }                                                                    \
+        } while (!opal_atomic_compare_exchange_strong_##bits(addr, &old, new_value)); \
+    }                                                                            \
+                                                                                 \
+    if (NULL != result_addr) {                                                   \
+        memcpy(result_addr, &old, sizeof(old));                                  \
+    }                                                                            \
+}                                                                                \
+                                                                                 \
+static inline void                                                               \
+ompi_osc_sm_atomic_cswap_##bits(const void *origin_addr, const void *compare_addr, \
+                                void *result_addr, void *remote_address)         \
+{                                                                                \
+    int##bits##_t origin, old;                                                   \
+                                                                                 \
+    memcpy(&origin, origin_addr, sizeof(origin));                                \
+    memcpy(&old, compare_addr, sizeof(old));                                     \
+    (void) opal_atomic_compare_exchange_strong_##bits((opal_atomic_int##bits##_t *) remote_address, \
+                                                      &old, origin);             \
+    memcpy(result_addr, &old, sizeof(old));                                      \
+}
+
+OSC_SM_ATOMIC_FUNCTIONS(32)
+OSC_SM_ATOMIC_FUNCTIONS(64)
+
+static inline void
+ompi_osc_sm_atomic_fop(const void *origin_addr, void *result_addr, struct ompi_datatype_t *dt,
+                       void *remote_address, struct ompi_op_t *op)
+{
+    if (4 == dt->super.size) {
+        ompi_osc_sm_atomic_fop_32(origin_addr, result_addr, dt, remote_address, op);
+    } else {
+        ompi_osc_sm_atomic_fop_64(origin_addr, result_addr, dt, remote_address, op);
+    }
+}
+
+/* accumulate and get_accumulate on one target element, the origin and
+   result buffers are converted from and to the target datatype */
+static inline int
+ompi_osc_sm_atomic_acc(const void *origin_addr, int origin_count, struct ompi_datatype_t *origin_dt,
+                       void *result_addr, int result_count, struct ompi_datatype_t *result_dt,
+                       struct ompi_datatype_t *target_dt, void *remote_address, struct ompi_op_t *op)
+{
+    uint64_t origin = 0, result;
+    int ret;
+
+    if (op != &ompi_mpi_op_no_op.op) {
+        ret = ompi_datatype_sndrcv((void *) origin_addr, origin_count, origin_dt,
+                                   &origin, 1, target_dt);
+        if (OMPI_SUCCESS != ret) {
+            return ret;
+        }
+    }
+
+    ompi_osc_sm_atomic_fop(&origin, &result, target_dt, remote_address, op);
+
+    if (NULL == result_addr) {
+        return OMPI_SUCCESS;
+    }
+
+    return ompi_datatype_sndrcv(&result, 1, target_dt, result_addr, result_count, result_dt);
+}
+
+
 int
 ompi_osc_sm_rput(const void *origin_addr,
                  int origin_count,
@@ -127,6 +246,13 @@ ompi_osc_sm_raccumulate(const void *origin_addr,
 
     remote_address = ((char*) (module->bases[target])) + module->disp_units[target] * target_disp;
 
+    if (1 == target_count && ompi_osc_sm_use_atomics(module, target_dt, remote_address)) {
+        ret = ompi_osc_sm_atomic_acc(origin_addr, origin_count, origin_dt, NULL, 0, NULL,
+                                     target_dt, remote_address, op);
+        *ompi_req = &ompi_request_empty;
+        return ret;
+    }
+
     opal_atomic_lock(&module->node_states[target].accumulate_lock);
     if (op == &ompi_mpi_op_replace.op) {
         ret = ompi_datatype_sndrcv((void *)origin_addr, origin_count, origin_dt,
@@ -178,6 +304,13 @@ ompi_osc_sm_rget_accumulate(const void *origin_addr,
 
     remote_address = ((char*) (module->bases[target])) + module->disp_units[target] * target_disp;
 
+    if (1 == target_count && ompi_osc_sm_use_atomics(module, target_dt, remote_address)) {
+        ret = ompi_osc_sm_atomic_acc(origin_addr, origin_count, origin_dt, result_addr,
+                                     result_count, result_dt, target_dt, remote_address, op);
+        *ompi_req = &ompi_request_empty;
+        return ret;
+    }
+
     opal_atomic_lock(&module->node_states[target].accumulate_lock);
 
     ret = ompi_datatype_sndrcv(remote_address, target_count, target_dt,
@@ -293,6 +426,12 @@ ompi_osc_sm_accumulate(const void *origin_addr,
 
     remote_address = ((char*) (module->bases[target])) + module->disp_units[target] * target_disp;
 
+    if (1 == target_count && ompi_osc_sm_use_atomics(module, target_dt, remote_address)) {
+        ret = ompi_osc_sm_atomic_acc(origin_addr, origin_count, origin_dt, NULL, 0, NULL,
+                                     target_dt, remote_address, op);
+        return ret;
+    }
+
     opal_atomic_lock(&module->node_states[target].accumulate_lock);
     if (op == &ompi_mpi_op_replace.op) {
         ret = ompi_datatype_sndrcv((void *)origin_addr, origin_count, origin_dt,
@@ -337,6 +476,12 @@ ompi_osc_sm_get_accumulate(const void *origin_addr,
 
     remote_address = ((char*) (module->bases[target])) + module->disp_units[target] * target_disp;
 
+    if (1 == target_count && ompi_osc_sm_use_atomics(module, target_dt, remote_address)) {
+        ret = ompi_osc_sm_atomic_acc(origin_addr, origin_count, origin_dt, result_addr,
+                                     result_count, result_dt, target_dt, remote_address, op);
+        return ret;
+    }
+
     opal_atomic_lock(&module->node_states[target].accumulate_lock);
 
     ret = ompi_datatype_sndrcv(remote_address, target_count, target_dt,
@@ -381,6 +526,15 @@ ompi_osc_sm_compare_and_swap(const void *origin_addr,
 
     remote_address = ((char*) (module->bases[target])) + module->disp_units[target] * target_disp;
 
+    if (ompi_osc_sm_use_atomics(module, dt, remote_address)) {
+        if (4 == dt->super.size) {
+            ompi_osc_sm_atomic_cswap_32(origin_addr, compare_addr, result_addr, remote_address);
+        } else {
+            ompi_osc_sm_atomic_cswap_64(origin_addr, compare_addr, result_addr, remote_address);
+        }
+        return OMPI_SUCCESS;
+    }
+
     ompi_datatype_type_size(dt, &size);
 
     opal_atomic_lock(&module->node_states[target].accumulate_lock);
@@ -421,6 +575,11 @@ ompi_osc_sm_fetch_and_op(const void *origin_addr,
 
     remote_address = ((char*) (module->bases[target])) + module->disp_units[target] * target_disp;
 
+    if (ompi_osc_sm_use_atomics(module, dt, remote_address)) {
+        ompi_osc_sm_atomic_fop(origin_addr, result_addr, dt, remote_address, op);
+        return OMPI_SUCCESS;
+    }
+
     opal_atomic_lock(&module->node_states[target].accumulate_lock);
 
     /* fetch */
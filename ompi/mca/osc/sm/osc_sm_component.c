@@ -128,6 +128,15 @@ static int component_register (void)
                                             MCA_BASE_VAR_TYPE_STRING, NULL, 0, 0, OPAL_INFO_LVL_3,
                                             MCA_BASE_VAR_SCOPE_READONLY, &mca_osc_sm_component.backing_directory);
 
+    mca_osc_sm_component.acc_single_intrinsic = false;
+    (void) mca_base_component_var_register (&mca_osc_sm_component.super.osc_version, "acc_single_intrinsic",
+                                            "Enable optimizations for MPI_Fetch_and_op, MPI_Compare_and_swap, "
+                                            "MPI_Accumulate, etc for codes that will not use anything more than "
+                                            "a single predefined datatype. Info key of same name overrides this "
+                                            "value (default: false)",
+                                            MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0, OPAL_INFO_LVL_5,
+                                            MCA_BASE_VAR_SCOPE_GROUP, &mca_osc_sm_component.acc_single_intrinsic);
+
     return OPAL_SUCCESS;
 }
 
@@ -228,6 +237,17 @@ component_select(struct ompi_win_t *win, void **base, size_t size, int disp_unit
 
     module->flavor = flavor;
 
+    module->acc_single_intrinsic = mca_osc_sm_component.acc_single_intrinsic;
+    if (NULL != info) {
+        bool acc_single_intrinsic;
+        int flag;
+
+        if (OMPI_SUCCESS == opal_info_get_bool(info, "acc_single_intrinsic",
+                                               &acc_single_intrinsic, &flag) && flag) {
+            module->acc_single_intrinsic = acc_single_intrinsic;
+        }
+    }
+
     /* create the segment */
     if (1 == comm_size) {
         module->segment_base = NULL;
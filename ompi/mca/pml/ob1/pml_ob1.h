@@ -61,6 +61,12 @@ struct mca_pml_ob1_t {
     int max_rdma_per_request;
     int max_send_per_range;
     bool use_all_rdma;
+    /* number of fragments of a non-contiguous rendezvous message to pack while
+     * waiting for the ACK (0 disables packing ahead) */
+    int send_prepack_depth;
+    /* size of the first scheduled fragment of a non-contiguous message. the
+     * fragment size doubles up to the btl maximum send size (0 disables) */
+    unsigned int send_pipeline_min_frag;
 
     /* lock queue access */
     opal_mutex_t lock;
@@ -216,6 +216,25 @@ static int mca_pml_ob1_component_register(void)
 
     mca_pml_ob1_param_register_uint("unexpected_limit", 128, &mca_pml_ob1.unexpected_limit);
 
+    mca_pml_ob1.send_prepack_depth = 2;
+    (void) mca_base_component_var_register(&mca_pml_ob1_component.pmlm_version, "send_prepack_depth",
+                                           "Number of fragments of a non-contiguous rendezvous message to "
+                                           "pack while waiting for the receiver's acknowledgement. Packed "
+                                           "fragments are handed to the BTL as soon as the acknowledgement "
+                                           "arrives (0 disables, maximum: 4, default: 2)",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0, OPAL_INFO_LVL_5,
+                                           MCA_BASE_VAR_SCOPE_READONLY, &mca_pml_ob1.send_prepack_depth);
+
+    mca_pml_ob1.send_pipeline_min_frag = 0;
+    (void) mca_base_component_var_register(&mca_pml_ob1_component.pmlm_version, "send_pipeline_min_frag",
+                                           "Size of the first fragment scheduled for a non-contiguous "
+                                           "rendezvous message. The size of each following fragment doubles "
+                                           "until it reaches the BTL maximum send size so the receiver can "
+                                           "start unpacking while the sender is still packing (0 always uses "
+                                           "the BTL maximum send size, default: 0)",
+                                           MCA_BASE_VAR_TYPE_UNSIGNED_INT, NULL, 0, 0, OPAL_INFO_LVL_5,
+                                           MCA_BASE_VAR_SCOPE_READONLY, &mca_pml_ob1.send_pipeline_min_frag);
+
     mca_pml_ob1.use_all_rdma = false;
     (void) mca_base_component_var_register(&mca_pml_ob1_component.pmlm_version, "use_all_rdma",
                                            "Use all available RDMA btls for the RDMA and RDMA pipeline protocols "
@@ -27,8 +27,10 @@
 #include "pml_ob1.h"
 #include "pml_ob1_sendreq.h"
 #include "pml_ob1_recvreq.h"
+#include "pml_ob1_recvfrag.h"
 #include "ompi/peruse/peruse-internal.h"
 #include "ompi/runtime/ompi_spc.h"
+#include "opal/util/minmax.h"
 
 /**
  * Single usage request. As we allow recursive calls (as an
@@ -144,6 +146,134 @@ static inline int mca_pml_ob1_send_inline (const void *buf, size_t count,
     return (int) size;
 }
 
+/* size of the bounce buffer used when both sides of a send to self are
+ * non contiguous with different datatypes */
+#define MCA_PML_OB1_SEND_SELF_BOUNCE 4096
+
+/* copy from the send buffer into the matched receive, once whenever
+ * possible, and return the number of bytes delivered */
+static inline size_t mca_pml_ob1_send_self_copy (const void *buf, size_t count,
+                                                 ompi_datatype_t * datatype, size_t size,
+                                                 opal_convertor_t *convertor,
+                                                 mca_pml_ob1_recv_request_t *recvreq)
+{
+    opal_convertor_t *recv_convertor = &recvreq->req_recv.req_base.req_convertor;
+    size_t bytes_delivered;
+    struct iovec iov;
+    uint32_t iov_count = 1;
+    void *data_ptr;
+
+    if (datatype == recvreq->req_recv.req_base.req_datatype &&
+        count <= recvreq->req_recv.req_base.req_count && count <= (size_t) INT32_MAX) {
+        /* same layout on both sides, contiguous or not */
+        opal_datatype_copy_content_same_ddt (&datatype->super, count,
+                                             (char *) recvreq->req_recv.req_base.req_addr,
+                                             (char *) buf);
+        bytes_delivered = size;
+    } else if (!opal_convertor_need_buffers (convertor)) {
+        /* unpack straight from the send buffer */
+        opal_convertor_get_current_pointer (convertor, &data_ptr);
+        iov.iov_base = (IOVBASE_TYPE *) data_ptr;
+        iov.iov_len = bytes_delivered = size;
+        opal_convertor_unpack (recv_convertor, &iov, &iov_count, &bytes_delivered);
+    } else if (!opal_convertor_need_buffers (recv_convertor)) {
+        /* pack straight into the receive buffer */
+        opal_convertor_get_current_pointer (recv_convertor, &data_ptr);
+        iov.iov_base = (IOVBASE_TYPE *) data_ptr;
+        iov.iov_len = bytes_delivered = opal_min(size, recvreq->req_bytes_expected);
+        opal_convertor_pack (convertor, &iov, &iov_count, &bytes_delivered);
+    } else {
+        char bounce[MCA_PML_OB1_SEND_SELF_BOUNCE];
+        size_t bytes;
+
+        bytes_delivered = 0;
+        while (bytes_delivered < recvreq->req_bytes_expected) {
+            iov.iov_base = (IOVBASE_TYPE *) bounce;
+            iov.iov_len = bytes = sizeof (bounce);
+            iov_count = 1;
+            opal_convertor_pack (convertor, &iov, &iov_count, &bytes);
+            if (0 == bytes) {
+                break;
+            }
+            iov.iov_len = bytes;
+            iov_count = 1;
+            opal_convertor_unpack (recv_convertor, &iov, &iov_count, &bytes);
+            bytes_delivered += bytes;
+        }
+    }
+
+    return bytes_delivered;
+}
+
+/* deliver a message to self straight into a posted receive, without
+ * fragments and without going through the btl */
+static inline int mca_pml_ob1_send_self (const void *buf, size_t count,
+                                         ompi_datatype_t * datatype,
+                                         int tag, int16_t seqn,
+                                         ompi_communicator_t * comm)
+{
+    mca_pml_ob1_recv_request_t *recvreq;
+    mca_pml_ob1_match_hdr_t match;
+    opal_convertor_t convertor;
+    size_t size;
+
+    OBJ_CONSTRUCT(&convertor, opal_convertor_t);
+    opal_convertor_copy_and_prepare_for_send (ompi_proc_local_proc->super.proc_convertor,
+                                              (const struct opal_datatype_t *) datatype,
+                                              count, buf, 0, &convertor);
+
+    /* accelerator buffers are only handled by the btl path, the receive
+     * side is checked while matching */
+    if (OPAL_UNLIKELY(convertor.flags & CONVERTOR_CUDA)) {
+        recvreq = NULL;
+    } else {
+        recvreq = mca_pml_ob1_recv_frag_match_self (comm, tag, seqn);
+    }
+    if (NULL == recvreq) {
+        opal_convertor_cleanup (&convertor);
+        OBJ_DESTRUCT(&convertor);
+        return OMPI_ERR_NOT_AVAILABLE;
+    }
+
+    mca_pml_ob1_match_hdr_prepare (&match, MCA_PML_OB1_HDR_TYPE_MATCH, 0,
+                                   comm->c_contextid, comm->c_my_rank,
+                                   tag, seqn);
+
+    ompi_datatype_type_size (datatype, &size);
+    size *= count;
+    recvreq->req_recv.req_bytes_packed = size;
+
+    MCA_PML_OB1_RECV_REQUEST_MATCHED(recvreq, &match);
+    if (recvreq->req_bytes_expected > 0 && size > 0) {
+        MEMCHECKER(
+                   memchecker_call(&opal_memchecker_base_mem_defined,
+                                   recvreq->req_recv.req_base.req_addr,
+                                   recvreq->req_recv.req_base.req_count,
+                                   recvreq->req_recv.req_base.req_datatype);
+                   );
+
+        recvreq->req_bytes_received = mca_pml_ob1_send_self_copy (buf, count, datatype,
+                                                                  size, &convertor, recvreq);
+        SPC_USER_OR_MPI(tag, (ompi_spc_value_t)recvreq->req_bytes_received,
+                        OMPI_SPC_BYTES_RECEIVED_USER, OMPI_SPC_BYTES_RECEIVED_MPI);
+
+        MEMCHECKER(
+                   memchecker_call(&opal_memchecker_base_mem_noaccess,
+                                   recvreq->req_recv.req_base.req_addr,
+                                   recvreq->req_recv.req_base.req_count,
+                                   recvreq->req_recv.req_base.req_datatype);
+                   );
+    }
+    SPC_USER_OR_MPI(tag, (ompi_spc_value_t)size, OMPI_SPC_BYTES_SENT_USER, OMPI_SPC_BYTES_SENT_MPI);
+
+    opal_convertor_cleanup (&convertor);
+    OBJ_DESTRUCT(&convertor);
+
+    recv_request_pml_complete (recvreq);
+
+    return OMPI_SUCCESS;
+}
+
 int mca_pml_ob1_isend(const void *buf,
                       size_t count,
                       ompi_datatype_t * datatype,
@@ -173,6 +303,15 @@ int mca_pml_ob1_isend(const void *buf,
         seqn = (uint16_t) OPAL_THREAD_ADD_FETCH32(&ob1_proc->send_sequence, 1);
     }
 
+    if (OPAL_UNLIKELY(ompi_proc_local_proc == dst_proc)) {
+        /* a matched send to self is complete in any mode */
+        rc = mca_pml_ob1_send_self (buf, count, datatype, tag, seqn, comm);
+        if (OMPI_SUCCESS == rc) {
+            *request = &ompi_request_empty;
+            return OMPI_SUCCESS;
+        }
+    }
+
     if (MCA_PML_BASE_SEND_SYNCHRONOUS != sendmode) {
         rc = mca_pml_ob1_send_inline (buf, count, datatype, dst, tag, seqn, dst_proc,
                                       endpoint, comm);
@@ -277,6 +416,13 @@ int mca_pml_ob1_send(const void *buf,
         seqn = (uint16_t) OPAL_THREAD_ADD_FETCH32(&ob1_proc->send_sequence, 1);
     }
 
+    if (OPAL_UNLIKELY(ompi_proc_local_proc == dst_proc)) {
+        rc = mca_pml_ob1_send_self (buf, count, datatype, tag, seqn, comm);
+        if (OMPI_SUCCESS == rc) {
+            return OMPI_SUCCESS;
+        }
+    }
+
     /**
      * The immediate send will not have a request, so they are
      * intracable from the point of view of any debugger attached to
@@ -829,14 +829,15 @@ static inline mca_pml_ob1_recv_request_t* get_next_posted_recv(
     return (mca_pml_ob1_recv_request_t*)i;
 }
 
-static mca_pml_ob1_recv_request_t *match_incomming(const mca_pml_ob1_match_hdr_t *hdr,
-                                                   mca_pml_ob1_comm_t *comm,
-                                                   mca_pml_ob1_comm_proc_t *proc)
-{
 #if !MCA_PML_OB1_CUSTOM_MATCH
+/* find the first posted receive matching tag, without removing it from
+ * the queue returned in queue_out */
+static mca_pml_ob1_recv_request_t *find_incomming(int tag, mca_pml_ob1_comm_t *comm,
+                                                  mca_pml_ob1_comm_proc_t *proc,
+                                                  opal_list_t **queue_out)
+{
     mca_pml_ob1_recv_request_t *specific_recv, *wild_recv;
     mca_pml_sequence_t wild_recv_seq, specific_recv_seq;
-    int tag = hdr->hdr_tag;
 
     specific_recv = get_posted_recv(&proc->specific_receives);
     wild_recv = get_posted_recv(&comm->wild_receives);
@@ -865,9 +866,7 @@ static mca_pml_ob1_recv_request_t *match_incomming(const mca_pml_ob1_match_hdr_t
 
         req_tag = (*match)->req_recv.req_base.req_tag;
         if(req_tag == tag || (req_tag == OMPI_ANY_TAG && tag >= 0)) {
-            opal_list_remove_item(queue, (opal_list_item_t*)(*match));
-            PERUSE_TRACE_COMM_EVENT(PERUSE_COMM_REQ_REMOVE_FROM_POSTED_Q,
-                    &((*match)->req_recv.req_base), PERUSE_RECV);
+            *queue_out = queue;
             return *match;
         }
 
@@ -876,26 +875,19 @@ static mca_pml_ob1_recv_request_t *match_incomming(const mca_pml_ob1_match_hdr_t
     }
 
     return NULL;
-#else
-    return custom_match_prq_find_dequeue_verify(comm->prq, hdr->hdr_tag, hdr->hdr_src);
-#endif
 }
 
-#if !MCA_PML_OB1_CUSTOM_MATCH
-static mca_pml_ob1_recv_request_t *match_incomming_no_any_source (const mca_pml_ob1_match_hdr_t *hdr,
-                                                                  mca_pml_ob1_comm_t *comm,
-                                                                  mca_pml_ob1_comm_proc_t *proc)
+static mca_pml_ob1_recv_request_t *find_incomming_no_any_source (int tag,
+                                                                 mca_pml_ob1_comm_proc_t *proc,
+                                                                 opal_list_t **queue_out)
 {
     mca_pml_ob1_recv_request_t *recv_req;
-    int tag = hdr->hdr_tag;
 
     OPAL_LIST_FOREACH(recv_req, &proc->specific_receives, mca_pml_ob1_recv_request_t) {
         int req_tag = recv_req->req_recv.req_base.req_tag;
 
         if (req_tag == tag || (req_tag == OMPI_ANY_TAG && tag >= 0)) {
-            opal_list_remove_item (&proc->specific_receives, (opal_list_item_t *) recv_req);
-            PERUSE_TRACE_COMM_EVENT(PERUSE_COMM_REQ_REMOVE_FROM_POSTED_Q,
-                    &(recv_req->req_recv.req_base), PERUSE_RECV);
+            *queue_out = &proc->specific_receives;
             return recv_req;
         }
     }
@@ -904,6 +896,46 @@ static mca_pml_ob1_recv_request_t *match_incomming_no_any_source (const mca_pml_
 }
 #endif
 
+static mca_pml_ob1_recv_request_t *match_incomming(const mca_pml_ob1_match_hdr_t *hdr,
+                                                   mca_pml_ob1_comm_t *comm,
+                                                   mca_pml_ob1_comm_proc_t *proc)
+{
+#if !MCA_PML_OB1_CUSTOM_MATCH
+    mca_pml_ob1_recv_request_t *match;
+    opal_list_t *queue;
+
+    match = find_incomming(hdr->hdr_tag, comm, proc, &queue);
+    if (NULL != match) {
+        opal_list_remove_item(queue, (opal_list_item_t *) match);
+        PERUSE_TRACE_COMM_EVENT(PERUSE_COMM_REQ_REMOVE_FROM_POSTED_Q,
+                &(match->req_recv.req_base), PERUSE_RECV);
+    }
+
+    return match;
+#else
+    return custom_match_prq_find_dequeue_verify(comm->prq, hdr->hdr_tag, hdr->hdr_src);
+#endif
+}
+
+#if !MCA_PML_OB1_CUSTOM_MATCH
+static mca_pml_ob1_recv_request_t *match_incomming_no_any_source (const mca_pml_ob1_match_hdr_t *hdr,
+                                                                  mca_pml_ob1_comm_t *comm,
+                                                                  mca_pml_ob1_comm_proc_t *proc)
+{
+    mca_pml_ob1_recv_request_t *match;
+    opal_list_t *queue;
+
+    match = find_incomming_no_any_source(hdr->hdr_tag, proc, &queue);
+    if (NULL != match) {
+        opal_list_remove_item(queue, (opal_list_item_t *) match);
+        PERUSE_TRACE_COMM_EVENT(PERUSE_COMM_REQ_REMOVE_FROM_POSTED_Q,
+                &(match->req_recv.req_base), PERUSE_RECV);
+    }
+
+    return match;
+}
+#endif
+
 static mca_pml_ob1_recv_request_t *match_one (mca_btl_base_module_t *btl,
                                               const mca_pml_ob1_match_hdr_t *hdr,
                                               const mca_btl_base_segment_t *segments,
@@ -985,6 +1017,68 @@ static mca_pml_ob1_recv_request_t *match_one (mca_btl_base_module_t *btl,
     } while(true);
 }
 
+mca_pml_ob1_recv_request_t *mca_pml_ob1_recv_frag_match_self (ompi_communicator_t *comm_ptr,
+                                                                int tag, int16_t seqn)
+{
+#if MCA_PML_OB1_CUSTOM_MATCH
+    /* the custom matching queues cannot be searched without dequeuing */
+    (void) comm_ptr; (void) tag; (void) seqn;
+    return NULL;
+#else
+    mca_pml_ob1_comm_t *comm = (mca_pml_ob1_comm_t *) comm_ptr->c_pml_comm;
+    mca_pml_ob1_comm_proc_t *proc = mca_pml_ob1_peer_lookup (comm_ptr, comm_ptr->c_my_rank);
+    mca_pml_ob1_recv_request_t *match;
+    opal_list_t *queue;
+
+    OB1_MATCHING_LOCK(&comm->matching_lock);
+
+#if OPAL_ENABLE_FT_MPI
+    if (OPAL_UNLIKELY(ompi_comm_is_revoked(comm_ptr))) {
+        OB1_MATCHING_UNLOCK(&comm->matching_lock);
+        return NULL;
+    }
+#endif
+
+    if (!OMPI_COMM_CHECK_ASSERT_ALLOW_OVERTAKE(comm_ptr)) {
+        /* an earlier message from self is still waiting for its turn,
+         * this one has to queue up behind it */
+        if (((uint16_t) seqn) != ((uint16_t) proc->expected_sequence) ||
+            NULL != proc->frags_cant_match) {
+            OB1_MATCHING_UNLOCK(&comm->matching_lock);
+            return NULL;
+        }
+    }
+
+    if (!OMPI_COMM_CHECK_ASSERT_NO_ANY_SOURCE (comm_ptr)) {
+        match = find_incomming(tag, comm, proc, &queue);
+    } else {
+        match = find_incomming_no_any_source(tag, proc, &queue);
+    }
+
+    /* probes need a fragment to look at and accelerator buffers the
+     * accelerator aware protocols, leave them to the btl */
+    if (NULL == match || MCA_PML_REQUEST_RECV != match->req_recv.req_base.req_type ||
+        (match->req_recv.req_base.req_convertor.flags & CONVERTOR_CUDA)) {
+        OB1_MATCHING_UNLOCK(&comm->matching_lock);
+        return NULL;
+    }
+
+    opal_list_remove_item(queue, (opal_list_item_t *) match);
+    PERUSE_TRACE_COMM_EVENT(PERUSE_COMM_REQ_REMOVE_FROM_POSTED_Q,
+                            &(match->req_recv.req_base), PERUSE_RECV);
+    if (!OMPI_COMM_CHECK_ASSERT_ALLOW_OVERTAKE(comm_ptr)) {
+        proc->expected_sequence++;
+    }
+    match->req_recv.req_base.req_proc = proc->ompi_proc;
+    PERUSE_TRACE_COMM_EVENT(PERUSE_COMM_MSG_MATCH_POSTED_REQ,
+                            &(match->req_recv.req_base), PERUSE_RECV);
+
+    OB1_MATCHING_UNLOCK(&comm->matching_lock);
+
+    return match;
+#endif
+}
+
 /**
  * RCS/CTS receive side matching
  *
@@ -171,6 +171,19 @@ void append_frag_to_ordered_list(mca_pml_ob1_recv_frag_t** queue,
                                  uint16_t seq);
 
 extern void mca_pml_ob1_dump_cant_match(mca_pml_ob1_recv_frag_t* queue);
+
+/**
+ * Match a message the process sends to itself against the posted
+ * receives, without going through a BTL. On success the receive is
+ * removed from the posted queue and the sequence number is consumed,
+ * the caller delivers the data. NULL when nothing matches yet, when a
+ * probe or a receive into an accelerator buffer matches first, or when
+ * an earlier message to self is pending: the message then takes the
+ * usual path with the same sequence number.
+ */
+struct mca_pml_ob1_recv_request_t;
+extern struct mca_pml_ob1_recv_request_t *
+mca_pml_ob1_recv_frag_match_self(ompi_communicator_t *comm_ptr, int tag, int16_t seqn);
 END_C_DECLS
 
 #endif
@@ -29,6 +29,7 @@
 
 #include "ompi_config.h"
 #include "opal/prefetch.h"
+#include "opal/util/minmax.h"
 #include "opal/mca/mpool/mpool.h"
 #include "ompi/runtime/ompi_spc.h"
 #include "ompi/constants.h"
@@ -175,6 +176,9 @@ static void mca_pml_ob1_send_request_construct(mca_pml_ob1_send_request_t* req)
     req->req_rdma_cnt = 0;
     req->req_throttle_sends = false;
     req->rdma_frag = NULL;
+    req->req_prepacked_cnt = 0;
+    req->req_prepacked_idx = 0;
+    req->req_frag_size = 0;
     OBJ_CONSTRUCT(&req->req_send_ranges, opal_list_t);
     OBJ_CONSTRUCT(&req->req_send_range_lock, opal_mutex_t);
 }
@@ -872,6 +876,165 @@ int mca_pml_ob1_send_request_start_rdma( mca_pml_ob1_send_request_t* sendreq,
 }
 
 
+/**
+ * Maximum amount of user data that fits in a fragment on the given btl.
+ */
+static inline size_t mca_pml_ob1_send_request_max_frag_size (mca_pml_ob1_send_request_t *sendreq,
+                                                             mca_bml_base_btl_t *bml_btl, size_t size)
+{
+    if (bml_btl->btl->btl_max_send_size != 0) {
+        size_t max_send_size = bml_btl->btl->btl_max_send_size - sizeof(mca_pml_ob1_frag_hdr_t);
+        if (size > max_send_size) {
+            size = max_send_size;
+        }
+    }
+
+    /* adaptive fragment size for non-contiguous data */
+    if (0 != sendreq->req_frag_size && size > sendreq->req_frag_size) {
+        size = sendreq->req_frag_size;
+    }
+
+    return size;
+}
+
+static inline void mca_pml_ob1_send_request_grow_frag_size (mca_pml_ob1_send_request_t *sendreq,
+                                                            mca_bml_base_btl_t *bml_btl)
+{
+    if (0 != sendreq->req_frag_size) {
+        sendreq->req_frag_size <<= 1;
+        if (0 == bml_btl->btl->btl_max_send_size ||
+            sendreq->req_frag_size >= bml_btl->btl->btl_max_send_size) {
+            /* reached the btl limit. stop adjusting. */
+            sendreq->req_frag_size = 0;
+        }
+    }
+}
+
+/**
+ * Pack the fragments following the first fragment of a non-contiguous
+ * rendezvous message while the ACK is in flight. This overlaps the cost of
+ * packing with the rendezvous round trip. The fragments are handed to the
+ * btl by mca_pml_ob1_send_request_schedule_once() once the ACK arrives.
+ */
+static void mca_pml_ob1_send_request_prepack (mca_pml_ob1_send_request_t *sendreq)
+{
+    opal_convertor_t *convertor = &sendreq->req_send.req_base.req_convertor;
+    mca_bml_base_btl_t *bml_btl;
+    int depth = opal_min(mca_pml_ob1.send_prepack_depth, MCA_PML_OB1_MAX_PREPACK_DEPTH);
+    size_t offset;
+
+    /* another thread may have started scheduling (ACK already received) */
+    if (0 != sendreq->req_prepacked_cnt ||
+        !opal_list_is_empty(&sendreq->req_send_ranges)) {
+        return;
+    }
+
+    bml_btl = mca_bml_base_btl_array_get_index(&sendreq->req_endpoint->btl_send, 0);
+    if (OPAL_UNLIKELY(NULL == bml_btl)) {
+        return;
+    }
+
+    offset = convertor->bConverted;
+
+    while (sendreq->req_prepacked_cnt < depth && offset < sendreq->req_send.req_bytes_packed) {
+        mca_pml_ob1_prepacked_frag_t *frag = sendreq->req_prepacked + sendreq->req_prepacked_cnt;
+        mca_btl_base_descriptor_t *des;
+        size_t size = mca_pml_ob1_send_request_max_frag_size (sendreq, bml_btl,
+                                                              sendreq->req_send.req_bytes_packed - offset);
+
+        opal_convertor_set_position (convertor, &offset);
+        MEMCHECKER(
+            memchecker_call(&opal_memchecker_base_mem_defined,
+                            sendreq->req_send.req_base.req_addr,
+                            sendreq->req_send.req_base.req_count,
+                            sendreq->req_send.req_base.req_datatype);
+        );
+        mca_bml_base_prepare_src (bml_btl, convertor, MCA_BTL_NO_ORDER, sizeof(mca_pml_ob1_frag_hdr_t),
+                                  &size, MCA_BTL_DES_FLAGS_BTL_OWNERSHIP | MCA_BTL_DES_SEND_ALWAYS_CALLBACK |
+                                  MCA_BTL_DES_FLAGS_SIGNAL, &des);
+        MEMCHECKER(
+            memchecker_call(&opal_memchecker_base_mem_noaccess,
+                            sendreq->req_send.req_base.req_addr,
+                            sendreq->req_send.req_base.req_count,
+                            sendreq->req_send.req_base.req_datatype);
+        );
+        if (OPAL_UNLIKELY(NULL == des || 0 == size)) {
+            if (NULL != des) {
+                mca_bml_base_free (bml_btl, des);
+            }
+            /* the scheduler will pack the rest */
+            break;
+        }
+
+        frag->bml_btl = bml_btl;
+        frag->des = des;
+        frag->offset = offset;
+        frag->size = size;
+        ++sendreq->req_prepacked_cnt;
+
+        offset += size;
+        mca_pml_ob1_send_request_grow_frag_size (sendreq, bml_btl);
+    }
+}
+
+/**
+ * Send the next fragment packed ahead of the ACK. The fragment is only used
+ * if it starts at the beginning of the range and the range allows enough data
+ * on the fragment's btl. Otherwise all remaining prepacked fragments are
+ * discarded and the data is packed again by the scheduler.
+ */
+static int mca_pml_ob1_send_request_send_prepacked (mca_pml_ob1_send_request_t *sendreq,
+                                                    mca_pml_ob1_send_range_t *range)
+{
+    mca_pml_ob1_prepacked_frag_t *frag = sendreq->req_prepacked + sendreq->req_prepacked_idx;
+    mca_pml_ob1_frag_hdr_t *hdr;
+    int btl_idx, rc;
+
+    for (btl_idx = 0 ; btl_idx < range->range_btl_cnt ; ++btl_idx) {
+        if (range->range_btls[btl_idx].bml_btl == frag->bml_btl) {
+            break;
+        }
+    }
+
+    if (btl_idx == range->range_btl_cnt || frag->offset != range->range_send_offset ||
+        range->range_btls[btl_idx].length < frag->size) {
+        mca_pml_ob1_send_request_discard_prepacked (sendreq);
+        return OMPI_ERR_NOT_FOUND;
+    }
+
+    frag->des->des_cbfunc = mca_pml_ob1_frag_completion;
+    frag->des->des_cbdata = sendreq;
+
+    /* setup header */
+    hdr = (mca_pml_ob1_frag_hdr_t *) frag->des->des_segments->seg_addr.pval;
+    mca_pml_ob1_frag_hdr_prepare (hdr, 0, frag->offset, sendreq, sendreq->req_recv.lval);
+    ob1_hdr_hton(hdr, MCA_PML_OB1_HDR_TYPE_FRAG, sendreq->req_send.req_base.req_proc);
+
+#if OMPI_WANT_PERUSE
+    PERUSE_TRACE_COMM_OMPI_EVENT(PERUSE_COMM_REQ_XFER_CONTINUE,
+                                 &(sendreq->req_send.req_base), frag->size, PERUSE_SEND);
+#endif  /* OMPI_WANT_PERUSE */
+
+    /* initiate send - note that this may complete before the call returns */
+    rc = mca_bml_base_send (frag->bml_btl, frag->des, MCA_PML_OB1_HDR_TYPE_FRAG);
+    if (OPAL_UNLIKELY(rc < 0)) {
+        mca_pml_ob1_send_request_discard_prepacked (sendreq);
+        return rc;
+    }
+
+    range->range_btls[btl_idx].length -= frag->size;
+    range->range_send_length -= frag->size;
+    range->range_send_offset += frag->size;
+    OPAL_THREAD_ADD_FETCH32(&sendreq->req_pipeline_depth, 1);
+
+    frag->des = NULL;
+    if (++sendreq->req_prepacked_idx == sendreq->req_prepacked_cnt) {
+        sendreq->req_prepacked_cnt = sendreq->req_prepacked_idx = 0;
+    }
+
+    return OMPI_SUCCESS;
+}
+
 /**
  *  Rendezvous is required. Not doing rdma so eager send up to
  *  the btls eager limit.
@@ -885,6 +1048,7 @@ int mca_pml_ob1_send_request_start_rndv( mca_pml_ob1_send_request_t* sendreq,
     mca_btl_base_descriptor_t* des;
     mca_btl_base_segment_t* segment;
     mca_pml_ob1_hdr_t* hdr;
+    bool pipelined;
     int rc;
 
     /* prepare descriptor */
@@ -941,14 +1105,39 @@ int mca_pml_ob1_send_request_start_rndv( mca_pml_ob1_send_request_t* sendreq,
     /* wait for ack and completion */
     sendreq->req_state = 2;
 
+    /* non-contiguous data is packed into the fragments. pipeline the packing
+     * of the remaining fragments with the rendezvous handshake. */
+    pipelined = (size < sendreq->req_send.req_bytes_packed) &&
+        opal_convertor_need_buffers(&sendreq->req_send.req_base.req_convertor);
+#if OPAL_CUDA_SUPPORT
+    pipelined &= !(sendreq->req_send.req_base.req_convertor.flags & CONVERTOR_CUDA);
+#endif /* OPAL_CUDA_SUPPORT */
+    if (pipelined) {
+        sendreq->req_frag_size = mca_pml_ob1.send_pipeline_min_frag;
+        /* hold the scheduling lock across the send: once the header is
+         * handed to the btl the ACK may come in at any time, and the
+         * request cannot be scheduled or completed while we pack */
+        pipelined = (mca_pml_ob1.send_prepack_depth > 0) && lock_send_request(sendreq);
+    }
+
     /* send */
     rc = mca_bml_base_send(bml_btl, des, MCA_PML_OB1_HDR_TYPE_RNDV);
     if( OPAL_LIKELY( rc >= 0 ) ) {
         if( OPAL_LIKELY( 1 == rc ) ) {
             mca_pml_ob1_rndv_completion_request( bml_btl, sendreq, size );
         }
+
+        if (pipelined) {
+            mca_pml_ob1_send_request_prepack(sendreq);
+            /* the ACK may have arrived while packing */
+            mca_pml_ob1_send_request_schedule_exclusive(sendreq);
+        }
         return OMPI_SUCCESS;
     }
+    if (pipelined) {
+        (void) unlock_send_request(sendreq);
+    }
+    sendreq->req_frag_size = 0;
     mca_bml_base_free(bml_btl, des );
     return rc;
 }
@@ -1060,6 +1249,16 @@ mca_pml_ob1_send_request_schedule_once(mca_pml_ob1_send_request_t* sendreq)
 
         assert(range->range_send_length != 0);
 
+        /* fragments packed while waiting for the ACK go out first */
+        if (sendreq->req_prepacked_idx < sendreq->req_prepacked_cnt &&
+            OMPI_SUCCESS == mca_pml_ob1_send_request_send_prepacked(sendreq, range)) {
+            if(range->range_send_length == 0) {
+                range = get_next_send_range(sendreq, range);
+                prev_bytes_remaining = 0;
+            }
+            continue;
+        }
+
         if(prev_bytes_remaining == range->range_send_length)
             num_fail++;
         else
@@ -1108,6 +1307,10 @@ cannot_pack:
             }
         }
 
+        if (0 != sendreq->req_frag_size && size > sendreq->req_frag_size) {
+            size = sendreq->req_frag_size;
+        }
+
         /* pack into a descriptor */
         offset = (size_t)range->range_send_offset;
         opal_convertor_set_position(&sendreq->req_send.req_base.req_convertor,
@@ -1193,6 +1396,7 @@ cannot_pack:
             range->range_send_length -= size;
             range->range_send_offset += size;
             OPAL_THREAD_ADD_FETCH32(&sendreq->req_pipeline_depth, 1);
+            mca_pml_ob1_send_request_grow_frag_size(sendreq, bml_btl);
             if(range->range_send_length == 0) {
                 range = get_next_send_range(sendreq, range);
                 prev_bytes_remaining = 0;
@@ -43,6 +43,22 @@ typedef enum {
     MCA_PML_OB1_SEND_PENDING_START
 } mca_pml_ob1_send_pending_t;
 
+/** maximum number of fragments packed ahead of the rendezvous ACK */
+#define MCA_PML_OB1_MAX_PREPACK_DEPTH 4
+
+/**
+ * A fragment of a non-contiguous message packed while waiting for the
+ * rendezvous ACK. The fragment header is filled in when the fragment is
+ * sent as the receive request is not known until then.
+ */
+struct mca_pml_ob1_prepacked_frag_t {
+    mca_bml_base_btl_t *bml_btl;
+    mca_btl_base_descriptor_t *des;
+    uint64_t offset;
+    size_t size;
+};
+typedef struct mca_pml_ob1_prepacked_frag_t mca_pml_ob1_prepacked_frag_t;
+
 struct mca_pml_ob1_send_request_t {
     mca_pml_base_send_request_t req_send;
     mca_bml_base_endpoint_t* req_endpoint;
@@ -57,6 +73,12 @@ struct mca_pml_ob1_send_request_t {
     opal_mutex_t req_send_range_lock;
     opal_list_t req_send_ranges;
     mca_pml_ob1_rdma_frag_t *rdma_frag;
+    /** fragments packed while waiting for the rendezvous ACK */
+    mca_pml_ob1_prepacked_frag_t req_prepacked[MCA_PML_OB1_MAX_PREPACK_DEPTH];
+    int req_prepacked_cnt;
+    int req_prepacked_idx;
+    /** size of the next scheduled fragment (0: use the btl maximum send size) */
+    size_t req_frag_size;
     /** The size of this array is set from mca_pml_ob1.max_rdma_per_request */
     mca_pml_ob1_com_btl_t req_rdma[];
 };
@@ -161,6 +183,20 @@ get_request_from_send_pending(mca_pml_ob1_send_pending_t *type)
 #define MCA_PML_OB1_SEND_REQUEST_RESET(sendreq)                         \
     MCA_PML_BASE_SEND_REQUEST_RESET(&(sendreq)->req_send)
 
+/**
+ * Return any fragments packed ahead of the rendezvous ACK that were not sent.
+ */
+static inline void mca_pml_ob1_send_request_discard_prepacked (mca_pml_ob1_send_request_t* sendreq)
+{
+    for (int i = sendreq->req_prepacked_idx ; i < sendreq->req_prepacked_cnt ; ++i) {
+        mca_pml_ob1_prepacked_frag_t *frag = sendreq->req_prepacked + i;
+        mca_bml_base_free (frag->bml_btl, frag->des);
+        frag->des = NULL;
+    }
+
+    sendreq->req_prepacked_cnt = sendreq->req_prepacked_idx = 0;
+}
+
 static inline void mca_pml_ob1_free_rdma_resources (mca_pml_ob1_send_request_t* sendreq)
 {
     size_t r;
@@ -262,6 +298,10 @@ send_request_pml_complete(mca_pml_ob1_send_request_t *sendreq)
         /* return mpool resources */
         mca_pml_ob1_free_rdma_resources(sendreq);
 
+        if (OPAL_UNLIKELY(sendreq->req_prepacked_idx < sendreq->req_prepacked_cnt)) {
+            mca_pml_ob1_send_request_discard_prepacked(sendreq);
+        }
+
         if (sendreq->req_send.req_send_mode == MCA_PML_BASE_SEND_BUFFERED &&
             sendreq->req_send.req_addr != sendreq->req_send.req_base.req_addr) {
             mca_pml_base_bsend_request_fini((ompi_request_t*)sendreq);
@@ -463,6 +503,9 @@ mca_pml_ob1_send_request_start_seq (mca_pml_ob1_send_request_t* sendreq, mca_bml
     sendreq->req_lock = 0;
     sendreq->req_pipeline_depth = 0;
     sendreq->req_bytes_delivered = 0;
+    sendreq->req_prepacked_cnt = 0;
+    sendreq->req_prepacked_idx = 0;
+    sendreq->req_frag_size = 0;
     sendreq->req_pending = MCA_PML_OB1_SEND_PENDING_NONE;
     sendreq->req_send.req_base.req_sequence = seqn;
 
@@ -76,14 +76,8 @@ int mca_sharedfp_sm_read_ordered_begin(ompio_file_t *fh,
 {
     int ret = OMPI_SUCCESS;
     OMPI_MPI_OFFSET_TYPE offset = 0;
-    long sendBuff = 0;
-    long *buff=NULL;
-    long offsetBuff;
-    OMPI_MPI_OFFSET_TYPE offsetReceived = 0;
-    long bytesRequested = 0;
-    int recvcnt = 1, sendcnt = 1;
+    OMPI_MPI_OFFSET_TYPE bytesRequested = 0;
     size_t numofBytes;
-    int i;
 
     if ( NULL == fh->f_sharedfp_data){
         opal_output(ompi_sharedfp_base_framework.framework_output,
@@ -99,78 +93,12 @@ int mca_sharedfp_sm_read_ordered_begin(ompio_file_t *fh,
 
     /* Calculate the number of bytes to read*/
     opal_datatype_type_size ( &datatype->super, &numofBytes);
-    sendBuff = count * numofBytes;
-
-
-    if ( 0  == fh->f_rank ) {
-        buff = (long*)malloc(sizeof(long) * fh->f_size);
-        if (  NULL == buff )
-            return OMPI_ERR_OUT_OF_RESOURCE;
-    }
-
-    ret = fh->f_comm->c_coll->coll_gather ( &sendBuff, 
-                                            sendcnt, 
-                                            OMPI_OFFSET_DATATYPE,
-                                            buff, 
-                                            recvcnt, 
-                                            OMPI_OFFSET_DATATYPE, 
-                                            0,
-                                            fh->f_comm, 
-                                            fh->f_comm->c_coll->coll_gather_module );
-    if( OMPI_SUCCESS != ret){
-	goto exit;
-    }
-
-    /* All the counts are present now in the recvBuff.
-    ** The size of recvBuff is sizeof_newComm
-    */
-    if (  0 == fh->f_rank ) {
-        for (i = 0; i < fh->f_size ; i ++) {
-	    bytesRequested += buff[i];
-	    if ( mca_sharedfp_sm_verbose ) {
-		opal_output(ompi_sharedfp_base_framework.framework_output,
-			    "mca_sharedfp_sm_read_ordered_begin: Bytes requested are %ld\n",
-			    bytesRequested);
-	    }
-        }
-
-        /* Request the offset to read bytesRequested bytes
-	** only the root process needs to do the request,
-	** since the root process will then tell the other
-	** processes at what offset they should read their
-	** share of the data.
-	*/
-        ret = mca_sharedfp_sm_request_position(fh,bytesRequested,&offsetReceived);
-        if( OMPI_SUCCESS != ret){
-	    goto exit;
-        }
-	if ( mca_sharedfp_sm_verbose ) {
-	    opal_output(ompi_sharedfp_base_framework.framework_output,
-			"mca_sharedfp_sm_read_ordered_begin: Offset received is %lld\n",offsetReceived);
-	}
-
-        buff[0] += offsetReceived;
-        for (i = 1 ; i < fh->f_size; i++)  {
-            buff[i] += buff[i-1];
-        }
-    }
+    bytesRequested = count * numofBytes;
 
-    /* Scatter the results to the other processes*/
-    ret = fh->f_comm->c_coll->coll_scatter ( buff, 
-                                             sendcnt, 
-                                             OMPI_OFFSET_DATATYPE,
-                                             &offsetBuff, 
-                                             recvcnt, 
-                                             OMPI_OFFSET_DATATYPE, 
-                                             0,
-                                             fh->f_comm, 
-                                             fh->f_comm->c_coll->coll_scatter_module );
-    if( OMPI_SUCCESS != ret){
-	goto exit;
+    ret = mca_sharedfp_sm_ordered_position (fh, bytesRequested, &offset);
+    if ( OMPI_SUCCESS != ret ) {
+        return ret;
     }
-
-    /*Each process now has its own individual offset in recvBUFF*/
-    offset = offsetBuff - sendBuff;
     offset /= fh->f_etype_size;
 
     if ( mca_sharedfp_sm_verbose ) {
@@ -183,11 +111,6 @@ int mca_sharedfp_sm_read_ordered_begin(ompio_file_t *fh,
                                              &fh->f_split_coll_req);
     fh->f_split_coll_in_use = true;
 
-exit:
-    if ( NULL != buff ) {
-	free ( buff );
-    }
-
     return ret;
 }
 
@@ -26,67 +26,104 @@
 #include "ompi/constants.h"
 #include "ompi/mca/sharedfp/sharedfp.h"
 #include "ompi/mca/sharedfp/base/base.h"
+#include "opal/sys/atomic.h"
 
-/*use a semaphore to lock the shared memory*/
-#include <semaphore.h>
-
+/*
+ * The shared file pointer lives in the memory mapped segment and is
+ * advanced with an atomic fetch-and-add, processes appending to the file
+ * at the same time do not serialize on a lock.
+ */
 int mca_sharedfp_sm_request_position(ompio_file_t *fh, 
                                      int bytes_requested,
                                      OMPI_MPI_OFFSET_TYPE *offset)
 {
-    int ret = OMPI_SUCCESS;
-    OMPI_MPI_OFFSET_TYPE position = 0;
     OMPI_MPI_OFFSET_TYPE old_offset;
     struct mca_sharedfp_sm_data * sm_data = NULL;
-    struct mca_sharedfp_sm_offset * sm_offset_ptr = NULL;
     struct mca_sharedfp_base_data_t *sh = NULL;
 
     sh = fh->f_sharedfp_data;
     sm_data = sh->selected_module_data;
 
-    *offset = 0;
+    old_offset = opal_atomic_fetch_add_64 (&sm_data->sm_offset_ptr->offset, bytes_requested);
     if ( mca_sharedfp_sm_verbose ) {
         opal_output(ompi_sharedfp_base_framework.framework_output,
-                    "Aquiring lock, rank=%d...",fh->f_rank);
+                    "old_offset=%lld, bytes_requested=%d, new offset=%lld, rank=%d\n",
+                    old_offset, bytes_requested, old_offset + bytes_requested, fh->f_rank);
     }
 
-    sm_offset_ptr = sm_data->sm_offset_ptr;
+    *offset = old_offset;
 
-    /* Aquire an exclusive lock */
+    return OMPI_SUCCESS;
+}
 
-    sem_wait(sm_data->mutex);
+int mca_sharedfp_sm_set_position (ompio_file_t *fh,
+                                  OMPI_MPI_OFFSET_TYPE offset)
+{
+    struct mca_sharedfp_sm_data * sm_data = NULL;
+    struct mca_sharedfp_base_data_t *sh = NULL;
 
-    if ( mca_sharedfp_sm_verbose ) {
-        opal_output(ompi_sharedfp_base_framework.framework_output,
-                    "Succeeded! Acquired sm lock.for rank=%d\n",fh->f_rank);
-    }
+    sh = fh->f_sharedfp_data;
+    sm_data = sh->selected_module_data;
 
-    old_offset=sm_offset_ptr->offset;
+    (void) opal_atomic_swap_64 (&sm_data->sm_offset_ptr->offset, offset);
     if ( mca_sharedfp_sm_verbose ) {
         opal_output(ompi_sharedfp_base_framework.framework_output,
-                    "Read last_offset=%lld!\n",old_offset);
+                    "sharedfp_sm_set_position: new offset=%lld, rank=%d\n",
+                    offset, fh->f_rank);
     }
 
-    position = old_offset + bytes_requested;
-    if ( mca_sharedfp_sm_verbose ) {
-        opal_output(ompi_sharedfp_base_framework.framework_output,
-                    "old_offset=%lld, bytes_requested=%d, new offset=%lld!\n",old_offset,bytes_requested,position);
-    }
-    sm_offset_ptr->offset=position;
+    return OMPI_SUCCESS;
+}
 
+/*
+ * Position for the ordered operations: an exclusive scan over the number
+ * of bytes gives every process its place in the block, the last process
+ * knows the size of the whole block, reserves it with a single
+ * fetch-and-add and broadcasts where it starts. On return offset holds
+ * the position of the calling process in bytes.
+ */
+int mca_sharedfp_sm_ordered_position (ompio_file_t *fh,
+                                      OMPI_MPI_OFFSET_TYPE bytes_requested,
+                                      OMPI_MPI_OFFSET_TYPE *offset)
+{
+    int ret;
+    int last = fh->f_size - 1;
+    OMPI_MPI_OFFSET_TYPE prefix = 0;
+    OMPI_MPI_OFFSET_TYPE base = 0;
+    struct mca_sharedfp_sm_data * sm_data = NULL;
+    struct mca_sharedfp_base_data_t *sh = NULL;
 
-    if ( mca_sharedfp_sm_verbose ) {
-        opal_output(ompi_sharedfp_base_framework.framework_output,
-                    "Releasing sm lock...rank=%d",fh->f_rank);
+    sh = fh->f_sharedfp_data;
+    sm_data = sh->selected_module_data;
+
+    ret = fh->f_comm->c_coll->coll_exscan ( &bytes_requested, &prefix, 1,
+                                            OMPI_OFFSET_DATATYPE, MPI_SUM, fh->f_comm,
+                                            fh->f_comm->c_coll->coll_exscan_module );
+    if ( OMPI_SUCCESS != ret ) {
+        return ret;
+    }
+    /* the receive buffer of the first process is undefined after an exscan */
+    if ( 0 == fh->f_rank ) {
+        prefix = 0;
     }
 
-    sem_post(sm_data->mutex);
-    if ( mca_sharedfp_sm_verbose ) {
-        opal_output(ompi_sharedfp_base_framework.framework_output,
-                    "Released lock! released lock.for rank=%d\n",fh->f_rank);
+    if ( last == fh->f_rank ) {
+        base = opal_atomic_fetch_add_64 (&sm_data->sm_offset_ptr->offset,
+                                         prefix + bytes_requested);
+        if ( mca_sharedfp_sm_verbose ) {
+            opal_output(ompi_sharedfp_base_framework.framework_output,
+                        "sharedfp_sm_ordered_position: Bytes requested are %lld, "
+                        "offset received is %lld\n", prefix + bytes_requested, base);
+        }
     }
 
-    *offset = old_offset;
+    ret = fh->f_comm->c_coll->coll_bcast ( &base, 1, OMPI_OFFSET_DATATYPE, last, fh->f_comm,
+                                           fh->f_comm->c_coll->coll_bcast_module );
+    if ( OMPI_SUCCESS != ret ) {
+        return ret;
+    }
+
+    *offset = base + prefix;
 
-    return ret;
+    return OMPI_SUCCESS;
 }
@@ -101,6 +101,18 @@ mca_topo_base_cart_map(ompi_communicator_t * comm,
                        int ndims,
                        const int *dims, const int *periods, int *newrank);
 
+/* node aware placement of the processes of a cartesian grid, see
+   topo_base_cart_reorder.c. Fills perm[new rank] = old rank. */
+OMPI_DECLSPEC int
+mca_topo_base_cart_reorder(ompi_communicator_t *comm,
+                           int ndims,
+                           const int *dims, const int *periods, int *perm);
+
+OMPI_DECLSPEC extern bool mca_topo_base_cart_reorder_enable;
+/* inter-node edges of the last reordered grid, before and after */
+OMPI_DECLSPEC extern unsigned long mca_topo_base_cart_internode_edges_before;
+OMPI_DECLSPEC extern unsigned long mca_topo_base_cart_internode_edges_after;
+
 OMPI_DECLSPEC int
 mca_topo_base_cart_rank(ompi_communicator_t *comm,
                         const int *coords,
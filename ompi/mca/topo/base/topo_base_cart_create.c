@@ -42,7 +42,8 @@
  * @param reorder ranking may be reordered (true) or not (false) (logical)
  * @param comm_cart communicator with new cartesian topology (handle)
  *
- * Open MPI currently ignores the 'reorder' flag.
+ * If 'reorder' is set the processes are placed so that grid neighbors
+ * share a node, see mca_topo_base_cart_reorder().
  *
  * @retval OMPI_SUCCESS
  */
@@ -117,15 +118,6 @@ int mca_topo_base_cart_create(mca_topo_base_module_t *topo,
             OBJ_RELEASE(cart);
             return OMPI_ERR_OUT_OF_RESOURCE;
         }
-        {  /* setup the cartesian topology */
-            int n_procs = num_procs, rank = new_rank;
-
-            for (i = 0; i < ndims; ++i) {
-                n_procs /= cart->dims[i];
-                cart->coords[i] = rank / n_procs;
-                rank %= n_procs;
-            }
-        }
     }
 
     /* JMS: This should really be refactored to use
@@ -152,6 +144,47 @@ int mca_topo_base_cart_create(mca_topo_base_module_t *topo,
         }
     }
 
+    if (reorder && num_procs > 0) {
+        /* place grid neighbors on the same node, every process computes
+           the same permutation from the node ids of the group */
+        int *perm = (int*)malloc(num_procs * sizeof(int));
+        ompi_proc_t **procs = (ompi_proc_t**)malloc(num_procs * sizeof(ompi_proc_t *));
+        if (NULL == perm || NULL == procs) {
+            free(perm);
+            free(procs);
+            free(topo_procs);
+            OBJ_RELEASE(cart);
+            return OMPI_ERR_OUT_OF_RESOURCE;
+        }
+        ret = mca_topo_base_cart_reorder(old_comm, ndims, dims, periods, perm);
+        if (OMPI_SUCCESS == ret) {
+            memcpy(procs, topo_procs, num_procs * sizeof(ompi_proc_t *));
+            for (i = 0; i < num_procs; i++) {
+                topo_procs[i] = procs[perm[i]];
+                if (perm[i] == old_comm->c_local_group->grp_my_rank) {
+                    new_rank = i;
+                }
+            }
+        }
+        free(perm);
+        free(procs);
+        if (OMPI_SUCCESS != ret) {
+            free(topo_procs);
+            OBJ_RELEASE(cart);
+            return ret;
+        }
+    }
+
+    if (ndims > 0) {  /* setup the cartesian topology */
+        int n_procs = num_procs, rank = new_rank;
+
+        for (i = 0; i < ndims; ++i) {
+            n_procs /= cart->dims[i];
+            cart->coords[i] = rank / n_procs;
+            rank %= n_procs;
+        }
+    }
+
     /* allocate a new communicator */
     new_comm = ompi_comm_allocate(num_procs, 0);
     if (NULL == new_comm) {
@@ -42,7 +42,7 @@ int mca_topo_base_cart_map(ompi_communicator_t* comm,
                            int ndims,
                            const int *dims, const int *periods, int *newrank)
 {
-    int nprocs, rank, size, i;
+    int nprocs, rank, size, i, ret, *perm;
 
     /*
      * Compute the # of processes in the grid.
@@ -66,6 +66,25 @@ int mca_topo_base_cart_map(ompi_communicator_t* comm,
      */
     rank = ompi_comm_rank(comm);
     *newrank = ((rank < 0) || (rank >= nprocs)) ? MPI_UNDEFINED : rank;
+    if (MPI_UNDEFINED == *newrank || 0 == ndims) {
+        return MPI_SUCCESS;
+    }
+
+    /* same placement as a reordered MPI_Cart_create */
+    perm = (int *) malloc(nprocs * sizeof(int));
+    if (NULL == perm) {
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+    ret = mca_topo_base_cart_reorder(comm, ndims, dims, periods, perm);
+    if (OMPI_SUCCESS == ret) {
+        for (i = 0 ; i < nprocs; ++i) {
+            if (perm[i] == rank) {
+                *newrank = i;
+                break;
+            }
+        }
+    }
+    free(perm);
 
-    return MPI_SUCCESS;
+    return ret;
 }
@@ -0,0 +1,240 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The Open MPI Project.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+
+#include <stdlib.h>
+
+#include "opal/util/output.h"
+#include "opal/mca/pmix/pmix-internal.h"
+#include "ompi/constants.h"
+#include "ompi/mca/topo/base/base.h"
+#include "ompi/communicator/communicator.h"
+#include "ompi/group/group.h"
+
+/*
+ * Node aware placement of a cartesian grid.
+ *
+ * The grid is cut into blocks of identical shape, one per node, and the
+ * processes of a node are placed in its block in the order of their
+ * ranks. The shape is chosen to minimize the number of grid edges
+ * between different nodes. Only the node ids of the processes are used,
+ * which every process knows from the modex: all processes compute the
+ * same placement without communicating. The node ids are looked up by
+ * process name, no proc structure is created for the peers.
+ */
+
+bool mca_topo_base_cart_reorder_enable = true;
+unsigned long mca_topo_base_cart_internode_edges_before = 0;
+unsigned long mca_topo_base_cart_internode_edges_after = 0;
+
+/* number of edges (r, r+1) along each dimension joining processes on
+   different nodes, node[] is indexed by the row-major grid rank */
+static unsigned long cart_internode_edges(int ndims, const int *dims, const int *periods,
+                                          int nprocs, const int *node)
+{
+    unsigned long edges = 0;
+    int i, r, stride = nprocs, c;
+
+    for (i = 0 ; i < ndims ; ++i) {
+        stride /= dims[i];
+        if (1 == dims[i]) {
+            continue;
+        }
+        for (r = 0 ; r < nprocs ; ++r) {
+            c = (r / stride) % dims[i];
+            if (c + 1 < dims[i]) {
+                edges += (node[r] != node[r + stride]);
+            } else if (periods[i]) {
+                edges += (node[r] != node[r - c * stride]);
+            }
+        }
+    }
+    return edges;
+}
+
+/* analytic count of the edges cut by blocks of the given shape */
+static unsigned long cart_block_cost(int ndims, const int *dims, const int *periods,
+                                     int nprocs, const int *shape)
+{
+    unsigned long cost = 0;
+    int i, nblocks;
+
+    for (i = 0 ; i < ndims ; ++i) {
+        nblocks = dims[i] / shape[i];
+        if (1 == nblocks) {
+            continue;
+        }
+        cost += (unsigned long) (nprocs / dims[i]) * (periods[i] ? nblocks : nblocks - 1);
+    }
+    return cost;
+}
+
+/* depth first search over the shapes with shape[i] dividing dims[i] and
+   a product of ppn */
+static void cart_block_search(int dim, int ndims, const int *dims, const int *periods,
+                              int nprocs, int remain, int *shape, int *best,
+                              unsigned long *best_cost)
+{
+    unsigned long cost;
+    int b;
+
+    if (dim == ndims) {
+        if (1 != remain) {
+            return;
+        }
+        cost = cart_block_cost(ndims, dims, periods, nprocs, shape);
+        if (cost < *best_cost) {
+            *best_cost = cost;
+            memcpy(best, shape, ndims * sizeof(int));
+        }
+        return;
+    }
+    for (b = 1 ; b <= remain && b <= dims[dim] ; ++b) {
+        if (0 != remain % b || 0 != dims[dim] % b) {
+            continue;
+        }
+        shape[dim] = b;
+        cart_block_search(dim + 1, ndims, dims, periods, nprocs, remain / b,
+                          shape, best, best_cost);
+    }
+}
+
+int mca_topo_base_cart_reorder(ompi_communicator_t *comm, int ndims,
+                               const int *dims, const int *periods, int *perm)
+{
+    int *node = NULL, *node_of = NULL, *next = NULL, *first = NULL;
+    int *shape = NULL, *best = NULL, *coords = NULL;
+    int nprocs = 1, nnodes = 0, ppn = 0, i, j, r, block, offset, stride, bstride;
+    unsigned long best_cost = (unsigned long) -1;
+    uint32_t val, *pval = &val, *ids = NULL;
+    opal_process_name_t name;
+    int rc = OMPI_SUCCESS;
+
+    for (i = 0 ; i < ndims ; ++i) {
+        nprocs *= dims[i];
+    }
+    for (r = 0 ; r < nprocs ; ++r) {
+        perm[r] = r;
+    }
+    if (!mca_topo_base_cart_reorder_enable || 0 == ndims || nprocs < 2) {
+        return OMPI_SUCCESS;
+    }
+
+    node = (int *) malloc(nprocs * sizeof(int));
+    node_of = (int *) malloc(nprocs * sizeof(int));
+    ids = (uint32_t *) malloc(nprocs * sizeof(uint32_t));
+    first = (int *) malloc(nprocs * sizeof(int));
+    next = (int *) malloc(nprocs * sizeof(int));
+    shape = (int *) malloc(3 * ndims * sizeof(int));
+    if (NULL == node || NULL == node_of || NULL == ids || NULL == first ||
+        NULL == next || NULL == shape) {
+        rc = OMPI_ERR_OUT_OF_RESOURCE;
+        goto exit;
+    }
+    best = shape + ndims;
+    coords = shape + 2 * ndims;
+
+    /* number the nodes in the order of their lowest rank, and chain the
+       ranks of each node */
+    for (r = 0 ; r < nprocs ; ++r) {
+        name = ompi_group_get_proc_name(comm->c_local_group, r);
+        OPAL_MODEX_RECV_VALUE(rc, PMIX_NODEID, &name, &pval, PMIX_UINT32);
+        if (PMIX_SUCCESS != rc) {
+            /* without the node ids the grid stays as it is */
+            rc = OMPI_SUCCESS;
+            goto exit;
+        }
+        ids[r] = val;
+        for (j = 0 ; j < nnodes && ids[first[j]] != val ; ++j);
+        if (j == nnodes) {
+            first[nnodes++] = r;
+        }
+        node_of[r] = j;
+        next[r] = -1;
+    }
+    rc = OMPI_SUCCESS;
+
+    /* all nodes have to hold the same number of processes of the grid */
+    for (j = 0 ; j < nnodes ; ++j) {
+        int last = first[j], count = 1;
+
+        for (r = first[j] + 1 ; r < nprocs ; ++r) {
+            if (node_of[r] == j) {
+                next[last] = r;
+                last = r;
+                count++;
+            }
+        }
+        if (0 == j) {
+            ppn = count;
+        } else if (count != ppn) {
+            goto exit;
+        }
+    }
+    if (1 == nnodes || 1 == ppn) {
+        goto exit;
+    }
+
+    for (r = 0 ; r < nprocs ; ++r) {
+        node[r] = node_of[r];
+    }
+    mca_topo_base_cart_internode_edges_before =
+        cart_internode_edges(ndims, dims, periods, nprocs, node);
+
+    cart_block_search(0, ndims, dims, periods, nprocs, ppn, shape, best, &best_cost);
+    if ((unsigned long) -1 == best_cost) {
+        mca_topo_base_cart_internode_edges_after = mca_topo_base_cart_internode_edges_before;
+        goto exit;
+    }
+
+    /* grid rank -> (block, offset within the block), block j goes to the
+       node numbered j, offset k to the k-th process of that node */
+    for (r = 0 ; r < nprocs ; ++r) {
+        for (i = ndims - 1, stride = r ; i >= 0 ; --i) {
+            coords[i] = stride % dims[i];
+            stride /= dims[i];
+        }
+        for (i = 0, block = 0, offset = 0 ; i < ndims ; ++i) {
+            bstride = dims[i] / best[i];
+            block = block * bstride + coords[i] / best[i];
+            offset = offset * best[i] + coords[i] % best[i];
+        }
+        for (j = first[block] ; offset > 0 ; --offset) {
+            j = next[j];
+        }
+        node[r] = block;
+        perm[r] = j;
+    }
+    mca_topo_base_cart_internode_edges_after =
+        cart_internode_edges(ndims, dims, periods, nprocs, node);
+
+    if (mca_topo_base_cart_internode_edges_after >= mca_topo_base_cart_internode_edges_before) {
+        /* the ranks are already placed at least as well */
+        mca_topo_base_cart_internode_edges_after = mca_topo_base_cart_internode_edges_before;
+        for (r = 0 ; r < nprocs ; ++r) {
+            perm[r] = r;
+        }
+    }
+
+    opal_output_verbose(10, ompi_topo_base_framework.framework_output,
+                        "cart_reorder: %d nodes with %d processes, inter-node edges %lu -> %lu",
+                        nnodes, ppn, mca_topo_base_cart_internode_edges_before,
+                        mca_topo_base_cart_internode_edges_after);
+
+ exit:
+    free(node);
+    free(node_of);
+    free(ids);
+    free(first);
+    free(next);
+    free(shape);
+    return rc;
+}
@@ -29,6 +29,7 @@
 #include "opal/util/output.h"
 #include "ompi/mca/mca.h"
 #include "opal/mca/base/base.h"
+#include "opal/mca/base/mca_base_pvar.h"
 
 
 #include "ompi/mca/topo/base/base.h"
@@ -57,6 +58,33 @@ OBJ_CLASS_INSTANCE(mca_topo_base_module_t, opal_object_t,
                    mca_topo_base_module_construct,
                    mca_topo_base_module_destruct);
 
+static int mca_topo_base_register(mca_base_register_flag_t flags)
+{
+    mca_topo_base_cart_reorder_enable = true;
+    (void) mca_base_framework_var_register(&ompi_topo_base_framework, "cart_reorder",
+                                           "Place the processes of cartesian communicators created with "
+                                           "reorder set so that grid neighbors share a node",
+                                           MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0, OPAL_INFO_LVL_5,
+                                           MCA_BASE_VAR_SCOPE_ALL_EQ, &mca_topo_base_cart_reorder_enable);
+
+    (void) mca_base_pvar_register("ompi", "topo", "base", "cart_internode_edges_before",
+                                  "Grid edges between different nodes of the last reordered "
+                                  "cartesian communicator, in the original placement",
+                                  OPAL_INFO_LVL_5, MCA_BASE_PVAR_CLASS_LEVEL,
+                                  MCA_BASE_VAR_TYPE_UNSIGNED_LONG, NULL, MCA_BASE_VAR_BIND_NO_OBJECT,
+                                  MCA_BASE_PVAR_FLAG_READONLY | MCA_BASE_PVAR_FLAG_CONTINUOUS,
+                                  NULL, NULL, NULL, &mca_topo_base_cart_internode_edges_before);
+    (void) mca_base_pvar_register("ompi", "topo", "base", "cart_internode_edges_after",
+                                  "Grid edges between different nodes of the last reordered "
+                                  "cartesian communicator, in the new placement",
+                                  OPAL_INFO_LVL_5, MCA_BASE_PVAR_CLASS_LEVEL,
+                                  MCA_BASE_VAR_TYPE_UNSIGNED_LONG, NULL, MCA_BASE_VAR_BIND_NO_OBJECT,
+                                  MCA_BASE_PVAR_FLAG_READONLY | MCA_BASE_PVAR_FLAG_CONTINUOUS,
+                                  NULL, NULL, NULL, &mca_topo_base_cart_internode_edges_after);
+
+    return OMPI_SUCCESS;
+}
+
 static int mca_topo_base_close(void)
 {
     return mca_base_framework_components_close(&ompi_topo_base_framework, NULL);
@@ -98,7 +126,7 @@ int mca_topo_base_neighbor_count (ompi_communicator_t *comm, int *indegree, int
   return OMPI_SUCCESS;
 }
 
-MCA_BASE_FRAMEWORK_DECLARE(ompi, topo, "OMPI Topo", NULL,
+MCA_BASE_FRAMEWORK_DECLARE(ompi, topo, "OMPI Topo", mca_topo_base_register,
                            mca_topo_base_open, mca_topo_base_close,
                            mca_topo_base_static_components, 0);
 
@@ -51,6 +51,9 @@ int MPI_Allgather(const void *sendbuf, int sendcount, MPI_Datatype sendtype,
 {
     int err;
 
+#if SPC_ENABLE == 1
+    opal_timer_t timer = 0;
+#endif
     SPC_RECORD(OMPI_SPC_ALLGATHER, 1);
 
     MEMCHECKER(
@@ -132,9 +135,12 @@ int MPI_Allgather(const void *sendbuf, int sendcount, MPI_Datatype sendtype,
 
     /* Invoke the coll component to perform the back-end operation */
 
+    SPC_HIST_RECORD(OMPI_SPC_HIST_COLL_SIZE, (ompi_spc_value_t)recvcount * recvtype->super.size);
+    SPC_HIST_TIMER_START(OMPI_SPC_HIST_COLL_TIME, &timer);
     err = comm->c_coll->coll_allgather(sendbuf, sendcount, sendtype,
                                       recvbuf, recvcount, recvtype, comm,
                                       comm->c_coll->coll_allgather_module);
+    SPC_HIST_TIMER_STOP(OMPI_SPC_HIST_COLL_TIME, &timer);
     OMPI_ERRHANDLER_RETURN(err, comm, err, FUNC_NAME);
 }
 
@@ -49,6 +49,9 @@ int MPI_Allreduce(const void *sendbuf, void *recvbuf, int count,
 {
     int err;
 
+#if SPC_ENABLE == 1
+    opal_timer_t timer = 0;
+#endif
     SPC_RECORD(OMPI_SPC_ALLREDUCE, 1);
 
     MEMCHECKER(
@@ -120,9 +123,12 @@ int MPI_Allreduce(const void *sendbuf, void *recvbuf, int count,
     /* Invoke the coll component to perform the back-end operation */
 
     OBJ_RETAIN(op);
+    SPC_HIST_RECORD(OMPI_SPC_HIST_COLL_SIZE, (ompi_spc_value_t)count * datatype->super.size);
+    SPC_HIST_TIMER_START(OMPI_SPC_HIST_COLL_TIME, &timer);
     err = comm->c_coll->coll_allreduce(sendbuf, recvbuf, count,
                                       datatype, op, comm,
                                       comm->c_coll->coll_allreduce_module);
+    SPC_HIST_TIMER_STOP(OMPI_SPC_HIST_COLL_TIME, &timer);
     OBJ_RELEASE(op);
     OMPI_ERRHANDLER_RETURN(err, comm, err, FUNC_NAME);
 }
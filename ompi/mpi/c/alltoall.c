@@ -53,6 +53,9 @@ int MPI_Alltoall(const void *sendbuf, int sendcount, MPI_Datatype sendtype,
     int err;
     size_t recvtype_size;
 
+#if SPC_ENABLE == 1
+    opal_timer_t timer = 0;
+#endif
     SPC_RECORD(OMPI_SPC_ALLTOALL, 1);
 
     MEMCHECKER(
@@ -117,9 +120,12 @@ int MPI_Alltoall(const void *sendbuf, int sendcount, MPI_Datatype sendtype,
     }
 
     /* Invoke the coll component to perform the back-end operation */
+    SPC_HIST_RECORD(OMPI_SPC_HIST_COLL_SIZE, (ompi_spc_value_t)recvcount * recvtype->super.size);
+    SPC_HIST_TIMER_START(OMPI_SPC_HIST_COLL_TIME, &timer);
     err = comm->c_coll->coll_alltoall(sendbuf, sendcount, sendtype,
                                      recvbuf, recvcount, recvtype,
                                      comm, comm->c_coll->coll_alltoall_module);
+    SPC_HIST_TIMER_STOP(OMPI_SPC_HIST_COLL_TIME, &timer);
     OMPI_ERRHANDLER_RETURN(err, comm, err, FUNC_NAME);
 }
 
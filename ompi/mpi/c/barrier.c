@@ -42,6 +42,10 @@ int MPI_Barrier(MPI_Comm comm)
 {
   int err = MPI_SUCCESS;
 
+#if SPC_ENABLE == 1
+  opal_timer_t timer = 0;
+#endif
+
   SPC_RECORD(OMPI_SPC_BARRIER, 1);
 
   MEMCHECKER(
@@ -71,6 +75,7 @@ int MPI_Barrier(MPI_Comm comm)
   /* Intracommunicators: Only invoke the back-end coll module barrier
      function if there's more than one process in the communicator */
 
+  SPC_HIST_TIMER_START(OMPI_SPC_HIST_COLL_TIME, &timer);
   if (OMPI_COMM_IS_INTRA(comm)) {
     if (ompi_comm_size(comm) > 1) {
       err = comm->c_coll->coll_barrier(comm, comm->c_coll->coll_barrier_module);
@@ -83,6 +88,7 @@ int MPI_Barrier(MPI_Comm comm)
   else {
       err = comm->c_coll->coll_barrier(comm, comm->c_coll->coll_barrier_module);
   }
+  SPC_HIST_TIMER_STOP(OMPI_SPC_HIST_COLL_TIME, &timer);
 
   /* All done */
 
@@ -44,6 +44,9 @@ int MPI_Bcast(void *buffer, int count, MPI_Datatype datatype,
 {
     int err;
 
+#if SPC_ENABLE == 1
+    opal_timer_t timer = 0;
+#endif
     SPC_RECORD(OMPI_SPC_BCAST, 1);
 
     MEMCHECKER(
@@ -122,7 +125,10 @@ int MPI_Bcast(void *buffer, int count, MPI_Datatype datatype,
 
     /* Invoke the coll component to perform the back-end operation */
 
+    SPC_HIST_RECORD(OMPI_SPC_HIST_COLL_SIZE, (ompi_spc_value_t)count * datatype->super.size);
+    SPC_HIST_TIMER_START(OMPI_SPC_HIST_COLL_TIME, &timer);
     err = comm->c_coll->coll_bcast(buffer, count, datatype, root, comm,
                                   comm->c_coll->coll_bcast_module);
+    SPC_HIST_TIMER_STOP(OMPI_SPC_HIST_COLL_TIME, &timer);
     OMPI_ERRHANDLER_RETURN(err, comm, err, FUNC_NAME);
 }
@@ -76,6 +76,7 @@ int MPI_Get(void *origin_addr, int origin_count,
 
     if (MPI_PROC_NULL == target_rank) return MPI_SUCCESS;
 
+    SPC_HIST_RECORD(OMPI_SPC_HIST_RMA_SIZE, (ompi_spc_value_t)origin_count * origin_datatype->super.size);
     rc = win->w_osc_module->osc_get(origin_addr, origin_count, origin_datatype,
                                     target_rank, target_disp, target_count,
                                     target_datatype, win);
@@ -86,6 +86,7 @@ int MPI_Irecv(void *buf, int count, MPI_Datatype type, int source,
     MEMCHECKER (
         memchecker_call(&opal_memchecker_base_mem_noaccess, buf, count, type);
     );
+    SPC_HIST_RECORD(OMPI_SPC_HIST_RECV_SIZE, (ompi_spc_value_t)count * type->super.size);
     rc = MCA_PML_CALL(irecv(buf,count,type,source,tag,comm,request));
     OMPI_ERRHANDLER_RETURN(rc, comm, rc, FUNC_NAME);
 }
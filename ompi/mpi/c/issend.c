@@ -91,6 +91,9 @@ int MPI_Issend(const void *buf, int count, MPI_Datatype type, int dest,
     MEMCHECKER (
         memchecker_call(&opal_memchecker_base_mem_noaccess, buf, count, type);
     );
+    SPC_HIST_RECORD(OMPI_SPC_HIST_SEND_SIZE, (ompi_spc_value_t)count * type->super.size);
+    SPC_PEER_RECORD(OMPI_SPC_PEER_MESSAGES_SENT, comm, dest, 1);
+    SPC_PEER_RECORD(OMPI_SPC_PEER_BYTES_SENT, comm, dest, (ompi_spc_value_t)count * type->super.size);
     rc = MCA_PML_CALL(isend(buf, count, type, dest, tag,
                             MCA_PML_BASE_SEND_SYNCHRONOUS, comm, request));
     OMPI_ERRHANDLER_RETURN(rc, comm, rc, FUNC_NAME);
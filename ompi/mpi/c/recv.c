@@ -45,6 +45,11 @@ int MPI_Recv(void *buf, int count, MPI_Datatype type, int source,
 {
     int rc = MPI_SUCCESS;
 
+#if SPC_ENABLE == 1
+    opal_timer_t timer = 0, peer_timer = 0;
+    ompi_status_public_t spc_status;
+#endif
+
     SPC_RECORD(OMPI_SPC_RECV, 1);
 
     MEMCHECKER(
@@ -94,6 +99,24 @@ int MPI_Recv(void *buf, int count, MPI_Datatype type, int source,
         return MPI_SUCCESS;
     }
 
+#if SPC_ENABLE == 1
+    /* the per-peer counters need the source and size of the message */
+    if (MPI_STATUS_IGNORE == status) {
+        status = &spc_status;
+    }
+#endif
+    SPC_HIST_RECORD(OMPI_SPC_HIST_RECV_SIZE, (ompi_spc_value_t)count * type->super.size);
+    SPC_HIST_TIMER_START(OMPI_SPC_HIST_RECV_TIME, &timer);
+    SPC_PEER_TIMER_START(OMPI_SPC_PEER_RECV_TIME, &peer_timer);
     rc = MCA_PML_CALL(recv(buf, count, type, source, tag, comm, status));
+    SPC_HIST_TIMER_STOP(OMPI_SPC_HIST_RECV_TIME, &timer);
+#if SPC_ENABLE == 1
+    if (MPI_SUCCESS == rc) {
+        SPC_PEER_TIMER_STOP(OMPI_SPC_PEER_RECV_TIME, comm, status->MPI_SOURCE, &peer_timer);
+        SPC_PEER_RECORD(OMPI_SPC_PEER_MESSAGES_RECEIVED, comm, status->MPI_SOURCE, 1);
+        SPC_PEER_RECORD(OMPI_SPC_PEER_BYTES_RECEIVED, comm, status->MPI_SOURCE,
+                        (ompi_spc_value_t)status->_ucount);
+    }
+#endif
     OMPI_ERRHANDLER_RETURN(rc, comm, rc, FUNC_NAME);
 }
@@ -47,6 +47,9 @@ int MPI_Ssend(const void *buf, int count, MPI_Datatype type, int dest, int tag,
 {
     int rc = MPI_SUCCESS;
 
+#if SPC_ENABLE == 1
+    opal_timer_t timer = 0;
+#endif
     SPC_RECORD(OMPI_SPC_SSEND, 1);
 
     MEMCHECKER(
@@ -91,8 +94,13 @@ int MPI_Ssend(const void *buf, int count, MPI_Datatype type, int dest, int tag,
         return MPI_SUCCESS;
     }
 
+    SPC_HIST_RECORD(OMPI_SPC_HIST_SEND_SIZE, (ompi_spc_value_t)count * type->super.size);
+    SPC_PEER_RECORD(OMPI_SPC_PEER_MESSAGES_SENT, comm, dest, 1);
+    SPC_PEER_RECORD(OMPI_SPC_PEER_BYTES_SENT, comm, dest, (ompi_spc_value_t)count * type->super.size);
+    SPC_HIST_TIMER_START(OMPI_SPC_HIST_SEND_TIME, &timer);
     rc = MCA_PML_CALL(send(buf, count, type, dest, tag,
                            MCA_PML_BASE_SEND_SYNCHRONOUS, comm));
+    SPC_HIST_TIMER_STOP(OMPI_SPC_HIST_SEND_TIME, &timer);
     OMPI_ERRHANDLER_RETURN(rc, comm, rc, FUNC_NAME);
 }
 
@@ -41,6 +41,11 @@ static const char FUNC_NAME[] = "MPI_Wait";
 
 int MPI_Wait(MPI_Request *request, MPI_Status *status)
 {
+    int rc = MPI_SUCCESS;
+#if SPC_ENABLE == 1
+    opal_timer_t timer = 0;
+#endif
+
     SPC_RECORD(OMPI_SPC_WAIT, 1);
 
     MEMCHECKER(
@@ -48,7 +53,6 @@ int MPI_Wait(MPI_Request *request, MPI_Status *status)
     );
 
     if ( MPI_PARAM_CHECK ) {
-        int rc = MPI_SUCCESS;
         OMPI_ERR_INIT_FINALIZE(FUNC_NAME);
         if (request == NULL) {
             rc = MPI_ERR_REQUEST;
@@ -69,7 +73,10 @@ int MPI_Wait(MPI_Request *request, MPI_Status *status)
         return MPI_SUCCESS;
     }
 
-    if (OMPI_SUCCESS == ompi_request_wait(request, status)) {
+    SPC_HIST_TIMER_START(OMPI_SPC_HIST_WAIT_TIME, &timer);
+    rc = ompi_request_wait(request, status);
+    SPC_HIST_TIMER_STOP(OMPI_SPC_HIST_WAIT_TIME, &timer);
+    if (OMPI_SUCCESS == rc) {
         /*
          * Per MPI-1, the MPI_ERROR field is not defined for single-completion calls
          */
@@ -43,6 +43,11 @@ static const char FUNC_NAME[] = "MPI_Waitall";
 
 int MPI_Waitall(int count, MPI_Request requests[], MPI_Status statuses[])
 {
+    int rc = MPI_SUCCESS;
+#if SPC_ENABLE == 1
+    opal_timer_t timer = 0;
+#endif
+
     SPC_RECORD(OMPI_SPC_WAITALL, 1);
 
     MEMCHECKER(
@@ -53,7 +58,7 @@ int MPI_Waitall(int count, MPI_Request requests[], MPI_Status statuses[])
     );
 
     if ( MPI_PARAM_CHECK ) {
-        int i, rc = MPI_SUCCESS;
+        int i;
         OMPI_ERR_INIT_FINALIZE(FUNC_NAME);
         if( (NULL == requests) && (0 != count) ) {
             rc = MPI_ERR_REQUEST;
@@ -75,7 +80,10 @@ int MPI_Waitall(int count, MPI_Request requests[], MPI_Status statuses[])
         return MPI_SUCCESS;
     }
 
-    if (OMPI_SUCCESS == ompi_request_wait_all(count, requests, statuses)) {
+    SPC_HIST_TIMER_START(OMPI_SPC_HIST_WAIT_TIME, &timer);
+    rc = ompi_request_wait_all(count, requests, statuses);
+    SPC_HIST_TIMER_STOP(OMPI_SPC_HIST_WAIT_TIME, &timer);
+    if (OMPI_SUCCESS == rc) {
         return MPI_SUCCESS;
     }
 
@@ -142,6 +142,20 @@ int ompi_proc_complete_init_single (ompi_proc_t *proc)
         return OMPI_SUCCESS;
     }
 
+    if (ompi_mpi_lazy_procs && OPAL_PROC_NON_LOCAL == proc->super.proc_flags) {
+        /* node-local peers were not created by ompi_proc_complete_init ()
+         * so get the locality now, before the flags are used below. the
+         * RTE only provides it for peers on this node, remote procs keep
+         * the default */
+        uint16_t u16, *u16ptr = &u16;
+        int ret;
+
+        OPAL_MODEX_RECV_VALUE_OPTIONAL(ret, PMIX_LOCALITY, &proc->super.proc_name, &u16ptr, PMIX_UINT16);
+        if (OPAL_SUCCESS == ret) {
+            proc->super.proc_flags = u16;
+        }
+    }
+
 #if OPAL_ENABLE_HETEROGENEOUS_SUPPORT
     /* get the remote architecture - this might force a modex except
      * for those environments where the RM provides it */
@@ -238,8 +252,8 @@ opal_proc_t *ompi_proc_for_name (const opal_process_name_t proc_name)
 
 int ompi_proc_init(void)
 {
-    int opal_proc_hash_init_size = (ompi_process_info.num_procs < ompi_add_procs_cutoff) ? ompi_process_info.num_procs :
-        1024;
+    int opal_proc_hash_init_size = (!ompi_mpi_lazy_procs && ompi_process_info.num_procs < ompi_add_procs_cutoff) ?
+        ompi_process_info.num_procs : 1024;
     ompi_proc_t *proc;
     int ret;
 
@@ -308,12 +322,17 @@ int ompi_proc_complete_init(void)
 
     opal_mutex_lock (&ompi_proc_lock);
 
-    /* Add all local peers first */
+    /* Add all local peers first. In lazy mode they are created on first
+     * use like all other peers (see ompi_proc_complete_init_single) */
     wildcard_rank.jobid = OMPI_PROC_MY_NAME->jobid;
     wildcard_rank.vpid = OMPI_NAME_WILDCARD->vpid;
     /* retrieve the local peers */
-    OPAL_MODEX_RECV_VALUE(ret, PMIX_LOCAL_PEERS,
-                          &wildcard_rank, &val, PMIX_STRING);
+    if (ompi_mpi_lazy_procs) {
+        ret = OPAL_ERR_NOT_FOUND;
+    } else {
+        OPAL_MODEX_RECV_VALUE(ret, PMIX_LOCAL_PEERS,
+                              &wildcard_rank, &val, PMIX_STRING);
+    }
     if (OPAL_SUCCESS == ret && NULL != val) {
         char **peers = opal_argv_split(val, ',');
         int i;
@@ -351,7 +370,7 @@ int ompi_proc_complete_init(void)
      * NOTE that local procs will be automatically skipped as they
      * are already in the hash table
      */
-    if (ompi_process_info.num_procs < ompi_add_procs_cutoff) {
+    if (!ompi_mpi_lazy_procs && ompi_process_info.num_procs < ompi_add_procs_cutoff) {
         /* sinse ompi_proc_for_name is locking internally -
          * we need to release lock here
          */
@@ -90,6 +90,7 @@
 #include "ompi/dpm/dpm.h"
 #include "ompi/mpiext/mpiext.h"
 #include "ompi/mca/hook/base/base.h"
+#include "ompi/util/timings.h"
 
 extern bool ompi_enable_timing;
 
@@ -111,6 +112,7 @@ int ompi_mpi_finalize(void)
     uint32_t key;
     ompi_datatype_t * datatype;
     pmix_status_t rc;
+    OMPI_TIMING_INIT(16);
 
     ompi_hook_base_mpi_finalize_top();
 
@@ -139,6 +141,7 @@ int ompi_mpi_finalize(void)
     opal_atomic_swap_32(&ompi_mpi_state, OMPI_MPI_STATE_FINALIZE_STARTED);
 
     ompi_mpiext_fini();
+    OMPI_TIMING_NEXT("mpiext_fini");
 
     /* Per MPI-2:4.8, we have to free MPI_COMM_SELF before doing
        anything else in MPI_FINALIZE (to include setting up such that
@@ -150,6 +153,7 @@ int ompi_mpi_finalize(void)
         OBJ_RELEASE(ompi_mpi_comm_self.comm.c_keyhash);
         ompi_mpi_comm_self.comm.c_keyhash = NULL;
     }
+    OMPI_TIMING_NEXT("comm_self-attributes");
 
 #if OPAL_ENABLE_FT_MPI
     if( ompi_ftmpi_enabled ) {
@@ -185,6 +189,7 @@ int ompi_mpi_finalize(void)
         ompi_comm_rbcast_finalize();
         opal_output_verbose(40, ompi_ftmpi_output_handle, "Rank %05d: DONE WITH FINALIZE", ompi_comm_rank(comm));
     }
+    OMPI_TIMING_NEXT("ft_drain");
 #endif /* OPAL_ENABLE_FT_MPI */
 
     /* Mark that we are past COMM_SELF destruction so that
@@ -200,6 +205,14 @@ int ompi_mpi_finalize(void)
      * of the user buffer used for bsend, before going anywhere further.
      */
     (void)mca_pml_base_bsend_detach(NULL, NULL);
+    OMPI_TIMING_NEXT("bsend_detach");
+
+    /* The timings are reduced over MPI_COMM_WORLD, so they have to be
+     * reported before the fence below which guarantees that the
+     * messages of the reduction have left. The remaining teardown
+     * cannot be reported this way. */
+    OMPI_TIMING_OUT;
+    OMPI_TIMING_FINALIZE;
 
 #if OPAL_ENABLE_PROGRESS_THREADS == 0
     opal_progress_set_event_flag(OPAL_EVLOOP_ONCE | OPAL_EVLOOP_NONBLOCK);
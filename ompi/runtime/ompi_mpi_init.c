@@ -636,6 +636,7 @@ int ompi_mpi_init(int argc, char **argv, int requested, int *provided,
         error = "mca_proc_init() failed";
         goto error;
     }
+    OMPI_TIMING_NEXT("proc_init");
 
     /* Initialize the op framework. This has to be done *after*
        ddt_init, but befor mca_coll_base_open, since some collective
@@ -655,6 +656,7 @@ int ompi_mpi_init(int argc, char **argv, int requested, int *provided,
         error = "ompi_op_init() failed";
         goto error;
     }
+    OMPI_TIMING_NEXT("op_init");
 
     /* Open up MPI-related MCA components */
 
@@ -662,40 +664,49 @@ int ompi_mpi_init(int argc, char **argv, int requested, int *provided,
         error = "mca_allocator_base_open() failed";
         goto error;
     }
+    OMPI_TIMING_NEXT("open-allocator");
     if (OMPI_SUCCESS != (ret = mca_base_framework_open(&opal_rcache_base_framework, 0))) {
         error = "mca_rcache_base_open() failed";
         goto error;
     }
+    OMPI_TIMING_NEXT("open-rcache");
     if (OMPI_SUCCESS != (ret = mca_base_framework_open(&opal_mpool_base_framework, 0))) {
         error = "mca_mpool_base_open() failed";
         goto error;
     }
+    OMPI_TIMING_NEXT("open-mpool");
     if (OMPI_SUCCESS != (ret = mca_base_framework_open(&ompi_bml_base_framework, 0))) {
         error = "mca_bml_base_open() failed";
         goto error;
     }
+    OMPI_TIMING_NEXT("open-bml");
     if (OMPI_SUCCESS != (ret = mca_bml_base_init (1, ompi_mpi_thread_multiple))) {
         error = "mca_bml_base_init() failed";
         goto error;
     }
+    OMPI_TIMING_NEXT("bml_init");
     if (OMPI_SUCCESS != (ret = mca_base_framework_open(&ompi_pml_base_framework, 0))) {
         error = "mca_pml_base_open() failed";
         goto error;
     }
+    OMPI_TIMING_NEXT("open-pml");
     if (OMPI_SUCCESS != (ret = mca_base_framework_open(&ompi_coll_base_framework, 0))) {
         error = "mca_coll_base_open() failed";
         goto error;
     }
+    OMPI_TIMING_NEXT("open-coll");
 
     if (OMPI_SUCCESS != (ret = mca_base_framework_open(&ompi_osc_base_framework, 0))) {
         error = "ompi_osc_base_open() failed";
         goto error;
     }
+    OMPI_TIMING_NEXT("open-osc");
     
     if (OMPI_SUCCESS != (ret = mca_base_framework_open(&ompi_part_base_framework, 0))) {
         error = "ompi_part_base_open() failed";
         goto error;
     }
+    OMPI_TIMING_NEXT("open-part");
 
     /* In order to reduce the common case for MPI apps (where they
        don't use MPI-2 IO or MPI-1 topology functions), the io and
@@ -711,6 +722,8 @@ int ompi_mpi_init(int argc, char **argv, int requested, int *provided,
         error = "mca_pml_base_select() failed";
         goto error;
     }
+    OMPI_TIMING_NEXT("select-pml");
+    OMPI_TIMING_IMPORT_OPAL("mca_pml_base_select");
 
     OMPI_TIMING_IMPORT_OPAL("orte_init");
     OMPI_TIMING_NEXT("rte_init-commit");
@@ -794,6 +807,7 @@ int ompi_mpi_init(int argc, char **argv, int requested, int *provided,
         error = "mca_pml_base_bsend_init() failed";
         goto error;
     }
+    OMPI_TIMING_NEXT("bsend_init");
 
     if (OMPI_SUCCESS !=
         (ret = mca_coll_base_find_available(OPAL_ENABLE_PROGRESS_THREADS,
@@ -801,6 +815,8 @@ int ompi_mpi_init(int argc, char **argv, int requested, int *provided,
         error = "mca_coll_base_find_available() failed";
         goto error;
     }
+    OMPI_TIMING_NEXT("query-coll");
+    OMPI_TIMING_IMPORT_OPAL("mca_coll_base_find_available");
 
     if (OMPI_SUCCESS !=
         (ret = ompi_osc_base_find_available(OPAL_ENABLE_PROGRESS_THREADS,
@@ -808,6 +824,7 @@ int ompi_mpi_init(int argc, char **argv, int requested, int *provided,
         error = "ompi_osc_base_find_available() failed";
         goto error;
     }
+    OMPI_TIMING_NEXT("query-osc");
 
 
     if (OMPI_SUCCESS !=
@@ -816,6 +833,7 @@ int ompi_mpi_init(int argc, char **argv, int requested, int *provided,
         error = "mca_part_base_select() failed";
         goto error;
     }
+    OMPI_TIMING_NEXT("select-part");
 
     /* io and topo components are not selected here -- see comment
        above about the io and topo frameworks being loaded lazily */
@@ -879,6 +897,7 @@ int ompi_mpi_init(int argc, char **argv, int requested, int *provided,
         error = "ompi_win_init() failed";
         goto error;
     }
+    OMPI_TIMING_NEXT("handles_init");
 
     /* identify the architectures of remote procs and setup
      * their datatype convertors, if required
@@ -887,6 +906,7 @@ int ompi_mpi_init(int argc, char **argv, int requested, int *provided,
         error = "ompi_proc_complete_init failed";
         goto error;
     }
+    OMPI_TIMING_NEXT("proc_complete_init");
 
     /* start PML/BTL's */
     ret = MCA_PML_CALL(enable(true));
@@ -894,6 +914,7 @@ int ompi_mpi_init(int argc, char **argv, int requested, int *provided,
         error = "PML control failed";
         goto error;
     }
+    OMPI_TIMING_NEXT("pml_enable");
 
     /* some btls/mtls require we call add_procs with all procs in the job.
      * since the btls/mtls have no visibility here it is up to the pml to
@@ -928,6 +949,7 @@ int ompi_mpi_init(int argc, char **argv, int requested, int *provided,
 
     MCA_PML_CALL(add_comm(&ompi_mpi_comm_world.comm));
     MCA_PML_CALL(add_comm(&ompi_mpi_comm_self.comm));
+    OMPI_TIMING_NEXT("add_procs");
 
 #if OPAL_ENABLE_FT_MPI
     /* initialize the fault tolerant infrastructure (revoke, detector,
@@ -1012,6 +1034,7 @@ int ompi_mpi_init(int argc, char **argv, int requested, int *provided,
         error = "ompi_mpi_do_preconnect_all() failed";
         goto error;
     }
+    OMPI_TIMING_NEXT("preconnect");
 
     /* Setup the dynamic process management (DPM) subsystem */
     if (OMPI_SUCCESS != (ret = ompi_dpm_init())) {
@@ -1029,6 +1052,7 @@ int ompi_mpi_init(int argc, char **argv, int requested, int *provided,
         error = "ompi_mpi_init: ompi_comm_cid_init failed";
         goto error;
     }
+    OMPI_TIMING_NEXT("dpm_init");
 
     /* Init coll for the comms. This has to be after dpm_base_select,
        (since dpm.mark_dyncomm is not set in the communicator creation
@@ -1039,12 +1063,14 @@ int ompi_mpi_init(int argc, char **argv, int requested, int *provided,
         error = "mca_coll_base_comm_select(MPI_COMM_WORLD) failed";
         goto error;
     }
+    OMPI_TIMING_NEXT("select-coll-world");
 
     if (OMPI_SUCCESS !=
         (ret = mca_coll_base_comm_select(MPI_COMM_SELF))) {
         error = "mca_coll_base_comm_select(MPI_COMM_SELF) failed";
         goto error;
     }
+    OMPI_TIMING_NEXT("select-coll-self");
 
     /* Check whether we have been spawned or not.  We introduce that
        at the very end, since we need collectives, datatypes, ptls
@@ -1053,6 +1079,7 @@ int ompi_mpi_init(int argc, char **argv, int requested, int *provided,
         error = "ompi_dpm_dyn_init() failed";
         goto error;
     }
+    OMPI_TIMING_NEXT("dpm_dyn_init");
 
     /* see if yield_when_idle was specified - if so, use it */
     opal_progress_set_yield_when_idle(ompi_mpi_yield_when_idle);
@@ -1071,6 +1098,7 @@ int ompi_mpi_init(int argc, char **argv, int requested, int *provided,
         error = "ompi_mpiext_init";
         goto error;
     }
+    OMPI_TIMING_NEXT("mpiext_init");
 
 #if OPAL_ENABLE_FT_MPI
     /* start the failure detector */
@@ -80,13 +80,17 @@ bool ompi_async_mpi_finalize = false;
 
 #define OMPI_ADD_PROCS_CUTOFF_DEFAULT 0
 uint32_t ompi_add_procs_cutoff = OMPI_ADD_PROCS_CUTOFF_DEFAULT;
+bool ompi_mpi_lazy_procs = false;
 bool ompi_mpi_dynamics_enabled = true;
 
 bool ompi_mpi_compat_mpi3 = false;
 
 char *ompi_mpi_spc_attach_string = NULL;
 bool ompi_mpi_spc_dump_enabled = false;
+char *ompi_mpi_spc_mmap_dir = NULL;
+unsigned int ompi_mpi_spc_mmap_interval = 1000;
 uint32_t ompi_pmix_connect_timeout = 0;
+int ompi_mpi_comm_cid_window = 64;
 
 static bool show_default_mca_params = false;
 static bool show_file_mca_params = false;
@@ -321,6 +325,18 @@ int ompi_mpi_register_params(void)
                                   0, 0, OPAL_INFO_LVL_3, MCA_BASE_VAR_SCOPE_LOCAL,
                                   &ompi_add_procs_cutoff);
 
+    ompi_mpi_lazy_procs = false;
+    (void) mca_base_var_register ("ompi", "mpi", NULL, "lazy_procs",
+                                  "Defer the creation of the process structures, the modex lookups and "
+                                  "the transport endpoints of all peers, including the peers on the local "
+                                  "node, until the first communication with them. Reduces MPI_Init time "
+                                  "and memory usage of very large jobs where each process only talks to "
+                                  "a few peers. Takes precedence over mpi_add_procs_cutoff but has no "
+                                  "effect if the PML requires all processes at startup",
+                                  MCA_BASE_VAR_TYPE_BOOL, NULL,
+                                  0, 0, OPAL_INFO_LVL_4, MCA_BASE_VAR_SCOPE_LOCAL,
+                                  &ompi_mpi_lazy_procs);
+
     ompi_mpi_dynamics_enabled = true;
     (void) mca_base_var_register("ompi", "mpi", NULL, "dynamics_enabled",
                                  "Is the MPI dynamic process functionality enabled (e.g., MPI_COMM_SPAWN)?  Default is yes, but certain transports and/or environments may disable it.",
@@ -381,8 +397,38 @@ int ompi_mpi_register_params(void)
                                  OPAL_INFO_LVL_4,
                                  MCA_BASE_VAR_SCOPE_READONLY,
                                  &ompi_mpi_spc_dump_enabled);
+
+    ompi_mpi_spc_mmap_dir = NULL;
+    (void) mca_base_var_register("ompi", "mpi", NULL, "spc_mmap_dir",
+                                 "If set, each process periodically publishes the values of the SPC counters "
+                                 "and histograms in a memory-mapped file named ompi_spc.<jobid>.<rank> in this "
+                                 "directory, so they can be sampled by an external tool without any MPI call. "
+                                 "Only the counters enabled through mpi_spc_attach are updated, the others stay at zero.",
+                                 MCA_BASE_VAR_TYPE_STRING, NULL, 0, 0,
+                                 OPAL_INFO_LVL_4,
+                                 MCA_BASE_VAR_SCOPE_READONLY,
+                                 &ompi_mpi_spc_mmap_dir);
+
+    ompi_mpi_spc_mmap_interval = 1000;
+    (void) mca_base_var_register("ompi", "mpi", NULL, "spc_mmap_interval",
+                                 "Interval in milliseconds between two updates of the SPC values published "
+                                 "through mpi_spc_mmap_dir (default: 1000).",
+                                 MCA_BASE_VAR_TYPE_UNSIGNED_INT, NULL, 0, 0,
+                                 OPAL_INFO_LVL_4,
+                                 MCA_BASE_VAR_SCOPE_READONLY,
+                                 &ompi_mpi_spc_mmap_interval);
 #endif // SPC_ENABLE
 
+    ompi_mpi_comm_cid_window = 64;
+    (void) mca_base_var_register("ompi", "mpi", NULL, "comm_cid_window",
+                                 "Number of consecutive context IDs examined at once when creating an "
+                                 "intra- or inter-communicator. In the common case the context ID is then agreed "
+                                 "upon with a single allreduce instead of at least two. Must be the same on all "
+                                 "processes. 0 disables the window and always uses the iterative algorithm (default: 64).",
+                                 MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                 OPAL_INFO_LVL_9, MCA_BASE_VAR_SCOPE_ALL_EQ,
+                                 &ompi_mpi_comm_cid_window);
+
     ompi_pmix_connect_timeout = 0; /* infinite timeout - see PMIx standard */
     (void) mca_base_var_register ("ompi", "mpi", NULL, "pmix_connect_timeout",
                                   "Timeout(secs) for calls to PMIx_Connect. Default is no timeout.",
@@ -23,23 +23,35 @@
 #include <stdlib.h>
 #include <string.h>
 #include <dlfcn.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/time.h>
 
 #include "ompi/runtime/ompi_spc.h"
 #include "ompi/runtime/params.h"
 
 #include "ompi/communicator/communicator.h"
 #include "ompi/datatype/ompi_datatype.h"
+#include "ompi/proc/proc.h"
 #include "opal/mca/timer/timer.h"
 #include "opal/mca/base/mca_base_pvar.h"
+#include "opal/runtime/opal_progress_threads.h"
 #include "opal/util/argv.h"
+#include "opal/util/event.h"
+#include "opal/util/printf.h"
 #include "opal/util/show_help.h"
 #include "opal/util/output.h"
+#include "opal/util/string_copy.h"
 
 #if SPC_ENABLE == 1
 
 static opal_timer_t sys_clock_freq_mhz = 0;
 
 static void ompi_spc_dump(void);
+static void ompi_spc_mmap_init(void);
+static void ompi_spc_mmap_fini(void);
 static ompi_spc_value_t ompi_spc_cycles_to_usecs_internal(opal_timer_t cycles);
 
 /* Array for converting from SPC indices to MPI_T indices */
@@ -166,7 +178,7 @@ static const ompi_spc_event_t ompi_spc_events_desc[OMPI_SPC_NUM_COUNTERS] = {
     SET_COUNTER_ARRAY(OMPI_SPC_MAX_UNEXPECTED_IN_QUEUE, "The maximum number of messages that the unexpected message queue(s) within an MPI process "
                                                     "contained at once since the last reset of this counter. Note: This counter is reset each time it is read.", true, false),
     SET_COUNTER_ARRAY(OMPI_SPC_MAX_OOS_IN_QUEUE, "The maximum number of messages that the out of sequence message queue(s) within an MPI process "
-                                             "contained at once since the last reset of this counter. Note: This counter is reset each time it is read.", true, false)
+                                             "contained at once since the last reset of this counter. Note: This counter is reset each time it is read.", true, false),
     SET_COUNTER_ARRAY(OMPI_SPC_ISENDRECV, "The number of times MPI_Isendrecv was called.", false, false),
     SET_COUNTER_ARRAY(OMPI_SPC_ISENDRECV_REPLACE, "The number of times MPI_Isendrecv_replace was called.", false, false),
 };
@@ -174,6 +186,43 @@ static const ompi_spc_event_t ompi_spc_events_desc[OMPI_SPC_NUM_COUNTERS] = {
 /* An array of event structures to store the event data (value, attachments, flags) */
 ompi_spc_t ompi_spc_events[OMPI_SPC_NUM_COUNTERS];
 
+#define SET_HIST_ARRAY(NAME, DESC, ITE)   [NAME] = { .counter_name = #NAME, .counter_description = DESC, \
+                                                     .is_high_watermark = false, .is_timer_event = ITE }
+
+static const ompi_spc_event_t ompi_spc_hists_desc[OMPI_SPC_NUM_HISTS] = {
+    SET_HIST_ARRAY(OMPI_SPC_HIST_SEND_SIZE, "Histogram of the message sizes in bytes passed to MPI_Send, MPI_Ssend, MPI_Isend and MPI_Issend.", false),
+    SET_HIST_ARRAY(OMPI_SPC_HIST_RECV_SIZE, "Histogram of the receive buffer sizes in bytes passed to MPI_Recv and MPI_Irecv.", false),
+    SET_HIST_ARRAY(OMPI_SPC_HIST_COLL_SIZE, "Histogram of the local buffer sizes in bytes passed to the blocking collectives.", false),
+    SET_HIST_ARRAY(OMPI_SPC_HIST_RMA_SIZE, "Histogram of the origin buffer sizes in bytes passed to MPI_Put and MPI_Get.", false),
+    SET_HIST_ARRAY(OMPI_SPC_HIST_SEND_TIME, "Histogram of the number of microseconds spent in MPI_Send and MPI_Ssend.", true),
+    SET_HIST_ARRAY(OMPI_SPC_HIST_RECV_TIME, "Histogram of the number of microseconds spent in MPI_Recv.", true),
+    SET_HIST_ARRAY(OMPI_SPC_HIST_WAIT_TIME, "Histogram of the number of microseconds spent in MPI_Wait and MPI_Waitall.", true),
+    SET_HIST_ARRAY(OMPI_SPC_HIST_COLL_TIME, "Histogram of the number of microseconds spent in the blocking collectives.", true),
+};
+
+static const ompi_spc_event_t ompi_spc_peers_desc[OMPI_SPC_NUM_PEERS] = {
+    SET_HIST_ARRAY(OMPI_SPC_PEER_MESSAGES_SENT, "The number of point-to-point messages sent to each MPI_COMM_WORLD rank.", false),
+    SET_HIST_ARRAY(OMPI_SPC_PEER_BYTES_SENT, "The number of point-to-point bytes sent to each MPI_COMM_WORLD rank.", false),
+    SET_HIST_ARRAY(OMPI_SPC_PEER_MESSAGES_RECEIVED, "The number of messages received with MPI_Recv from each MPI_COMM_WORLD rank.", false),
+    SET_HIST_ARRAY(OMPI_SPC_PEER_BYTES_RECEIVED, "The number of bytes received with MPI_Recv from each MPI_COMM_WORLD rank.", false),
+    SET_HIST_ARRAY(OMPI_SPC_PEER_RECV_TIME, "The number of microseconds spent in MPI_Recv waiting for a message from each MPI_COMM_WORLD rank.  "
+                                            "A rank with a large value compared to the others is a likely straggler or slow link.", true),
+};
+
+/* Histogram and per-peer data */
+ompi_spc_hist_t ompi_spc_hists[OMPI_SPC_NUM_HISTS];
+ompi_spc_peer_t ompi_spc_peers[OMPI_SPC_NUM_PEERS];
+
+/* Number of entries in each per-peer counter (size of MPI_COMM_WORLD) */
+static int ompi_spc_num_peers = 0;
+
+/* Shared-memory export of the SPC values */
+static const char *ompi_spc_mmap_thread_name = "ompi-spc";
+static ompi_spc_mmap_header_t *ompi_spc_mmap_hdr = NULL;
+static size_t ompi_spc_mmap_size = 0;
+static opal_event_base_t *ompi_spc_mmap_evbase = NULL;
+static opal_event_t ompi_spc_mmap_event;
+
 /* ##############################################################
  * ################# Begin MPI_T Functions ######################
  * ##############################################################
@@ -208,6 +257,76 @@ static int ompi_spc_notify(mca_base_pvar_t *pvar, mca_base_pvar_event_t event, v
     return MPI_SUCCESS;
 }
 
+/* Allocates the storage of a per-peer counter. Called before the counter is
+ * attached for the first time so that the recording functions never see an
+ * attached counter without storage. */
+static int ompi_spc_peer_alloc(int index)
+{
+    opal_atomic_int64_t *values, *expected = NULL;
+
+    if( NULL != ompi_spc_peers[index].values ) {
+        return OMPI_SUCCESS;
+    }
+
+    values = (opal_atomic_int64_t *) calloc(ompi_spc_num_peers, sizeof(opal_atomic_int64_t));
+    if( NULL == values ) {
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+
+    if( !opal_atomic_compare_exchange_strong_ptr((opal_atomic_intptr_t *) &ompi_spc_peers[index].values,
+                                                 (intptr_t *) &expected, (intptr_t) values) ) {
+        /* another thread won the race */
+        free(values);
+    }
+
+    return OMPI_SUCCESS;
+}
+
+static int ompi_spc_hist_notify(mca_base_pvar_t *pvar, mca_base_pvar_event_t event, void *obj_handle, int *count)
+{
+    int index;
+
+    if(OPAL_LIKELY(!mpi_t_enabled)) {
+        return MPI_SUCCESS;
+    }
+
+    index = (int)(uintptr_t)pvar->ctx;
+
+    if(MCA_BASE_PVAR_HANDLE_BIND == event) {
+        *count = OMPI_SPC_HIST_NUM_BINS;
+    } else if(MCA_BASE_PVAR_HANDLE_START == event) {
+        opal_atomic_fetch_add_32(&ompi_spc_hists[index].num_attached, 1);
+    } else if(MCA_BASE_PVAR_HANDLE_STOP == event) {
+        opal_atomic_fetch_add_32(&ompi_spc_hists[index].num_attached, -1);
+    }
+
+    return MPI_SUCCESS;
+}
+
+static int ompi_spc_peer_notify(mca_base_pvar_t *pvar, mca_base_pvar_event_t event, void *obj_handle, int *count)
+{
+    int index;
+
+    if(OPAL_LIKELY(!mpi_t_enabled)) {
+        return MPI_SUCCESS;
+    }
+
+    index = (int)(uintptr_t)pvar->ctx;
+
+    if(MCA_BASE_PVAR_HANDLE_BIND == event) {
+        *count = ompi_spc_num_peers;
+    } else if(MCA_BASE_PVAR_HANDLE_START == event) {
+        if( OMPI_SUCCESS != ompi_spc_peer_alloc(index) ) {
+            return MPI_ERR_NO_MEM;
+        }
+        opal_atomic_fetch_add_32(&ompi_spc_peers[index].num_attached, 1);
+    } else if(MCA_BASE_PVAR_HANDLE_STOP == event) {
+        opal_atomic_fetch_add_32(&ompi_spc_peers[index].num_attached, -1);
+    }
+
+    return MPI_SUCCESS;
+}
+
 /* ##############################################################
  * ################# Begin SPC Functions ########################
  * ##############################################################
@@ -246,6 +365,61 @@ static int ompi_spc_get_count(const struct mca_base_pvar_t *pvar, void *value, v
     return MPI_SUCCESS;
 }
 
+/* Copies the bins of a histogram that has been registered as an MPI_T pvar. */
+static int ompi_spc_get_hist(const struct mca_base_pvar_t *pvar, void *value, void *obj_handle)
+{
+    unsigned long long *bins = (unsigned long long*)value;
+    int index = (int)(uintptr_t)pvar->ctx;
+
+    for(int i = 0; i < OMPI_SPC_HIST_NUM_BINS; i++) {
+        bins[i] = mpi_t_enabled ? (unsigned long long)ompi_spc_hists[index].bins[i] : 0;
+    }
+
+    return MPI_SUCCESS;
+}
+
+/* Copies the values of a per-peer counter that has been registered as an
+ * MPI_T pvar. Timer-based counters are converted to microseconds. */
+static int ompi_spc_get_peer(const struct mca_base_pvar_t *pvar, void *value, void *obj_handle)
+{
+    unsigned long long *values = (unsigned long long*)value;
+    int index = (int)(uintptr_t)pvar->ctx;
+    opal_atomic_int64_t *peer_values = ompi_spc_peers[index].values;
+
+    for(int i = 0; i < ompi_spc_num_peers; i++) {
+        if( !mpi_t_enabled || NULL == peer_values ) {
+            values[i] = 0;
+        } else if( ompi_spc_peers[index].is_timer_event ) {
+            values[i] = (unsigned long long)ompi_spc_cycles_to_usecs_internal(peer_values[i]);
+        } else {
+            values[i] = (unsigned long long)peer_values[i];
+        }
+    }
+
+    return MPI_SUCCESS;
+}
+
+/* Records a per-peer value. The peer is translated to its MPI_COMM_WORLD rank
+ * without instantiating the proc structure of the peer. */
+void ompi_spc_peer_record_internal(unsigned int peer_id, struct ompi_communicator_t *comm,
+                                   int rank, ompi_spc_value_t value)
+{
+    opal_atomic_int64_t *values = ompi_spc_peers[peer_id].values;
+    opal_process_name_t name;
+
+    if( OPAL_UNLIKELY(NULL == values || NULL == comm || rank < 0 ||
+                      rank >= comm->c_remote_group->grp_proc_count) ) {
+        return;
+    }
+
+    name = ompi_group_get_proc_name(comm->c_remote_group, rank);
+    if( name.jobid != OMPI_PROC_MY_NAME->jobid || name.vpid >= (opal_vpid_t)ompi_spc_num_peers ) {
+        return;
+    }
+
+    OPAL_THREAD_ADD_FETCH64(&values[name.vpid], value);
+}
+
 /* Allocate and initializes the events data structure. */
 static void ompi_spc_events_init(void)
 {
@@ -261,11 +435,32 @@ static void ompi_spc_events_init(void)
         ompi_spc_events[i].is_timer_event = ompi_spc_events_desc[i].is_timer_event;
     }
 
+    ompi_spc_num_peers = ompi_comm_size(&ompi_mpi_comm_world.comm);
+    memset(ompi_spc_hists, 0, sizeof(ompi_spc_hists));
+    for(i = 0; i < OMPI_SPC_NUM_HISTS; i++) {
+        ompi_spc_hists[i].is_timer_event = ompi_spc_hists_desc[i].is_timer_event;
+    }
+    memset(ompi_spc_peers, 0, sizeof(ompi_spc_peers));
+    for(i = 0; i < OMPI_SPC_NUM_PEERS; i++) {
+        ompi_spc_peers[i].is_timer_event = ompi_spc_peers_desc[i].is_timer_event;
+    }
+
     if (ompi_mpi_spc_dump_enabled) {
         ompi_comm_dup(&ompi_mpi_comm_world.comm, &ompi_spc_comm);
     }
 }
 
+/* Returns true if 'name' is in the list of counters to turn on. */
+static bool ompi_spc_name_matches(const char *name, char **arg_strings, int num_args)
+{
+    for(int j = 0; j < num_args; j++) {
+        if( 0 == strcmp(name, arg_strings[j]) ) {
+            return true;
+        }
+    }
+    return false;
+}
+
 /*
  * Initializes the SPC events infrastructure.
  * Registers all counters requested through the MCA parameter mpi_spc_attach as MPI_T pvars.
@@ -325,7 +520,218 @@ void ompi_spc_init(void)
         }
     }
 
+    /* Histograms have one value per bin */
+    for(i = 0; mpi_t_enabled && i < OMPI_SPC_NUM_HISTS; i++) {
+        if( all_on || ompi_spc_name_matches(ompi_spc_hists_desc[i].counter_name, arg_strings, num_args) ) {
+            opal_atomic_fetch_add_32(&ompi_spc_hists[i].num_attached, 1);
+        }
+
+        ret = mca_base_pvar_register("ompi", "runtime", "spc", ompi_spc_hists_desc[i].counter_name, ompi_spc_hists_desc[i].counter_description,
+                                     OPAL_INFO_LVL_4, MPI_T_PVAR_CLASS_COUNTER,
+                                     MCA_BASE_VAR_TYPE_UNSIGNED_LONG_LONG, NULL, MPI_T_BIND_NO_OBJECT,
+                                     MCA_BASE_PVAR_FLAG_READONLY,
+                                     ompi_spc_get_hist, NULL, ompi_spc_hist_notify, (void*)(uintptr_t)i);
+        if( ret < 0 ) {
+            mpi_t_enabled = false;
+            opal_show_help("help-mpi-runtime.txt", "spc: MPI_T disabled", true);
+        }
+    }
+
+    /* Per-peer counters have one value per MPI_COMM_WORLD rank. They are not
+     * part of "all" because of their memory footprint at scale. */
+    for(i = 0; mpi_t_enabled && i < OMPI_SPC_NUM_PEERS; i++) {
+        if( ompi_spc_name_matches(ompi_spc_peers_desc[i].counter_name, arg_strings, num_args) ) {
+            if( OMPI_SUCCESS == ompi_spc_peer_alloc(i) ) {
+                opal_atomic_fetch_add_32(&ompi_spc_peers[i].num_attached, 1);
+            }
+        }
+
+        ret = mca_base_pvar_register("ompi", "runtime", "spc", ompi_spc_peers_desc[i].counter_name, ompi_spc_peers_desc[i].counter_description,
+                                     OPAL_INFO_LVL_4, MPI_T_PVAR_CLASS_COUNTER,
+                                     MCA_BASE_VAR_TYPE_UNSIGNED_LONG_LONG, NULL, MPI_T_BIND_NO_OBJECT,
+                                     MCA_BASE_PVAR_FLAG_READONLY,
+                                     ompi_spc_get_peer, NULL, ompi_spc_peer_notify, (void*)(uintptr_t)i);
+        if( ret < 0 ) {
+            mpi_t_enabled = false;
+            opal_show_help("help-mpi-runtime.txt", "spc: MPI_T disabled", true);
+        }
+    }
+
     opal_argv_free(arg_strings);
+
+    ompi_spc_mmap_init();
+}
+
+/* ##############################################################
+ * ########### Begin SPC Shared-Memory Export Functions #########
+ * ##############################################################
+ */
+
+/* Copies the current SPC values in the memory-mapped file under the
+ * sequence lock. Only one thread at a time updates the file: the SPC
+ * progress thread while it runs and the main thread once it is stopped.
+ */
+static void ompi_spc_mmap_publish(void)
+{
+    ompi_spc_mmap_header_t *hdr = ompi_spc_mmap_hdr;
+    int64_t *values = (int64_t *)((char *) hdr + hdr->values_offset);
+    struct timeval tv;
+    int i, k;
+
+    hdr->seq++;
+    opal_atomic_wmb();
+
+    for(i = 0; i < OMPI_SPC_NUM_COUNTERS; i++) {
+        int64_t value = ompi_spc_events[i].value;
+        if( ompi_spc_events[i].is_timer_event ) {
+            value = ompi_spc_cycles_to_usecs_internal(value);
+        }
+        *values++ = value;
+    }
+    for(i = 0; i < OMPI_SPC_NUM_HISTS; i++) {
+        for(k = 0; k < OMPI_SPC_HIST_NUM_BINS; k++) {
+            *values++ = ompi_spc_hists[i].bins[k];
+        }
+    }
+    gettimeofday(&tv, NULL);
+    hdr->timestamp = (uint64_t) tv.tv_sec * 1000000 + tv.tv_usec;
+
+    opal_atomic_wmb();
+    hdr->seq++;
+}
+
+static void ompi_spc_mmap_timer_cb(int fd, short flags, void *arg)
+{
+    struct timeval tv = {.tv_sec = ompi_mpi_spc_mmap_interval / 1000,
+                         .tv_usec = (ompi_mpi_spc_mmap_interval % 1000) * 1000};
+
+    ompi_spc_mmap_publish();
+    opal_event_evtimer_add(&ompi_spc_mmap_event, &tv);
+}
+
+static void ompi_spc_mmap_fill_entry(ompi_spc_mmap_entry_t *entry, const char *name, uint32_t count,
+                                     uint32_t flags, uint64_t value_index)
+{
+    opal_string_copy(entry->name, name, OMPI_SPC_MMAP_NAME_LEN);
+    entry->count = count;
+    entry->flags = flags;
+    entry->value_index = value_index;
+}
+
+/* Creates the memory-mapped file, describes the published counters and
+ * starts the progress thread that periodically updates the values. The
+ * file is left in place at the end of the job so that the final values
+ * can be collected.
+ */
+static void ompi_spc_mmap_init(void)
+{
+    const uint32_t num_entries = OMPI_SPC_NUM_COUNTERS + OMPI_SPC_NUM_HISTS;
+    const uint32_t num_values = OMPI_SPC_NUM_COUNTERS + OMPI_SPC_NUM_HISTS * OMPI_SPC_HIST_NUM_BINS;
+    ompi_spc_mmap_header_t *hdr;
+    ompi_spc_mmap_entry_t *entries;
+    char *filename = NULL;
+    uint32_t i, index = 0;
+    int fd;
+
+    if( NULL == ompi_mpi_spc_mmap_dir || '\0' == ompi_mpi_spc_mmap_dir[0] ) {
+        return;
+    }
+
+    ompi_spc_mmap_size = sizeof(*hdr) + num_entries * sizeof(*entries) + num_values * sizeof(int64_t);
+
+    /* the directory may be shared between nodes, where pids are not unique */
+    if( 0 > opal_asprintf(&filename, "%s/ompi_spc.%s.%u", ompi_mpi_spc_mmap_dir,
+                          OPAL_JOBID_PRINT(OMPI_PROC_MY_NAME->jobid),
+                          (unsigned int) OMPI_PROC_MY_NAME->vpid) ) {
+        return;
+    }
+
+    fd = open(filename, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if( fd < 0 || 0 != ftruncate(fd, ompi_spc_mmap_size) ) {
+        opal_show_help("help-mpi-runtime.txt", "spc: mmap failed", true, filename, strerror(errno));
+        if( fd >= 0 ) {
+            close(fd);
+            unlink(filename);
+        }
+        free(filename);
+        return;
+    }
+
+    hdr = mmap(NULL, ompi_spc_mmap_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if( MAP_FAILED == hdr ) {
+        opal_show_help("help-mpi-runtime.txt", "spc: mmap failed", true, filename, strerror(errno));
+        unlink(filename);
+        free(filename);
+        return;
+    }
+    free(filename);
+
+    hdr->version = OMPI_SPC_MMAP_VERSION;
+    hdr->num_entries = num_entries;
+    hdr->num_values = num_values;
+    hdr->rank = ompi_comm_rank(&ompi_mpi_comm_world.comm);
+    hdr->world_size = ompi_comm_size(&ompi_mpi_comm_world.comm);
+    hdr->pid = (int32_t) getpid();
+    hdr->entries_offset = sizeof(*hdr);
+    hdr->values_offset = sizeof(*hdr) + num_entries * sizeof(*entries);
+    opal_string_copy(hdr->jobid, OPAL_JOBID_PRINT(OMPI_PROC_MY_NAME->jobid), OMPI_SPC_MMAP_NAME_LEN);
+
+    entries = (ompi_spc_mmap_entry_t *)((char *) hdr + hdr->entries_offset);
+    for(i = 0; i < OMPI_SPC_NUM_COUNTERS; i++) {
+        ompi_spc_mmap_fill_entry(entries++, ompi_spc_events_desc[i].counter_name, 1,
+                                 (ompi_spc_events_desc[i].is_timer_event ? OMPI_SPC_MMAP_FLAG_TIMER : 0) |
+                                 (ompi_spc_events_desc[i].is_high_watermark ? OMPI_SPC_MMAP_FLAG_HIGH_WATERMARK : 0),
+                                 index++);
+    }
+    for(i = 0; i < OMPI_SPC_NUM_HISTS; i++) {
+        ompi_spc_mmap_fill_entry(entries++, ompi_spc_hists_desc[i].counter_name, OMPI_SPC_HIST_NUM_BINS,
+                                 OMPI_SPC_MMAP_FLAG_HISTOGRAM |
+                                 (ompi_spc_hists_desc[i].is_timer_event ? OMPI_SPC_MMAP_FLAG_TIMER : 0),
+                                 index);
+        index += OMPI_SPC_HIST_NUM_BINS;
+    }
+
+    ompi_spc_mmap_hdr = hdr;
+    ompi_spc_mmap_publish();
+
+    /* the file is complete. let the readers use it. */
+    opal_atomic_wmb();
+    hdr->magic = OMPI_SPC_MMAP_MAGIC;
+
+    if( 0 == ompi_mpi_spc_mmap_interval ) {
+        /* only published at the end of the job */
+        return;
+    }
+
+    ompi_spc_mmap_evbase = opal_progress_thread_init(ompi_spc_mmap_thread_name);
+    if( NULL == ompi_spc_mmap_evbase ) {
+        return;
+    }
+    opal_event_evtimer_set(ompi_spc_mmap_evbase, &ompi_spc_mmap_event, ompi_spc_mmap_timer_cb, NULL);
+    ompi_spc_mmap_timer_cb(-1, 0, NULL);
+}
+
+static void ompi_spc_mmap_fini(void)
+{
+    if( NULL == ompi_spc_mmap_hdr ) {
+        return;
+    }
+
+    if( NULL != ompi_spc_mmap_evbase ) {
+        opal_progress_thread_pause(ompi_spc_mmap_thread_name);
+        opal_event_evtimer_del(&ompi_spc_mmap_event);
+        opal_progress_thread_finalize(ompi_spc_mmap_thread_name);
+        ompi_spc_mmap_evbase = NULL;
+    }
+
+    /* publish the final values */
+    ompi_spc_mmap_publish();
+    opal_atomic_wmb();
+    ompi_spc_mmap_hdr->finalized = 1;
+
+    munmap(ompi_spc_mmap_hdr, ompi_spc_mmap_size);
+    ompi_spc_mmap_hdr = NULL;
 }
 
 /* Gathers all of the SPC data onto rank 0 of MPI_COMM_WORLD and prints out all
@@ -333,8 +739,9 @@ void ompi_spc_init(void)
  */
 static void ompi_spc_dump(void)
 {
-    int i, j, world_size, offset;
+    int i, j, k, world_size, offset;
     long long *recv_buffer = NULL, *send_buffer;
+    const int num_values = OMPI_SPC_NUM_COUNTERS + OMPI_SPC_NUM_HISTS * OMPI_SPC_HIST_NUM_BINS;
 
     int rank = ompi_comm_rank(ompi_spc_comm);
     world_size = ompi_comm_size(ompi_spc_comm);
@@ -347,7 +754,7 @@ static void ompi_spc_dump(void)
     }
 
     /* Aggregate all of the information on rank 0 using MPI_Gather on MPI_COMM_WORLD */
-    send_buffer = (long long*)malloc(OMPI_SPC_NUM_COUNTERS * sizeof(long long));
+    send_buffer = (long long*)malloc(num_values * sizeof(long long));
     if (NULL == send_buffer) {
         opal_show_help("help-mpi-runtime.txt", "lib-call-fail", true,
                        "malloc", __FILE__, __LINE__);
@@ -356,16 +763,21 @@ static void ompi_spc_dump(void)
     for(i = 0; i < OMPI_SPC_NUM_COUNTERS; i++) {
         send_buffer[i] = (long long)ompi_spc_events[i].value;
     }
+    for(i = 0; i < OMPI_SPC_NUM_HISTS; i++) {
+        for(k = 0; k < OMPI_SPC_HIST_NUM_BINS; k++) {
+            send_buffer[OMPI_SPC_NUM_COUNTERS + i * OMPI_SPC_HIST_NUM_BINS + k] = (long long)ompi_spc_hists[i].bins[k];
+        }
+    }
     if( 0 == rank ) {
-        recv_buffer = (long long*)malloc(world_size * OMPI_SPC_NUM_COUNTERS * sizeof(long long));
+        recv_buffer = (long long*)malloc(world_size * num_values * sizeof(long long));
         if (NULL == recv_buffer) {
             opal_show_help("help-mpi-runtime.txt", "lib-call-fail", true,
                            "malloc", __FILE__, __LINE__);
             return;
         }
     }
-    (void)ompi_spc_comm->c_coll->coll_gather(send_buffer, OMPI_SPC_NUM_COUNTERS, MPI_LONG_LONG,
-                                             recv_buffer, OMPI_SPC_NUM_COUNTERS, MPI_LONG_LONG,
+    (void)ompi_spc_comm->c_coll->coll_gather(send_buffer, num_values, MPI_LONG_LONG,
+                                             recv_buffer, num_values, MPI_LONG_LONG,
                                              0, ompi_spc_comm,
                                              ompi_spc_comm->c_coll->coll_gather_module);
 
@@ -381,8 +793,26 @@ static void ompi_spc_dump(void)
                 }
                 opal_output(0, "%s -> %lld\n", ompi_spc_events_desc[i].counter_name, recv_buffer[offset+i]);
             }
+            /* Histograms print one line per non-empty bin with the bin's range */
+            for(i = 0; i < OMPI_SPC_NUM_HISTS; i++) {
+                long long *bins = recv_buffer + offset + OMPI_SPC_NUM_COUNTERS + i * OMPI_SPC_HIST_NUM_BINS;
+                for(k = 0; k < OMPI_SPC_HIST_NUM_BINS; k++) {
+                    if( 0 == bins[k] ) {
+                        continue;
+                    }
+                    if( 0 == k ) {
+                        opal_output(0, "%s[0] -> %lld\n", ompi_spc_hists_desc[i].counter_name, bins[k]);
+                    } else if( OMPI_SPC_HIST_NUM_BINS - 1 == k ) {
+                        opal_output(0, "%s[%llu+] -> %lld\n", ompi_spc_hists_desc[i].counter_name,
+                                    1ULL << (k - 1), bins[k]);
+                    } else {
+                        opal_output(0, "%s[%llu-%llu] -> %lld\n", ompi_spc_hists_desc[i].counter_name,
+                                    1ULL << (k - 1), (1ULL << k) - 1, bins[k]);
+                    }
+                }
+            }
             opal_output(0, "\n");
-            offset += OMPI_SPC_NUM_COUNTERS;
+            offset += num_values;
         }
         printf("###########################################################################\n");
         printf("NOTE: Any counters not shown here were either disabled or had a value of 0.\n");
@@ -398,10 +828,22 @@ static void ompi_spc_dump(void)
 /* Frees any dynamically alocated OMPI SPC data structures */
 void ompi_spc_fini(void)
 {
+    int i;
+
+    /* must be done before the dump converts the timers in place */
+    ompi_spc_mmap_fini();
+
     if (ompi_mpi_spc_dump_enabled) {
         ompi_spc_dump();
         ompi_comm_free(&ompi_spc_comm);
     }
+
+    for(i = 0; i < OMPI_SPC_NUM_PEERS; i++) {
+        ompi_spc_peers[i].num_attached = 0;
+        opal_atomic_wmb();
+        free(ompi_spc_peers[i].values);
+        ompi_spc_peers[i].values = NULL;
+    }
 }
 
 /* Converts a counter value that is in cycles to microseconds.
@@ -157,6 +157,43 @@ typedef enum ompi_spc_counters {
     OMPI_SPC_NUM_COUNTERS /* This serves as the number of counters.  It must be last. */
 } ompi_spc_counters_t;
 
+/* Histogram SPCs.  Each histogram counts the recorded values in log2 sized
+ * bins: bin 0 counts values of 0, bin i (i > 0) counts values in
+ * [2^(i-1), 2^i) and the last bin also counts all larger values.  Sizes are
+ * in bytes and timer-based histograms are binned in microseconds.
+ * To add a histogram, add its name here and its description to the
+ * ompi_spc_hists_desc array in ompi_spc.c.
+ */
+typedef enum ompi_spc_hists {
+    OMPI_SPC_HIST_SEND_SIZE,
+    OMPI_SPC_HIST_RECV_SIZE,
+    OMPI_SPC_HIST_COLL_SIZE,
+    OMPI_SPC_HIST_RMA_SIZE,
+    OMPI_SPC_HIST_SEND_TIME,
+    OMPI_SPC_HIST_RECV_TIME,
+    OMPI_SPC_HIST_WAIT_TIME,
+    OMPI_SPC_HIST_COLL_TIME,
+    OMPI_SPC_NUM_HISTS /* This serves as the number of histograms.  It must be last. */
+} ompi_spc_hists_t;
+
+#define OMPI_SPC_HIST_NUM_BINS 32
+
+/* Per-peer SPCs.  These counters have one value per process in
+ * MPI_COMM_WORLD and are indexed by the MPI_COMM_WORLD rank of the peer.
+ * Communication with processes outside of MPI_COMM_WORLD is not counted.
+ * The storage is only allocated once a counter is attached.
+ * To add a per-peer counter, add its name here and its description to the
+ * ompi_spc_peers_desc array in ompi_spc.c.
+ */
+typedef enum ompi_spc_peers {
+    OMPI_SPC_PEER_MESSAGES_SENT,
+    OMPI_SPC_PEER_BYTES_SENT,
+    OMPI_SPC_PEER_MESSAGES_RECEIVED,
+    OMPI_SPC_PEER_BYTES_RECEIVED,
+    OMPI_SPC_PEER_RECV_TIME,
+    OMPI_SPC_NUM_PEERS /* This serves as the number of per-peer counters.  It must be last. */
+} ompi_spc_peers_t;
+
 /* There is currently no support for atomics on long long values so we will default to
  * size_t for now until support for such atomics is implemented.
  */
@@ -170,6 +207,66 @@ typedef struct ompi_spc_s{
     bool is_timer_event;
 } ompi_spc_t;
 
+/* A structure for storing the histogram data */
+typedef struct ompi_spc_hist_s {
+    opal_atomic_int64_t bins[OMPI_SPC_HIST_NUM_BINS];
+    opal_atomic_int32_t num_attached;
+    bool is_timer_event;
+} ompi_spc_hist_t;
+
+/* A structure for storing the per-peer data */
+typedef struct ompi_spc_peer_s {
+    opal_atomic_int64_t *values;
+    opal_atomic_int32_t num_attached;
+    bool is_timer_event;
+} ompi_spc_peer_t;
+
+struct ompi_communicator_t;
+
+/* Layout of the memory-mapped file in which the SPC values are published
+ * when mpi_spc_mmap_dir is set.  The file starts with a header, followed by
+ * num_entries entries describing the counters and num_values 64-bit signed
+ * values.  The layout is fixed for a given version.
+ *
+ * The values are updated under a sequence lock.  A reader must:
+ *   1.) read seq and retry later if it is odd (update in progress),
+ *   2.) copy the values (and timestamp) it is interested in,
+ *   3.) issue a read memory barrier and read seq again; the copy is a
+ *       consistent snapshot only if seq did not change.
+ * The magic is written last when the file is created, so a reader must
+ * ignore files whose magic does not match yet.
+ */
+#define OMPI_SPC_MMAP_MAGIC    0x4f535043 /* "OSPC" */
+#define OMPI_SPC_MMAP_VERSION  1
+#define OMPI_SPC_MMAP_NAME_LEN 64
+
+typedef struct ompi_spc_mmap_header_t {
+    uint32_t magic;
+    uint32_t version;
+    volatile uint64_t seq;          /* sequence lock, odd while values are updated */
+    volatile uint64_t timestamp;    /* microseconds since the Epoch of the last update */
+    uint32_t num_entries;
+    uint32_t num_values;
+    uint32_t rank;                  /* MPI_COMM_WORLD rank of the process */
+    uint32_t world_size;
+    int32_t pid;
+    volatile uint32_t finalized;    /* set once the process stopped updating the values */
+    uint64_t entries_offset;        /* offset of the first entry from the start of the file */
+    uint64_t values_offset;         /* offset of the first value from the start of the file */
+    char jobid[OMPI_SPC_MMAP_NAME_LEN];
+} ompi_spc_mmap_header_t;
+
+#define OMPI_SPC_MMAP_FLAG_TIMER          0x1 /* values are in microseconds */
+#define OMPI_SPC_MMAP_FLAG_HIGH_WATERMARK 0x2
+#define OMPI_SPC_MMAP_FLAG_HISTOGRAM      0x4 /* one value per log2 bin */
+
+typedef struct ompi_spc_mmap_entry_t {
+    char name[OMPI_SPC_MMAP_NAME_LEN];
+    uint32_t count;                 /* number of values of this counter */
+    uint32_t flags;                 /* OMPI_SPC_MMAP_FLAG_* */
+    uint64_t value_index;           /* index of the first value of this counter */
+} ompi_spc_mmap_entry_t;
+
 /* Definitions for using the SPC utility functions throughout the codebase.
  * If SPC_ENABLE is not 1, the macros become no-ops.
  */
@@ -186,6 +283,14 @@ void ompi_spc_cycles_to_usecs(opal_timer_t *cycles);
 OPAL_DECLSPEC extern
 ompi_spc_t ompi_spc_events[OMPI_SPC_NUM_COUNTERS] __opal_attribute_aligned__(sizeof(ompi_spc_t));
 
+OPAL_DECLSPEC extern ompi_spc_hist_t ompi_spc_hists[OMPI_SPC_NUM_HISTS];
+OPAL_DECLSPEC extern ompi_spc_peer_t ompi_spc_peers[OMPI_SPC_NUM_PEERS];
+
+/* Slow path of the per-peer counters. Translates the communicator rank
+ * into an MPI_COMM_WORLD rank and records the value. */
+OMPI_DECLSPEC void ompi_spc_peer_record_internal(unsigned int peer_id, struct ompi_communicator_t *comm,
+                                                 int rank, ompi_spc_value_t value);
+
 #define SPC_INIT()  \
     ompi_spc_init()
 
@@ -210,6 +315,24 @@ ompi_spc_t ompi_spc_events[OMPI_SPC_NUM_COUNTERS] __opal_attribute_aligned__(siz
 #define SPC_UPDATE_WATERMARK(watermark_enum, value_enum) \
     ompi_spc_update_watermark(watermark_enum, value_enum)
 
+#define SPC_HIST_RECORD(hist_id, value) \
+    ompi_spc_hist_record(hist_id, value)
+
+#define SPC_HIST_TIMER_START(hist_id, cycles) \
+    ompi_spc_hist_timer_start(hist_id, cycles)
+
+#define SPC_HIST_TIMER_STOP(hist_id, cycles) \
+    ompi_spc_hist_timer_stop(hist_id, cycles)
+
+#define SPC_PEER_RECORD(peer_id, comm, rank, value) \
+    ompi_spc_peer_record(peer_id, comm, rank, value)
+
+#define SPC_PEER_TIMER_START(peer_id, cycles) \
+    ompi_spc_peer_timer_start(peer_id, cycles)
+
+#define SPC_PEER_TIMER_STOP(peer_id, comm, rank, cycles) \
+    ompi_spc_peer_timer_stop(peer_id, comm, rank, cycles)
+
 
 /* Records an update to a counter using an atomic add operation. */
 static inline
@@ -282,6 +405,90 @@ void ompi_spc_timer_stop(unsigned int event_id, opal_timer_t *cycles)
     }
 }
 
+/* Returns the histogram bin for a value. */
+static inline
+int ompi_spc_hist_bin(ompi_spc_value_t value)
+{
+    uint64_t v = (uint64_t) value;
+    int bin = 1;
+
+    if( value <= 0 ) {
+        return 0;
+    }
+    if( v >> 32 ) { v >>= 32; bin += 32; }
+    if( v >> 16 ) { v >>= 16; bin += 16; }
+    if( v >> 8 )  { v >>= 8;  bin += 8; }
+    if( v >> 4 )  { v >>= 4;  bin += 4; }
+    if( v >> 2 )  { v >>= 2;  bin += 2; }
+    if( v >> 1 )  { bin += 1; }
+
+    return (bin < OMPI_SPC_HIST_NUM_BINS) ? bin : OMPI_SPC_HIST_NUM_BINS - 1;
+}
+
+/* Records a value into the matching bin of a histogram. */
+static inline
+void ompi_spc_hist_record(unsigned int hist_id, ompi_spc_value_t value)
+{
+    if( ompi_spc_hists[hist_id].num_attached > 0 ) {
+        OPAL_THREAD_ADD_FETCH64(&ompi_spc_hists[hist_id].bins[ompi_spc_hist_bin(value)], 1);
+    }
+}
+
+/* Starts a cycle-precision timer for a timer-based histogram. Same semantic
+ * as ompi_spc_timer_start. */
+static inline
+void ompi_spc_hist_timer_start(unsigned int hist_id, opal_timer_t *cycles)
+{
+    *cycles = 0;
+
+    if( ompi_spc_hists[hist_id].num_attached > 0 ) {
+        *cycles = opal_timer_base_get_cycles();
+    }
+}
+
+/* Stops a timer-based histogram timer and records the elapsed time in
+ * microseconds. */
+static inline
+void ompi_spc_hist_timer_stop(unsigned int hist_id, opal_timer_t *cycles)
+{
+    if( ompi_spc_hists[hist_id].num_attached > 0 && *cycles > 0 ) {
+        *cycles = opal_timer_base_get_cycles() - *cycles;
+        ompi_spc_cycles_to_usecs(cycles);
+        OPAL_THREAD_ADD_FETCH64(&ompi_spc_hists[hist_id].bins[ompi_spc_hist_bin(*cycles)], 1);
+    }
+}
+
+/* Records an update to the counter of the peer with rank 'rank' in 'comm'. */
+static inline
+void ompi_spc_peer_record(unsigned int peer_id, struct ompi_communicator_t *comm, int rank,
+                          ompi_spc_value_t value)
+{
+    if( OPAL_UNLIKELY(ompi_spc_peers[peer_id].num_attached > 0) ) {
+        ompi_spc_peer_record_internal(peer_id, comm, rank, value);
+    }
+}
+
+static inline
+void ompi_spc_peer_timer_start(unsigned int peer_id, opal_timer_t *cycles)
+{
+    *cycles = 0;
+
+    if( OPAL_UNLIKELY(ompi_spc_peers[peer_id].num_attached > 0) ) {
+        *cycles = opal_timer_base_get_cycles();
+    }
+}
+
+/* The elapsed time is recorded in cycles and converted to microseconds when
+ * the counter is read. */
+static inline
+void ompi_spc_peer_timer_stop(unsigned int peer_id, struct ompi_communicator_t *comm, int rank,
+                              opal_timer_t *cycles)
+{
+    if( OPAL_UNLIKELY(ompi_spc_peers[peer_id].num_attached > 0) && *cycles > 0 ) {
+        *cycles = opal_timer_base_get_cycles() - *cycles;
+        ompi_spc_peer_record_internal(peer_id, comm, rank, (ompi_spc_value_t) *cycles);
+    }
+}
 
 #else /* SPCs are not enabled */
 
@@ -309,6 +516,24 @@ void ompi_spc_timer_stop(unsigned int event_id, opal_timer_t *cycles)
 #define SPC_UPDATE_WATERMARK(watermark_enum, value_enum) \
     ((void)0)
 
+#define SPC_HIST_RECORD(hist_id, value) \
+    ((void)0)
+
+#define SPC_HIST_TIMER_START(hist_id, cycles) \
+    ((void)0)
+
+#define SPC_HIST_TIMER_STOP(hist_id, cycles) \
+    ((void)0)
+
+#define SPC_PEER_RECORD(peer_id, comm, rank, value) \
+    ((void)0)
+
+#define SPC_PEER_TIMER_START(peer_id, cycles) \
+    ((void)0)
+
+#define SPC_PEER_TIMER_STOP(peer_id, comm, rank, cycles) \
+    ((void)0)
+
 #endif
 
 #endif
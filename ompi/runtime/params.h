@@ -145,6 +145,12 @@ OMPI_DECLSPEC extern bool ompi_use_sparse_group_storage;
  */
 OMPI_DECLSPEC extern uint32_t ompi_add_procs_cutoff;
 
+/**
+ * Whether ompi_proc_t's of node-local peers are also created on first
+ * use instead of during MPI_Init (default: false)
+ */
+OMPI_DECLSPEC extern bool ompi_mpi_lazy_procs;
+
 /**
  * Whether anything in the code base has disabled MPI dynamic process
  * functionality or not
@@ -175,6 +181,26 @@ OMPI_DECLSPEC extern char * ompi_mpi_spc_attach_string;
  */
 OMPI_DECLSPEC extern bool ompi_mpi_spc_dump_enabled;
 
+/**
+ * Directory in which each process publishes its SPC values in a
+ * memory-mapped file for out-of-process readers.  Publishing is
+ * disabled if NULL or empty.
+ */
+OMPI_DECLSPEC extern char * ompi_mpi_spc_mmap_dir;
+
+/**
+ * Interval in milliseconds between two updates of the SPC values in
+ * the memory-mapped file.
+ */
+OMPI_DECLSPEC extern unsigned int ompi_mpi_spc_mmap_interval;
+
+/**
+ * Number of consecutive context IDs examined at once when allocating
+ * the context ID of a new communicator.  0 disables the window based
+ * allocation.
+ */
+OMPI_DECLSPEC extern int ompi_mpi_comm_cid_window;
+
 /**
  * Timeout for calls to PMIx_Connect(defaut 0, no timeout)
  */
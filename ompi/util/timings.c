@@ -0,0 +1,102 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The Open MPI Project.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ompi/util/timings.h"
+
+#if (OPAL_ENABLE_TIMING)
+
+static void ompi_timing_json_string(FILE *fp, const char *str)
+{
+    fputc('"', fp);
+    for ( ; NULL != str && '\0' != *str ; ++str) {
+        switch (*str) {
+        case '"':
+        case '\\':
+            fputc('\\', fp);
+            fputc(*str, fp);
+            break;
+        case '\n':
+            fputs("\\n", fp);
+            break;
+        case '\t':
+            fputs("\\t", fp);
+            break;
+        default:
+            if ((unsigned char) *str < 0x20) {
+                fprintf(fp, "\\u%04x", (unsigned char) *str);
+            } else {
+                fputc(*str, fp);
+            }
+        }
+    }
+    fputc('"', fp);
+}
+
+void ompi_timing_json_output(const char *name, int nranks, int cnt,
+                             const int *imported,
+                             const double *avg, const double *min, const double *max,
+                             char **desc, char **prefix, char **file)
+{
+    const char *path = getenv("OMPI_TIMING_JSON");
+    double total_avg = 0, total_min = 0, total_max = 0;
+    int i;
+    FILE *fp;
+
+    if (NULL == path || '\0' == path[0]) {
+        return;
+    }
+
+    if (0 == strcmp(path, "-")) {
+        fp = stdout;
+    } else {
+        /* one report per line, MPI_Init and MPI_Finalize append to the same file */
+        fp = fopen(path, "a");
+        if (NULL == fp) {
+            fprintf(stderr, "==OMPI_TIMING== error: could not open %s\n", path);
+            return;
+        }
+    }
+
+    fprintf(fp, "{\"name\":");
+    ompi_timing_json_string(fp, name);
+    fprintf(fp, ",\"nranks\":%d,\"unit\":\"s\",\"phases\":[", nranks);
+    for (i = 0 ; i < cnt ; ++i) {
+        fprintf(fp, "%s{\"file\":", i ? "," : "");
+        ompi_timing_json_string(fp, file[i]);
+        fprintf(fp, ",\"func\":");
+        ompi_timing_json_string(fp, prefix[i]);
+        fprintf(fp, ",\"phase\":");
+        ompi_timing_json_string(fp, desc[i]);
+        fprintf(fp, ",\"imported\":%s,\"avg\":%lf,\"min\":%lf,\"max\":%lf}",
+                imported[i] ? "true" : "false", avg[i], min[i], max[i]);
+        /* imported phases are a breakdown of the enclosing phase */
+        if (!imported[i]) {
+            total_avg += avg[i];
+            total_min += min[i];
+            total_max += max[i];
+        }
+    }
+    fprintf(fp, "],\"total\":{\"avg\":%lf,\"min\":%lf,\"max\":%lf}}\n",
+            total_avg, total_min, total_max);
+
+    if (stdout == fp) {
+        fflush(fp);
+    } else {
+        fclose(fp);
+    }
+}
+
+#endif
@@ -43,6 +43,16 @@ typedef struct ompi_timing_t {
     ompi_timing_list_t *cur_timing;
 } ompi_timing_t;
 
+/**
+ * Write the reduced timings as one JSON document to the file named by
+ * the OMPI_TIMING_JSON environment variable ("-" for stdout). Called by
+ * rank 0 from OMPI_TIMING_OUT.
+ */
+OMPI_DECLSPEC void ompi_timing_json_output(const char *name, int nranks, int cnt,
+                                           const int *imported,
+                                           const double *avg, const double *min, const double *max,
+                                           char **desc, char **prefix, char **file);
+
 #define OMPI_TIMING_ENABLED \
     (getenv("OMPI_TIMING_ENABLE") ? atoi(getenv("OMPI_TIMING_ENABLE")) : 0)
 
@@ -113,6 +123,7 @@ typedef struct ompi_timing_t {
             }                                                                      \
             OMPI_TIMING.cur_timing->val[OMPI_TIMING.cur_timing->use].file = strdup(f);     \
             OMPI_TIMING.cur_timing->val[OMPI_TIMING.cur_timing->use].prefix = strdup(__func__);      \
+            OMPI_TIMING.cur_timing->val[OMPI_TIMING.cur_timing->use].imported = 0;       \
             OMPI_TIMING.cur_timing->val[OMPI_TIMING.cur_timing->use++].ts =        \
                 OMPI_TIMING.get_ts() - OMPI_TIMING.ts;                             \
             OMPI_TIMING.cnt++;                                                     \
@@ -152,6 +163,9 @@ typedef struct ompi_timing_t {
             OPAL_TIMING_ENV_ERROR_PREFIX(_prefix, func, OMPI_TIMING.error);        \
             for(i = 0; i < cnt; i++){                                              \
                 char *desc, *filename;                                             \
+                if (OMPI_TIMING.cur_timing->use >= OMPI_TIMING.size){              \
+                    OMPI_TIMING_ITEM_EXTEND;                                       \
+                }                                                                  \
                 OMPI_TIMING.cur_timing->val[OMPI_TIMING.cur_timing->use].imported= \
                     OMPI_TIMING.import_cnt;                                        \
                 OPAL_TIMING_ENV_GETDESC_PREFIX(_prefix, &filename, func, i, &desc, ts);  \
@@ -188,6 +202,7 @@ typedef struct ompi_timing_t {
                 char **desc = (char**)malloc(sizeof(char*) * OMPI_TIMING.cnt);    \
                 char **prefix = (char**)malloc(sizeof(char*) * OMPI_TIMING.cnt);  \
                 char **file = (char**)malloc(sizeof(char*) * OMPI_TIMING.cnt);    \
+                int *imp = (int*)malloc(sizeof(int) * OMPI_TIMING.cnt);           \
                 double total_avg = 0, total_min = 0, total_max = 0;               \
                                                                                   \
                 if( OMPI_TIMING.cnt > 0 ) {                                       \
@@ -209,6 +224,7 @@ typedef struct ompi_timing_t {
                             desc[i] = timing->val[use].desc;                      \
                             prefix[i] = timing->val[use].prefix;                  \
                             file[i] = timing->val[use].file;                      \
+                            imp[i] = timing->val[use].imported;                   \
                             i++;                                                  \
                         }                                                         \
                         timing = (ompi_timing_list_t*)timing->next;               \
@@ -222,15 +238,15 @@ typedef struct ompi_timing_t {
                                                                                   \
                         printf("------------------ %s ------------------\n",      \
                             OMPI_TIMING.prefix);                                  \
-                        imported = OMPI_TIMING.timing->val[0].imported;           \
+                        imported = imp[0];                                        \
                         for(i=0; i< OMPI_TIMING.cnt; i++){                        \
                             bool print_total = 0;                                 \
-                            imported = OMPI_TIMING.timing->val[i].imported;       \
+                            imported = imp[i];                                    \
                             avg[i] /= size;                                       \
                             printf("%s[%s:%s:%s]: %lf / %lf / %lf\n",             \
                                 imported ? " -- " : "",                           \
                                 file[i], prefix[i], desc[i], avg[i], min[i], max[i]); \
-                            if (OMPI_TIMING.timing->val[i].imported) {            \
+                            if (imp[i]) {                                         \
                                 total_avg += avg[i];                              \
                                 total_min += min[i];                              \
                                 total_max += max[i];                              \
@@ -238,9 +254,9 @@ typedef struct ompi_timing_t {
                             if (i == (OMPI_TIMING.cnt-1)) {                       \
                                 print_total = true;                               \
                             } else {                                              \
-                                print_total = imported != OMPI_TIMING.timing->val[i+1].imported; \
+                                print_total = imported != imp[i+1];               \
                             }                                                     \
-                            if (print_total && OMPI_TIMING.timing->val[i].imported) {            \
+                            if (print_total && imp[i]) {                          \
                                 printf("%s[%s:%s:%s]: %lf / %lf / %lf\n",         \
                                     imported ? " !! " : "",                       \
                                     file[i], prefix[i], "total",                  \
@@ -250,7 +266,7 @@ typedef struct ompi_timing_t {
                         }                                                         \
                         total_avg = 0; total_min = 0; total_max = 0;              \
                         for(i=0; i< OMPI_TIMING.cnt; i++) {                       \
-                            if (!OMPI_TIMING.timing->val[i].imported) {           \
+                            if (!imp[i]) {                                        \
                                 total_avg += avg[i];                              \
                                 total_min += min[i];                              \
                                 total_max += max[i];                              \
@@ -261,6 +277,9 @@ typedef struct ompi_timing_t {
                             total_avg, total_min, total_max);                     \
                         printf("[%s:overhead]: %lf \n", OMPI_TIMING.prefix,       \
                             OMPI_TIMING.get_ts() - OMPI_TIMING.ts);               \
+                        ompi_timing_json_output(OMPI_TIMING.prefix, size,         \
+                                                OMPI_TIMING.cnt, imp,                 \
+                                                avg, min, max, desc, prefix, file); \
                     }                                                             \
                 }                                                                 \
                 free(avg);                                                        \
@@ -269,6 +288,7 @@ typedef struct ompi_timing_t {
                 free(desc);                                                       \
                 free(prefix);                                                     \
                 free(file);                                                       \
+                free(imp);                                                        \
             }                                                                     \
         }                                                                         \
     } while(0)
@@ -72,6 +72,7 @@ OPAL_DECLSPEC extern char *mca_base_component_path;
 OPAL_DECLSPEC extern bool mca_base_component_show_load_errors;
 OPAL_DECLSPEC extern bool mca_base_component_track_load_errors;
 OPAL_DECLSPEC extern bool mca_base_component_disable_dlopen;
+OPAL_DECLSPEC extern bool mca_base_component_use_manifest;
 OPAL_DECLSPEC extern char *mca_base_system_default_path;
 OPAL_DECLSPEC extern char *mca_base_user_default_path;
 
@@ -28,6 +28,9 @@
 #ifdef HAVE_SYS_TYPES_H
 #    include <sys/types.h>
 #endif
+#ifdef HAVE_SYS_STAT_H
+#    include <sys/stat.h>
+#endif
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -195,6 +198,82 @@ static int file_exists(const char *filename, const char *ext)
     return (0 == ret);
 }
 
+/*
+ * Whether the directory was modified after the manifest was written.
+ * Without sub-second timestamps a directory modified in the same second
+ * as the manifest cannot be told apart, consider the manifest stale.
+ */
+static bool manifest_is_stale(const struct stat *dir_stat, const struct stat *manifest_stat)
+{
+#if defined(HAVE_STRUCT_STAT_ST_MTIM)
+    if (dir_stat->st_mtim.tv_sec != manifest_stat->st_mtim.tv_sec) {
+        return dir_stat->st_mtim.tv_sec > manifest_stat->st_mtim.tv_sec;
+    }
+    return dir_stat->st_mtim.tv_nsec >= manifest_stat->st_mtim.tv_nsec;
+#else
+    return dir_stat->st_mtime >= manifest_stat->st_mtime;
+#endif
+}
+
+/*
+ * Add the components listed in the manifest of a component directory.
+ * Returns OPAL_ERR_NOT_FOUND if the directory has to be scanned
+ * instead: there is no manifest or the directory was modified after
+ * the manifest was written (e.g., a component was installed later).
+ */
+static int process_repository_manifest(const char *dir)
+{
+    char *manifest, line[OPAL_PATH_MAX], *filename;
+    struct stat dir_stat, manifest_stat;
+    FILE *fp;
+    int ret;
+
+    ret = opal_asprintf(&manifest, "%s" OPAL_PATH_SEP "%s", dir, MCA_BASE_COMPONENT_MANIFEST);
+    if (0 > ret) {
+        return OPAL_ERR_OUT_OF_RESOURCE;
+    }
+
+    if (0 != stat(manifest, &manifest_stat) || 0 != stat(dir, &dir_stat)
+        || manifest_is_stale(&dir_stat, &manifest_stat)) {
+        free(manifest);
+        return OPAL_ERR_NOT_FOUND;
+    }
+
+    fp = fopen(manifest, "r");
+    if (NULL == fp) {
+        free(manifest);
+        return OPAL_ERR_NOT_FOUND;
+    }
+
+    opal_output_verbose(MCA_BASE_VERBOSE_COMPONENT, 0,
+                        "mca_base_component_repository_add: using manifest %s", manifest);
+    free(manifest);
+
+    ret = OPAL_SUCCESS;
+    while (NULL != fgets(line, sizeof(line), fp)) {
+        line[strcspn(line, "\r\n")] = '\0';
+        if ('\0' == line[0] || '#' == line[0]) {
+            continue;
+        }
+
+        ret = opal_asprintf(&filename, "%s" OPAL_PATH_SEP "%s", dir, line);
+        if (0 > ret) {
+            ret = OPAL_ERR_OUT_OF_RESOURCE;
+            break;
+        }
+
+        ret = process_repository_item(filename, NULL);
+        free(filename);
+        if (OPAL_SUCCESS != ret) {
+            break;
+        }
+    }
+
+    fclose(fp);
+
+    return ret;
+}
+
 #endif /* OPAL_HAVE_DL_SUPPORT */
 
 int mca_base_component_repository_add(const char *path)
@@ -219,6 +298,11 @@ int mca_base_component_repository_add(const char *path)
             dir = mca_base_system_default_path;
         }
 
+        if (mca_base_component_use_manifest
+            && OPAL_ERR_NOT_FOUND != process_repository_manifest(dir)) {
+            continue;
+        }
+
         if (0 != opal_dl_foreachfile(dir, process_repository_item, NULL)) {
             break;
         }
@@ -61,6 +61,13 @@ typedef struct mca_base_component_repository_item_t mca_base_component_repositor
 
 OBJ_CLASS_DECLARATION(mca_base_component_repository_item_t);
 
+/**
+ * Name of the component manifest written into a component directory
+ * at install time (see config/opal_mca_component_manifest.sh). It
+ * lists one component file per line, without the file extension.
+ */
+#define MCA_BASE_COMPONENT_MANIFEST "component_manifest.txt"
+
 /*
  * Structure to track information about why a component failed to load.
  */
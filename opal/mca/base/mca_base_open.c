@@ -55,6 +55,7 @@ char *mca_base_user_default_path = NULL;
 bool mca_base_component_show_load_errors = (bool) OPAL_SHOW_LOAD_ERRORS_DEFAULT;
 bool mca_base_component_track_load_errors = false;
 bool mca_base_component_disable_dlopen = false;
+bool mca_base_component_use_manifest = true;
 
 static char *mca_base_verbose = NULL;
 
@@ -129,6 +130,15 @@ int mca_base_open(void)
     (void) mca_base_var_register_synonym(var_id, "opal", "mca", NULL, "component_disable_dlopen",
                                          MCA_BASE_VAR_SYN_FLAG_DEPRECATED);
 
+    mca_base_component_use_manifest = true;
+    (void) mca_base_var_register("opal", "mca", "base", "component_use_manifest",
+                                 "Whether to read the list of dynamic components from the "
+                                 MCA_BASE_COMPONENT_MANIFEST " file generated at install time "
+                                 "instead of scanning the component directory. The manifest is "
+                                 "ignored if the directory was modified after it was generated",
+                                 MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0, OPAL_INFO_LVL_9,
+                                 MCA_BASE_VAR_SCOPE_READONLY, &mca_base_component_use_manifest);
+
     /* What verbosity level do we want for the default 0 stream? */
     char *str = getenv("OPAL_OUTPUT_INTERNAL_TO_STDOUT");
     if (NULL != str && str[0] == '1') {
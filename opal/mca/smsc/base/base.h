@@ -12,12 +12,122 @@
 #define OPAL_MCA_SMSC_BASE_BASE_H
 
 #include "opal/mca/smsc/smsc.h"
+#include "opal/class/opal_list.h"
 
 extern mca_base_framework_t opal_smsc_base_framework;
 extern mca_smsc_component_t *selected_component;
 extern mca_smsc_module_t *selected_module;
 
+/** maximum number of unreferenced regions kept in the mapped-region cache */
+extern unsigned int mca_smsc_base_region_cache_max_entries;
+/** mapped-region cache statistics (exposed as performance variables) */
+extern unsigned long mca_smsc_base_region_cache_hits;
+extern unsigned long mca_smsc_base_region_cache_misses;
+extern unsigned long mca_smsc_base_region_cache_evictions;
+extern unsigned long mca_smsc_base_region_cache_invalidations;
+
 int mca_smsc_base_select(void);
 void mca_smsc_base_register_default_params(mca_smsc_component_t *component, int default_priority);
 
+/*
+ * Mapped-region cache
+ *
+ * Components that can map peer memory (MCA_SMSC_FEATURE_CAN_MAP) can use this cache to avoid
+ * re-establishing a mapping for every transfer. Regions are keyed by (endpoint, peer address
+ * range) in an interval tree and carry the peer segment they were attached through. A mapping
+ * follows the peer's address space, so it stays valid while that segment does: a lookup through
+ * a different segment drops it. Regions that are no longer referenced stay mapped and are kept
+ * on an LRU list until they are evicted (see smsc_base_region_cache_max_entries), found stale,
+ * or flushed when the endpoint is returned.
+ */
+
+enum {
+    /** Region has been removed from the cache and will be detached on the last unmap. */
+    MCA_SMSC_BASE_REGION_FLAG_RETIRED = 0x1,
+    /** Region was attached through a peer segment that is no longer current. */
+    MCA_SMSC_BASE_REGION_FLAG_INVALID = 0x2,
+};
+
+struct mca_smsc_base_region_t {
+    /** LRU list linkage. Only valid while the region is unreferenced. */
+    opal_list_item_t super;
+    /** Endpoint this region belongs to */
+    mca_smsc_endpoint_t *endpoint;
+    /** Peer segment the region was attached through */
+    uint64_t segment;
+    /** First byte of the region in the peer's address space */
+    uintptr_t base;
+    /** One past the last byte of the region in the peer's address space */
+    uintptr_t bound;
+    /** Address of base in this process */
+    void *local_base;
+    /** Number of active users of this region */
+    opal_atomic_int32_t ref_count;
+    /** Region flags (see MCA_SMSC_BASE_REGION_FLAG_*) */
+    opal_atomic_int32_t flags;
+};
+
+typedef struct mca_smsc_base_region_t mca_smsc_base_region_t;
+
+OBJ_CLASS_DECLARATION(mca_smsc_base_region_t);
+
+/**
+ * @brief Attach a peer memory region.
+ *
+ * @param(in) endpoint  shared-memory single-copy endpoint
+ * @param(in) base      start of the region in the peer's address space
+ * @param(in) size      size of the region
+ *
+ * @returns the local address of base or NULL on failure
+ */
+typedef void *(*mca_smsc_base_region_attach_fn_t)(mca_smsc_endpoint_t *endpoint, uintptr_t base,
+                                                  size_t size);
+
+/**
+ * @brief Detach a region previously attached with the attach function.
+ *
+ * @param(in) local_base  local address returned by the attach function
+ * @param(in) size        size of the region
+ *
+ * The endpoint may already have been returned when this function is called.
+ */
+typedef void (*mca_smsc_base_region_detach_fn_t)(void *local_base, size_t size);
+
+/**
+ * @brief Enable the mapped-region cache for the selected component.
+ */
+int mca_smsc_base_region_cache_init(mca_smsc_base_region_attach_fn_t attach,
+                                    mca_smsc_base_region_detach_fn_t detach);
+
+/**
+ * @brief Detach all cached regions and tear down the cache.
+ */
+void mca_smsc_base_region_cache_fini(void);
+
+/**
+ * @brief Find or create a mapping that covers [base, bound) in the peer's address space.
+ *
+ * @param(in) segment  identifies the peer segment the mapping goes through (e.g. the xpmem apid).
+ *                     Cached regions of the endpoint attached through another segment are
+ *                     dropped.
+ *
+ * @returns a referenced region or NULL if the region could not be attached
+ *
+ * Overlapping regions for the same endpoint are coalesced into the new mapping. The caller must
+ * drop the reference with mca_smsc_base_region_cache_unmap().
+ */
+mca_smsc_base_region_t *mca_smsc_base_region_cache_map(mca_smsc_endpoint_t *endpoint,
+                                                       uint64_t segment, uintptr_t base,
+                                                       uintptr_t bound);
+
+/**
+ * @brief Drop a reference to a region returned by mca_smsc_base_region_cache_map().
+ */
+void mca_smsc_base_region_cache_unmap(mca_smsc_base_region_t *region);
+
+/**
+ * @brief Remove all regions belonging to an endpoint from the cache.
+ */
+void mca_smsc_base_region_cache_flush(mca_smsc_endpoint_t *endpoint);
+
 #endif /* OPAL_MCA_SMSC_BASE_BASE_H */
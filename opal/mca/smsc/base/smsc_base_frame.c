@@ -23,6 +23,7 @@
 
 #include "opal/class/opal_list.h"
 #include "opal/mca/base/base.h"
+#include "opal/mca/base/mca_base_pvar.h"
 #include "opal/mca/mca.h"
 #include "opal/mca/smsc/base/base.h"
 #include "opal/mca/smsc/smsc.h"
@@ -38,10 +39,67 @@
 mca_smsc_component_t *selected_component = NULL;
 mca_smsc_module_t *mca_smsc = NULL;
 
+unsigned int mca_smsc_base_region_cache_max_entries = 1024;
+unsigned long mca_smsc_base_region_cache_hits = 0;
+unsigned long mca_smsc_base_region_cache_misses = 0;
+unsigned long mca_smsc_base_region_cache_evictions = 0;
+unsigned long mca_smsc_base_region_cache_invalidations = 0;
+
+static int mca_smsc_base_register(mca_base_register_flag_t flags);
+static int mca_smsc_base_close(void);
+
 /*
  * Global variables
  */
-MCA_BASE_FRAMEWORK_DECLARE(opal, smsc, NULL, NULL, NULL, NULL, mca_smsc_base_static_components, 0);
+MCA_BASE_FRAMEWORK_DECLARE(opal, smsc, NULL, mca_smsc_base_register, NULL, mca_smsc_base_close,
+                           mca_smsc_base_static_components, 0);
+
+static void mca_smsc_base_register_cache_pvar(const char *name, const char *desc,
+                                              unsigned long *counter)
+{
+    (void) mca_base_pvar_register("opal", "smsc", "base", name, desc, OPAL_INFO_LVL_4,
+                                  MCA_BASE_PVAR_CLASS_COUNTER, MCA_BASE_VAR_TYPE_UNSIGNED_LONG,
+                                  NULL, MCA_BASE_VAR_BIND_NO_OBJECT,
+                                  MCA_BASE_PVAR_FLAG_READONLY | MCA_BASE_PVAR_FLAG_CONTINUOUS,
+                                  NULL, NULL, NULL, (void *) counter);
+}
+
+static int mca_smsc_base_register(mca_base_register_flag_t flags)
+{
+    mca_smsc_base_region_cache_max_entries = 1024;
+    (void) mca_base_framework_var_register(&opal_smsc_base_framework, "region_cache_max_entries",
+                                           "Maximum number of unused peer memory mappings to keep "
+                                           "in the mapped-region cache. Least recently used "
+                                           "mappings are removed first. Set to 0 to unmap regions "
+                                           "as soon as they are no longer in use (default: 1024)",
+                                           MCA_BASE_VAR_TYPE_UNSIGNED_INT, NULL, 0,
+                                           MCA_BASE_VAR_FLAG_SETTABLE, OPAL_INFO_LVL_5,
+                                           MCA_BASE_VAR_SCOPE_LOCAL,
+                                           &mca_smsc_base_region_cache_max_entries);
+
+    mca_smsc_base_register_cache_pvar("region_cache_hits",
+                                      "Number of peer region lookups satisfied by an existing "
+                                      "mapping",
+                                      &mca_smsc_base_region_cache_hits);
+    mca_smsc_base_register_cache_pvar("region_cache_misses",
+                                      "Number of peer region lookups that required a new mapping",
+                                      &mca_smsc_base_region_cache_misses);
+    mca_smsc_base_register_cache_pvar("region_cache_evictions",
+                                      "Number of unused peer mappings removed to stay within "
+                                      "smsc_base_region_cache_max_entries",
+                                      &mca_smsc_base_region_cache_evictions);
+    mca_smsc_base_register_cache_pvar("region_cache_invalidations",
+                                      "Number of peer mappings dropped because the peer segment changed",
+                                      &mca_smsc_base_region_cache_invalidations);
+
+    return OPAL_SUCCESS;
+}
+
+static int mca_smsc_base_close(void)
+{
+    mca_smsc_base_region_cache_fini();
+    return mca_base_framework_components_close(&opal_smsc_base_framework, NULL);
+}
 
 static int mca_smsc_compare_components(opal_list_item_t **a, opal_list_item_t **b)
 {
@@ -0,0 +1,299 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "opal_config.h"
+
+#include "opal/class/opal_interval_tree.h"
+#include "opal/mca/base/base.h"
+#include "opal/mca/threads/mutex.h"
+#include "opal/mca/smsc/base/base.h"
+#include "opal/util/minmax.h"
+
+OBJ_CLASS_INSTANCE(mca_smsc_base_region_t, opal_list_item_t, NULL, NULL);
+
+struct mca_smsc_base_region_cache_t {
+    /** cache is usable */
+    bool enabled;
+    /** protects the tree and the LRU list */
+    opal_mutex_t lock;
+    /** all cached regions keyed by peer address range. regions for different endpoints may
+     * overlap so lookups need to filter on the endpoint. */
+    opal_interval_tree_t remote_tree;
+    /** unreferenced regions. least recently used first. */
+    opal_list_t lru;
+    /** component attach function */
+    mca_smsc_base_region_attach_fn_t attach;
+    /** component detach function */
+    mca_smsc_base_region_detach_fn_t detach;
+};
+
+typedef struct mca_smsc_base_region_cache_t mca_smsc_base_region_cache_t;
+
+static mca_smsc_base_region_cache_t mca_smsc_base_region_cache = {.enabled = false};
+
+struct mca_smsc_base_region_find_ctx_t {
+    mca_smsc_endpoint_t *endpoint;
+    uint64_t segment;
+    uintptr_t base;
+    uintptr_t bound;
+    mca_smsc_base_region_t *region;
+};
+
+typedef struct mca_smsc_base_region_find_ctx_t mca_smsc_base_region_find_ctx_t;
+
+enum {
+    /** found a region that covers the requested range */
+    MCA_SMSC_BASE_REGION_FOUND = 1,
+    /** found a region that needs to be removed before continuing the search */
+    MCA_SMSC_BASE_REGION_REMOVE = 2,
+};
+
+static void mca_smsc_base_region_detach(mca_smsc_base_region_t *region)
+{
+    opal_output_verbose(MCA_BASE_VERBOSE_INFO, opal_smsc_base_framework.framework_output,
+                        "mca_smsc_base_region_detach: deleting region mapping for endpoint %p "
+                        "address range 0x%" PRIxPTR "-0x%" PRIxPTR,
+                        (void *) region->endpoint, region->base, region->bound);
+    mca_smsc_base_region_cache.detach(region->local_base, region->bound - region->base);
+    OBJ_RELEASE(region);
+}
+
+/* remove a region from the cache. must be called with the cache lock held. */
+static void mca_smsc_base_region_retire(mca_smsc_base_region_t *region)
+{
+    mca_smsc_base_region_cache_t *cache = &mca_smsc_base_region_cache;
+
+    if (MCA_SMSC_BASE_REGION_FLAG_RETIRED & region->flags) {
+        return;
+    }
+
+    opal_atomic_fetch_or_32(&region->flags, MCA_SMSC_BASE_REGION_FLAG_RETIRED);
+    (void) opal_interval_tree_delete(&cache->remote_tree, region->base, region->bound - 1, region);
+
+    if (0 == region->ref_count) {
+        opal_list_remove_item(&cache->lru, &region->super);
+        mca_smsc_base_region_detach(region);
+    }
+    /* otherwise the region is detached when the last user unmaps it */
+}
+
+static int mca_smsc_base_region_find_cb(uint64_t low, uint64_t high, void *data, void *ctx)
+{
+    mca_smsc_base_region_find_ctx_t *find_ctx = (mca_smsc_base_region_find_ctx_t *) ctx;
+    mca_smsc_base_region_t *region = (mca_smsc_base_region_t *) data;
+
+    if (region->endpoint != find_ctx->endpoint) {
+        /* ignore this region */
+        return OPAL_SUCCESS;
+    }
+
+    find_ctx->region = region;
+
+    if (region->segment != find_ctx->segment) {
+        /* the peer exposes a different segment now, the mapping is stale */
+        opal_atomic_fetch_or_32(&region->flags, MCA_SMSC_BASE_REGION_FLAG_INVALID);
+        return MCA_SMSC_BASE_REGION_REMOVE;
+    }
+
+    if (find_ctx->base >= region->base && find_ctx->bound <= region->bound) {
+        return MCA_SMSC_BASE_REGION_FOUND;
+    }
+
+    /* overlapping region. coalesce it into the requested range. */
+    find_ctx->base = opal_min(find_ctx->base, region->base);
+    find_ctx->bound = opal_max(find_ctx->bound, region->bound);
+    return MCA_SMSC_BASE_REGION_REMOVE;
+}
+
+/* must be called with the cache lock held */
+static void mca_smsc_base_region_cache_trim(void)
+{
+    mca_smsc_base_region_cache_t *cache = &mca_smsc_base_region_cache;
+
+    while (opal_list_get_size(&cache->lru) > mca_smsc_base_region_cache_max_entries) {
+        mca_smsc_base_region_t *region = (mca_smsc_base_region_t *) opal_list_get_first(
+            &cache->lru);
+        ++mca_smsc_base_region_cache_evictions;
+        mca_smsc_base_region_retire(region);
+    }
+}
+
+mca_smsc_base_region_t *mca_smsc_base_region_cache_map(mca_smsc_endpoint_t *endpoint,
+                                                       uint64_t segment, uintptr_t base,
+                                                       uintptr_t bound)
+{
+    mca_smsc_base_region_cache_t *cache = &mca_smsc_base_region_cache;
+    mca_smsc_base_region_find_ctx_t find_ctx = {.endpoint = endpoint, .segment = segment,
+                                                .base = base, .bound = bound};
+    mca_smsc_base_region_t *region;
+    int rc;
+
+    OPAL_THREAD_LOCK(&cache->lock);
+
+    do {
+        find_ctx.region = NULL;
+        rc = opal_interval_tree_traverse(&cache->remote_tree, find_ctx.base, find_ctx.bound - 1,
+                                         true, mca_smsc_base_region_find_cb, &find_ctx);
+        if (MCA_SMSC_BASE_REGION_REMOVE == rc) {
+            if (MCA_SMSC_BASE_REGION_FLAG_INVALID & find_ctx.region->flags) {
+                ++mca_smsc_base_region_cache_invalidations;
+            }
+            mca_smsc_base_region_retire(find_ctx.region);
+        }
+    } while (MCA_SMSC_BASE_REGION_REMOVE == rc);
+
+    if (MCA_SMSC_BASE_REGION_FOUND == rc) {
+        region = find_ctx.region;
+        if (0 == region->ref_count++) {
+            opal_list_remove_item(&cache->lru, &region->super);
+        }
+        ++mca_smsc_base_region_cache_hits;
+        OPAL_THREAD_UNLOCK(&cache->lock);
+        return region;
+    }
+
+    ++mca_smsc_base_region_cache_misses;
+
+    region = OBJ_NEW(mca_smsc_base_region_t);
+    if (OPAL_UNLIKELY(NULL == region)) {
+        OPAL_THREAD_UNLOCK(&cache->lock);
+        return NULL;
+    }
+
+    region->endpoint = endpoint;
+    region->segment = segment;
+    region->base = find_ctx.base;
+    region->bound = find_ctx.bound;
+    region->ref_count = 1;
+    region->flags = 0;
+
+    opal_output_verbose(MCA_BASE_VERBOSE_INFO, opal_smsc_base_framework.framework_output,
+                        "mca_smsc_base_region_cache_map: creating region mapping for endpoint %p "
+                        "address range 0x%" PRIxPTR "-0x%" PRIxPTR,
+                        (void *) endpoint, region->base, region->bound);
+
+    region->local_base = cache->attach(endpoint, region->base, region->bound - region->base);
+    if (OPAL_UNLIKELY(NULL == region->local_base)) {
+        OPAL_THREAD_UNLOCK(&cache->lock);
+        OBJ_RELEASE(region);
+        return NULL;
+    }
+
+    (void) opal_interval_tree_insert(&cache->remote_tree, region, region->base, region->bound - 1);
+
+    OPAL_THREAD_UNLOCK(&cache->lock);
+
+    return region;
+}
+
+void mca_smsc_base_region_cache_unmap(mca_smsc_base_region_t *region)
+{
+    mca_smsc_base_region_cache_t *cache = &mca_smsc_base_region_cache;
+
+    OPAL_THREAD_LOCK(&cache->lock);
+    if (0 == --region->ref_count) {
+        if (MCA_SMSC_BASE_REGION_FLAG_RETIRED & region->flags) {
+            mca_smsc_base_region_detach(region);
+        } else {
+            /* keep the mapping around for the next user */
+            opal_list_append(&cache->lru, &region->super);
+            mca_smsc_base_region_cache_trim();
+        }
+    }
+    OPAL_THREAD_UNLOCK(&cache->lock);
+}
+
+static int mca_smsc_base_region_flush_cb(uint64_t low, uint64_t high, void *data, void *ctx)
+{
+    mca_smsc_base_region_find_ctx_t *find_ctx = (mca_smsc_base_region_find_ctx_t *) ctx;
+    mca_smsc_base_region_t *region = (mca_smsc_base_region_t *) data;
+
+    if (NULL != find_ctx->endpoint && region->endpoint != find_ctx->endpoint) {
+        return OPAL_SUCCESS;
+    }
+
+    find_ctx->region = region;
+    return MCA_SMSC_BASE_REGION_REMOVE;
+}
+
+void mca_smsc_base_region_cache_flush(mca_smsc_endpoint_t *endpoint)
+{
+    mca_smsc_base_region_cache_t *cache = &mca_smsc_base_region_cache;
+    mca_smsc_base_region_find_ctx_t find_ctx = {.endpoint = endpoint};
+    int rc;
+
+    if (!cache->enabled) {
+        return;
+    }
+
+    opal_output_verbose(MCA_BASE_VERBOSE_INFO, opal_smsc_base_framework.framework_output,
+                        "mca_smsc_base_region_cache_flush: flushing regions for endpoint %p",
+                        (void *) endpoint);
+
+    OPAL_THREAD_LOCK(&cache->lock);
+    do {
+        /* the tree can not be modified during the traversal so remove one region at a time */
+        rc = opal_interval_tree_traverse(&cache->remote_tree, 0, UINT64_MAX, true,
+                                         mca_smsc_base_region_flush_cb, &find_ctx);
+        if (MCA_SMSC_BASE_REGION_REMOVE == rc) {
+            mca_smsc_base_region_retire(find_ctx.region);
+        }
+    } while (MCA_SMSC_BASE_REGION_REMOVE == rc);
+    OPAL_THREAD_UNLOCK(&cache->lock);
+}
+
+int mca_smsc_base_region_cache_init(mca_smsc_base_region_attach_fn_t attach,
+                                    mca_smsc_base_region_detach_fn_t detach)
+{
+    mca_smsc_base_region_cache_t *cache = &mca_smsc_base_region_cache;
+    int rc;
+
+    if (cache->enabled) {
+        return OPAL_SUCCESS;
+    }
+
+    OBJ_CONSTRUCT(&cache->lock, opal_mutex_t);
+    OBJ_CONSTRUCT(&cache->lru, opal_list_t);
+    OBJ_CONSTRUCT(&cache->remote_tree, opal_interval_tree_t);
+
+    rc = opal_interval_tree_init(&cache->remote_tree);
+    if (OPAL_UNLIKELY(OPAL_SUCCESS != rc)) {
+        OBJ_DESTRUCT(&cache->remote_tree);
+        OBJ_DESTRUCT(&cache->lru);
+        OBJ_DESTRUCT(&cache->lock);
+        return rc;
+    }
+
+    cache->attach = attach;
+    cache->detach = detach;
+    cache->enabled = true;
+
+    opal_output_verbose(MCA_BASE_VERBOSE_COMPONENT, opal_smsc_base_framework.framework_output,
+                        "mca_smsc_base_region_cache_init: mapped-region cache enabled. max "
+                        "entries: %u",
+                        mca_smsc_base_region_cache_max_entries);
+
+    return OPAL_SUCCESS;
+}
+
+void mca_smsc_base_region_cache_fini(void)
+{
+    mca_smsc_base_region_cache_t *cache = &mca_smsc_base_region_cache;
+
+    if (!cache->enabled) {
+        return;
+    }
+
+    mca_smsc_base_region_cache_flush(NULL);
+    cache->enabled = false;
+
+    OBJ_DESTRUCT(&cache->remote_tree);
+    OBJ_DESTRUCT(&cache->lru);
+    OBJ_DESTRUCT(&cache->lock);
+}
@@ -76,10 +76,7 @@ static int mca_smsc_xpmem_component_open(void)
 
 static int mca_smsc_xpmem_component_close(void)
 {
-    if (mca_smsc_xpmem_module.vma_module) {
-        OBJ_RELEASE(mca_smsc_xpmem_module.vma_module);
-    }
-
+    /* the mapped-region cache is torn down by the base */
     return OPAL_SUCCESS;
 }
 
@@ -161,7 +158,10 @@ static mca_smsc_module_t *mca_smsc_xpmem_component_enable(void)
     mca_smsc_xpmem_component.log_attach_align
         = opal_min(opal_max(mca_smsc_xpmem_component.log_attach_align, 12), 25);
 
-    mca_smsc_xpmem_module.vma_module = mca_rcache_base_vma_module_alloc();
+    if (OPAL_SUCCESS
+        != mca_smsc_base_region_cache_init(mca_smsc_xpmem_attach, mca_smsc_xpmem_detach)) {
+        return NULL;
+    }
 
     return &mca_smsc_xpmem_module.super;
 }
@@ -13,7 +13,7 @@
 
 #include "opal/mca/smsc/xpmem/smsc_xpmem.h"
 
-#include "opal/mca/rcache/base/rcache_base_vma.h"
+#include "opal/mca/smsc/base/base.h"
 #if defined(HAVE_XPMEM_H)
 #    include <xpmem.h>
 
@@ -67,10 +67,6 @@ typedef struct mca_smsc_xpmem_component_t mca_smsc_xpmem_component_t;
 
 struct mca_smsc_xpmem_module_t {
     mca_smsc_module_t super;
-
-    /** cache of xpmem attachments. this cache holds attachments for all peers. the registrations
-     * are differentiated by the alloc_base which is set to the endpoint. */
-    mca_rcache_base_vma_module_t *vma_module;
 };
 
 typedef struct mca_smsc_xpmem_module_t mca_smsc_xpmem_module_t;
@@ -78,4 +74,8 @@ typedef struct mca_smsc_xpmem_module_t mca_smsc_xpmem_module_t;
 extern mca_smsc_xpmem_module_t mca_smsc_xpmem_module;
 extern mca_smsc_xpmem_component_t mca_smsc_xpmem_component;
 
+/** attach/detach functions used by the base mapped-region cache */
+void *mca_smsc_xpmem_attach(mca_smsc_endpoint_t *endpoint, uintptr_t base, size_t size);
+void mca_smsc_xpmem_detach(void *local_base, size_t size);
+
 #endif /* OPAL_MCA_SMSC_XPMEM_SMSC_XPMEM_INTERNAL_H */
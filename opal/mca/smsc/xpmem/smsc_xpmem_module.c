@@ -19,7 +19,6 @@
 #include "opal/include/opal/align.h"
 #include "opal/mca/memchecker/base/base.h"
 #include "opal/mca/pmix/pmix-internal.h"
-#include "opal/mca/rcache/rcache.h"
 #include "opal/mca/smsc/base/base.h"
 #include "opal/mca/smsc/xpmem/smsc_xpmem_internal.h"
 #include "opal/util/minmax.h"
@@ -51,69 +50,44 @@ mca_smsc_endpoint_t *mca_smsc_xpmem_get_endpoint(opal_proc_t *peer_proc)
     return &endpoint->super;
 }
 
-struct mca_smsc_xpmem_cleanup_reg_ctx_t {
-    mca_smsc_xpmem_endpoint_t *endpoint;
-    opal_list_t *registrations;
-};
-
-typedef struct mca_smsc_xpmem_cleanup_reg_ctx_t mca_smsc_xpmem_cleanup_reg_ctx_t;
-
-struct mca_smsc_xpmem_check_reg_ctx_t {
-    mca_smsc_xpmem_endpoint_t *endpoint;
-    mca_rcache_base_registration_t **reg;
-    uintptr_t base;
-    uintptr_t bound;
-};
-typedef struct mca_smsc_xpmem_check_reg_ctx_t mca_smsc_xpmem_check_reg_ctx_t;
-
-static int mca_smsc_xpmem_check_reg(mca_rcache_base_registration_t *reg, void *ctx)
+void *mca_smsc_xpmem_attach(mca_smsc_endpoint_t *endpoint, uintptr_t base, size_t size)
 {
-    mca_smsc_xpmem_check_reg_ctx_t *xpmem_ctx = (mca_smsc_xpmem_check_reg_ctx_t *) ctx;
+    mca_smsc_xpmem_endpoint_t *xpmem_endpoint = (mca_smsc_xpmem_endpoint_t *) endpoint;
+    xpmem_addr_t xpmem_addr;
+    void *local_base;
 
-    if (reg->alloc_base != (void *) xpmem_ctx->endpoint) {
-        /* ignore this registration */
-        return OPAL_SUCCESS;
-    }
+#if defined(HAVE_SN_XPMEM_H)
+    xpmem_addr.id = xpmem_endpoint->apid;
+#else
+    xpmem_addr.apid = xpmem_endpoint->apid;
+#endif
+    xpmem_addr.offset = base;
 
-    xpmem_ctx->reg[0] = reg;
-
-    if (xpmem_ctx->bound <= (uintptr_t) reg->bound && xpmem_ctx->base >= (uintptr_t) reg->base) {
-        if (0 == opal_atomic_fetch_add_32(&reg->ref_count, 1)) {
-            /* registration is being deleted by a thread in sm_return_registration. the
-             * VMA tree implementation will block in mca_rcache_delete until we finish
-             * iterating over the VMA tree so it is safe to just ignore this registration
-             * and continue. */
-            xpmem_ctx->reg[0] = NULL;
-            return OPAL_SUCCESS;
-        }
-        return 1;
+    local_base = xpmem_attach(xpmem_addr, size, NULL);
+    if (OPAL_UNLIKELY((void *) -1 == local_base)) {
+        return NULL;
     }
 
-    if (MCA_RCACHE_FLAGS_INVALID & opal_atomic_fetch_or_32(&reg->flags, MCA_RCACHE_FLAGS_INVALID)) {
-        /* another thread has already marked this registration as invalid. ignore and continue. */
-        xpmem_ctx->reg[0] = NULL;
-        return OPAL_SUCCESS;
-    }
+    opal_memchecker_base_mem_defined(local_base, size);
+
+    return local_base;
+}
 
-    /* let the caller know we found an overlapping registration that can be coalesced into
-     * the requested interval. the caller will remove the last reference and delete the
-     * registration. */
-    return 2;
+void mca_smsc_xpmem_detach(void *local_base, size_t size)
+{
+    opal_memchecker_base_mem_noaccess(local_base, size);
+    (void) xpmem_detach(local_base);
 }
 
-/* look up the remote pointer in the peer rcache and attach if
+/* look up the remote pointer in the mapped-region cache and attach if
  * necessary */
 void *mca_smsc_xpmem_map_peer_region(mca_smsc_endpoint_t *endpoint, uint64_t flags,
                                      void *remote_ptr, size_t size, void **local_ptr)
 {
     mca_smsc_xpmem_endpoint_t *xpmem_endpoint = (mca_smsc_xpmem_endpoint_t *) endpoint;
-    mca_rcache_base_vma_module_t *vma_module = mca_smsc_xpmem_module.vma_module;
     uint64_t attach_align = 1 << mca_smsc_xpmem_component.log_attach_align;
-    mca_rcache_base_registration_t *reg = NULL;
-    mca_smsc_xpmem_check_reg_ctx_t check_ctx = {.endpoint = xpmem_endpoint, .reg = &reg};
-    xpmem_addr_t xpmem_addr;
+    mca_smsc_base_region_t *region;
     uintptr_t base, bound;
-    int rc;
 
     base = OPAL_DOWN_ALIGN((uintptr_t) remote_ptr, attach_align, uintptr_t);
     bound = OPAL_ALIGN((uintptr_t) remote_ptr + size - 1, attach_align, uintptr_t) + 1;
@@ -121,117 +95,30 @@ void *mca_smsc_xpmem_map_peer_region(mca_smsc_endpoint_t *endpoint, uint64_t fla
         bound = xpmem_endpoint->address_max;
     }
 
-    check_ctx.base = base;
-    check_ctx.bound = bound;
-
-    /* several segments may match the base pointer */
-    rc = mca_rcache_base_vma_iterate(vma_module, (void *) base, bound - base, true,
-                                     mca_smsc_xpmem_check_reg, &check_ctx);
-    if (2 == rc) {
-        bound = bound < (uintptr_t) reg->bound ? (uintptr_t) reg->bound : bound;
-        base = base > (uintptr_t) reg->base ? (uintptr_t) reg->base : base;
-        mca_smsc_xpmem_unmap_peer_region(reg);
-        reg = NULL;
-    }
-
-    if (NULL == reg) {
-        reg = OBJ_NEW(mca_rcache_base_registration_t);
-        if (OPAL_LIKELY(NULL != reg)) {
-            /* stick around for awhile */
-            reg->ref_count = 2;
-            reg->base = (unsigned char *) base;
-            reg->bound = (unsigned char *) bound;
-            reg->alloc_base = (void *) endpoint;
-
-#if defined(HAVE_SN_XPMEM_H)
-            xpmem_addr.id = xpmem_endpoint->apid;
-#else
-            xpmem_addr.apid = xpmem_endpoint->apid;
-#endif
-            xpmem_addr.offset = base;
-
-            opal_output_verbose(MCA_BASE_VERBOSE_INFO, opal_smsc_base_framework.framework_output,
-                                "mca_smsc_xpmem_map_peer_region: creating region mapping "
-                                "for endpoint %p address range %p-%p",
-                                endpoint, reg->base, reg->bound);
-
-            reg->rcache_context = xpmem_attach(xpmem_addr, bound - base, NULL);
-            if (OPAL_UNLIKELY((void *) -1 == reg->rcache_context)) {
-                OBJ_RELEASE(reg);
-                return NULL;
-            }
-
-            opal_memchecker_base_mem_defined(reg->rcache_context, bound - base);
-
-            mca_rcache_base_vma_insert(vma_module, reg, 0);
-        }
+    region = mca_smsc_base_region_cache_map(endpoint, (uint64_t) xpmem_endpoint->apid, base,
+                                            bound);
+    if (OPAL_UNLIKELY(NULL == region)) {
+        return NULL;
     }
 
-    opal_atomic_wmb();
-    *local_ptr = (void *) ((uintptr_t) reg->rcache_context
-                           + (ptrdiff_t)((uintptr_t) remote_ptr - (uintptr_t) reg->base));
+    *local_ptr = (void *) ((uintptr_t) region->local_base
+                           + (ptrdiff_t)((uintptr_t) remote_ptr - region->base));
 
-    return (void *) reg;
+    return (void *) region;
 }
 
 void mca_smsc_xpmem_unmap_peer_region(void *ctx)
 {
-    mca_rcache_base_registration_t *reg = (mca_rcache_base_registration_t *) ctx;
-    mca_rcache_base_vma_module_t *vma_module = mca_smsc_xpmem_module.vma_module;
-    int32_t ref_count;
-
-    ref_count = opal_atomic_add_fetch_32(&reg->ref_count, -1);
-    if (OPAL_UNLIKELY(0 == ref_count && !(reg->flags & MCA_RCACHE_FLAGS_PERSIST))) {
-        opal_output_verbose(MCA_BASE_VERBOSE_INFO, opal_smsc_base_framework.framework_output,
-                            "mca_smsc_xpmem_unmap_peer_region: deleting region mapping for "
-                            "endpoint %p address range %p-%p",
-                            reg->alloc_base, reg->base, reg->bound);
-#if OPAL_ENABLE_DEBUG
-        int ret = mca_rcache_base_vma_delete(vma_module, reg);
-        assert(OPAL_SUCCESS == ret);
-#else
-        (void) mca_rcache_base_vma_delete(vma_module, reg);
-#endif
-        opal_memchecker_base_mem_noaccess(reg->rcache_context, (uintptr_t)(reg->bound - reg->base));
-        (void) xpmem_detach(reg->rcache_context);
-        OBJ_RELEASE(reg);
-    }
-}
-
-static int mca_smsc_xpmem_endpoint_rcache_cleanup(mca_rcache_base_registration_t *reg, void *ctx)
-{
-    mca_smsc_xpmem_cleanup_reg_ctx_t *cleanup_ctx = (mca_smsc_xpmem_cleanup_reg_ctx_t *) ctx;
-    if (reg->alloc_base == (void *) cleanup_ctx->endpoint) {
-        opal_list_append(cleanup_ctx->registrations, &reg->super.super);
-    }
-
-    return OPAL_SUCCESS;
+    mca_smsc_base_region_cache_unmap((mca_smsc_base_region_t *) ctx);
 }
 
 static void mca_smsc_xpmem_cleanup_endpoint(mca_smsc_xpmem_endpoint_t *endpoint)
 {
-    mca_rcache_base_registration_t *reg;
-    opal_list_t registrations;
-    mca_smsc_xpmem_cleanup_reg_ctx_t cleanup_ctx = {.endpoint = endpoint,
-                                                    .registrations = &registrations};
-
     opal_output_verbose(MCA_BASE_VERBOSE_INFO, opal_smsc_base_framework.framework_output,
                         "mca_smsc_xpmem_cleanup_endpoint: cleaning up endpoint %p", endpoint);
 
-    OBJ_CONSTRUCT(&registrations, opal_list_t);
-
-    /* clean out the registration cache */
-    (void) mca_rcache_base_vma_iterate(mca_smsc_xpmem_module.vma_module, NULL, (size_t) -1, true,
-                                       mca_smsc_xpmem_endpoint_rcache_cleanup,
-                                       (void *) &cleanup_ctx);
-    opal_output_verbose(MCA_BASE_VERBOSE_INFO, opal_smsc_base_framework.framework_output,
-                        "mca_smsc_xpmem_cleanup_endpoint: deleting %" PRIsize_t " region mappings",
-                        opal_list_get_size(&registrations));
-    while (NULL
-           != (reg = (mca_rcache_base_registration_t *) opal_list_remove_first(&registrations))) {
-        mca_smsc_xpmem_unmap_peer_region(reg);
-    }
-    OBJ_DESTRUCT(&registrations);
+    /* remove all mappings for this peer from the cache */
+    mca_smsc_base_region_cache_flush(&endpoint->super);
 
     xpmem_release(endpoint->apid);
     endpoint->apid = 0;
@@ -264,6 +151,10 @@ int mca_smsc_xpmem_copy_to(mca_smsc_endpoint_t *endpoint, void *local_address, v
 
     void *remote_ptr, *ctx;
     ctx = mca_smsc_xpmem_map_peer_region(endpoint, /*flags=*/0, remote_address, size, &remote_ptr);
+    if (OPAL_UNLIKELY(NULL == ctx)) {
+        return OPAL_ERROR;
+    }
+
     mca_smsc_xpmem_memmove(remote_ptr, local_address, size);
 
     mca_smsc_xpmem_unmap_peer_region(ctx);
@@ -281,6 +172,10 @@ int mca_smsc_xpmem_copy_from(mca_smsc_endpoint_t *endpoint, void *local_address,
 
     struct timespec start, stop;
     ctx = mca_smsc_xpmem_map_peer_region(endpoint, /*flags=*/0, remote_address, size, &remote_ptr);
+    if (OPAL_UNLIKELY(NULL == ctx)) {
+        return OPAL_ERROR;
+    }
+
     mca_smsc_xpmem_memmove(local_address, remote_ptr, size);
 
     mca_smsc_xpmem_unmap_peer_region(ctx);